@@ -32,6 +32,12 @@ void  get_random_vector_of_magnitude(
         vector3&  resulting_vector
         );
 
+void  get_random_vector_of_magnitude(
+        float_32_bit const  magnitude,
+        counter_based_random_generator&   random_generator,
+        vector3&  resulting_vector
+        );
+
 
 }
 
@@ -4,17 +4,16 @@
 #include <utility/timeprof.hpp>
 #include <utility/log.hpp>
 
-namespace angeo {
+namespace angeo { namespace detail {
 
 
+template<typename random_generator_type>
 void  get_random_vector_of_magnitude(
         float_32_bit const  magnitude,
-        random_generator_for_natural_32_bit&   random_generator,
+        random_generator_type&   random_generator,
         vector3&  resulting_vector
         )
 {
-    TMPROF_BLOCK();
-
     ASSUMPTION(magnitude >= 0.0f);
 
     float_32_bit const  phi = get_random_float_32_bit_in_range(0.0f,2.0f * PI(),random_generator);
@@ -29,4 +28,33 @@ void  get_random_vector_of_magnitude(
 }
 
 
+}}
+
+namespace angeo {
+
+
+void  get_random_vector_of_magnitude(
+        float_32_bit const  magnitude,
+        random_generator_for_natural_32_bit&   random_generator,
+        vector3&  resulting_vector
+        )
+{
+    TMPROF_BLOCK();
+
+    detail::get_random_vector_of_magnitude(magnitude,random_generator,resulting_vector);
+}
+
+
+void  get_random_vector_of_magnitude(
+        float_32_bit const  magnitude,
+        counter_based_random_generator&   random_generator,
+        vector3&  resulting_vector
+        )
+{
+    TMPROF_BLOCK();
+
+    detail::get_random_vector_of_magnitude(magnitude,random_generator,resulting_vector);
+}
+
+
 }
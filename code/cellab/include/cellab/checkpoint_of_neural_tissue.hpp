@@ -0,0 +1,63 @@
+#ifndef CELLAB_CHECKPOINT_OF_NEURAL_TISSUE_HPP_INCLUDED
+#   define CELLAB_CHECKPOINT_OF_NEURAL_TISSUE_HPP_INCLUDED
+
+#   include <cellab/static_state_of_neural_tissue.hpp>
+#   include <cellab/dynamic_state_of_neural_tissue.hpp>
+#   include <utility/basic_numeric_types.hpp>
+#   include <boost/filesystem/path.hpp>
+#   include <memory>
+
+namespace cellab {
+
+
+/**
+ * A checkpoint is a binary file storing both the static and the dynamic state of a neural tissue. The static
+ * state is stored as the list of arguments of its constructor. The dynamic state is stored as its storage and
+ * buffering modes followed by all its arrays of units (see the method 'get_arrays_of_units_in_order_of_allocation'
+ * of 'dynamic_state_of_neural_tissue') copied verbatim. Each array starts at an offset aligned to 64 bytes.
+ *
+ * The file starts with a magic string, a version of the format, and a marker of the byte order of the machine
+ * which wrote the file. A checkpoint can only be loaded on a machine with the same byte order.
+ *
+ * Loading does NOT copy the arrays. The file is mapped into memory and the dynamic state is constructed directly
+ * over the mapped arrays (see the parameter 'memory_provider' of the constructor of 'dynamic_state_of_neural_tissue').
+ * So, loading takes time proportional to the size of the header only and pages of the tissue are read from
+ * the file lazily, when they are accessed for the first time. The neural tissue is then constructed from the
+ * loaded dynamic state by the constructor of 'neural_tissue' accepting a dynamic state.
+ */
+
+
+natural_32_bit  version_of_format_of_checkpoint_of_neural_tissue();
+
+
+/**
+ * These constants define what happens with modifications of a dynamic state loaded from a checkpoint.
+ */
+enum mapping_of_checkpoint_of_neural_tissue
+{
+    PRIVATE_MAPPING_OF_CHECKPOINT = 0,  //!< Modified pages are privately copied (copy-on-write). The file
+                                        //!< is never modified. So, any number of independent simulations
+                                        //!< (what-if branches) can be started from the same checkpoint.
+    SHARED_MAPPING_OF_CHECKPOINT = 1    //!< Modifications are written directly to the file. So, the file always
+                                        //!< holds the latest dynamic state (the static state cannot change).
+};
+
+
+void  save_checkpoint_of_neural_tissue(
+        dynamic_state_of_neural_tissue const&  dynamic_state,
+        boost::filesystem::path const&  path_to_checkpoint_file
+        );
+
+/**
+ * It throws 'std::runtime_error', if the file cannot be mapped, or if it is not a valid checkpoint
+ * of the current version written on a machine with the same byte order.
+ */
+std::shared_ptr<dynamic_state_of_neural_tissue>  load_checkpoint_of_neural_tissue(
+        boost::filesystem::path const&  path_to_checkpoint_file,
+        mapping_of_checkpoint_of_neural_tissue const  mapping = PRIVATE_MAPPING_OF_CHECKPOINT
+        );
+
+
+}
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef CELLAB_DOUBLE_BUFFERED_TRANSITION_OF_TISSUE_HPP_INCLUDED
+#   define CELLAB_DOUBLE_BUFFERED_TRANSITION_OF_TISSUE_HPP_INCLUDED
+
+#   include <cellab/static_state_of_neural_tissue.hpp>
+#   include <cellab/dynamic_state_of_neural_tissue.hpp>
+#   include <cellab/neighbourhood_clipping_table.hpp>
+#   include <cellab/utilities_for_transition_algorithms.hpp>
+#   include <cellab/inlined_transition_algorithms.hpp>
+#   include <utility/basic_numeric_types.hpp>
+#   include <utility/bits_reference.hpp>
+#   include <utility/thread_pool.hpp>
+#   include <utility/assumptions.hpp>
+#   include <memory>
+
+
+/**
+ * This module provides a transition of the neural tissue, which fuses five of the six algorithms of the
+ * header 'transition_algorithms.hpp' (all except the synaptic migration) into one parallel sweep over
+ * the tissue. So, threads are joined only once per step (instead of once per algorithm). It requires a
+ * dynamic state constructed with DOUBLE_BUFFERED_CELLS_AND_SIGNALLING.
+ *
+ * Tissue cells and signalling are read from the current buffer only, while their new states are written
+ * to the next buffer. The synapses and territorial lists of a territory are updated in situ by the thread
+ * owning the territory, and no other territory reads them. Units are packed into bytes (with PACKED_UNITS
+ * storage), so neighbouring units of different threads could share a byte. Therefore, threads process tiles
+ * of whole blocks of 8 columns (see 'compute_num_cells_in_byte_aligned_tile_of_tissue') and ranges of
+ * synapses to muscles starting at multiples of 8, which both start at byte boundaries. So, no two threads
+ * ever write the same byte nor read data being written. The buffers are swapped at the end of the step.
+ *
+ * The only difference to the sequence of the six algorithms is that a cell reads signalling computed in the
+ * previous step (while the sequence gives it the signalling computed in the same step). All the remaining
+ * data read by kernels are the same. The synaptic migration touches only the migration lists (not read by
+ * any kernel), and so it can be applied either before or after this transition (by the function
+ * 'apply_transition_of_synaptic_migration_in_tissue').
+ *
+ * Kernels are the same as for the templates in the header 'inlined_transition_algorithms.hpp'. The kernels
+ * of signalling and cells receive a reference to the next state, which is initialised by a copy of the
+ * current one. So, in situ kernels can be used without any change.
+ */
+
+
+namespace cellab {
+
+
+template<typename kernel_of_synapse_to_muscle,
+         typename kernel_of_synapse_inside_tissue,
+         typename kernel_of_signalling,
+         typename kernel_of_cell>
+void apply_double_buffered_transition_of_tissue(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        kernel_of_synapse_to_muscle const& transition_function_of_packed_synapse_to_muscle,
+        kernel_of_synapse_inside_tissue const& transition_function_of_packed_synapse_inside_tissue,
+        kernel_of_signalling const& transition_function_of_packed_signalling,
+        kernel_of_cell const& transition_function_of_packed_cell,
+        natural_32_bit const  num_threads_avalilable_for_computation,
+        thread_pool&  pool
+        )
+{
+    ASSUMPTION(dynamic_state_of_tissue->get_buffering_of_cells_and_signalling() == DOUBLE_BUFFERED_CELLS_AND_SIGNALLING);
+    ASSUMPTION(num_threads_avalilable_for_computation > 0U);
+
+    std::shared_ptr<static_state_of_neural_tissue const> const static_state_of_tissue =
+            dynamic_state_of_tissue->get_static_state_of_neural_tissue();
+    neighbourhood_clipping_table const&  clipping_table = static_state_of_tissue->get_neighbourhood_clipping_table();
+
+    natural_32_bit const  num_cells_in_tile =
+            dynamic_state_of_tissue->get_storage_of_units() == BYTE_ALIGNED_UNITS ?
+                compute_num_cells_in_tile_of_tissue(static_state_of_tissue,num_threads_avalilable_for_computation) :
+                compute_num_cells_in_byte_aligned_tile_of_tissue(static_state_of_tissue,num_threads_avalilable_for_computation);
+
+    natural_64_bit const  num_synapses_to_muscles = static_state_of_tissue->num_synapses_to_muscles();
+    auto const  synapses_to_muscles_begin_of_thread =
+        [num_synapses_to_muscles,num_threads_avalilable_for_computation](natural_32_bit const  thread_index) -> natural_64_bit {
+            return thread_index == num_threads_avalilable_for_computation ?
+                        num_synapses_to_muscles :
+                        (num_synapses_to_muscles * thread_index / num_threads_avalilable_for_computation) & ~7ULL;
+        };
+
+    pool.run_and_wait(
+            num_threads_avalilable_for_computation,
+            [&](natural_32_bit const  thread_index) {
+                for (natural_64_bit  index = synapses_to_muscles_begin_of_thread(thread_index),
+                                     end = synapses_to_muscles_begin_of_thread(thread_index + 1U);
+                     index < end;
+                     ++index)
+                    private_internal_implementation_details::apply_transition_of_synapse_to_muscle(
+                            dynamic_state_of_tissue,
+                            static_state_of_tissue,
+                            transition_function_of_packed_synapse_to_muscle,
+                            (natural_32_bit)index
+                            );
+
+                natural_32_bit x_coord;
+                natural_32_bit y_coord;
+                natural_32_bit c_coord;
+                if (!go_to_first_coordinates_in_tiles(
+                            x_coord,y_coord,c_coord,
+                            thread_index,
+                            num_cells_in_tile,
+                            static_state_of_tissue->num_cells_along_x_axis(),
+                            static_state_of_tissue->num_cells_along_y_axis(),
+                            static_state_of_tissue->num_cells_along_columnar_axis()
+                            ))
+                    return;
+
+                natural_32_bit index_in_tile = 0U;
+                do
+                {
+                    private_internal_implementation_details::apply_transition_of_synapses_in_territory(
+                            dynamic_state_of_tissue,
+                            static_state_of_tissue,
+                            clipping_table,
+                            transition_function_of_packed_synapse_inside_tissue,
+                            x_coord,y_coord,c_coord
+                            );
+
+                    move_synapses_into_proper_lists_in_territory_of_cell(
+                            dynamic_state_of_tissue,
+                            static_state_of_tissue,
+                            x_coord,y_coord,c_coord
+                            );
+
+                    bits_reference  bits_of_next_signalling =
+                            dynamic_state_of_tissue->find_bits_of_next_signalling(x_coord,y_coord,c_coord);
+                    copy_referenced_bits(dynamic_state_of_tissue->find_bits_of_signalling(x_coord,y_coord,c_coord),
+                                         bits_of_next_signalling);
+                    private_internal_implementation_details::apply_transition_of_signalling_in_territory(
+                            dynamic_state_of_tissue,
+                            static_state_of_tissue,
+                            clipping_table,
+                            transition_function_of_packed_signalling,
+                            bits_of_next_signalling,
+                            x_coord,y_coord,c_coord
+                            );
+
+                    bits_reference  bits_of_next_cell =
+                            dynamic_state_of_tissue->find_bits_of_next_cell_in_tissue(x_coord,y_coord,c_coord);
+                    copy_referenced_bits(dynamic_state_of_tissue->find_bits_of_cell_in_tissue(x_coord,y_coord,c_coord),
+                                         bits_of_next_cell);
+                    private_internal_implementation_details::apply_transition_of_cell_in_territory(
+                            dynamic_state_of_tissue,
+                            static_state_of_tissue,
+                            clipping_table,
+                            transition_function_of_packed_cell,
+                            bits_of_next_cell,
+                            x_coord,y_coord,c_coord
+                            );
+                }
+                while (go_to_next_coordinates_in_tiles(
+                                x_coord,y_coord,c_coord,
+                                index_in_tile,
+                                num_cells_in_tile,
+                                num_threads_avalilable_for_computation,
+                                static_state_of_tissue->num_cells_along_x_axis(),
+                                static_state_of_tissue->num_cells_along_y_axis(),
+                                static_state_of_tissue->num_cells_along_columnar_axis()
+                                ));
+                }
+            );
+
+    dynamic_state_of_tissue->swap_current_and_next_buffers();
+}
+
+
+}
+
+#endif
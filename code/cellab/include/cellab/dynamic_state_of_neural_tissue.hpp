@@ -14,6 +14,38 @@
 namespace cellab {
 
 
+/**
+ * These constants define how units (i.e. cells, synapses, signalling, etc.) are laid out in the memory of
+ * a dynamic state of the neural tissue (see the constructor of 'dynamic_state_of_neural_tissue' bellow).
+ */
+enum storage_of_units_of_neural_tissue
+{
+    PACKED_UNITS = 0,           //!< Units are stored one after another without any padding bits. It is the
+                                //!< most memory efficient storage, but units can be accessed only through
+                                //!< bits references (i.e. they have to be packed/unpacked on each access).
+    BYTE_ALIGNED_UNITS = 1      //!< Each unit starts at a byte boundary. If the number of bits of units
+                                //!< of some component is 8*sizeof(T) for some plain type T, then the units
+                                //!< of that component can directly be accessed as instances of T (see
+                                //!< the typed 'find_*' methods bellow and the function 'reinterpret_bits_as').
+};
+
+
+/**
+ * These constants define whether tissue cells and signalling are stored in one buffer, or in two buffers
+ * called 'current' and 'next' (see the constructor of 'dynamic_state_of_neural_tissue' bellow).
+ */
+enum buffering_of_cells_and_signalling
+{
+    SINGLE_BUFFERED_CELLS_AND_SIGNALLING = 0,   //!< All transition algorithms update the units in situ.
+    DOUBLE_BUFFERED_CELLS_AND_SIGNALLING = 1    //!< Tissue cells and signalling are read from the current buffer
+                                                //!< and written to the next buffer. The buffers are then swapped
+                                                //!< (see the method 'swap_current_and_next_buffers' bellow). It
+                                                //!< doubles the memory of tissue cells and signalling, but all
+                                                //!< transitions of one step can be fused into one parallel sweep
+                                                //!< over the tissue (see the header 'double_buffered_transition_of_tissue.hpp').
+};
+
+
 /**
  * It defines that part of a state of the neural tissue which can be modified (updated)
  * by transition algorithms (see the header file 'transition_algorithms.hpp'). An instance
@@ -56,9 +88,19 @@ struct dynamic_state_of_neural_tissue : private boost::noncopyable
      * It has to be done manually as described above. Use methods bellow to access memory of individual components.
      *
      * A constructed instance will take a shared ownership of the passed instance of 'static_state_of_neural_tissue'.
+     *
+     * When double buffering is requested, then all methods bellow access the current buffer. The next buffer
+     * is accessible only through the methods 'find_bits_of_next_*'. Its content is NOT initialised either.
+     *
+     * If 'memory_provider' is not empty, then the memory of all components is obtained from it (instead of
+     * the heap), one request per array of units, in the order of the method 'get_arrays_of_units_in_order_of_allocation'.
+     * It allows to construct the state directly over the memory of a checkpoint (see 'checkpoint_of_neural_tissue.hpp').
      */
     dynamic_state_of_neural_tissue(
-            std::shared_ptr<static_state_of_neural_tissue const> const pointer_to_static_state_of_neural_tissue
+            std::shared_ptr<static_state_of_neural_tissue const> const pointer_to_static_state_of_neural_tissue,
+            storage_of_units_of_neural_tissue const storage_of_units = PACKED_UNITS,
+            buffering_of_cells_and_signalling const buffering = SINGLE_BUFFERED_CELLS_AND_SIGNALLING,
+            memory_provider_for_array_of_bit_units const& memory_provider = memory_provider_for_array_of_bit_units()
             );
 
     /**
@@ -72,6 +114,9 @@ struct dynamic_state_of_neural_tissue : private boost::noncopyable
      */
     std::shared_ptr<static_state_of_neural_tissue const>  get_static_state_of_neural_tissue() const;
 
+    storage_of_units_of_neural_tissue  get_storage_of_units() const;
+    buffering_of_cells_and_signalling  get_buffering_of_cells_and_signalling() const;
+
 
     bits_reference  find_bits_of_cell(
             natural_32_bit const coord_along_x_axis,
@@ -150,13 +195,104 @@ struct dynamic_state_of_neural_tissue : private boost::noncopyable
             natural_32_bit const index_of_synapse_to_muscle
             );
 
+    /**
+     * These two methods can only be used, if the instance was constructed with DOUBLE_BUFFERED_CELLS_AND_SIGNALLING.
+     * They give access to the next buffer of tissue cells and signalling respectively.
+     */
+    bits_reference  find_bits_of_next_cell_in_tissue(
+            natural_32_bit const coord_along_x_axis,
+            natural_32_bit const coord_along_y_axis,
+            natural_32_bit const coord_along_columnar_axis
+            );
+    bits_reference  find_bits_of_next_signalling(
+            natural_32_bit const coord_to_cell_along_x_axis,
+            natural_32_bit const coord_to_cell_along_y_axis,
+            natural_32_bit const coord_to_cell_along_columnar_axis
+            );
+
+    /**
+     * It makes the next buffer current and vice versa. No data are copied. It can only be used, if the instance
+     * was constructed with DOUBLE_BUFFERED_CELLS_AND_SIGNALLING.
+     */
+    void  swap_current_and_next_buffers();
+
     natural_8_bit  num_bits_per_source_cell_coordinate() const;
     natural_8_bit  num_bits_per_delimiter_number(kind_of_cell const  kind_of_tissue_cell) const;
 
+    /**
+     * It returns all arrays of units of the state in the order the constructor allocates them: sensory cells,
+     * synapses to muscles, coords of source cells of synapses to muscles, and then for each kind of tissue cells
+     * slices of cells, synapses, territorial states of synapses, coords of source cells of synapses, signalling,
+     * delimiters between territorial lists, and (if double-buffered) next cells and next signalling.
+     */
+    std::vector<array_of_bit_units const*>  get_arrays_of_units_in_order_of_allocation() const;
+
+    /**
+     * Typed variants of the methods above. They can only be used, if the instance was constructed
+     * with BYTE_ALIGNED_UNITS storage and the number of bits of the accessed component (as defined in
+     * the static state) is 8*sizeof(T).
+     */
+
+    template<typename T>
+    T&  find_cell_in_tissue(
+            natural_32_bit const coord_along_x_axis,
+            natural_32_bit const coord_along_y_axis,
+            natural_32_bit const coord_along_columnar_axis
+            )
+    {
+        return reinterpret_bits_as<T>(
+                    find_bits_of_cell_in_tissue(coord_along_x_axis,coord_along_y_axis,coord_along_columnar_axis)
+                    );
+    }
+
+    template<typename T>
+    T&  find_synapse_in_tissue(
+            natural_32_bit const coord_to_cell_along_x_axis,
+            natural_32_bit const coord_to_cell_along_y_axis,
+            natural_32_bit const coord_to_cell_along_columnar_axis,
+            natural_32_bit const index_of_synapse_in_territory_of_cell
+            )
+    {
+        return reinterpret_bits_as<T>(
+                    find_bits_of_synapse_in_tissue(coord_to_cell_along_x_axis,
+                                                   coord_to_cell_along_y_axis,
+                                                   coord_to_cell_along_columnar_axis,
+                                                   index_of_synapse_in_territory_of_cell)
+                    );
+    }
+
+    template<typename T>
+    T&  find_signalling(
+            natural_32_bit const coord_to_cell_along_x_axis,
+            natural_32_bit const coord_to_cell_along_y_axis,
+            natural_32_bit const coord_to_cell_along_columnar_axis
+            )
+    {
+        return reinterpret_bits_as<T>(
+                    find_bits_of_signalling(coord_to_cell_along_x_axis,
+                                            coord_to_cell_along_y_axis,
+                                            coord_to_cell_along_columnar_axis)
+                    );
+    }
+
+    template<typename T>
+    T&  find_sensory_cell(natural_32_bit const index_of_sensory_cell)
+    {
+        return reinterpret_bits_as<T>(find_bits_of_sensory_cell(index_of_sensory_cell));
+    }
+
+    template<typename T>
+    T&  find_synapse_to_muscle(natural_32_bit const index_of_synapse_to_muscle)
+    {
+        return reinterpret_bits_as<T>(find_bits_of_synapse_to_muscle(index_of_synapse_to_muscle));
+    }
+
 private:
     typedef std::shared_ptr<homogenous_slice_of_tissue> pointer_to_homogenous_slice_of_tissue;
 
     std::shared_ptr<static_state_of_neural_tissue const> m_static_state_of_neural_tissue;
+    storage_of_units_of_neural_tissue m_storage_of_units;
+    buffering_of_cells_and_signalling m_buffering;
     natural_8_bit m_num_bits_per_source_cell_coordinate;
     std::vector<natural_8_bit> m_num_bits_per_delimiter_number;
     std::vector<pointer_to_homogenous_slice_of_tissue> m_slices_of_cells;
@@ -165,6 +301,8 @@ private:
     std::vector<pointer_to_homogenous_slice_of_tissue> m_slices_of_source_cell_coords_of_synapses;
     std::vector<pointer_to_homogenous_slice_of_tissue> m_slices_of_signalling_data;
     std::vector<pointer_to_homogenous_slice_of_tissue> m_slices_of_delimiters_between_territorial_lists;
+    std::vector<pointer_to_homogenous_slice_of_tissue> m_next_slices_of_cells; //!< Empty, if not double-buffered.
+    std::vector<pointer_to_homogenous_slice_of_tissue> m_next_slices_of_signalling_data; //!< Empty, if not double-buffered.
     array_of_bit_units m_bits_of_sensory_cells;
     array_of_bit_units m_bits_of_synapses_to_muscles;
     array_of_bit_units m_bits_of_source_cell_coords_of_synapses_to_muscles;
@@ -23,7 +23,13 @@ struct homogenous_slice_of_tissue
     homogenous_slice_of_tissue(natural_16_bit const num_bits_per_unit,
                                natural_32_bit const num_units_along_x_axis,
                                natural_32_bit const num_units_along_y_axis,
-                               natural_64_bit const num_units_along_columnar_axis);
+                               natural_64_bit const num_units_along_columnar_axis,
+                               bool const align_units_to_bytes = false,
+                                    //!< See the constructor of 'array_of_bit_units'.
+                               memory_provider_for_array_of_bit_units const& memory_provider =
+                                    memory_provider_for_array_of_bit_units()
+                                    //!< See the constructor of 'array_of_bit_units'.
+                               );
 
     bits_reference find_bits_of_unit(natural_32_bit const shift_along_x_axis,
                                      natural_32_bit const shift_along_y_axis,
@@ -32,6 +38,8 @@ struct homogenous_slice_of_tissue
     natural_32_bit num_units_along_x_axis() const;
     natural_32_bit num_units_along_y_axis() const;
     natural_64_bit num_units_along_columnar_axis() const;
+    bool are_units_aligned_to_bytes() const;
+    array_of_bit_units const& get_array_of_units() const;
 private:
     natural_64_bit m_num_units_along_x_axis;
     natural_64_bit m_num_units_along_y_axis;
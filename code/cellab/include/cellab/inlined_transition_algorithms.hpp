@@ -0,0 +1,812 @@
+#ifndef CELLAB_INLINED_TRANSITION_ALGORITHMS_HPP_INCLUDED
+#   define CELLAB_INLINED_TRANSITION_ALGORITHMS_HPP_INCLUDED
+
+#   include <cellab/static_state_of_neural_tissue.hpp>
+#   include <cellab/dynamic_state_of_neural_tissue.hpp>
+#   include <cellab/territorial_state_of_synapse.hpp>
+#   include <cellab/shift_in_coordinates.hpp>
+#   include <cellab/neighbourhood_clipping_table.hpp>
+#   include <cellab/utilities_for_transition_algorithms.hpp>
+#   include <cellab/transition_algorithms.hpp>
+#   include <utility/basic_numeric_types.hpp>
+#   include <utility/bits_reference.hpp>
+#   include <utility/thread_pool.hpp>
+#   include <utility/assumptions.hpp>
+#   include <utility/invariants.hpp>
+#   include <boost/noncopyable.hpp>
+#   include <memory>
+#   include <tuple>
+
+
+/**
+ * This module provides the same algorithms as the header 'transition_algorithms.hpp' for those four
+ * of them, which call user's callback functions (i.e. transitions of synapses to muscles, synapses
+ * in the tissue, signalling, and cells). Here the type of a callback function (called a kernel) is
+ * a template parameter of the algorithm, and access functions to the neighbourhood of an updated
+ * element are passed to the kernel as lightweight accessors (see bellow) instead of 'std::function'
+ * objects built by 'std::bind'. So, when a kernel is a functor (or a lambda) whose call operator
+ * is visible to the compiler, then the whole inner loop of an algorithm can be inlined.
+ *
+ * A kernel is called with the same arguments (in the same order) as the corresponding callback
+ * function in the header 'transition_algorithms.hpp', except that the access functions have types
+ * 'synapse_accessor', 'signalling_accessor', and 'cell_accessor' respectivelly. Since each accessor
+ * is convertible to the corresponding 'std::function', any callback function of the original
+ * algorithms can also be used as a kernel here. In fact, the algorithms in 'transition_algorithms.hpp'
+ * are implemented by the templates bellow (instantiated for the 'std::function' types).
+ */
+
+
+namespace cellab {
+
+
+/**
+ * It gives access to signalling in the spatial neighbourhood of an updated cell or synapse.
+ * See the function 'get_signalling_callback_function' for details.
+ */
+struct signalling_accessor
+{
+    signalling_accessor(
+            std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+            std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+            spatial_neighbourhood const& neighbourhood
+            )
+        : m_dynamic_state_of_tissue(dynamic_state_of_tissue)
+        , m_static_state_of_tissue(static_state_of_tissue)
+        , m_neighbourhood(neighbourhood)
+    {}
+
+    std::pair<bits_const_reference,kind_of_cell>  operator()(shift_in_coordinates const& shift) const
+    {
+        return get_signalling_callback_function(m_dynamic_state_of_tissue,m_static_state_of_tissue,m_neighbourhood,shift);
+    }
+
+private:
+    std::shared_ptr<dynamic_state_of_neural_tissue> const&  m_dynamic_state_of_tissue;
+    std::shared_ptr<static_state_of_neural_tissue const> const&  m_static_state_of_tissue;
+    spatial_neighbourhood const&  m_neighbourhood;
+};
+
+
+/**
+ * It gives access to tissue cells in the spatial neighbourhood of an updated signalling.
+ * See the function 'get_cell_callback_function' for details.
+ */
+struct cell_accessor
+{
+    cell_accessor(
+            std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+            std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+            spatial_neighbourhood const& neighbourhood
+            )
+        : m_dynamic_state_of_tissue(dynamic_state_of_tissue)
+        , m_static_state_of_tissue(static_state_of_tissue)
+        , m_neighbourhood(neighbourhood)
+    {}
+
+    std::pair<bits_const_reference,kind_of_cell>  operator()(shift_in_coordinates const& shift) const
+    {
+        return get_cell_callback_function(m_dynamic_state_of_tissue,m_static_state_of_tissue,m_neighbourhood,shift);
+    }
+
+private:
+    std::shared_ptr<dynamic_state_of_neural_tissue> const&  m_dynamic_state_of_tissue;
+    std::shared_ptr<static_state_of_neural_tissue const> const&  m_static_state_of_tissue;
+    spatial_neighbourhood const&  m_neighbourhood;
+};
+
+
+/**
+ * It gives access to synapses connected to an updated tissue cell.
+ * See the function 'get_synapse_callback_function' for details.
+ */
+struct synapse_accessor
+{
+    synapse_accessor(
+            std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+            std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+            tissue_coordinates const& target_cell,
+            kind_of_cell const kind_of_target_cell,
+            natural_32_bit const number_of_synapses_in_range,
+            natural_32_bit const shift_to_start_index
+            )
+        : m_dynamic_state_of_tissue(dynamic_state_of_tissue)
+        , m_static_state_of_tissue(static_state_of_tissue)
+        , m_target_cell(target_cell)
+        , m_kind_of_target_cell(kind_of_target_cell)
+        , m_number_of_synapses_in_range(number_of_synapses_in_range)
+        , m_shift_to_start_index(shift_to_start_index)
+    {}
+
+    std::tuple<bits_const_reference,kind_of_cell,kind_of_cell>  operator()(natural_32_bit const shift_from_start_index) const
+    {
+        return get_synapse_callback_function(m_dynamic_state_of_tissue,m_static_state_of_tissue,m_target_cell,
+                                             m_kind_of_target_cell,m_number_of_synapses_in_range,
+                                             m_shift_to_start_index,shift_from_start_index);
+    }
+
+private:
+    std::shared_ptr<dynamic_state_of_neural_tissue> const&  m_dynamic_state_of_tissue;
+    std::shared_ptr<static_state_of_neural_tissue const> const&  m_static_state_of_tissue;
+    tissue_coordinates const&  m_target_cell;
+    kind_of_cell  m_kind_of_target_cell;
+    natural_32_bit  m_number_of_synapses_in_range;
+    natural_32_bit  m_shift_to_start_index;
+};
+
+
+namespace private_internal_implementation_details {
+
+
+template<typename kernel_type>
+void apply_transition_of_synapse_to_muscle(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+        kernel_type const& transition_function_of_packed_synapse_to_muscle,
+        natural_32_bit const index
+        )
+{
+    bits_reference bits_of_synapse =
+        dynamic_state_of_tissue->find_bits_of_synapse_to_muscle(index);
+
+    tissue_coordinates const source_cell_coords(
+                get_coordinates_of_source_cell_of_synapse_to_muscle(
+                        dynamic_state_of_tissue,
+                        index
+                        )
+                );
+
+    std::pair<kind_of_cell,natural_32_bit> const kind_and_index_of_source_cell =
+        static_state_of_tissue->compute_kind_of_cell_and_relative_columnar_index_from_coordinate_along_columnar_axis(
+                source_cell_coords.get_coord_along_columnar_axis()
+                );
+
+    bits_const_reference const bits_of_source_cell =
+            dynamic_state_of_tissue->find_bits_of_cell(
+                source_cell_coords.get_coord_along_x_axis(),
+                source_cell_coords.get_coord_along_y_axis(),
+                kind_and_index_of_source_cell.first,
+                kind_and_index_of_source_cell.second
+                );
+
+    transition_function_of_packed_synapse_to_muscle(
+                bits_of_synapse,
+                static_state_of_tissue->compute_kind_of_sensory_cell_from_its_index(index),
+                kind_and_index_of_source_cell.first,
+                bits_of_source_cell
+                );
+}
+
+
+template<typename kernel_type>
+void thread_apply_transition_of_synapses_to_muscles(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+        kernel_type const& transition_function_of_packed_synapse_to_muscle,
+        natural_32_bit index,
+        natural_32_bit const extent_of_index
+        )
+{
+    do
+    {
+        apply_transition_of_synapse_to_muscle(
+                dynamic_state_of_tissue,
+                static_state_of_tissue,
+                transition_function_of_packed_synapse_to_muscle,
+                index
+                );
+    }
+    while (go_to_next_index(index,extent_of_index,static_state_of_tissue->num_synapses_to_muscles()));
+}
+
+
+template<typename kernel_type>
+void apply_transition_of_synapses_in_territory(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+        neighbourhood_clipping_table const&  clipping_table,
+        kernel_type const& transition_function_of_packed_synapse_inside_tissue,
+        natural_32_bit const x_coord,
+        natural_32_bit const y_coord,
+        natural_32_bit const c_coord
+        )
+{
+    bits_const_reference const bits_of_territory_cell =
+        dynamic_state_of_tissue->find_bits_of_cell_in_tissue(x_coord,y_coord,c_coord);
+
+    natural_16_bit const kind_of_territory_cell = clipping_table.get_kind_of_tissue_cell(c_coord);
+    INVARIANT(kind_of_territory_cell < static_state_of_tissue->num_kinds_of_tissue_cells());
+
+    tissue_coordinates const territory_cell_coordinates(x_coord,y_coord,c_coord);
+
+    shift_in_coordinates const shift_to_low_corner =
+        clipping_table.get_shift_to_low_corner(SIGNALLING_NEIGHBOURHOOD_OF_SYNAPSE,x_coord,y_coord,c_coord);
+    shift_in_coordinates const shift_to_high_corner =
+        clipping_table.get_shift_to_high_corner(SIGNALLING_NEIGHBOURHOOD_OF_SYNAPSE,x_coord,y_coord,c_coord);
+
+    spatial_neighbourhood const synapse_neighbourhood(
+                territory_cell_coordinates, shift_to_low_corner, shift_to_high_corner
+                );
+    signalling_accessor const  signalling_in_neighbourhood(
+                dynamic_state_of_tissue, static_state_of_tissue, synapse_neighbourhood
+                );
+
+    for (natural_32_bit synapse_index = 0U;
+         synapse_index < static_state_of_tissue->num_synapses_in_territory_of_cell_kind(kind_of_territory_cell);
+         ++synapse_index)
+    {
+        bits_reference bits_of_synapse =
+            dynamic_state_of_tissue->find_bits_of_synapse_in_tissue(x_coord,y_coord,c_coord,synapse_index);
+
+        tissue_coordinates const source_cell_coords =
+            get_coordinates_of_source_cell_of_synapse_in_tissue(
+                    dynamic_state_of_tissue,
+                    territory_cell_coordinates,
+                    synapse_index
+                    );
+
+        std::pair<kind_of_cell,natural_32_bit> const kind_and_index_of_source_cell =
+            static_state_of_tissue->compute_kind_of_cell_and_relative_columnar_index_from_coordinate_along_columnar_axis(
+                    source_cell_coords.get_coord_along_columnar_axis()
+                    );
+
+        bits_const_reference const bits_of_source_cell =
+                dynamic_state_of_tissue->find_bits_of_cell(
+                    source_cell_coords.get_coord_along_x_axis(),
+                    source_cell_coords.get_coord_along_y_axis(),
+                    kind_and_index_of_source_cell.first,
+                    kind_and_index_of_source_cell.second
+                    );
+
+        bits_reference bits_of_territorial_state_of_synapse =
+                dynamic_state_of_tissue->find_bits_of_territorial_state_of_synapse_in_tissue(
+                    x_coord,y_coord,c_coord,
+                    synapse_index
+                    );
+        natural_32_bit const current_territorial_state_of_synapse =
+                bits_to_value<natural_32_bit>(bits_of_territorial_state_of_synapse);
+        INVARIANT( current_territorial_state_of_synapse < 7U );
+
+        territorial_state_of_synapse const new_territorial_state_of_synapse =
+            transition_function_of_packed_synapse_inside_tissue(
+                        bits_of_synapse,
+                        kind_and_index_of_source_cell.first, bits_of_source_cell,
+                        kind_of_territory_cell, bits_of_territory_cell,
+                        static_cast<territorial_state_of_synapse>(current_territorial_state_of_synapse),
+                        shift_to_low_corner,
+                        shift_to_high_corner,
+                        signalling_in_neighbourhood
+                        );
+
+        natural_32_bit const territorial_state_value =
+                static_cast<natural_32_bit>(new_territorial_state_of_synapse);
+        ASSUMPTION( territorial_state_value < 7U );
+        value_to_bits( territorial_state_value, bits_of_territorial_state_of_synapse );
+    }
+}
+
+
+template<typename kernel_type>
+void thread_apply_transition_of_synapses_of_tissue(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+        kernel_type const& transition_function_of_packed_synapse_inside_tissue,
+        natural_32_bit x_coord,
+        natural_32_bit y_coord,
+        natural_32_bit c_coord,
+        natural_32_bit const num_cells_in_tile,
+        natural_32_bit const num_threads
+        )
+{
+    neighbourhood_clipping_table const&  clipping_table = static_state_of_tissue->get_neighbourhood_clipping_table();
+
+    natural_32_bit index_in_tile = 0U;
+    do
+    {
+        apply_transition_of_synapses_in_territory(
+                dynamic_state_of_tissue,
+                static_state_of_tissue,
+                clipping_table,
+                transition_function_of_packed_synapse_inside_tissue,
+                x_coord,y_coord,c_coord
+                );
+    }
+    while (go_to_next_coordinates_in_tiles(
+                    x_coord,y_coord,c_coord,
+                    index_in_tile,
+                    num_cells_in_tile,
+                    num_threads,
+                    static_state_of_tissue->num_cells_along_x_axis(),
+                    static_state_of_tissue->num_cells_along_y_axis(),
+                    static_state_of_tissue->num_cells_along_columnar_axis()
+                    ));
+}
+
+
+/**
+ * The passed bits of signalling are updated by the kernel. They are either the bits of the signalling
+ * in the territory at (x_coord,y_coord,c_coord), or the bits of its next state (when double-buffered).
+ */
+template<typename kernel_type>
+void apply_transition_of_signalling_in_territory(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+        neighbourhood_clipping_table const&  clipping_table,
+        kernel_type const& transition_function_of_packed_signalling,
+        bits_reference& bits_of_signalling,
+        natural_32_bit const x_coord,
+        natural_32_bit const y_coord,
+        natural_32_bit const c_coord
+        )
+{
+    natural_16_bit const kind_of_territory_cell = clipping_table.get_kind_of_tissue_cell(c_coord);
+    INVARIANT(kind_of_territory_cell < static_state_of_tissue->num_kinds_of_tissue_cells());
+
+    tissue_coordinates const territory_cell_coordinates(x_coord,y_coord,c_coord);
+
+    shift_in_coordinates const shift_to_low_corner =
+        clipping_table.get_shift_to_low_corner(CELLULAR_NEIGHBOURHOOD_OF_SIGNALLING,x_coord,y_coord,c_coord);
+    shift_in_coordinates const shift_to_high_corner =
+        clipping_table.get_shift_to_high_corner(CELLULAR_NEIGHBOURHOOD_OF_SIGNALLING,x_coord,y_coord,c_coord);
+
+    spatial_neighbourhood const signalling_neighbourhood(
+                territory_cell_coordinates,shift_to_low_corner,shift_to_high_corner
+                );
+
+    transition_function_of_packed_signalling(
+                bits_of_signalling,
+                kind_of_territory_cell,
+                shift_to_low_corner,
+                shift_to_high_corner,
+                cell_accessor(dynamic_state_of_tissue,static_state_of_tissue,signalling_neighbourhood)
+                );
+}
+
+
+template<typename kernel_type>
+void thread_apply_transition_of_signalling_in_tissue(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+        kernel_type const& transition_function_of_packed_signalling,
+        natural_32_bit x_coord,
+        natural_32_bit y_coord,
+        natural_32_bit c_coord,
+        natural_32_bit const num_cells_in_tile,
+        natural_32_bit const num_threads
+        )
+{
+    neighbourhood_clipping_table const&  clipping_table = static_state_of_tissue->get_neighbourhood_clipping_table();
+
+    natural_32_bit index_in_tile = 0U;
+    do
+    {
+        bits_reference bits_of_signalling =
+            dynamic_state_of_tissue->find_bits_of_signalling(x_coord,y_coord,c_coord);
+
+        apply_transition_of_signalling_in_territory(
+                dynamic_state_of_tissue,
+                static_state_of_tissue,
+                clipping_table,
+                transition_function_of_packed_signalling,
+                bits_of_signalling,
+                x_coord,y_coord,c_coord
+                );
+    }
+    while (go_to_next_coordinates_in_tiles(
+                    x_coord,y_coord,c_coord,
+                    index_in_tile,
+                    num_cells_in_tile,
+                    num_threads,
+                    static_state_of_tissue->num_cells_along_x_axis(),
+                    static_state_of_tissue->num_cells_along_y_axis(),
+                    static_state_of_tissue->num_cells_along_columnar_axis()
+                    ));
+}
+
+
+/**
+ * The passed bits of cell are updated by the kernel. They are either the bits of the tissue cell
+ * at (x_coord,y_coord,c_coord), or the bits of its next state (when double-buffered).
+ */
+template<typename kernel_type>
+void apply_transition_of_cell_in_territory(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+        neighbourhood_clipping_table const&  clipping_table,
+        kernel_type const& transition_function_of_packed_cell,
+        bits_reference& bits_of_cell,
+        natural_32_bit const x_coord,
+        natural_32_bit const y_coord,
+        natural_32_bit const c_coord
+        )
+{
+    natural_32_bit const list_index_of_connected_synapses =
+            convert_territorial_state_of_synapse_to_territorial_list_index(
+                    SIGNAL_DELIVERY_TO_CELL_OF_TERRITORY
+                    );
+
+    kind_of_cell const cell_kind = clipping_table.get_kind_of_tissue_cell(c_coord);
+    INVARIANT(cell_kind < static_state_of_tissue->num_kinds_of_tissue_cells());
+
+    tissue_coordinates const cell_coordinates(x_coord,y_coord,c_coord);
+
+    shift_in_coordinates const shift_to_low_corner =
+        clipping_table.get_shift_to_low_corner(SIGNALLING_NEIGHBOURHOOD_OF_CELL,x_coord,y_coord,c_coord);
+    shift_in_coordinates const shift_to_high_corner =
+        clipping_table.get_shift_to_high_corner(SIGNALLING_NEIGHBOURHOOD_OF_CELL,x_coord,y_coord,c_coord);
+
+    spatial_neighbourhood const cell_neighbourhood(cell_coordinates,shift_to_low_corner,shift_to_high_corner);
+
+    natural_32_bit const begin_index_in_list_of_synapses =
+            get_begin_index_of_territorial_list_of_cell(
+                    dynamic_state_of_tissue,
+                    cell_coordinates,
+                    list_index_of_connected_synapses
+                    );
+    natural_32_bit const end_index_in_list_of_synapses =
+            get_end_index_of_territorial_list_of_cell(
+                    dynamic_state_of_tissue,
+                    static_state_of_tissue,
+                    cell_coordinates,
+                    list_index_of_connected_synapses
+                    );
+    natural_32_bit const number_of_connected_synapses =
+            end_index_in_list_of_synapses - begin_index_in_list_of_synapses;
+
+    transition_function_of_packed_cell(
+                bits_of_cell,
+                cell_kind,
+                number_of_connected_synapses,
+                synapse_accessor(dynamic_state_of_tissue,static_state_of_tissue,cell_coordinates,cell_kind,
+                                 number_of_connected_synapses,begin_index_in_list_of_synapses),
+                shift_to_low_corner,
+                shift_to_high_corner,
+                signalling_accessor(dynamic_state_of_tissue,static_state_of_tissue,cell_neighbourhood)
+                );
+}
+
+
+template<typename kernel_type>
+void thread_apply_transition_of_cells_of_tissue(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+        kernel_type const& transition_function_of_packed_cell,
+        natural_32_bit x_coord,
+        natural_32_bit y_coord,
+        natural_32_bit c_coord,
+        natural_32_bit const num_cells_in_tile,
+        natural_32_bit const num_threads
+        )
+{
+    neighbourhood_clipping_table const&  clipping_table = static_state_of_tissue->get_neighbourhood_clipping_table();
+
+    natural_32_bit index_in_tile = 0U;
+    do
+    {
+        bits_reference bits_of_cell =
+            dynamic_state_of_tissue->find_bits_of_cell_in_tissue(x_coord,y_coord,c_coord);
+
+        apply_transition_of_cell_in_territory(
+                dynamic_state_of_tissue,
+                static_state_of_tissue,
+                clipping_table,
+                transition_function_of_packed_cell,
+                bits_of_cell,
+                x_coord,y_coord,c_coord
+                );
+    }
+    while (go_to_next_coordinates_in_tiles(
+                    x_coord,y_coord,c_coord,
+                    index_in_tile,
+                    num_cells_in_tile,
+                    num_threads,
+                    static_state_of_tissue->num_cells_along_x_axis(),
+                    static_state_of_tissue->num_cells_along_y_axis(),
+                    static_state_of_tissue->num_cells_along_columnar_axis()
+                    ));
+}
+
+
+template<typename thread_apply_function_type>
+void  run_tiled_transition_of_tissue(
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+        natural_32_bit const  num_threads_avalilable_for_computation,
+        thread_pool&  pool,
+        thread_apply_function_type const&  thread_apply_function
+        )
+{
+    natural_32_bit const  num_cells_in_tile =
+            compute_num_cells_in_tile_of_tissue(static_state_of_tissue,num_threads_avalilable_for_computation);
+
+    pool.run_and_wait(
+            num_threads_avalilable_for_computation,
+            [&](natural_32_bit const  thread_index) {
+                natural_32_bit x_coord;
+                natural_32_bit y_coord;
+                natural_32_bit c_coord;
+                if (!go_to_first_coordinates_in_tiles(
+                            x_coord,y_coord,c_coord,
+                            thread_index,
+                            num_cells_in_tile,
+                            static_state_of_tissue->num_cells_along_x_axis(),
+                            static_state_of_tissue->num_cells_along_y_axis(),
+                            static_state_of_tissue->num_cells_along_columnar_axis()
+                            ))
+                    return;
+                thread_apply_function(
+                        x_coord,y_coord,c_coord,
+                        num_cells_in_tile,
+                        num_threads_avalilable_for_computation
+                        );
+                }
+            );
+}
+
+
+}
+
+
+/**
+ * The same as 'apply_transition_of_synapses_to_muscles' (see 'transition_algorithms.hpp'), but the
+ * kernel is a template parameter. Its call operator receives the same arguments as the callback
+ * function 'single_threaded_in_situ_transition_function_of_packed_dynamic_state_of_synapse_to_muscle'.
+ */
+template<typename kernel_type>
+void apply_inlined_transition_of_synapses_to_muscles(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        kernel_type const& transition_function_of_packed_synapse_to_muscle,
+        natural_32_bit const  num_threads_avalilable_for_computation,
+        thread_pool&  pool
+        )
+{
+    std::shared_ptr<static_state_of_neural_tissue const> const static_state_of_tissue =
+            dynamic_state_of_tissue->get_static_state_of_neural_tissue();
+
+    pool.run_and_wait(
+            num_threads_avalilable_for_computation,
+            [&](natural_32_bit const  thread_index) {
+                natural_32_bit index = 0U;
+                if (thread_index != 0U &&
+                    !go_to_next_index(index,thread_index,static_state_of_tissue->num_synapses_to_muscles()))
+                    return;
+                private_internal_implementation_details::thread_apply_transition_of_synapses_to_muscles(
+                        dynamic_state_of_tissue,
+                        static_state_of_tissue,
+                        transition_function_of_packed_synapse_to_muscle,
+                        index,
+                        num_threads_avalilable_for_computation
+                        );
+                }
+            );
+}
+
+
+/**
+ * The same as 'apply_transition_of_synapses_of_tissue' (see 'transition_algorithms.hpp'), but the
+ * kernel is a template parameter. Its call operator receives the same arguments as the callback
+ * function 'single_threaded_in_situ_transition_function_of_packed_dynamic_state_of_synapse_inside_tissue',
+ * except the last one, which is of the type 'signalling_accessor'.
+ */
+template<typename kernel_type>
+void apply_inlined_transition_of_synapses_of_tissue(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        kernel_type const& transition_function_of_packed_synapse_inside_tissue,
+        natural_32_bit const  num_threads_avalilable_for_computation,
+        thread_pool&  pool
+        )
+{
+    std::shared_ptr<static_state_of_neural_tissue const> const static_state_of_tissue =
+            dynamic_state_of_tissue->get_static_state_of_neural_tissue();
+
+    private_internal_implementation_details::run_tiled_transition_of_tissue(
+            static_state_of_tissue,
+            num_threads_avalilable_for_computation,
+            pool,
+            [&](natural_32_bit const x_coord, natural_32_bit const y_coord, natural_32_bit const c_coord,
+                natural_32_bit const num_cells_in_tile, natural_32_bit const num_threads) {
+                private_internal_implementation_details::thread_apply_transition_of_synapses_of_tissue(
+                        dynamic_state_of_tissue,
+                        static_state_of_tissue,
+                        transition_function_of_packed_synapse_inside_tissue,
+                        x_coord,y_coord,c_coord,
+                        num_cells_in_tile,
+                        num_threads
+                        );
+                }
+            );
+}
+
+
+/**
+ * The same as 'apply_transition_of_signalling_in_tissue' (see 'transition_algorithms.hpp'), but the
+ * kernel is a template parameter. Its call operator receives the same arguments as the callback
+ * function 'single_threaded_in_situ_transition_function_of_packed_dynamic_state_of_signalling',
+ * except the last one, which is of the type 'cell_accessor'.
+ */
+template<typename kernel_type>
+void apply_inlined_transition_of_signalling_in_tissue(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        kernel_type const& transition_function_of_packed_signalling,
+        natural_32_bit const  num_threads_avalilable_for_computation,
+        thread_pool&  pool
+        )
+{
+    std::shared_ptr<static_state_of_neural_tissue const> const static_state_of_tissue =
+            dynamic_state_of_tissue->get_static_state_of_neural_tissue();
+
+    private_internal_implementation_details::run_tiled_transition_of_tissue(
+            static_state_of_tissue,
+            num_threads_avalilable_for_computation,
+            pool,
+            [&](natural_32_bit const x_coord, natural_32_bit const y_coord, natural_32_bit const c_coord,
+                natural_32_bit const num_cells_in_tile, natural_32_bit const num_threads) {
+                private_internal_implementation_details::thread_apply_transition_of_signalling_in_tissue(
+                        dynamic_state_of_tissue,
+                        static_state_of_tissue,
+                        transition_function_of_packed_signalling,
+                        x_coord,y_coord,c_coord,
+                        num_cells_in_tile,
+                        num_threads
+                        );
+                }
+            );
+}
+
+
+/**
+ * The same as 'apply_transition_of_cells_of_tissue' (see 'transition_algorithms.hpp'), but the
+ * kernel is a template parameter. Its call operator receives the same arguments as the callback
+ * function 'single_threaded_in_situ_transition_function_of_packed_dynamic_state_of_cell', except
+ * the access functions to synapses and to signalling, which are of types 'synapse_accessor' and
+ * 'signalling_accessor' respectivelly.
+ */
+template<typename kernel_type>
+void apply_inlined_transition_of_cells_of_tissue(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        kernel_type const& transition_function_of_packed_cell,
+        natural_32_bit const  num_threads_avalilable_for_computation,
+        thread_pool&  pool
+        )
+{
+    std::shared_ptr<static_state_of_neural_tissue const> const static_state_of_tissue =
+            dynamic_state_of_tissue->get_static_state_of_neural_tissue();
+
+    private_internal_implementation_details::run_tiled_transition_of_tissue(
+            static_state_of_tissue,
+            num_threads_avalilable_for_computation,
+            pool,
+            [&](natural_32_bit const x_coord, natural_32_bit const y_coord, natural_32_bit const c_coord,
+                natural_32_bit const num_cells_in_tile, natural_32_bit const num_threads) {
+                private_internal_implementation_details::thread_apply_transition_of_cells_of_tissue(
+                        dynamic_state_of_tissue,
+                        static_state_of_tissue,
+                        transition_function_of_packed_cell,
+                        x_coord,y_coord,c_coord,
+                        num_cells_in_tile,
+                        num_threads
+                        );
+                }
+            );
+}
+
+
+
+/**
+ * It is a counterpart of the class 'neural_tissue' (see 'neural_tissue.hpp'), where the four user-defined
+ * transition functions are not stored in 'std::function' objects, but directly as instances of template
+ * parameter types. So, all six methods 'apply_transition_of_*' call the templates above, and a kernel
+ * whose call operator is visible to the compiler gets inlined into the inner loops of the algorithms.
+ * The kernels are only required to be copy-constructible and callable from several threads at once.
+ */
+template<typename kernel_of_synapse_to_muscle,
+         typename kernel_of_synapse_inside_tissue,
+         typename kernel_of_signalling,
+         typename kernel_of_cell>
+struct inlined_neural_tissue : private boost::noncopyable
+{
+    inlined_neural_tissue(
+            std::shared_ptr<cellab::dynamic_state_of_neural_tissue> const
+                dynamic_state_of_tissue,
+            kernel_of_synapse_to_muscle const& transition_function_of_packed_synapse_to_muscle,
+            kernel_of_synapse_inside_tissue const& transition_function_of_packed_synapse_inside_tissue,
+            kernel_of_signalling const& transition_function_of_packed_signalling,
+            kernel_of_cell const& transition_function_of_packed_cell
+            )
+        : m_dynamic_state_of_tissue(dynamic_state_of_tissue)
+        , m_transition_function_of_packed_synapse_to_muscle(transition_function_of_packed_synapse_to_muscle)
+        , m_transition_function_of_packed_synapse_inside_tissue(transition_function_of_packed_synapse_inside_tissue)
+        , m_transition_function_of_packed_signalling(transition_function_of_packed_signalling)
+        , m_transition_function_of_packed_cell(transition_function_of_packed_cell)
+        , m_thread_pool()
+    {
+        ASSUMPTION(m_dynamic_state_of_tissue.operator bool());
+    }
+
+    std::shared_ptr<static_state_of_neural_tissue const>  get_static_state_of_neural_tissue() const
+    { return m_dynamic_state_of_tissue->get_static_state_of_neural_tissue(); }
+
+    std::shared_ptr<dynamic_state_of_neural_tissue>  get_dynamic_state_of_neural_tissue()
+    { return m_dynamic_state_of_tissue; }
+
+    std::shared_ptr<thread_pool>  get_thread_pool() const { return m_thread_pool; }
+    void  set_thread_pool(std::shared_ptr<thread_pool> const  pool) { m_thread_pool = pool; }
+
+    void  apply_transition_of_synapses_to_muscles(natural_32_bit const  num_threads_avalilable_for_computation)
+    {
+        apply_inlined_transition_of_synapses_to_muscles(
+                m_dynamic_state_of_tissue,
+                m_transition_function_of_packed_synapse_to_muscle,
+                num_threads_avalilable_for_computation,
+                get_thread_pool_for(num_threads_avalilable_for_computation)
+                );
+    }
+
+    void  apply_transition_of_synapses_of_tissue(natural_32_bit const  num_threads_avalilable_for_computation)
+    {
+        apply_inlined_transition_of_synapses_of_tissue(
+                m_dynamic_state_of_tissue,
+                m_transition_function_of_packed_synapse_inside_tissue,
+                num_threads_avalilable_for_computation,
+                get_thread_pool_for(num_threads_avalilable_for_computation)
+                );
+    }
+
+    void  apply_transition_of_territorial_lists_of_synapses(natural_32_bit const  num_threads_avalilable_for_computation)
+    {
+        cellab::apply_transition_of_territorial_lists_of_synapses(
+                m_dynamic_state_of_tissue,
+                num_threads_avalilable_for_computation,
+                get_thread_pool_for(num_threads_avalilable_for_computation)
+                );
+    }
+
+    void  apply_transition_of_synaptic_migration_in_tissue(natural_32_bit const  num_threads_avalilable_for_computation)
+    {
+        cellab::apply_transition_of_synaptic_migration_in_tissue(
+                m_dynamic_state_of_tissue,
+                num_threads_avalilable_for_computation,
+                get_thread_pool_for(num_threads_avalilable_for_computation)
+                );
+    }
+
+    void  apply_transition_of_signalling_in_tissue(natural_32_bit const  num_threads_avalilable_for_computation)
+    {
+        apply_inlined_transition_of_signalling_in_tissue(
+                m_dynamic_state_of_tissue,
+                m_transition_function_of_packed_signalling,
+                num_threads_avalilable_for_computation,
+                get_thread_pool_for(num_threads_avalilable_for_computation)
+                );
+    }
+
+    void  apply_transition_of_cells_of_tissue(natural_32_bit const  num_threads_avalilable_for_computation)
+    {
+        apply_inlined_transition_of_cells_of_tissue(
+                m_dynamic_state_of_tissue,
+                m_transition_function_of_packed_cell,
+                num_threads_avalilable_for_computation,
+                get_thread_pool_for(num_threads_avalilable_for_computation)
+                );
+    }
+
+private:
+
+    thread_pool&  get_thread_pool_for(natural_32_bit const  num_threads_avalilable_for_computation)
+    {
+        ASSUMPTION(num_threads_avalilable_for_computation > 0U);
+        if (!m_thread_pool || m_thread_pool->num_workers() + 1U < num_threads_avalilable_for_computation)
+            m_thread_pool = std::make_shared<thread_pool>(num_threads_avalilable_for_computation - 1U);
+        return *m_thread_pool;
+    }
+
+    std::shared_ptr<cellab::dynamic_state_of_neural_tissue>  m_dynamic_state_of_tissue;
+    kernel_of_synapse_to_muscle  m_transition_function_of_packed_synapse_to_muscle;
+    kernel_of_synapse_inside_tissue  m_transition_function_of_packed_synapse_inside_tissue;
+    kernel_of_signalling  m_transition_function_of_packed_signalling;
+    kernel_of_cell  m_transition_function_of_packed_cell;
+    std::shared_ptr<thread_pool>  m_thread_pool;
+};
+
+
+}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef CELLAB_NEIGHBOURHOOD_CLIPPING_TABLE_HPP_INCLUDED
+#   define CELLAB_NEIGHBOURHOOD_CLIPPING_TABLE_HPP_INCLUDED
+
+#   include <cellab/static_state_of_neural_tissue.hpp>
+#   include <cellab/shift_in_coordinates.hpp>
+#   include <utility/basic_numeric_types.hpp>
+#   include <boost/noncopyable.hpp>
+#   include <vector>
+#   include <array>
+
+namespace cellab {
+
+
+/**
+ * There are three kinds of spatial neighbourhoods used in transition algorithms. Each one has its own radii
+ * (along all three axes) for each kind of tissue cell. They are defined in the static state of the tissue.
+ */
+enum kind_of_neighbourhood
+{
+    SIGNALLING_NEIGHBOURHOOD_OF_CELL = 0,
+    SIGNALLING_NEIGHBOURHOOD_OF_SYNAPSE = 1,
+    CELLULAR_NEIGHBOURHOOD_OF_SIGNALLING = 2
+};
+
+
+/**
+ * It holds data precomputed from a static state of the tissue, which allow transition algorithms to compute
+ * the kind of a tissue cell and extreme corners of a (clipped) neighbourhood of any tissue cell by few table
+ * lookups. Namely, the kind of cell and the clipped shifts along the columnar axis are stored for each columnar
+ * coordinate (since a cell kind is determined by the columnar coordinate). Along x and y axes, each pair of
+ * kinds of neighbourhood and cell has its radius, which is the clipped shift of all interior cells, and tables
+ * of clipped shifts for those (at most radius) cells at each boundary of the axis. There are no tables for
+ * torus axes, since no shift is clipped there.
+ *
+ * An instance is built by (and owned by) the static state of the tissue (see the method
+ * 'static_state_of_neural_tissue::get_neighbourhood_clipping_table').
+ */
+struct neighbourhood_clipping_table : private boost::noncopyable
+{
+    explicit neighbourhood_clipping_table(static_state_of_neural_tissue const& static_state_of_tissue);
+
+    kind_of_cell  get_kind_of_tissue_cell(natural_32_bit const c_coord) const
+    {
+        return m_kinds_of_tissue_cells_along_columnar_axis[c_coord];
+    }
+
+    shift_in_coordinates  get_shift_to_low_corner(
+            kind_of_neighbourhood const neighbourhood_kind,
+            natural_32_bit const x_coord,
+            natural_32_bit const y_coord,
+            natural_32_bit const c_coord
+            ) const
+    {
+        kind_of_cell const cell_kind = get_kind_of_tissue_cell(c_coord);
+        return shift_in_coordinates(
+                    m_along_x_axis[neighbourhood_kind][cell_kind].get_shift_to_low_end(x_coord),
+                    m_along_y_axis[neighbourhood_kind][cell_kind].get_shift_to_low_end(y_coord),
+                    m_along_columnar_axis[neighbourhood_kind][c_coord].first
+                    );
+    }
+
+    shift_in_coordinates  get_shift_to_high_corner(
+            kind_of_neighbourhood const neighbourhood_kind,
+            natural_32_bit const x_coord,
+            natural_32_bit const y_coord,
+            natural_32_bit const c_coord
+            ) const
+    {
+        kind_of_cell const cell_kind = get_kind_of_tissue_cell(c_coord);
+        return shift_in_coordinates(
+                    m_along_x_axis[neighbourhood_kind][cell_kind].get_shift_to_high_end(x_coord),
+                    m_along_y_axis[neighbourhood_kind][cell_kind].get_shift_to_high_end(y_coord),
+                    m_along_columnar_axis[neighbourhood_kind][c_coord].second
+                    );
+    }
+
+private:
+
+    struct clipping_along_axis
+    {
+        clipping_along_axis(
+                integer_8_bit const radius,
+                natural_32_bit const length_of_axis,
+                bool const is_it_torus_axis
+                );
+
+        integer_8_bit  get_shift_to_low_end(natural_32_bit const coord) const
+        {
+            return coord < m_shifts_at_low_boundary.size() ? m_shifts_at_low_boundary[coord] : (integer_8_bit)-m_radius;
+        }
+
+        integer_8_bit  get_shift_to_high_end(natural_32_bit const coord) const
+        {
+            natural_32_bit const distance_to_end = m_last_coord - coord;
+            return distance_to_end < m_shifts_at_high_boundary.size() ? m_shifts_at_high_boundary[distance_to_end] :
+                                                                        m_radius;
+        }
+
+    private:
+        integer_8_bit  m_radius;
+        natural_32_bit  m_last_coord;
+        std::vector<integer_8_bit>  m_shifts_at_low_boundary;   //!< Indexed by a coordinate.
+        std::vector<integer_8_bit>  m_shifts_at_high_boundary;  //!< Indexed by a distance to the last coordinate.
+    };
+
+    static natural_32_bit const  num_kinds_of_neighbourhoods = 3U;
+
+    std::vector<kind_of_cell>  m_kinds_of_tissue_cells_along_columnar_axis;
+    std::array<std::vector<clipping_along_axis>,num_kinds_of_neighbourhoods>  m_along_x_axis;
+    std::array<std::vector<clipping_along_axis>,num_kinds_of_neighbourhoods>  m_along_y_axis;
+    std::array<std::vector<std::pair<integer_8_bit,integer_8_bit> >,num_kinds_of_neighbourhoods>  m_along_columnar_axis;
+};
+
+
+}
+
+#endif
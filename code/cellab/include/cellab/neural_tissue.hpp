@@ -6,6 +6,7 @@
 #   include <cellab/transition_algorithms.hpp>
 #   include <cellab/utilities_for_construction_of_neural_tissue.hpp>
 #   include <utility/basic_numeric_types.hpp>
+#   include <utility/thread_pool.hpp>
 #   include <boost/noncopyable.hpp>
 #   include <type_traits>
 #   include <typeinfo>
@@ -130,6 +131,15 @@ struct neural_tissue : private boost::noncopyable
     std::shared_ptr<static_state_of_neural_tissue const>  get_static_state_of_neural_tissue() const;
     std::shared_ptr<dynamic_state_of_neural_tissue>  get_dynamic_state_of_neural_tissue();
 
+    /**
+     * All transition algorithms called via methods bellow run in threads of this pool. So, no thread
+     * is created during the simulation, except the first call (or a call asking for more threads than
+     * in any previous call), when the pool is created (or replaced by a bigger one). The pool can also
+     * be passed in by a user, e.g. in order to share it between several tissues updated one by one.
+     */
+    std::shared_ptr<thread_pool>  get_thread_pool() const;
+    void  set_thread_pool(std::shared_ptr<thread_pool> const  pool);
+
     void  apply_transition_of_synapses_to_muscles(
             natural_32_bit const  num_threads_avalilable_for_computation
             );
@@ -160,6 +170,8 @@ struct neural_tissue : private boost::noncopyable
 
 private:
 
+    thread_pool&  get_thread_pool_for(natural_32_bit const  num_threads_avalilable_for_computation);
+
     std::shared_ptr<cellab::dynamic_state_of_neural_tissue>
             m_dynamic_state_of_tissue;
 
@@ -175,6 +187,8 @@ private:
     std::size_t  m_hash_code_of_class_for_cells;
     std::size_t  m_hash_code_of_class_for_synapses;
     std::size_t  m_hash_code_of_class_for_signalling;
+
+    std::shared_ptr<thread_pool>  m_thread_pool;
 };
 
 
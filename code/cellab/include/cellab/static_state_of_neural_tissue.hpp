@@ -14,6 +14,8 @@ namespace cellab {
 typedef natural_16_bit kind_of_cell;
 typedef natural_16_bit kind_of_synapse_to_muscle;
 
+struct neighbourhood_clipping_table;
+
 
 /**
  * It defines that part of a state of the neural tissue which cannot be modified (updated)
@@ -177,6 +179,12 @@ struct static_state_of_neural_tissue : private boost::noncopyable
     integer_8_bit  get_y_radius_of_cellular_neighbourhood_of_signalling(kind_of_cell const cell_kind) const;
     integer_8_bit  get_columnar_radius_of_cellular_neighbourhood_of_signalling(kind_of_cell const cell_kind) const;
 
+    /**
+     * It returns kinds of tissue cells and clipped neighbourhoods of tissue cells precomputed from this
+     * static state (see 'neighbourhood_clipping_table.hpp'). The table is built once in the constructor.
+     */
+    neighbourhood_clipping_table const&  get_neighbourhood_clipping_table() const;
+
 private:
     natural_16_bit m_num_kinds_of_cells;
     natural_16_bit m_num_kinds_of_tissue_cells;
@@ -216,6 +224,8 @@ private:
     std::vector<integer_8_bit> m_x_radius_of_cellular_neighbourhood_of_signalling;
     std::vector<integer_8_bit> m_y_radius_of_cellular_neighbourhood_of_signalling;
     std::vector<integer_8_bit> m_columnar_radius_of_cellular_neighbourhood_of_signalling;
+
+    std::unique_ptr<neighbourhood_clipping_table const> m_neighbourhood_clipping_table;
 };
 
 
@@ -6,6 +6,7 @@
 #include <cellab/shift_in_coordinates.hpp>
 #include <utility/basic_numeric_types.hpp>
 #include <utility/bits_reference.hpp>
+#include <utility/thread_pool.hpp>
 #include <functional>
 #include <memory>
 
@@ -21,6 +22,10 @@
  * a next valid state from a given valid state. Finally, the algorithms overwrite the old
  * state of the neural tissue by the next one.
  *
+ * When the dynamic state is double-buffered (see 'DOUBLE_BUFFERED_CELLS_AND_SIGNALLING'), then all
+ * transitions of one step except the synaptic migration can be applied at once in a single parallel
+ * sweep over the tissue. See the header file 'double_buffered_transition_of_tissue.hpp'.
+ *
  * For more info read about the algorithms see the documentation:
  *      file:///<E2-root-dir>/doc/project_documentation/cellab/cellab.html#transition_algorithms
  */
@@ -298,6 +303,19 @@ void apply_transition_of_synapses_to_muscles(
         natural_32_bit const  num_threads_avalilable_for_computation
         );
 
+/**
+ * The same as above, but the computation is performed by threads of the passed pool instead of
+ * threads created (and joined) just for this call. It is required that the pool has at least
+ * 'num_threads_avalilable_for_computation' - 1 workers.
+ */
+void apply_transition_of_synapses_to_muscles(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        single_threaded_in_situ_transition_function_of_packed_dynamic_state_of_synapse_to_muscle const&
+            transition_function_of_packed_synapse_to_muscle,
+        natural_32_bit const  num_threads_avalilable_for_computation,
+        thread_pool&  pool
+        );
+
 
 /**
  * This algorithm represent the second of the six steps in computation of a next state of the neural
@@ -322,6 +340,17 @@ void apply_transition_of_synapses_of_tissue(
         natural_32_bit const  num_threads_avalilable_for_computation
         );
 
+/**
+ * The same as above, but threads of the passed pool are used for the computation.
+ */
+void apply_transition_of_synapses_of_tissue(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        single_threaded_in_situ_transition_function_of_packed_dynamic_state_of_synapse_inside_tissue const&
+            transition_function_of_packed_synapse_inside_tissue,
+        natural_32_bit const  num_threads_avalilable_for_computation,
+        thread_pool&  pool
+        );
+
 
 /**
  * This algorithm sorts lists of synapses in territories in the neural tissue according to their
@@ -342,6 +371,15 @@ void apply_transition_of_territorial_lists_of_synapses(
         natural_32_bit const  num_threads_avalilable_for_computation
         );
 
+/**
+ * The same as above, but threads of the passed pool are used for the computation.
+ */
+void apply_transition_of_territorial_lists_of_synapses(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        natural_32_bit const  num_threads_avalilable_for_computation,
+        thread_pool&  pool
+        );
+
 
 /**
  * It exchanges synapses in adjacent territories according to territorrial states of the synapses. Let
@@ -365,6 +403,32 @@ void  apply_transition_of_synaptic_migration_in_tissue(
         natural_32_bit const  num_threads_avalilable_for_computation
         );
 
+/**
+ * The same as above, but threads of the passed pool are used for the computation.
+ */
+void  apply_transition_of_synaptic_migration_in_tissue(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        natural_32_bit const  num_threads_avalilable_for_computation,
+        thread_pool&  pool
+        );
+
+/**
+ * The same as above, but random generators used by the algorithm are seeded by the passed value. The
+ * territories are processed in two (or three for an odd-length torus axis) colour classes along the
+ * axis of migration, so that threads never touch the same territory concurrently. Random numbers for
+ * each pivot cell are drawn from its own stream of a counter-based generator keyed by the seed, the axis
+ * of migration, and the cell (see 'counter_based_random_generator' in 'utility/random.hpp'). So, for the
+ * same seed the result is always the same, regardless of the number of threads. A caller simulating more
+ * steps should pass a different seed for each step. The overloads above draw the seed from
+ * 'default_random_generator()'.
+ */
+void  apply_transition_of_synaptic_migration_in_tissue(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        natural_32_bit const  num_threads_avalilable_for_computation,
+        thread_pool&  pool,
+        natural_32_bit const  seed_of_random_generators
+        );
+
 
 /**
  * This algorithm represent the fifth of the six steps in computation of a next state of the neural
@@ -383,6 +447,17 @@ void apply_transition_of_signalling_in_tissue(
         natural_32_bit const  num_threads_avalilable_for_computation
         );
 
+/**
+ * The same as above, but threads of the passed pool are used for the computation.
+ */
+void apply_transition_of_signalling_in_tissue(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        single_threaded_in_situ_transition_function_of_packed_dynamic_state_of_signalling const&
+            transition_function_of_packed_signalling,
+        natural_32_bit const  num_threads_avalilable_for_computation,
+        thread_pool&  pool
+        );
+
 
 /**
  * This algorithm represent the last of the six steps in computation of a next state of the neural
@@ -406,6 +481,17 @@ void apply_transition_of_cells_of_tissue(
         natural_32_bit const  num_threads_avalilable_for_computation
         );
 
+/**
+ * The same as above, but threads of the passed pool are used for the computation.
+ */
+void apply_transition_of_cells_of_tissue(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        single_threaded_in_situ_transition_function_of_packed_dynamic_state_of_cell const&
+            transition_function_of_packed_cell,
+        natural_32_bit const  num_threads_avalilable_for_computation,
+        thread_pool&  pool
+        );
+
 
 }
 
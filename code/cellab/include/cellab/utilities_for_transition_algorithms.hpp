@@ -117,6 +117,72 @@ bool  go_to_next_index(
         );
 
 
+/**
+ * The following three functions allows for a tiled enumeration of coordinates of cells in the tissue.
+ * Cells are enumerated in the same order as they are stored in slices of the tissue (i.e. the columnar
+ * coordinate changes the fastest and the y coordinate the slowest). The sequence is split into tiles of
+ * 'num_cells_in_tile' consecutive cells and the tiles are distributed cyclically among 'num_threads'
+ * threads, i.e. a thread of an index i processes tiles i, i + num_threads, i + 2*num_threads, etc.
+ * Therefore, each thread works on contiguous blocks of memory of the slices, instead of on every
+ * 'num_threads'-th cell (as in the enumeration by 'go_to_next_coordinates'), which mostly removes
+ * false sharing of cache lines between threads. For num_cells_in_tile == 1 both enumerations are the same.
+ */
+
+/**
+ * It computes a number of cells in a tile such that all data touched during processing of the tile
+ * (i.e. cells, signalling and synapses in territories of the cells) approximately fit into L2 cache
+ * (of the size 'num_bytes_of_l2_cache'). If a tile is bigger than a column, then it is rounded down
+ * to whole columns, so the tile is then a block of columns along x and y axes. The tile is also never
+ * bigger than the number of cells divided by 'num_threads' (rounded up), so that no thread stays idle.
+ */
+natural_32_bit  compute_num_cells_in_tile_of_tissue(
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+        natural_32_bit const num_threads,
+        natural_32_bit const num_bytes_of_l2_cache = 256U * 1024U
+        );
+
+/**
+ * It is the same as 'compute_num_cells_in_tile_of_tissue', but the tile is rounded to whole blocks of 8 columns
+ * (and it is never smaller than one block). Units of a block of 8 columns occupy a whole number of bytes in each
+ * slice of the tissue (even with PACKED_UNITS storage). So, each tile starts at a byte boundary of all slices, and
+ * threads writing packed units of cells of different tiles never write the same byte. Small tissues may then have
+ * fewer tiles than threads.
+ */
+natural_32_bit  compute_num_cells_in_byte_aligned_tile_of_tissue(
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+        natural_32_bit const num_threads,
+        natural_32_bit const num_bytes_of_l2_cache = 256U * 1024U
+        );
+
+/**
+ * It sets the coordinates to the first cell of the first tile of the thread of the passed index.
+ * It returns false, if there is no tile for the thread.
+ */
+bool  go_to_first_coordinates_in_tiles(
+        natural_32_bit& x_coord, natural_32_bit& y_coord, natural_32_bit& c_coord,
+        natural_32_bit const thread_index,
+        natural_32_bit const num_cells_in_tile,
+        natural_32_bit const num_cells_along_x_axis,
+        natural_32_bit const num_cells_along_y_axis,
+        natural_32_bit const num_cells_along_columnar_axis
+        );
+
+/**
+ * It moves the coordinates to the next cell of the thread. The counter 'index_in_tile' must be
+ * initialised to 0 together with the call to 'go_to_first_coordinates_in_tiles'. It returns false,
+ * if there is no further cell for the thread.
+ */
+bool  go_to_next_coordinates_in_tiles(
+        natural_32_bit& x_coord, natural_32_bit& y_coord, natural_32_bit& c_coord,
+        natural_32_bit& index_in_tile,
+        natural_32_bit const num_cells_in_tile,
+        natural_32_bit const num_threads,
+        natural_32_bit const num_cells_along_x_axis,
+        natural_32_bit const num_cells_along_y_axis,
+        natural_32_bit const num_cells_along_columnar_axis
+        );
+
+
 
 integer_64_bit  clip_shift(
         integer_64_bit const shift,
@@ -135,24 +201,24 @@ void  write_tissue_coordinates_to_bits_of_coordinates(tissue_coordinates const&
 tissue_coordinates  convert_bits_of_coordinates_to_tissue_coordinates(bits_reference const& bits_ref);
 
 tissue_coordinates  get_coordinates_of_source_cell_of_synapse_in_tissue(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
         tissue_coordinates const& coords_of_territorial_cell_of_synapse,
         natural_32_bit const index_of_synapse_in_territory
         );
 
 tissue_coordinates  get_coordinates_of_source_cell_of_synapse_to_muscle(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
         natural_32_bit const index_of_synapse_to_muscle
         );
 
 natural_32_bit  get_begin_index_of_territorial_list_of_cell(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
         tissue_coordinates const& coordinates_of_cell,
         natural_8_bit const index_of_territorial_list
         );
 natural_32_bit  get_end_index_of_territorial_list_of_cell(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
-        std::shared_ptr<static_state_of_neural_tissue const> const static_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
         tissue_coordinates const& coordinates_of_cell,
         natural_8_bit const index_of_territorial_list
         );
@@ -166,7 +232,7 @@ natural_32_bit  get_end_index_of_territorial_list_of_cell(
  * legal (but useless) to swap a synapse with itself.
  */
 void  swap_all_data_of_two_synapses(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
         tissue_coordinates const& first_cell_coordinates,
         natural_32_bit const synapse_index_in_first_territory,
         tissue_coordinates const& second_cell_coordinates,
@@ -174,11 +240,26 @@ void  swap_all_data_of_two_synapses(
         );
 
 
+/**
+ * It moves all synapses in the territory of the cell at the passed coordinates into territorial lists
+ * corresponding to their territorial states (and updates delimiters of the lists accordingly). Only
+ * data in that territory are accessed. It is the body of the algorithm
+ * 'apply_transition_of_territorial_lists_of_synapses' (see the header file 'transition_algorithms.hpp').
+ */
+void  move_synapses_into_proper_lists_in_territory_of_cell(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+        natural_32_bit const x_coord,
+        natural_32_bit const y_coord,
+        natural_32_bit const c_coord
+        );
+
+
 /**
  * It is passed to user's callback function (from inside of either 'apply_transition_of_cells_of_tissue' or
  * 'apply_transition_of_synapses_of_tissue') in order to allow easy access all signalling within a local
  * neighbourhood of the territory inside which the updated cell or synapse appears. First three parameters
- * of this function are bound to fixed values (using std::bind inside both functions mentioned aboce), so
+ * of this function are bound to fixed values (using 'signalling_accessor' inside both functions mentioned aboce), so
  * user's callback function provides only one (the last) argument, which is a shift vector from the current
  * territory into a desired one (within the neughbourhood). The shift vector is relative from the coordinates
  * of the current territory. So, the shift to the current territory is a sift vector (0,0,0). Note that the
@@ -188,8 +269,8 @@ void  swap_all_data_of_two_synapses(
  * 'thransition_algorithms.hpp' to see the prototype of the user's callback function.
  */
 std::pair<bits_const_reference,kind_of_cell>  get_signalling_callback_function(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
-        std::shared_ptr<static_state_of_neural_tissue const> const static_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
         spatial_neighbourhood const& neighbourhood,
         shift_in_coordinates const& shift
         );
@@ -198,7 +279,7 @@ std::pair<bits_const_reference,kind_of_cell>  get_signalling_callback_function(
 /**
  * It is passed to user's callback function (from inside of the function 'apply_transition_of_cells_of_tissue')
  * in order to allow easy access to synapses connected to an updated tissue cell. First six parameters of
- * this function are bound to fixed values (using std::bind inside 'apply_transition_of_cells_of_tissue'),
+ * this function are bound to fixed values (using 'synapse_accessor' inside 'apply_transition_of_cells_of_tissue'),
  * so user's callback function provides only one (the last) argument, which is an index of an enumerated
  * synapse. It is supposed to be in the range 0,...,'number_of_synapses_in_range'-1. Note that the value
  * 'number_of_synapses_in_range' is also passed to the user's callback function through another parameter.
@@ -206,8 +287,8 @@ std::pair<bits_const_reference,kind_of_cell>  get_signalling_callback_function(
  * header file 'thransition_algorithms.hpp' to see the prototype of the user's callback function.
  */
 std::tuple<bits_const_reference,kind_of_cell,kind_of_cell>  get_synapse_callback_function(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
-        std::shared_ptr<static_state_of_neural_tissue const> const static_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
         tissue_coordinates const& target_cell,
         kind_of_cell const kind_of_target_cell,
         natural_32_bit const number_of_synapses_in_range,
@@ -219,7 +300,7 @@ std::tuple<bits_const_reference,kind_of_cell,kind_of_cell>  get_synapse_callback
 /**
  * It is passed to user's callback function (from inside of the function 'apply_transition_of_signalling_in_tissue')
  * in order to allow easy access to tissue cells inside a neighbourhood of an updated signalling. First three
- * parameters of this function are bound to fixed values (using std::bind inside 'apply_transition_of_signalling_in_tissue'),
+ * parameters of this function are bound to fixed values (using 'cell_accessor' inside 'apply_transition_of_signalling_in_tissue'),
  * so user's callback function provides only one (the last) argument, which is a 3D shift vector from the territory
  * of the updated signalling to some territory inside the spatial neighbourhood. Note that the spatial neighbourhood
  * is also passed to the user's callback function (via a pair of two extremal shifts). See definition of
@@ -227,8 +308,8 @@ std::tuple<bits_const_reference,kind_of_cell,kind_of_cell>  get_synapse_callback
  * header file 'thransition_algorithms.hpp' to see the prototype of the user's callback function.
  */
 std::pair<bits_const_reference,kind_of_cell>  get_cell_callback_function(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
-        std::shared_ptr<static_state_of_neural_tissue const> const static_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
         spatial_neighbourhood const& neighbourhood,
         shift_in_coordinates const& shift
         );
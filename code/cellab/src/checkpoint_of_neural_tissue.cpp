@@ -0,0 +1,354 @@
+#include <cellab/checkpoint_of_neural_tissue.hpp>
+#include <utility/array_of_bit_units.hpp>
+#include <utility/msgstream.hpp>
+#include <utility/assumptions.hpp>
+#include <utility/log.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+
+namespace cellab { namespace private_internal_implementation_details {
+
+
+char const  magic_of_checkpoint_file[8] = { 'E', '2', 'T', 'I', 'S', 'S', 'U', 'E' };
+natural_32_bit const  byte_order_marker = 0x01020304U;
+natural_64_bit const  alignment_of_arrays_in_file = 64ULL;
+
+
+struct  record_of_array_of_units
+{
+    natural_16_bit  num_bits_per_unit;
+    natural_8_bit  are_units_aligned_to_bytes;
+    natural_64_bit  num_units;
+    natural_64_bit  offset_in_file;
+    natural_64_bit  num_bytes;
+};
+
+natural_64_bit const  num_bytes_of_record_of_array_of_units = 2ULL + 1ULL + 3ULL * 8ULL;
+
+
+natural_64_bit  align_offset_in_file(natural_64_bit const  offset)
+{
+    return (offset + alignment_of_arrays_in_file - 1ULL) & ~(alignment_of_arrays_in_file - 1ULL);
+}
+
+
+struct  header_writer
+{
+    template<typename T>
+    void  write(T const  value)
+    {
+        natural_8_bit const* const  begin = reinterpret_cast<natural_8_bit const*>(&value);
+        m_bytes.insert(m_bytes.end(), begin, begin + sizeof(T));
+    }
+
+    template<typename T>
+    void  write(std::vector<T> const&  values)
+    {
+        write((natural_32_bit)values.size());
+        for (T const  value : values)
+            write(value);
+    }
+
+    std::vector<natural_8_bit> const&  bytes() const { return m_bytes; }
+
+private:
+    std::vector<natural_8_bit>  m_bytes;
+};
+
+
+struct  header_reader
+{
+    header_reader(natural_8_bit const* const  begin, natural_8_bit const* const  end,
+                  std::string const&  path_to_checkpoint_file)
+        : m_cursor(begin)
+        , m_end(end)
+        , m_path(path_to_checkpoint_file)
+    {}
+
+    template<typename T>
+    T  read()
+    {
+        if (m_end - m_cursor < (std::ptrdiff_t)sizeof(T))
+            throw std::runtime_error(msgstream() << "The checkpoint file '" << m_path << "' is truncated.");
+        T  value;
+        std::memcpy(&value, m_cursor, sizeof(T));
+        m_cursor += sizeof(T);
+        return value;
+    }
+
+    template<typename T>
+    std::vector<T>  read_vector()
+    {
+        natural_32_bit const  size = read<natural_32_bit>();
+        if ((natural_64_bit)(m_end - m_cursor) < (natural_64_bit)size * sizeof(T))
+            throw std::runtime_error(msgstream() << "The checkpoint file '" << m_path << "' is truncated.");
+        std::vector<T>  values;
+        values.reserve(size);
+        for (natural_32_bit i = 0U; i < size; ++i)
+            values.push_back(read<T>());
+        return values;
+    }
+
+private:
+    natural_8_bit const*  m_cursor;
+    natural_8_bit const*  m_end;
+    std::string  m_path;
+};
+
+
+void  write_static_state(static_state_of_neural_tissue const&  static_state, header_writer&  writer)
+{
+    writer.write(static_state.num_kinds_of_tissue_cells());
+    writer.write(static_state.num_kinds_of_sensory_cells());
+    writer.write((natural_16_bit)static_state.num_kinds_of_synapses_to_muscles());
+    writer.write(static_state.num_bits_per_cell());
+    writer.write(static_state.num_bits_per_synapse());
+    writer.write(static_state.num_bits_per_signalling());
+    writer.write(static_state.num_cells_along_x_axis());
+    writer.write(static_state.num_cells_along_y_axis());
+
+    std::vector<natural_32_bit>  num_tissue_cells_of_cell_kind;
+    std::vector<natural_32_bit>  num_synapses_in_territory_of_cell_kind;
+    std::vector<integer_8_bit>  radii[9];
+    for (kind_of_cell kind = 0U; kind < static_state.num_kinds_of_tissue_cells(); ++kind)
+    {
+        num_tissue_cells_of_cell_kind.push_back(static_state.num_tissue_cells_of_cell_kind(kind));
+        num_synapses_in_territory_of_cell_kind.push_back(static_state.num_synapses_in_territory_of_cell_kind(kind));
+        radii[0].push_back(static_state.get_x_radius_of_signalling_neighbourhood_of_cell(kind));
+        radii[1].push_back(static_state.get_y_radius_of_signalling_neighbourhood_of_cell(kind));
+        radii[2].push_back(static_state.get_columnar_radius_of_signalling_neighbourhood_of_cell(kind));
+        radii[3].push_back(static_state.get_x_radius_of_signalling_neighbourhood_of_synapse(kind));
+        radii[4].push_back(static_state.get_y_radius_of_signalling_neighbourhood_of_synapse(kind));
+        radii[5].push_back(static_state.get_columnar_radius_of_signalling_neighbourhood_of_synapse(kind));
+        radii[6].push_back(static_state.get_x_radius_of_cellular_neighbourhood_of_signalling(kind));
+        radii[7].push_back(static_state.get_y_radius_of_cellular_neighbourhood_of_signalling(kind));
+        radii[8].push_back(static_state.get_columnar_radius_of_cellular_neighbourhood_of_signalling(kind));
+    }
+    std::vector<natural_32_bit>  num_sensory_cells_of_cell_kind;
+    for (kind_of_cell kind = static_state.lowest_kind_of_sensory_cells(); kind < static_state.num_kinds_of_cells(); ++kind)
+        num_sensory_cells_of_cell_kind.push_back(static_state.num_sensory_cells_of_cell_kind(kind));
+    std::vector<natural_32_bit>  num_synapses_to_muscles_of_kind;
+    for (kind_of_synapse_to_muscle kind = 0U; kind < static_state.num_kinds_of_synapses_to_muscles(); ++kind)
+        num_synapses_to_muscles_of_kind.push_back(static_state.num_synapses_to_muscles_of_kind(kind));
+
+    writer.write(num_tissue_cells_of_cell_kind);
+    writer.write(num_synapses_in_territory_of_cell_kind);
+    writer.write(num_sensory_cells_of_cell_kind);
+    writer.write(num_synapses_to_muscles_of_kind);
+    writer.write((natural_8_bit)static_state.is_x_axis_torus_axis());
+    writer.write((natural_8_bit)static_state.is_y_axis_torus_axis());
+    writer.write((natural_8_bit)static_state.is_columnar_axis_torus_axis());
+    for (std::vector<integer_8_bit> const&  radius : radii)
+        writer.write(radius);
+}
+
+
+std::shared_ptr<static_state_of_neural_tissue const>  read_static_state(header_reader&  reader)
+{
+    natural_16_bit const  num_kinds_of_tissue_cells = reader.read<natural_16_bit>();
+    natural_16_bit const  num_kinds_of_sensory_cells = reader.read<natural_16_bit>();
+    natural_16_bit const  num_kinds_of_synapses_to_muscles = reader.read<natural_16_bit>();
+    natural_16_bit const  num_bits_per_cell = reader.read<natural_16_bit>();
+    natural_16_bit const  num_bits_per_synapse = reader.read<natural_16_bit>();
+    natural_16_bit const  num_bits_per_signalling = reader.read<natural_16_bit>();
+    natural_32_bit const  num_cells_along_x_axis = reader.read<natural_32_bit>();
+    natural_32_bit const  num_cells_along_y_axis = reader.read<natural_32_bit>();
+    std::vector<natural_32_bit> const  num_tissue_cells_of_cell_kind = reader.read_vector<natural_32_bit>();
+    std::vector<natural_32_bit> const  num_synapses_in_territory_of_cell_kind = reader.read_vector<natural_32_bit>();
+    std::vector<natural_32_bit> const  num_sensory_cells_of_cell_kind = reader.read_vector<natural_32_bit>();
+    std::vector<natural_32_bit> const  num_synapses_to_muscles_of_kind = reader.read_vector<natural_32_bit>();
+    bool const  is_x_axis_torus_axis = reader.read<natural_8_bit>() != 0U;
+    bool const  is_y_axis_torus_axis = reader.read<natural_8_bit>() != 0U;
+    bool const  is_columnar_axis_torus_axis = reader.read<natural_8_bit>() != 0U;
+    std::vector<integer_8_bit>  radii[9];
+    for (std::vector<integer_8_bit>&  radius : radii)
+        radius = reader.read_vector<integer_8_bit>();
+
+    return std::make_shared<static_state_of_neural_tissue const>(
+                num_kinds_of_tissue_cells,
+                num_kinds_of_sensory_cells,
+                num_kinds_of_synapses_to_muscles,
+                num_bits_per_cell,
+                num_bits_per_synapse,
+                num_bits_per_signalling,
+                num_cells_along_x_axis,
+                num_cells_along_y_axis,
+                num_tissue_cells_of_cell_kind,
+                num_synapses_in_territory_of_cell_kind,
+                num_sensory_cells_of_cell_kind,
+                num_synapses_to_muscles_of_kind,
+                is_x_axis_torus_axis,
+                is_y_axis_torus_axis,
+                is_columnar_axis_torus_axis,
+                radii[0], radii[1], radii[2],
+                radii[3], radii[4], radii[5],
+                radii[6], radii[7], radii[8]
+                );
+}
+
+
+}}
+
+namespace cellab {
+
+
+natural_32_bit  version_of_format_of_checkpoint_of_neural_tissue()
+{
+    return 1U;
+}
+
+
+void  save_checkpoint_of_neural_tissue(
+        dynamic_state_of_neural_tissue const&  dynamic_state,
+        boost::filesystem::path const&  path_to_checkpoint_file
+        )
+{
+    using namespace private_internal_implementation_details;
+
+    std::vector<array_of_bit_units const*> const  arrays = dynamic_state.get_arrays_of_units_in_order_of_allocation();
+
+    header_writer  writer;
+    for (char const  c : magic_of_checkpoint_file)
+        writer.write(c);
+    writer.write(version_of_format_of_checkpoint_of_neural_tissue());
+    writer.write(byte_order_marker);
+    write_static_state(*dynamic_state.get_static_state_of_neural_tissue(), writer);
+    writer.write((natural_8_bit)dynamic_state.get_storage_of_units());
+    writer.write((natural_8_bit)dynamic_state.get_buffering_of_cells_and_signalling());
+    writer.write((natural_32_bit)arrays.size());
+
+    natural_64_bit  offset_in_file =
+            align_offset_in_file(writer.bytes().size() + arrays.size() * num_bytes_of_record_of_array_of_units);
+    for (array_of_bit_units const* const  array : arrays)
+    {
+        writer.write(array->num_bits_per_unit());
+        writer.write((natural_8_bit)array->are_units_aligned_to_bytes());
+        writer.write(array->num_units());
+        writer.write(offset_in_file);
+        writer.write(array->num_bytes());
+        offset_in_file = align_offset_in_file(offset_in_file + array->num_bytes());
+    }
+
+    boost::filesystem::ofstream  ostr(path_to_checkpoint_file, std::ios_base::binary);
+    if (!ostr.good())
+        throw std::runtime_error(msgstream() << "Cannot open the checkpoint file '" << path_to_checkpoint_file
+                                             << "' for writing.");
+
+    char const  padding[alignment_of_arrays_in_file] = { 0 };
+    natural_64_bit  num_written_bytes = writer.bytes().size();
+    ostr.write((char const*)writer.bytes().data(), writer.bytes().size());
+    for (array_of_bit_units const* const  array : arrays)
+    {
+        ostr.write(padding, align_offset_in_file(num_written_bytes) - num_written_bytes);
+        num_written_bytes = align_offset_in_file(num_written_bytes);
+        ostr.write((char const*)array->data(), array->num_bytes());
+        num_written_bytes += array->num_bytes();
+    }
+    ostr.write(padding, align_offset_in_file(num_written_bytes) - num_written_bytes);
+
+    if (ostr.bad())
+        throw std::runtime_error(msgstream() << "Cannot write to the checkpoint file '" << path_to_checkpoint_file << "'.");
+}
+
+
+std::shared_ptr<dynamic_state_of_neural_tissue>  load_checkpoint_of_neural_tissue(
+        boost::filesystem::path const&  path_to_checkpoint_file,
+        mapping_of_checkpoint_of_neural_tissue const  mapping
+        )
+{
+    using namespace private_internal_implementation_details;
+
+    std::shared_ptr<boost::interprocess::mapped_region>  region;
+    try
+    {
+        boost::interprocess::file_mapping const  file(
+                path_to_checkpoint_file.string().c_str(),
+                mapping == SHARED_MAPPING_OF_CHECKPOINT ? boost::interprocess::read_write :
+                                                          boost::interprocess::read_only
+                );
+        region = std::make_shared<boost::interprocess::mapped_region>(
+                file,
+                mapping == SHARED_MAPPING_OF_CHECKPOINT ? boost::interprocess::read_write :
+                                                          boost::interprocess::copy_on_write
+                );
+    }
+    catch (boost::interprocess::interprocess_exception const&  e)
+    {
+        throw std::runtime_error(msgstream() << "Cannot map the checkpoint file '" << path_to_checkpoint_file
+                                             << "' into memory: " << e.what());
+    }
+
+    natural_8_bit* const  begin_of_file = static_cast<natural_8_bit*>(region->get_address());
+    natural_64_bit const  size_of_file = region->get_size();
+    header_reader  reader(begin_of_file, begin_of_file + size_of_file, path_to_checkpoint_file.string());
+
+    for (char const  c : magic_of_checkpoint_file)
+        if (reader.read<char>() != c)
+            throw std::runtime_error(msgstream() << "The file '" << path_to_checkpoint_file
+                                                 << "' is not a checkpoint of a neural tissue.");
+    natural_32_bit const  version = reader.read<natural_32_bit>();
+    if (version != version_of_format_of_checkpoint_of_neural_tissue())
+        throw std::runtime_error(msgstream() << "The checkpoint file '" << path_to_checkpoint_file
+                                             << "' has unsupported version " << version << ".");
+    if (reader.read<natural_32_bit>() != byte_order_marker)
+        throw std::runtime_error(msgstream() << "The checkpoint file '" << path_to_checkpoint_file
+                                             << "' was written on a machine with a different byte order.");
+
+    std::shared_ptr<static_state_of_neural_tissue const> const  static_state = read_static_state(reader);
+    storage_of_units_of_neural_tissue const  storage_of_units =
+            (storage_of_units_of_neural_tissue)reader.read<natural_8_bit>();
+    buffering_of_cells_and_signalling const  buffering =
+            (buffering_of_cells_and_signalling)reader.read<natural_8_bit>();
+
+    std::vector<record_of_array_of_units>  records(reader.read<natural_32_bit>());
+    for (record_of_array_of_units&  record : records)
+    {
+        record.num_bits_per_unit = reader.read<natural_16_bit>();
+        record.are_units_aligned_to_bytes = reader.read<natural_8_bit>();
+        record.num_units = reader.read<natural_64_bit>();
+        record.offset_in_file = reader.read<natural_64_bit>();
+        record.num_bytes = reader.read<natural_64_bit>();
+        if (record.offset_in_file > size_of_file || record.num_bytes > size_of_file - record.offset_in_file)
+            throw std::runtime_error(msgstream() << "The checkpoint file '" << path_to_checkpoint_file
+                                                 << "' is truncated.");
+    }
+
+    // The dynamic state takes its arrays directly from the mapped region. Each array shares the ownership
+    // of the whole region, so the region is unmapped only when the dynamic state is destroyed.
+    natural_32_bit  index_of_next_record = 0U;
+    memory_provider_for_array_of_bit_units const  memory_provider =
+            [&records, &index_of_next_record, &region, &path_to_checkpoint_file, begin_of_file]
+            (natural_64_bit const  num_bytes) -> std::shared_ptr<natural_8_bit>
+            {
+                if (index_of_next_record == records.size() || records.at(index_of_next_record).num_bytes != num_bytes)
+                    throw std::runtime_error(msgstream() << "The checkpoint file '" << path_to_checkpoint_file
+                                                         << "' does not match its static state.");
+                record_of_array_of_units const&  record = records.at(index_of_next_record++);
+                return std::shared_ptr<natural_8_bit>(region, begin_of_file + record.offset_in_file);
+            };
+
+    std::shared_ptr<dynamic_state_of_neural_tissue> const  dynamic_state =
+            std::make_shared<dynamic_state_of_neural_tissue>(static_state, storage_of_units, buffering, memory_provider);
+
+    std::vector<array_of_bit_units const*> const  arrays = dynamic_state->get_arrays_of_units_in_order_of_allocation();
+    if (index_of_next_record != records.size() || arrays.size() != records.size())
+        throw std::runtime_error(msgstream() << "The checkpoint file '" << path_to_checkpoint_file
+                                             << "' does not match its static state.");
+    for (natural_32_bit i = 0U; i < arrays.size(); ++i)
+        if (arrays.at(i)->num_bits_per_unit() != records.at(i).num_bits_per_unit ||
+            arrays.at(i)->num_units() != records.at(i).num_units ||
+            (natural_8_bit)arrays.at(i)->are_units_aligned_to_bytes() != records.at(i).are_units_aligned_to_bytes)
+            throw std::runtime_error(msgstream() << "The checkpoint file '" << path_to_checkpoint_file
+                                                 << "' does not match its static state.");
+
+    LOG(debug,"Loaded the checkpoint of neural tissue from the file '" << path_to_checkpoint_file << "'.");
+
+    return dynamic_state;
+}
+
+
+}
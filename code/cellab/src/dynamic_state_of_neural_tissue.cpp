@@ -21,9 +21,14 @@ namespace cellab {
 
 
 dynamic_state_of_neural_tissue::dynamic_state_of_neural_tissue(
-        std::shared_ptr<static_state_of_neural_tissue const> const pointer_to_static_state_of_neural_tissue
+        std::shared_ptr<static_state_of_neural_tissue const> const pointer_to_static_state_of_neural_tissue,
+        storage_of_units_of_neural_tissue const storage_of_units,
+        buffering_of_cells_and_signalling const buffering,
+        memory_provider_for_array_of_bit_units const& memory_provider
         )
     : m_static_state_of_neural_tissue(pointer_to_static_state_of_neural_tissue)
+    , m_storage_of_units(storage_of_units)
+    , m_buffering(buffering)
     , m_num_bits_per_source_cell_coordinate(
           compute_byte_aligned_num_of_bits_to_store_number(
               std::max(m_static_state_of_neural_tissue->num_cells_along_x_axis(),
@@ -40,12 +45,20 @@ dynamic_state_of_neural_tissue::dynamic_state_of_neural_tissue(
     , m_slices_of_source_cell_coords_of_synapses(m_static_state_of_neural_tissue->num_kinds_of_tissue_cells())
     , m_slices_of_signalling_data(m_static_state_of_neural_tissue->num_kinds_of_tissue_cells())
     , m_slices_of_delimiters_between_territorial_lists(m_static_state_of_neural_tissue->num_kinds_of_tissue_cells())
+    , m_next_slices_of_cells()
+    , m_next_slices_of_signalling_data()
     , m_bits_of_sensory_cells(m_static_state_of_neural_tissue->num_bits_per_cell(),
-                              m_static_state_of_neural_tissue->num_sensory_cells())
+                              m_static_state_of_neural_tissue->num_sensory_cells(),
+                              m_storage_of_units == BYTE_ALIGNED_UNITS,
+                              memory_provider)
     , m_bits_of_synapses_to_muscles(m_static_state_of_neural_tissue->num_bits_per_synapse(),
-                                    m_static_state_of_neural_tissue->num_synapses_to_muscles())
+                                    m_static_state_of_neural_tissue->num_synapses_to_muscles(),
+                                    m_storage_of_units == BYTE_ALIGNED_UNITS,
+                              memory_provider)
     , m_bits_of_source_cell_coords_of_synapses_to_muscles(checked_mul_16_bit(3U,m_num_bits_per_source_cell_coordinate),
-                                                          m_static_state_of_neural_tissue->num_synapses_to_muscles())
+                                                          m_static_state_of_neural_tissue->num_synapses_to_muscles(),
+                                                          m_storage_of_units == BYTE_ALIGNED_UNITS,
+                              memory_provider)
 {
     for (kind_of_cell kind = 0U; kind < m_static_state_of_neural_tissue->num_kinds_of_tissue_cells(); ++kind)
     {
@@ -61,7 +74,9 @@ dynamic_state_of_neural_tissue::dynamic_state_of_neural_tissue(
                         m_static_state_of_neural_tissue->num_bits_per_cell(),
                         m_static_state_of_neural_tissue->num_cells_along_x_axis(),
                         m_static_state_of_neural_tissue->num_cells_along_y_axis(),
-                        m_static_state_of_neural_tissue->num_tissue_cells_of_cell_kind(kind)
+                        m_static_state_of_neural_tissue->num_tissue_cells_of_cell_kind(kind),
+                        m_storage_of_units == BYTE_ALIGNED_UNITS,
+                        memory_provider
                         )
                     );
         m_slices_of_synapses.at(kind) =
@@ -73,7 +88,9 @@ dynamic_state_of_neural_tissue::dynamic_state_of_neural_tissue(
                         checked_mul_64_bit(
                             m_static_state_of_neural_tissue->num_tissue_cells_of_cell_kind(kind),
                             m_static_state_of_neural_tissue->num_synapses_in_territory_of_cell_kind(kind)
-                            )
+                            ),
+                        m_storage_of_units == BYTE_ALIGNED_UNITS,
+                        memory_provider
                         )
                     );
         m_slices_of_territorial_states_of_synapses.at(kind) =
@@ -85,7 +102,9 @@ dynamic_state_of_neural_tissue::dynamic_state_of_neural_tissue(
                         checked_mul_64_bit(
                             m_static_state_of_neural_tissue->num_tissue_cells_of_cell_kind(kind),
                             m_static_state_of_neural_tissue->num_synapses_in_territory_of_cell_kind(kind)
-                            )
+                            ),
+                        m_storage_of_units == BYTE_ALIGNED_UNITS,
+                        memory_provider
                         )
                     );
         m_slices_of_source_cell_coords_of_synapses.at(kind) =
@@ -97,7 +116,9 @@ dynamic_state_of_neural_tissue::dynamic_state_of_neural_tissue(
                         checked_mul_64_bit(
                             m_static_state_of_neural_tissue->num_tissue_cells_of_cell_kind(kind),
                             m_static_state_of_neural_tissue->num_synapses_in_territory_of_cell_kind(kind)
-                            )
+                            ),
+                        m_storage_of_units == BYTE_ALIGNED_UNITS,
+                        memory_provider
                         )
                     );
         m_slices_of_signalling_data.at(kind) =
@@ -106,7 +127,9 @@ dynamic_state_of_neural_tissue::dynamic_state_of_neural_tissue(
                         m_static_state_of_neural_tissue->num_bits_per_signalling(),
                         m_static_state_of_neural_tissue->num_cells_along_x_axis(),
                         m_static_state_of_neural_tissue->num_cells_along_y_axis(),
-                        m_static_state_of_neural_tissue->num_tissue_cells_of_cell_kind(kind)
+                        m_static_state_of_neural_tissue->num_tissue_cells_of_cell_kind(kind),
+                        m_storage_of_units == BYTE_ALIGNED_UNITS,
+                        memory_provider
                         )
                     );
         m_slices_of_delimiters_between_territorial_lists.at(kind) =
@@ -115,9 +138,38 @@ dynamic_state_of_neural_tissue::dynamic_state_of_neural_tissue(
                         checked_mul_16_bit(num_delimiters(),m_num_bits_per_delimiter_number.at(kind)),
                         m_static_state_of_neural_tissue->num_cells_along_x_axis(),
                         m_static_state_of_neural_tissue->num_cells_along_y_axis(),
-                        m_static_state_of_neural_tissue->num_tissue_cells_of_cell_kind(kind)
+                        m_static_state_of_neural_tissue->num_tissue_cells_of_cell_kind(kind),
+                        m_storage_of_units == BYTE_ALIGNED_UNITS,
+                        memory_provider
+                        )
+                    );
+        if (m_buffering == DOUBLE_BUFFERED_CELLS_AND_SIGNALLING)
+        {
+            m_next_slices_of_cells.push_back(
+                    pointer_to_homogenous_slice_of_tissue(
+                        new homogenous_slice_of_tissue(
+                            m_static_state_of_neural_tissue->num_bits_per_cell(),
+                            m_static_state_of_neural_tissue->num_cells_along_x_axis(),
+                            m_static_state_of_neural_tissue->num_cells_along_y_axis(),
+                            m_static_state_of_neural_tissue->num_tissue_cells_of_cell_kind(kind),
+                            m_storage_of_units == BYTE_ALIGNED_UNITS,
+                            memory_provider
+                            )
+                        )
+                    );
+            m_next_slices_of_signalling_data.push_back(
+                    pointer_to_homogenous_slice_of_tissue(
+                        new homogenous_slice_of_tissue(
+                            m_static_state_of_neural_tissue->num_bits_per_signalling(),
+                            m_static_state_of_neural_tissue->num_cells_along_x_axis(),
+                            m_static_state_of_neural_tissue->num_cells_along_y_axis(),
+                            m_static_state_of_neural_tissue->num_tissue_cells_of_cell_kind(kind),
+                            m_storage_of_units == BYTE_ALIGNED_UNITS,
+                            memory_provider
+                            )
                         )
                     );
+        }
     }
 
     LOG(debug,FUNCTION_PROTOTYPE());
@@ -134,6 +186,16 @@ dynamic_state_of_neural_tissue::get_static_state_of_neural_tissue() const
     return m_static_state_of_neural_tissue;
 }
 
+storage_of_units_of_neural_tissue  dynamic_state_of_neural_tissue::get_storage_of_units() const
+{
+    return m_storage_of_units;
+}
+
+buffering_of_cells_and_signalling  dynamic_state_of_neural_tissue::get_buffering_of_cells_and_signalling() const
+{
+    return m_buffering;
+}
+
 bits_reference  dynamic_state_of_neural_tissue::find_bits_of_cell(
         natural_32_bit const coord_along_x_axis,
         natural_32_bit const coord_along_y_axis,
@@ -289,6 +351,57 @@ bits_reference  dynamic_state_of_neural_tissue::find_bits_of_signalling(
                 );
 }
 
+bits_reference  dynamic_state_of_neural_tissue::find_bits_of_next_cell_in_tissue(
+        natural_32_bit const coord_along_x_axis,
+        natural_32_bit const coord_along_y_axis,
+        natural_32_bit const coord_along_columnar_axis
+        )
+{
+    ASSUMPTION(m_buffering == DOUBLE_BUFFERED_CELLS_AND_SIGNALLING);
+    ASSUMPTION(coord_along_x_axis < get_static_state_of_neural_tissue()->num_cells_along_x_axis());
+    ASSUMPTION(coord_along_y_axis < get_static_state_of_neural_tissue()->num_cells_along_y_axis());
+    ASSUMPTION(coord_along_columnar_axis < get_static_state_of_neural_tissue()->num_cells_along_columnar_axis());
+    std::pair<kind_of_cell,natural_32_bit> const kind_and_index =
+        get_static_state_of_neural_tissue()->
+            compute_kind_of_cell_and_relative_columnar_index_from_coordinate_along_columnar_axis(
+                coord_along_columnar_axis
+                );
+    return m_next_slices_of_cells.at(kind_and_index.first)->find_bits_of_unit(
+                coord_along_x_axis,
+                coord_along_y_axis,
+                kind_and_index.second
+                );
+}
+
+bits_reference  dynamic_state_of_neural_tissue::find_bits_of_next_signalling(
+        natural_32_bit const coord_to_cell_along_x_axis,
+        natural_32_bit const coord_to_cell_along_y_axis,
+        natural_32_bit const coord_to_cell_along_columnar_axis
+        )
+{
+    ASSUMPTION(m_buffering == DOUBLE_BUFFERED_CELLS_AND_SIGNALLING);
+    ASSUMPTION(coord_to_cell_along_x_axis < get_static_state_of_neural_tissue()->num_cells_along_x_axis());
+    ASSUMPTION(coord_to_cell_along_y_axis < get_static_state_of_neural_tissue()->num_cells_along_y_axis());
+    ASSUMPTION(coord_to_cell_along_columnar_axis < get_static_state_of_neural_tissue()->num_cells_along_columnar_axis());
+    std::pair<kind_of_cell,natural_32_bit> const kind_and_index =
+        get_static_state_of_neural_tissue()->
+            compute_kind_of_cell_and_relative_columnar_index_from_coordinate_along_columnar_axis(
+                coord_to_cell_along_columnar_axis
+                );
+    return m_next_slices_of_signalling_data.at(kind_and_index.first)->find_bits_of_unit(
+                coord_to_cell_along_x_axis,
+                coord_to_cell_along_y_axis,
+                kind_and_index.second
+                );
+}
+
+void  dynamic_state_of_neural_tissue::swap_current_and_next_buffers()
+{
+    ASSUMPTION(m_buffering == DOUBLE_BUFFERED_CELLS_AND_SIGNALLING);
+    m_slices_of_cells.swap(m_next_slices_of_cells);
+    m_slices_of_signalling_data.swap(m_next_slices_of_signalling_data);
+}
+
 bits_reference  dynamic_state_of_neural_tissue::find_bits_of_delimiter_between_territorial_lists(
         natural_32_bit const coord_to_cell_along_x_axis,
         natural_32_bit const coord_to_cell_along_y_axis,
@@ -359,6 +472,30 @@ natural_8_bit  dynamic_state_of_neural_tissue::num_bits_per_delimiter_number(kin
     return m_num_bits_per_delimiter_number.at(kind_of_tissue_cell);
 }
 
+std::vector<array_of_bit_units const*>  dynamic_state_of_neural_tissue::get_arrays_of_units_in_order_of_allocation() const
+{
+    std::vector<array_of_bit_units const*>  arrays = {
+            &m_bits_of_sensory_cells,
+            &m_bits_of_synapses_to_muscles,
+            &m_bits_of_source_cell_coords_of_synapses_to_muscles
+            };
+    for (kind_of_cell kind = 0U; kind < m_static_state_of_neural_tissue->num_kinds_of_tissue_cells(); ++kind)
+    {
+        arrays.push_back(&m_slices_of_cells.at(kind)->get_array_of_units());
+        arrays.push_back(&m_slices_of_synapses.at(kind)->get_array_of_units());
+        arrays.push_back(&m_slices_of_territorial_states_of_synapses.at(kind)->get_array_of_units());
+        arrays.push_back(&m_slices_of_source_cell_coords_of_synapses.at(kind)->get_array_of_units());
+        arrays.push_back(&m_slices_of_signalling_data.at(kind)->get_array_of_units());
+        arrays.push_back(&m_slices_of_delimiters_between_territorial_lists.at(kind)->get_array_of_units());
+        if (m_buffering == DOUBLE_BUFFERED_CELLS_AND_SIGNALLING)
+        {
+            arrays.push_back(&m_next_slices_of_cells.at(kind)->get_array_of_units());
+            arrays.push_back(&m_next_slices_of_signalling_data.at(kind)->get_array_of_units());
+        }
+    }
+    return arrays;
+}
+
 
 natural_16_bit num_of_bits_to_store_territorial_state_of_synapse()
 {
@@ -21,7 +21,9 @@ namespace cellab {
 homogenous_slice_of_tissue::homogenous_slice_of_tissue(natural_16_bit const num_bits_per_unit,
                                                        natural_32_bit const num_units_along_x_axis,
                                                        natural_32_bit const num_units_along_y_axis,
-                                                       natural_64_bit const num_units_along_columnar_axis)
+                                                       natural_64_bit const num_units_along_columnar_axis,
+                                                       bool const align_units_to_bytes,
+                                                       memory_provider_for_array_of_bit_units const& memory_provider)
     : m_num_units_along_x_axis(num_units_along_x_axis)
     , m_num_units_along_y_axis(num_units_along_y_axis)
     , m_num_units_along_columnar_axis(num_units_along_columnar_axis)
@@ -29,7 +31,9 @@ homogenous_slice_of_tissue::homogenous_slice_of_tissue(natural_16_bit const num_
                        compute_num_units_in_slice_of_tissue_with_checked_operations(
                                 m_num_units_along_x_axis,
                                 m_num_units_along_y_axis,
-                                m_num_units_along_columnar_axis))
+                                m_num_units_along_columnar_axis),
+                       align_units_to_bytes,
+                       memory_provider)
 {
     ASSUMPTION(num_bits_per_unit > 0U);
     ASSUMPTION(m_num_units_along_x_axis > 0U);
@@ -79,6 +83,16 @@ natural_64_bit homogenous_slice_of_tissue::num_units_along_columnar_axis() const
     return m_num_units_along_columnar_axis;
 }
 
+bool homogenous_slice_of_tissue::are_units_aligned_to_bytes() const
+{
+    return m_array_of_units.are_units_aligned_to_bytes();
+}
+
+array_of_bit_units const& homogenous_slice_of_tissue::get_array_of_units() const
+{
+    return m_array_of_units;
+}
+
 
 natural_64_bit compute_num_bits_of_slice_of_tissue_with_checked_operations(
         natural_16_bit const num_bits_per_unit,
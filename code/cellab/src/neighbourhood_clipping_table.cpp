@@ -0,0 +1,128 @@
+#include <cellab/neighbourhood_clipping_table.hpp>
+#include <cellab/static_state_of_neural_tissue.hpp>
+#include <utility/assumptions.hpp>
+#include <utility/invariants.hpp>
+#include <algorithm>
+
+namespace cellab {
+
+
+neighbourhood_clipping_table::clipping_along_axis::clipping_along_axis(
+        integer_8_bit const radius,
+        natural_32_bit const length_of_axis,
+        bool const is_it_torus_axis
+        )
+    : m_radius(radius)
+    , m_last_coord(length_of_axis - 1U)
+    , m_shifts_at_low_boundary()
+    , m_shifts_at_high_boundary()
+{
+    ASSUMPTION(radius >= 0 && length_of_axis > 0U);
+    if (is_it_torus_axis)
+        return;
+    natural_32_bit const num_boundary_cells = std::min((natural_32_bit)radius,length_of_axis);
+    m_shifts_at_low_boundary.reserve(num_boundary_cells);
+    m_shifts_at_high_boundary.reserve(num_boundary_cells);
+    for (natural_32_bit i = 0U; i < num_boundary_cells; ++i)
+    {
+        // Both values are the same as those computed by the function 'clip_shift' (see the
+        // header 'utilities_for_transition_algorithms.hpp') for a non-torus axis.
+        m_shifts_at_low_boundary.push_back(-(integer_8_bit)i);
+        m_shifts_at_high_boundary.push_back((integer_8_bit)i);
+    }
+}
+
+
+neighbourhood_clipping_table::neighbourhood_clipping_table(
+        static_state_of_neural_tissue const& static_state_of_tissue
+        )
+    : m_kinds_of_tissue_cells_along_columnar_axis()
+    , m_along_x_axis()
+    , m_along_y_axis()
+    , m_along_columnar_axis()
+{
+    natural_32_bit const num_cells_along_columnar_axis = static_state_of_tissue.num_cells_along_columnar_axis();
+
+    m_kinds_of_tissue_cells_along_columnar_axis.reserve(num_cells_along_columnar_axis);
+    for (kind_of_cell cell_kind = 0U; cell_kind < static_state_of_tissue.num_kinds_of_tissue_cells(); ++cell_kind)
+        m_kinds_of_tissue_cells_along_columnar_axis.resize(
+                m_kinds_of_tissue_cells_along_columnar_axis.size() +
+                        static_state_of_tissue.num_tissue_cells_of_cell_kind(cell_kind),
+                cell_kind
+                );
+    INVARIANT(m_kinds_of_tissue_cells_along_columnar_axis.size() == num_cells_along_columnar_axis);
+
+    for (natural_32_bit i = 0U; i < num_kinds_of_neighbourhoods; ++i)
+    {
+        kind_of_neighbourhood const neighbourhood_kind = static_cast<kind_of_neighbourhood>(i);
+
+        struct local
+        {
+            static void  get_radii(
+                    static_state_of_neural_tissue const& static_state_of_tissue,
+                    kind_of_neighbourhood const neighbourhood_kind,
+                    kind_of_cell const cell_kind,
+                    integer_8_bit& x_radius,
+                    integer_8_bit& y_radius,
+                    integer_8_bit& columnar_radius
+                    )
+            {
+                switch (neighbourhood_kind)
+                {
+                case SIGNALLING_NEIGHBOURHOOD_OF_CELL:
+                    x_radius = static_state_of_tissue.get_x_radius_of_signalling_neighbourhood_of_cell(cell_kind);
+                    y_radius = static_state_of_tissue.get_y_radius_of_signalling_neighbourhood_of_cell(cell_kind);
+                    columnar_radius = static_state_of_tissue.get_columnar_radius_of_signalling_neighbourhood_of_cell(cell_kind);
+                    break;
+                case SIGNALLING_NEIGHBOURHOOD_OF_SYNAPSE:
+                    x_radius = static_state_of_tissue.get_x_radius_of_signalling_neighbourhood_of_synapse(cell_kind);
+                    y_radius = static_state_of_tissue.get_y_radius_of_signalling_neighbourhood_of_synapse(cell_kind);
+                    columnar_radius = static_state_of_tissue.get_columnar_radius_of_signalling_neighbourhood_of_synapse(cell_kind);
+                    break;
+                case CELLULAR_NEIGHBOURHOOD_OF_SIGNALLING:
+                    x_radius = static_state_of_tissue.get_x_radius_of_cellular_neighbourhood_of_signalling(cell_kind);
+                    y_radius = static_state_of_tissue.get_y_radius_of_cellular_neighbourhood_of_signalling(cell_kind);
+                    columnar_radius = static_state_of_tissue.get_columnar_radius_of_cellular_neighbourhood_of_signalling(cell_kind);
+                    break;
+                default:
+                    UNREACHABLE();
+                }
+            }
+        };
+
+        for (kind_of_cell cell_kind = 0U; cell_kind < static_state_of_tissue.num_kinds_of_tissue_cells(); ++cell_kind)
+        {
+            integer_8_bit x_radius, y_radius, columnar_radius;
+            local::get_radii(static_state_of_tissue,neighbourhood_kind,cell_kind,x_radius,y_radius,columnar_radius);
+            m_along_x_axis[i].push_back(clipping_along_axis(
+                    x_radius,
+                    static_state_of_tissue.num_cells_along_x_axis(),
+                    static_state_of_tissue.is_x_axis_torus_axis()
+                    ));
+            m_along_y_axis[i].push_back(clipping_along_axis(
+                    y_radius,
+                    static_state_of_tissue.num_cells_along_y_axis(),
+                    static_state_of_tissue.is_y_axis_torus_axis()
+                    ));
+        }
+
+        m_along_columnar_axis[i].reserve(num_cells_along_columnar_axis);
+        for (natural_32_bit c = 0U; c < num_cells_along_columnar_axis; ++c)
+        {
+            integer_8_bit x_radius, y_radius, columnar_radius;
+            local::get_radii(static_state_of_tissue,neighbourhood_kind,m_kinds_of_tissue_cells_along_columnar_axis[c],
+                             x_radius,y_radius,columnar_radius);
+            clipping_along_axis const clipping(
+                    columnar_radius,
+                    num_cells_along_columnar_axis,
+                    static_state_of_tissue.is_columnar_axis_torus_axis()
+                    );
+            m_along_columnar_axis[i].push_back(
+                    std::make_pair(clipping.get_shift_to_low_end(c),clipping.get_shift_to_high_end(c))
+                    );
+        }
+    }
+}
+
+
+}
@@ -24,6 +24,7 @@ neural_tissue::neural_tissue(
     , m_hash_code_of_class_for_cells(typeid(bits_reference).hash_code())
     , m_hash_code_of_class_for_synapses(typeid(bits_reference).hash_code())
     , m_hash_code_of_class_for_signalling(typeid(bits_reference).hash_code())
+    , m_thread_pool()
 {
     ASSUMPTION(m_dynamic_state_of_tissue.operator bool());
 }
@@ -40,6 +41,24 @@ neural_tissue::get_dynamic_state_of_neural_tissue()
     return m_dynamic_state_of_tissue;
 }
 
+std::shared_ptr<thread_pool>  neural_tissue::get_thread_pool() const
+{
+    return m_thread_pool;
+}
+
+void  neural_tissue::set_thread_pool(std::shared_ptr<thread_pool> const  pool)
+{
+    m_thread_pool = pool;
+}
+
+thread_pool&  neural_tissue::get_thread_pool_for(natural_32_bit const  num_threads_avalilable_for_computation)
+{
+    ASSUMPTION(num_threads_avalilable_for_computation > 0U);
+    if (!m_thread_pool || m_thread_pool->num_workers() + 1U < num_threads_avalilable_for_computation)
+        m_thread_pool = std::make_shared<thread_pool>(num_threads_avalilable_for_computation - 1U);
+    return *m_thread_pool;
+}
+
 void  neural_tissue::apply_transition_of_synapses_to_muscles(
         natural_32_bit const  num_threads_avalilable_for_computation
         )
@@ -47,7 +66,8 @@ void  neural_tissue::apply_transition_of_synapses_to_muscles(
     cellab::apply_transition_of_synapses_to_muscles(
                 get_dynamic_state_of_neural_tissue(),
                 m_transition_function_of_packed_synapse_to_muscle,
-                num_threads_avalilable_for_computation
+                num_threads_avalilable_for_computation,
+                get_thread_pool_for(num_threads_avalilable_for_computation)
                 );
 }
 
@@ -58,7 +78,8 @@ void  neural_tissue::apply_transition_of_synapses_of_tissue(
     cellab::apply_transition_of_synapses_of_tissue(
                 get_dynamic_state_of_neural_tissue(),
                 m_transition_function_of_packed_synapse_inside_tissue,
-                num_threads_avalilable_for_computation
+                num_threads_avalilable_for_computation,
+                get_thread_pool_for(num_threads_avalilable_for_computation)
                 );
 }
 
@@ -68,7 +89,8 @@ void  neural_tissue::apply_transition_of_territorial_lists_of_synapses(
 {
     cellab::apply_transition_of_territorial_lists_of_synapses(
                 get_dynamic_state_of_neural_tissue(),
-                num_threads_avalilable_for_computation
+                num_threads_avalilable_for_computation,
+                get_thread_pool_for(num_threads_avalilable_for_computation)
                 );
 }
 
@@ -78,7 +100,8 @@ void  neural_tissue::apply_transition_of_synaptic_migration_in_tissue(
 {
     cellab::apply_transition_of_synaptic_migration_in_tissue(
                 get_dynamic_state_of_neural_tissue(),
-                num_threads_avalilable_for_computation
+                num_threads_avalilable_for_computation,
+                get_thread_pool_for(num_threads_avalilable_for_computation)
                 );
 }
 
@@ -89,7 +112,8 @@ void  neural_tissue::apply_transition_of_signalling_in_tissue(
     cellab::apply_transition_of_signalling_in_tissue(
                 get_dynamic_state_of_neural_tissue(),
                 m_transition_function_of_packed_signalling,
-                num_threads_avalilable_for_computation
+                num_threads_avalilable_for_computation,
+                get_thread_pool_for(num_threads_avalilable_for_computation)
                 );
 }
 
@@ -100,7 +124,8 @@ void  neural_tissue::apply_transition_of_cells_of_tissue(
     cellab::apply_transition_of_cells_of_tissue(
                 get_dynamic_state_of_neural_tissue(),
                 m_transition_function_of_packed_cell,
-                num_threads_avalilable_for_computation
+                num_threads_avalilable_for_computation,
+                get_thread_pool_for(num_threads_avalilable_for_computation)
                 );
 }
 
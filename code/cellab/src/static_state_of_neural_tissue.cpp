@@ -1,4 +1,5 @@
 #include <cellab/static_state_of_neural_tissue.hpp>
+#include <cellab/neighbourhood_clipping_table.hpp>
 #include <utility/checked_number_operations.hpp>
 #include <utility/assumptions.hpp>
 #include <utility/invariants.hpp>
@@ -129,6 +130,7 @@ static_state_of_neural_tissue::static_state_of_neural_tissue(
     , m_x_radius_of_cellular_neighbourhood_of_signalling(x_radius_of_cellular_neighbourhood_of_signalling)
     , m_y_radius_of_cellular_neighbourhood_of_signalling(y_radius_of_cellular_neighbourhood_of_signalling)
     , m_columnar_radius_of_cellular_neighbourhood_of_signalling(columnar_radius_of_cellular_neighbourhood_of_signalling)
+    , m_neighbourhood_clipping_table()
 {
     ASSUMPTION(m_num_kinds_of_tissue_cells > 0U);
     ASSUMPTION(m_num_kinds_of_cells < std::numeric_limits<natural_16_bit>::max());
@@ -218,6 +220,8 @@ static_state_of_neural_tissue::static_state_of_neural_tissue(
     ASSUMPTION(m_num_kinds_of_tissue_cells == m_columnar_radius_of_cellular_neighbourhood_of_signalling.size());
     ASSUMPTION( local::check_radii(m_columnar_radius_of_cellular_neighbourhood_of_signalling,m_num_cells_along_columnar_axis) );
 
+    m_neighbourhood_clipping_table.reset(new neighbourhood_clipping_table(*this));
+
     // The following code computes not only a number of bits which will be taken to store dynamic state of
     // the neural tissue, but is also check for wrap error for unsigned integers which could
     // otherwise occure later when computing addresses of bits of individual element of the tissue in
@@ -346,6 +350,8 @@ natural_32_bit  static_state_of_neural_tissue::num_synapses_to_muscles() const
 kind_of_cell  static_state_of_neural_tissue::compute_kind_of_cell_from_its_position_along_columnar_axis(
             natural_32_bit position_of_cell_in_column) const
 {
+    if (position_of_cell_in_column < num_cells_along_columnar_axis() && m_neighbourhood_clipping_table)
+        return m_neighbourhood_clipping_table->get_kind_of_tissue_cell(position_of_cell_in_column);
     return compute_kind_of_cell_and_relative_columnar_index_from_coordinate_along_columnar_axis(
                 position_of_cell_in_column).first;
 }
@@ -562,5 +568,11 @@ natural_64_bit  num_synapses_in_all_columns(
            num_synapses_in_any_column(static_tissue_ptr) ;
 }
 
+neighbourhood_clipping_table const&  static_state_of_neural_tissue::get_neighbourhood_clipping_table() const
+{
+    INVARIANT(m_neighbourhood_clipping_table.operator bool());
+    return *m_neighbourhood_clipping_table;
+}
+
 
 }
@@ -1,3 +1,4 @@
+#include <cellab/transition_algorithms.hpp>
 #include <cellab/static_state_of_neural_tissue.hpp>
 #include <cellab/dynamic_state_of_neural_tissue.hpp>
 #include <cellab/territorial_state_of_synapse.hpp>
@@ -6,23 +7,25 @@
 #include <utility/basic_numeric_types.hpp>
 #include <utility/bits_reference.hpp>
 #include <utility/random.hpp>
+#include <utility/thread_pool.hpp>
 #include <utility/assumptions.hpp>
 #include <utility/invariants.hpp>
 #include <memory>
 #include <vector>
-#include <thread>
+#include <algorithm>
 
 namespace cellab {
 
 
 static void  exchange_all_data_of_synapses_between_territorial_lists_of_cells_at_given_coordinates(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
         tissue_coordinates const& coordinates_of_first_cell,
         natural_32_bit const begin_index_of_first_list,
         natural_32_bit const end_index_of_first_list,
         tissue_coordinates const& coordinates_of_second_cell,
         natural_32_bit const begin_index_of_second_list,
-        natural_32_bit const num_synapses_to_be_exchanged
+        natural_32_bit const num_synapses_to_be_exchanged,
+        counter_based_random_generator&  generator
         )
 {
     if (num_synapses_to_be_exchanged == 0U)
@@ -32,7 +35,8 @@ static void  exchange_all_data_of_synapses_between_territorial_lists_of_cells_at
     natural_32_bit index_of_current_synapse_in_first_list =
             get_random_natural_32_bit_in_range(
                 begin_index_of_first_list,
-                end_index_of_first_list - 1U
+                end_index_of_first_list - 1U,
+                generator
                 );
     for (natural_32_bit i = 0U; i < num_synapses_to_be_exchanged; ++i)
     {
@@ -51,12 +55,13 @@ static void  exchange_all_data_of_synapses_between_territorial_lists_of_cells_at
 }
 
 static void  exchange_synapses_between_territorial_lists_of_cells_at_given_coordinates(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
-        std::shared_ptr<static_state_of_neural_tissue const> const static_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
         tissue_coordinates const& coordinates_of_first_cell,
         natural_8_bit const list_index_in_first_cell,
         tissue_coordinates const& coordinates_of_second_cell,
-        natural_8_bit const list_index_in_second_cell
+        natural_8_bit const list_index_in_second_cell,
+        counter_based_random_generator&  generator
         )
 {
     if (coordinates_of_first_cell == coordinates_of_second_cell)
@@ -101,7 +106,8 @@ static void  exchange_synapses_between_territorial_lists_of_cells_at_given_coord
                 end_index_of_first_list,
                 coordinates_of_second_cell,
                 begin_index_of_second_list,
-                end_index_of_second_list - begin_index_of_second_list
+                end_index_of_second_list - begin_index_of_second_list,
+                generator
                 );
     else
         exchange_all_data_of_synapses_between_territorial_lists_of_cells_at_given_coordinates(
@@ -111,67 +117,152 @@ static void  exchange_synapses_between_territorial_lists_of_cells_at_given_coord
                 end_index_of_second_list,
                 coordinates_of_first_cell,
                 begin_index_of_first_list,
-                end_index_of_first_list - begin_index_of_first_list
+                end_index_of_first_list - begin_index_of_first_list,
+                generator
                 );
 }
 
-static void  thread_exchange_synapses_between_territorial_lists_of_all_cells(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
-        std::shared_ptr<static_state_of_neural_tissue const> const static_state_of_tissue,
+/**
+ * Two cells processed concurrently must never touch the same territory (even different lists of
+ * the same territory may share bytes in the memory). A pivot cell at a coordinate k along the axis
+ * of migration touches territories at k and k+1 only. So, if we colour cells along the axis by
+ * k mod 2, then pivot cells of the same colour touch disjoint pairs of territories. The only
+ * exception is the last cell of an odd-length torus axis, which touches the first cell (of the
+ * same colour 0). It thus receives its own third colour.
+ */
+static natural_32_bit  num_colours_of_cells_along_axis_of_migration(
+        natural_32_bit const length_of_axis,
+        bool const is_it_torus_axis
+        )
+{
+    return is_it_torus_axis && length_of_axis > 1U && length_of_axis % 2U == 1U ? 3U : 2U;
+}
+
+static natural_32_bit  colour_of_cell_along_axis_of_migration(
+        natural_32_bit const coord,
+        natural_32_bit const length_of_axis,
+        bool const is_it_torus_axis
+        )
+{
+    if (coord + 1U == length_of_axis &&
+            num_colours_of_cells_along_axis_of_migration(length_of_axis,is_it_torus_axis) == 3U)
+        return 2U;
+    return coord % 2U;
+}
+
+/**
+ * Pivot cells processed concurrently must also never write territories sharing a byte in the memory
+ * (units of slices are bit-packed, so neighbouring territories in a slice may share bytes). Units of
+ * a slice are stored row by row along the y axis, so a block of consecutive rows occupies a contiguous
+ * range of memory in each slice (unlike a tile smaller than a column, which may have no units at all
+ * in slices of some kinds). Cells are thus distributed to threads in blocks of rows, and blocks are
+ * coloured by their index in the same way as cells along the axis of migration. A pivot of a block
+ * writes only territories of the block, except for the migration along the y axis, when it also writes
+ * the first row of the next block (of the first block for the torus axis). So, if each block has at
+ * least one more row than is needed for 8 columns (each column has at least one unit of at least one
+ * bit in each slice), then territories written by concurrently processed blocks (of the same colour)
+ * are always at least 8 bits apart, i.e. they never share a byte.
+ */
+static natural_32_bit  num_rows_in_block_of_tissue(
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+        natural_32_bit const num_threads
+        )
+{
+    natural_64_bit const num_cells_in_row =
+            (natural_64_bit)static_state_of_tissue->num_cells_along_x_axis() *
+            (natural_64_bit)static_state_of_tissue->num_cells_along_columnar_axis();
+    natural_32_bit const num_rows = static_state_of_tissue->num_cells_along_y_axis();
+
+    natural_32_bit const min_num_rows_in_block =
+            1U + (8U + static_state_of_tissue->num_cells_along_x_axis() - 1U) / static_state_of_tissue->num_cells_along_x_axis();
+    natural_32_bit const num_rows_in_tile =
+            (natural_32_bit)((compute_num_cells_in_tile_of_tissue(static_state_of_tissue,num_threads) + num_cells_in_row - 1ULL) /
+                             num_cells_in_row);
+    natural_32_bit const num_rows_per_thread_and_colour = std::max(1U, num_rows / (2U * num_threads));
+
+    return std::max(min_num_rows_in_block, std::min(num_rows_in_tile, num_rows_per_thread_and_colour));
+}
+
+static void  thread_exchange_synapses_between_territorial_lists_of_cells_in_block(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
         natural_8_bit const list_index_in_pivot_cells,
         shift_in_coordinates const& shift,
         natural_8_bit const list_index_in_shift_cells,
-        natural_32_bit x_coord,
-        natural_32_bit y_coord,
-        natural_32_bit c_coord,
-        natural_32_bit const extent_in_coordinates
+        natural_32_bit const colour,
+        natural_32_bit const seed_of_random_generators,
+        natural_32_bit const begin_y_coord,
+        natural_32_bit const end_y_coord
         )
 {
-    do
-    {
-        exchange_synapses_between_territorial_lists_of_cells_at_given_coordinates(
-                    dynamic_state_of_tissue,
-                    static_state_of_tissue,
-                    tissue_coordinates(x_coord,y_coord,c_coord),
-                    list_index_in_pivot_cells,
-                    shift_coordinates(
-                            tissue_coordinates(x_coord,y_coord,c_coord),
-                            shift_in_coordinates(
-                                clip_shift(shift.get_shift_along_x_axis(),x_coord,
-                                           static_state_of_tissue->num_cells_along_x_axis(),
-                                           static_state_of_tissue->is_x_axis_torus_axis()),
-                                clip_shift(shift.get_shift_along_y_axis(),y_coord,
-                                           static_state_of_tissue->num_cells_along_y_axis(),
-                                           static_state_of_tissue->is_y_axis_torus_axis()),
-                                clip_shift(shift.get_shift_along_columnar_axis(),c_coord,
-                                           static_state_of_tissue->num_cells_along_columnar_axis(),
-                                           static_state_of_tissue->is_columnar_axis_torus_axis())
-                                ),
-                            static_state_of_tissue->num_cells_along_x_axis(),
-                            static_state_of_tissue->num_cells_along_y_axis(),
-                            static_state_of_tissue->num_cells_along_columnar_axis()
-                            ),
-                    list_index_in_shift_cells
-                    );
+    natural_32_bit const axis_of_migration =
+            shift.get_shift_along_x_axis() != 0 ? 0U : shift.get_shift_along_y_axis() != 0 ? 1U : 2U;
+    natural_32_bit const length_of_axis_of_migration =
+            axis_of_migration == 0U ? static_state_of_tissue->num_cells_along_x_axis() :
+            axis_of_migration == 1U ? static_state_of_tissue->num_cells_along_y_axis() :
+                                      static_state_of_tissue->num_cells_along_columnar_axis() ;
+    bool const is_axis_of_migration_torus_axis =
+            axis_of_migration == 0U ? static_state_of_tissue->is_x_axis_torus_axis() :
+            axis_of_migration == 1U ? static_state_of_tissue->is_y_axis_torus_axis() :
+                                      static_state_of_tissue->is_columnar_axis_torus_axis() ;
 
-    }
-    while (go_to_next_coordinates(
-               x_coord,y_coord,c_coord,
-               extent_in_coordinates,
-               static_state_of_tissue->num_cells_along_x_axis(),
-               static_state_of_tissue->num_cells_along_y_axis(),
-               static_state_of_tissue->num_cells_along_columnar_axis()
-               ));
+    for (natural_32_bit y_coord = begin_y_coord; y_coord < end_y_coord; ++y_coord)
+        for (natural_32_bit x_coord = 0U; x_coord < static_state_of_tissue->num_cells_along_x_axis(); ++x_coord)
+            for (natural_32_bit c_coord = 0U; c_coord < static_state_of_tissue->num_cells_along_columnar_axis(); ++c_coord)
+            {
+                natural_32_bit const coord_along_axis_of_migration =
+                        axis_of_migration == 0U ? x_coord : axis_of_migration == 1U ? y_coord : c_coord;
+                if (colour != colour_of_cell_along_axis_of_migration(coord_along_axis_of_migration,
+                                                                     length_of_axis_of_migration,
+                                                                     is_axis_of_migration_torus_axis))
+                    continue;
 
+                // The stream of random numbers is keyed by the pivot cell (and the axis), not by the thread.
+                // So, the result does not depend on the number of threads nor on the blocks of the tissue.
+                counter_based_random_generator  generator(
+                        seed_of_random_generators,
+                        axis_of_migration,
+                        ((natural_64_bit)y_coord * static_state_of_tissue->num_cells_along_x_axis() + x_coord)
+                            * static_state_of_tissue->num_cells_along_columnar_axis() + c_coord
+                        );
+
+                exchange_synapses_between_territorial_lists_of_cells_at_given_coordinates(
+                            dynamic_state_of_tissue,
+                            static_state_of_tissue,
+                            tissue_coordinates(x_coord,y_coord,c_coord),
+                            list_index_in_pivot_cells,
+                            shift_coordinates(
+                                    tissue_coordinates(x_coord,y_coord,c_coord),
+                                    shift_in_coordinates(
+                                        clip_shift(shift.get_shift_along_x_axis(),x_coord,
+                                                   static_state_of_tissue->num_cells_along_x_axis(),
+                                                   static_state_of_tissue->is_x_axis_torus_axis()),
+                                        clip_shift(shift.get_shift_along_y_axis(),y_coord,
+                                                   static_state_of_tissue->num_cells_along_y_axis(),
+                                                   static_state_of_tissue->is_y_axis_torus_axis()),
+                                        clip_shift(shift.get_shift_along_columnar_axis(),c_coord,
+                                                   static_state_of_tissue->num_cells_along_columnar_axis(),
+                                                   static_state_of_tissue->is_columnar_axis_torus_axis())
+                                        ),
+                                    static_state_of_tissue->num_cells_along_x_axis(),
+                                    static_state_of_tissue->num_cells_along_y_axis(),
+                                    static_state_of_tissue->num_cells_along_columnar_axis()
+                                    ),
+                            list_index_in_shift_cells,
+                            generator
+                            );
+            }
 }
 
 static void  exchange_synapses_between_territorial_lists_of_all_cells(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
-        std::shared_ptr<static_state_of_neural_tissue const> const static_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
         natural_8_bit const list_index_in_pivot_cells,
         shift_in_coordinates const& shift,
         natural_8_bit const list_index_in_shift_cells,
-        natural_32_bit const  num_threads_avalilable_for_computation
+        natural_32_bit const  seed_of_random_generators,
+        natural_32_bit const  num_threads_avalilable_for_computation,
+        thread_pool&  pool
         )
 {
     ASSUMPTION(list_index_in_pivot_cells == 1U ||
@@ -179,54 +270,93 @@ static void  exchange_synapses_between_territorial_lists_of_all_cells(
                list_index_in_pivot_cells == 5U);
     ASSUMPTION(list_index_in_shift_cells == list_index_in_pivot_cells + 1U);
 
-    std::vector<std::thread> threads;
-    for (natural_32_bit i = 1U; i < num_threads_avalilable_for_computation; ++i)
-    {
-        natural_32_bit x_coord = 0U;
-        natural_32_bit y_coord = 0U;
-        natural_32_bit c_coord = 0U;
-        if (!go_to_next_coordinates(
-                    x_coord,y_coord,c_coord,
-                    i,
-                    static_state_of_tissue->num_cells_along_x_axis(),
-                    static_state_of_tissue->num_cells_along_y_axis(),
-                    static_state_of_tissue->num_cells_along_columnar_axis()
-                    ))
-            break;
+    natural_32_bit const  num_colours =
+            shift.get_shift_along_x_axis() != 0 ?
+                num_colours_of_cells_along_axis_of_migration(static_state_of_tissue->num_cells_along_x_axis(),
+                                                             static_state_of_tissue->is_x_axis_torus_axis()) :
+            shift.get_shift_along_y_axis() != 0 ?
+                num_colours_of_cells_along_axis_of_migration(static_state_of_tissue->num_cells_along_y_axis(),
+                                                             static_state_of_tissue->is_y_axis_torus_axis()) :
+                num_colours_of_cells_along_axis_of_migration(static_state_of_tissue->num_cells_along_columnar_axis(),
+                                                             static_state_of_tissue->is_columnar_axis_torus_axis()) ;
+
+    natural_32_bit const  num_rows = static_state_of_tissue->num_cells_along_y_axis();
+    natural_32_bit const  num_blocks =
+            std::max(1U, num_rows / num_rows_in_block_of_tissue(static_state_of_tissue,
+                                                                 num_threads_avalilable_for_computation));
+    // Only pivots migrating along the y axis write into the next block, so only then the first and the last
+    // block are neighbours for the torus y axis.
+    bool const  do_blocks_form_torus =
+            shift.get_shift_along_y_axis() != 0 && static_state_of_tissue->is_y_axis_torus_axis();
+    natural_32_bit const  num_colours_of_blocks =
+            num_colours_of_cells_along_axis_of_migration(num_blocks,do_blocks_form_torus);
 
-        threads.push_back(
-                    std::thread(
-                        &cellab::thread_exchange_synapses_between_territorial_lists_of_all_cells,
-                        dynamic_state_of_tissue,
-                        static_state_of_tissue,
-                        list_index_in_pivot_cells,
-                        shift,
-                        list_index_in_shift_cells,
-                        x_coord,y_coord,c_coord,
-                        num_threads_avalilable_for_computation
-                        )
+    for (natural_32_bit colour = 0U; colour < num_colours; ++colour)
+        for (natural_32_bit colour_of_blocks = 0U; colour_of_blocks < num_colours_of_blocks; ++colour_of_blocks)
+            pool.run_and_wait(
+                    num_threads_avalilable_for_computation,
+                    [&](natural_32_bit const  thread_index) {
+                        // Blocks of the colour are distributed cyclically among threads.
+                        natural_32_bit  index_of_block_of_colour = 0U;
+                        for (natural_32_bit block = 0U; block < num_blocks; ++block)
+                        {
+                            if (colour_of_blocks != colour_of_cell_along_axis_of_migration(block,num_blocks,do_blocks_form_torus))
+                                continue;
+                            if (index_of_block_of_colour++ % num_threads_avalilable_for_computation != thread_index)
+                                continue;
+                            thread_exchange_synapses_between_territorial_lists_of_cells_in_block(
+                                    dynamic_state_of_tissue,
+                                    static_state_of_tissue,
+                                    list_index_in_pivot_cells,
+                                    shift,
+                                    list_index_in_shift_cells,
+                                    colour,
+                                    seed_of_random_generators,
+                                    (natural_32_bit)((natural_64_bit)block * num_rows / num_blocks),
+                                    (natural_32_bit)((natural_64_bit)(block + 1U) * num_rows / num_blocks)
+                                    );
+                        }
+                    }
                     );
-    }
+}
 
-    thread_exchange_synapses_between_territorial_lists_of_all_cells(
+void  apply_transition_of_synaptic_migration_in_tissue(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        natural_32_bit const  num_threads_avalilable_for_computation
+        )
+{
+    ASSUMPTION(num_threads_avalilable_for_computation > 0U);
+    thread_pool  pool(num_threads_avalilable_for_computation - 1U);
+    apply_transition_of_synaptic_migration_in_tissue(
             dynamic_state_of_tissue,
-            static_state_of_tissue,
-            list_index_in_pivot_cells,
-            shift,
-            list_index_in_shift_cells,
-            0U,0U,0U,
-            num_threads_avalilable_for_computation
+            num_threads_avalilable_for_computation,
+            pool
             );
+}
 
-    for(std::thread& thread : threads)
-        thread.join();
+void  apply_transition_of_synaptic_migration_in_tissue(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        natural_32_bit const  num_threads_avalilable_for_computation,
+        thread_pool&  pool
+        )
+{
+    apply_transition_of_synaptic_migration_in_tissue(
+            dynamic_state_of_tissue,
+            num_threads_avalilable_for_computation,
+            pool,
+            get_random_natural_32_bit_in_range(1U,0x7ffffffeU)
+            );
 }
 
 void  apply_transition_of_synaptic_migration_in_tissue(
         std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
-        natural_32_bit const  num_threads_avalilable_for_computation
+        natural_32_bit const  num_threads_avalilable_for_computation,
+        thread_pool&  pool,
+        natural_32_bit const  seed_of_random_generators
         )
 {
+    ASSUMPTION(num_threads_avalilable_for_computation > 0U);
+
     std::shared_ptr<static_state_of_neural_tissue const> const static_state_of_tissue =
             dynamic_state_of_tissue->get_static_state_of_neural_tissue();
 
@@ -236,7 +366,9 @@ void  apply_transition_of_synaptic_migration_in_tissue(
                 convert_territorial_state_of_synapse_to_territorial_list_index(MIGRATION_ALONG_POSITIVE_X_AXIS),
                 shift_in_coordinates(1,0,0),
                 convert_territorial_state_of_synapse_to_territorial_list_index(MIGRATION_ALONG_NEGATIVE_X_AXIS),
-                num_threads_avalilable_for_computation
+                seed_of_random_generators,
+                num_threads_avalilable_for_computation,
+                pool
                 );
     exchange_synapses_between_territorial_lists_of_all_cells(
                 dynamic_state_of_tissue,
@@ -244,7 +376,9 @@ void  apply_transition_of_synaptic_migration_in_tissue(
                 convert_territorial_state_of_synapse_to_territorial_list_index(MIGRATION_ALONG_POSITIVE_Y_AXIS),
                 shift_in_coordinates(0,1,0),
                 convert_territorial_state_of_synapse_to_territorial_list_index(MIGRATION_ALONG_NEGATIVE_Y_AXIS),
-                num_threads_avalilable_for_computation
+                seed_of_random_generators,
+                num_threads_avalilable_for_computation,
+                pool
                 );
     exchange_synapses_between_territorial_lists_of_all_cells(
                 dynamic_state_of_tissue,
@@ -252,7 +386,9 @@ void  apply_transition_of_synaptic_migration_in_tissue(
                 convert_territorial_state_of_synapse_to_territorial_list_index(MIGRATION_ALONG_POSITIVE_COLUMNAR_AXIS),
                 shift_in_coordinates(0,0,1),
                 convert_territorial_state_of_synapse_to_territorial_list_index(MIGRATION_ALONG_NEGATIVE_COLUMNAR_AXIS),
-                num_threads_avalilable_for_computation
+                seed_of_random_generators,
+                num_threads_avalilable_for_computation,
+                pool
                 );
 }
 
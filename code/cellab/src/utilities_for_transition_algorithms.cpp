@@ -1,8 +1,12 @@
 #include <cellab/utilities_for_transition_algorithms.hpp>
 #include <cellab/static_state_of_neural_tissue.hpp>
 #include <cellab/dynamic_state_of_neural_tissue.hpp>
+#include <cellab/territorial_state_of_synapse.hpp>
 #include <utility/assumptions.hpp>
 #include <utility/invariants.hpp>
+#include <algorithm>
+#include <limits>
+#include <array>
 
 #include <utility/development.hpp>
 
@@ -185,6 +189,122 @@ bool  go_to_next_index(
     return extent_64_bit == 0ULL;
 }
 
+static bool  go_to_next_coordinates_by_64_bit_extent(
+        natural_32_bit& x_coord, natural_32_bit& y_coord, natural_32_bit& c_coord,
+        natural_64_bit extent_64_bit,
+        natural_32_bit const num_cells_along_x_axis,
+        natural_32_bit const num_cells_along_y_axis,
+        natural_32_bit const num_cells_along_columnar_axis
+        )
+{
+    c_coord = (natural_32_bit)go_to_next_value_modulo_range(c_coord,num_cells_along_columnar_axis,extent_64_bit);
+    x_coord = (natural_32_bit)go_to_next_value_modulo_range(x_coord,num_cells_along_x_axis,extent_64_bit);
+    y_coord = (natural_32_bit)go_to_next_value_modulo_range(y_coord,num_cells_along_y_axis,extent_64_bit);
+    return extent_64_bit == 0ULL;
+}
+
+natural_32_bit  compute_num_cells_in_tile_of_tissue(
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+        natural_32_bit const num_threads,
+        natural_32_bit const num_bytes_of_l2_cache
+        )
+{
+    ASSUMPTION(num_threads > 0U);
+
+    natural_64_bit const num_cells_in_column = static_state_of_tissue->num_cells_along_columnar_axis();
+    natural_64_bit const num_cells =
+            (natural_64_bit)static_state_of_tissue->num_cells_along_x_axis() *
+            (natural_64_bit)static_state_of_tissue->num_cells_along_y_axis() *
+            num_cells_in_column;
+
+    natural_64_bit num_synapses_in_column = 0ULL;
+    for (natural_32_bit c = 0U; c < num_cells_in_column; ++c)
+        num_synapses_in_column += static_state_of_tissue->num_synapses_in_territory_of_cell_with_columnar_coord(c);
+
+    natural_64_bit const num_bits_per_column =
+            num_cells_in_column * (static_state_of_tissue->num_bits_per_cell() +
+                                   static_state_of_tissue->num_bits_per_signalling()) +
+            num_synapses_in_column * static_state_of_tissue->num_bits_per_synapse();
+    natural_64_bit const num_bits_per_cell = std::max((natural_64_bit)1ULL, num_bits_per_column / num_cells_in_column);
+
+    natural_64_bit num_cells_in_tile = std::max((natural_64_bit)1ULL, (natural_64_bit)(8ULL * num_bytes_of_l2_cache / num_bits_per_cell));
+    if (num_cells_in_tile > num_cells_in_column)
+        num_cells_in_tile -= num_cells_in_tile % num_cells_in_column;
+    num_cells_in_tile = std::min(num_cells_in_tile, (natural_64_bit)((num_cells + num_threads - 1ULL) / num_threads));
+    num_cells_in_tile = std::min(num_cells_in_tile, (natural_64_bit)std::numeric_limits<natural_32_bit>::max());
+
+    INVARIANT(num_cells_in_tile > 0ULL);
+    return (natural_32_bit)num_cells_in_tile;
+}
+
+natural_32_bit  compute_num_cells_in_byte_aligned_tile_of_tissue(
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+        natural_32_bit const num_threads,
+        natural_32_bit const num_bytes_of_l2_cache
+        )
+{
+    natural_64_bit const num_cells_in_block = 8ULL * static_state_of_tissue->num_cells_along_columnar_axis();
+    ASSUMPTION(num_cells_in_block <= (natural_64_bit)std::numeric_limits<natural_32_bit>::max());
+
+    natural_64_bit const num_cells_in_tile =
+            compute_num_cells_in_tile_of_tissue(static_state_of_tissue,num_threads,num_bytes_of_l2_cache);
+    natural_64_bit const num_blocks_in_tile = std::min(
+            std::max((natural_64_bit)1ULL, num_cells_in_tile / num_cells_in_block),
+            (natural_64_bit)std::numeric_limits<natural_32_bit>::max() / num_cells_in_block
+            );
+
+    INVARIANT(num_blocks_in_tile > 0ULL);
+    return (natural_32_bit)(num_blocks_in_tile * num_cells_in_block);
+}
+
+bool  go_to_first_coordinates_in_tiles(
+        natural_32_bit& x_coord, natural_32_bit& y_coord, natural_32_bit& c_coord,
+        natural_32_bit const thread_index,
+        natural_32_bit const num_cells_in_tile,
+        natural_32_bit const num_cells_along_x_axis,
+        natural_32_bit const num_cells_along_y_axis,
+        natural_32_bit const num_cells_along_columnar_axis
+        )
+{
+    ASSUMPTION(num_cells_in_tile > 0U);
+    x_coord = 0U;
+    y_coord = 0U;
+    c_coord = 0U;
+    return go_to_next_coordinates_by_64_bit_extent(
+                x_coord,y_coord,c_coord,
+                (natural_64_bit)thread_index * (natural_64_bit)num_cells_in_tile,
+                num_cells_along_x_axis,
+                num_cells_along_y_axis,
+                num_cells_along_columnar_axis
+                );
+}
+
+bool  go_to_next_coordinates_in_tiles(
+        natural_32_bit& x_coord, natural_32_bit& y_coord, natural_32_bit& c_coord,
+        natural_32_bit& index_in_tile,
+        natural_32_bit const num_cells_in_tile,
+        natural_32_bit const num_threads,
+        natural_32_bit const num_cells_along_x_axis,
+        natural_32_bit const num_cells_along_y_axis,
+        natural_32_bit const num_cells_along_columnar_axis
+        )
+{
+    ASSUMPTION(index_in_tile < num_cells_in_tile && num_threads > 0U);
+    natural_64_bit extent_64_bit = 1ULL;
+    if (++index_in_tile == num_cells_in_tile)
+    {
+        index_in_tile = 0U;
+        extent_64_bit += (natural_64_bit)(num_threads - 1U) * (natural_64_bit)num_cells_in_tile;
+    }
+    return go_to_next_coordinates_by_64_bit_extent(
+                x_coord,y_coord,c_coord,
+                extent_64_bit,
+                num_cells_along_x_axis,
+                num_cells_along_y_axis,
+                num_cells_along_columnar_axis
+                );
+}
+
 integer_64_bit  clip_shift(
         integer_64_bit const shift,
         natural_32_bit const origin,
@@ -195,7 +315,7 @@ integer_64_bit  clip_shift(
     integer_64_bit const destination = origin64 + shift;
     integer_64_bit const length64 = length_of_axis;
 
-    if (destination < 0ULL)
+    if (destination < 0LL)
         return -origin64;
 
     if (destination >= length64)
@@ -246,7 +366,7 @@ tissue_coordinates  convert_bits_of_coordinates_to_tissue_coordinates(bits_refer
 }
 
 tissue_coordinates  get_coordinates_of_source_cell_of_synapse_in_tissue(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
         tissue_coordinates const& coords_of_territorial_cell_of_synapse,
         natural_32_bit const index_of_synapse_in_territory
         )
@@ -272,7 +392,7 @@ tissue_coordinates  get_coordinates_of_source_cell_of_synapse_in_tissue(
 }
 
 tissue_coordinates  get_coordinates_of_source_cell_of_synapse_to_muscle(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
         natural_32_bit const index_of_synapse_to_muscle
         )
 {
@@ -294,7 +414,7 @@ tissue_coordinates  get_coordinates_of_source_cell_of_synapse_to_muscle(
 }
 
 natural_32_bit  get_begin_index_of_territorial_list_of_cell(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
         tissue_coordinates const& coordinates_of_cell,
         natural_8_bit const index_of_territorial_list
         )
@@ -314,8 +434,8 @@ natural_32_bit  get_begin_index_of_territorial_list_of_cell(
 }
 
 natural_32_bit  get_end_index_of_territorial_list_of_cell(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
-        std::shared_ptr<static_state_of_neural_tissue const> const static_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
         tissue_coordinates const& coordinates_of_cell,
         natural_8_bit const index_of_territorial_list
         )
@@ -340,7 +460,7 @@ natural_32_bit  get_end_index_of_territorial_list_of_cell(
 }
 
 void  swap_all_data_of_two_synapses(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
         tissue_coordinates const& first_cell_coordinates,
         natural_32_bit const synapse_index_in_first_territory,
         tissue_coordinates const& second_cell_coordinates,
@@ -400,9 +520,143 @@ void  swap_all_data_of_two_synapses(
     }
 }
 
+static void move_all_synapse_data_from_source_list_to_target_list(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        tissue_coordinates const& cell_coordinates,
+        natural_32_bit source_list_index,
+        natural_32_bit const target_list_index,
+        natural_32_bit index_into_source_list,
+        std::array<natural_32_bit,8U>& boundaries_of_lists
+        )
+{
+    ASSUMPTION(source_list_index < 7U);
+    ASSUMPTION(target_list_index < 7U);
+    ASSUMPTION(index_into_source_list >= boundaries_of_lists.at(source_list_index));
+    ASSUMPTION(index_into_source_list < boundaries_of_lists.at(source_list_index + 1U));
+    for ( ; source_list_index < target_list_index; ++source_list_index)
+    {
+        natural_32_bit const next_list = source_list_index + 1U;
+        natural_32_bit const target_index = boundaries_of_lists.at(next_list) - 1U;
+        if (index_into_source_list != target_index)
+            swap_all_data_of_two_synapses(
+                    dynamic_state_of_tissue,
+                    cell_coordinates,
+                    index_into_source_list,
+                    cell_coordinates,
+                    target_index
+                    );
+        index_into_source_list = target_index;
+        boundaries_of_lists.at(next_list) = target_index;
+    }
+    for ( ; target_list_index < source_list_index; --source_list_index)
+    {
+        natural_32_bit const target_index = boundaries_of_lists.at(source_list_index);
+        if (index_into_source_list != target_index)
+            swap_all_data_of_two_synapses(
+                    dynamic_state_of_tissue,
+                    cell_coordinates,
+                    index_into_source_list,
+                    cell_coordinates,
+                    target_index
+                    );
+        index_into_source_list = target_index;
+        boundaries_of_lists.at(source_list_index) = target_index + 1U;
+    }
+}
+
+void  move_synapses_into_proper_lists_in_territory_of_cell(
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
+        natural_32_bit const x_coord,
+        natural_32_bit const y_coord,
+        natural_32_bit const c_coord
+        )
+{
+    ASSUMPTION(c_coord < static_state_of_tissue->num_cells_along_columnar_axis());
+
+    std::array<bits_reference,6U> bits_of_delimiters = {
+            dynamic_state_of_tissue->find_bits_of_delimiter_between_territorial_lists(
+                    x_coord, y_coord, c_coord, 0U
+                    ),
+            dynamic_state_of_tissue->find_bits_of_delimiter_between_territorial_lists(
+                    x_coord, y_coord, c_coord, 1U
+                    ),
+            dynamic_state_of_tissue->find_bits_of_delimiter_between_territorial_lists(
+                    x_coord, y_coord, c_coord, 2U
+                    ),
+            dynamic_state_of_tissue->find_bits_of_delimiter_between_territorial_lists(
+                    x_coord, y_coord, c_coord, 3U
+                    ),
+            dynamic_state_of_tissue->find_bits_of_delimiter_between_territorial_lists(
+                    x_coord, y_coord, c_coord, 4U
+                    ),
+            dynamic_state_of_tissue->find_bits_of_delimiter_between_territorial_lists(
+                    x_coord, y_coord, c_coord, 5U
+                    ),
+            };
+
+    std::array<natural_32_bit,8U> boundaries_of_lists = {
+            0U,
+            bits_to_value<natural_32_bit>(bits_of_delimiters.at(0U)),
+            bits_to_value<natural_32_bit>(bits_of_delimiters.at(1U)),
+            bits_to_value<natural_32_bit>(bits_of_delimiters.at(2U)),
+            bits_to_value<natural_32_bit>(bits_of_delimiters.at(3U)),
+            bits_to_value<natural_32_bit>(bits_of_delimiters.at(4U)),
+            bits_to_value<natural_32_bit>(bits_of_delimiters.at(5U)),
+            static_state_of_tissue->num_synapses_in_territory_of_cell_kind(
+                    static_state_of_tissue->compute_kind_of_cell_from_its_position_along_columnar_axis(
+                            c_coord
+                            )
+                    )
+            };
+
+    for (natural_32_bit list_index = 0U; list_index < 7U; ++list_index)
+        for (natural_32_bit index_into_list = boundaries_of_lists.at(list_index);
+             index_into_list < boundaries_of_lists.at(list_index + 1U);
+             )
+        {
+            natural_32_bit const target_list_index =
+                    convert_territorial_state_of_synapse_to_territorial_list_index(
+                        static_cast<territorial_state_of_synapse>(
+                            bits_to_value<natural_32_bit>(
+                                dynamic_state_of_tissue->find_bits_of_territorial_state_of_synapse_in_tissue(
+                                        x_coord, y_coord, c_coord,
+                                        index_into_list
+                                        )
+                                )
+                            )
+                        );
+            INVARIANT(target_list_index < 7U);
+            if (target_list_index == list_index)
+                ++index_into_list;
+            else
+            {
+                move_all_synapse_data_from_source_list_to_target_list(
+                        dynamic_state_of_tissue,
+                        tissue_coordinates(x_coord, y_coord, c_coord),
+                        list_index,
+                        target_list_index,
+                        index_into_list,
+                        boundaries_of_lists
+                        );
+                if (index_into_list < boundaries_of_lists.at(list_index))
+                {
+                    ++index_into_list;
+                    INVARIANT(index_into_list == boundaries_of_lists.at(list_index));
+                }
+            }
+        }
+
+    for (natural_32_bit delimiter_index = 0U; delimiter_index < bits_of_delimiters.size(); ++delimiter_index)
+    {
+        INVARIANT( boundaries_of_lists.at(delimiter_index) <= boundaries_of_lists.at(delimiter_index + 1U) );
+        value_to_bits( boundaries_of_lists.at(delimiter_index + 1U), bits_of_delimiters.at(delimiter_index) );
+    }
+}
+
 std::pair<bits_const_reference,kind_of_cell>  get_signalling_callback_function(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
-        std::shared_ptr<static_state_of_neural_tissue const> const static_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
         spatial_neighbourhood const& neighbourhood,
         shift_in_coordinates const& shift
         )
@@ -444,8 +698,8 @@ std::pair<bits_const_reference,kind_of_cell>  get_signalling_callback_function(
 }
 
 std::tuple<bits_const_reference,kind_of_cell,kind_of_cell>  get_synapse_callback_function(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
-        std::shared_ptr<static_state_of_neural_tissue const> const static_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
         tissue_coordinates const& target_cell,
         kind_of_cell const kind_of_target_cell,
         natural_32_bit const number_of_synapses_in_range,
@@ -475,8 +729,8 @@ std::tuple<bits_const_reference,kind_of_cell,kind_of_cell>  get_synapse_callback
 }
 
 std::pair<bits_const_reference,kind_of_cell>  get_cell_callback_function(
-        std::shared_ptr<dynamic_state_of_neural_tissue> const dynamic_state_of_tissue,
-        std::shared_ptr<static_state_of_neural_tissue const> const static_state_of_tissue,
+        std::shared_ptr<dynamic_state_of_neural_tissue> const& dynamic_state_of_tissue,
+        std::shared_ptr<static_state_of_neural_tissue const> const& static_state_of_tissue,
         spatial_neighbourhood const& neighbourhood,
         shift_in_coordinates const& shift
         )
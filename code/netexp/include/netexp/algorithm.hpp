@@ -8,9 +8,25 @@
 namespace netexp {
 
 
+/**
+ * Returns the stream of the counter-based generator of the passed seed which is keyed by indices of an object
+ * (e.g. of a spiker or a ship). Initialisers use it to draw the same random numbers for the object, no matter
+ * in which order and in how many threads the objects are processed.
+ *
+ * Functions below which draw random numbers are templates of the generator type. They are explicitly instantiated
+ * for 'counter_based_random_generator' and for 'random_generator_for_natural_32_bit' (used by serial initialisers).
+ */
+counter_based_random_generator  make_random_generator_of_object(
+        natural_64_bit const  seed,
+        netlab::layer_index_type const  layer_index,
+        netlab::object_index_type const  object_index_into_layer
+        );
+
+
+template<typename random_generator_type>
 netlab::layer_index_type  compute_layer_index_for_area_center(
         std::vector<natural_64_bit>&  counts_of_centers_into_layers,
-        random_generator_for_natural_32_bit&  generator
+        random_generator_type&  generator
         );
 
 
@@ -90,6 +106,7 @@ void  compute_maximal_bbox_for_storing_movement_area_of_spiker_into(
         );
 
 
+template<typename random_generator_type>
 void  compute_initial_movement_area_center_for_ships_of_spiker_XYC(
         netlab::layer_index_type const  spiker_layer_index,
         netlab::object_index_type const  spiker_index_into_layer,
@@ -101,25 +118,27 @@ void  compute_initial_movement_area_center_for_ships_of_spiker_XYC(
         netlab::sector_coordinate_type const  max_distance_x,
         netlab::sector_coordinate_type const  max_distance_y,
         netlab::sector_coordinate_type const  max_distance_c,
-        random_generator_for_natural_32_bit&  position_generator,
+        random_generator_type&  position_generator,
         vector3&  area_center
         );
 
 
+template<typename random_generator_type>
 void  compute_random_ship_position_in_movement_area(
         vector3 const&  area_center,
         float_32_bit const  half_size_of_ship_movement_area_along_x_axis_in_meters,
         float_32_bit const  half_size_of_ship_movement_area_along_y_axis_in_meters,
         float_32_bit const  half_size_of_ship_movement_area_along_c_axis_in_meters,
-        random_generator_for_natural_32_bit&   random_generator,
+        random_generator_type&   random_generator,
         vector3&  ship_position
         );
 
 
+template<typename random_generator_type>
 void  compute_random_ship_velocity_in_movement_area(
         float_32_bit const  min_speed_of_ship_in_movement_area,
         float_32_bit const  max_speed_of_ship_in_movement_area,
-        random_generator_for_natural_32_bit&   random_generator,
+        random_generator_type&   random_generator,
         vector3&  ship_velocity
         );
 
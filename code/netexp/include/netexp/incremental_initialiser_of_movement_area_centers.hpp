@@ -14,6 +14,17 @@
 namespace netexp {
 
 
+/**
+ * It repeatedly shifts movement area centers by a half of the distance of spikers along one axis, if such a shift
+ * reduces the sum of squared differences between densities of ships in spiker sectors and the ideal average density
+ * of ships in the layer. The change of the sum caused by a shift is computed from sums of densities of ships in at most
+ * 27 boxes of spiker sectors. The sums are read from a 3D Fenwick tree (binary indexed tree) of densities kept for each
+ * layer, so that both a box sum and an update of the density in one sector, when a center is moved, take only
+ * a logarithmic time along each axis.
+ *
+ * Shifts of centers are computed concurrently for spikers of one colour (see the base class), because the score of
+ * a shift depends only on densities inside the maximal bbox of the movement area of the spiker.
+ */
 struct  incremental_initialiser_of_movement_area_centers : public netlab::initialiser_of_movement_area_centers
 {
     using max_area_distance_from_spiker_callback_function =
@@ -31,9 +42,9 @@ struct  incremental_initialiser_of_movement_area_centers : public netlab::initia
         , m_updated()
         , m_solved()
         , m_ideal_average_ship_densities_in_layers()
+        , m_summed_densities_of_ships_in_layers()
         , m_max_iterations(0U)
-        , m_dbg_scores_old()
-        , m_dbg_scores_new()
+        , m_dbg_sums_of_squared_distances_to_ideal_densities()
     {}
 
     virtual void  prepare_for_shifting_movement_area_centers_in_layers(
@@ -61,6 +72,40 @@ struct  incremental_initialiser_of_movement_area_centers : public netlab::initia
             netlab::accessor_to_extra_data_for_spikers_in_layers&  extra_data_for_spikers
             ) override;
 
+    virtual bool  can_shift_movement_area_centers_concurrently() const override { return true; }
+
+    virtual std::array<natural_32_bit, 3ULL>  get_extents_of_independent_shifts_of_movement_area_centers(
+            netlab::layer_index_type const  spiker_layer_index,
+            netlab::network_props const&  props
+            ) const override;
+
+    virtual bool  compute_shift_of_movement_area_center_in_layer(
+            netlab::layer_index_type const  spiker_layer_index,
+            netlab::object_index_type const  spiker_index_into_layer,
+            netlab::sector_coordinate_type const  spiker_sector_coordinate_x,
+            netlab::sector_coordinate_type const  spiker_sector_coordinate_y,
+            netlab::sector_coordinate_type const  spiker_sector_coordinate_c,
+            netlab::layer_index_type const  area_layer_index,
+            netlab::network_props const&  props,
+            netlab::access_to_movement_area_centers const&  movement_area_centers,
+            vector3 const&  area_center,
+            netlab::accessor_to_extra_data_for_spikers_in_layers const&  extra_data_for_spikers,
+            vector3&  moved_area_center
+            ) const override;
+
+    virtual void  apply_shift_of_movement_area_center_in_layer(
+            netlab::layer_index_type const  spiker_layer_index,
+            netlab::object_index_type const  spiker_index_into_layer,
+            netlab::sector_coordinate_type const  spiker_sector_coordinate_x,
+            netlab::sector_coordinate_type const  spiker_sector_coordinate_y,
+            netlab::sector_coordinate_type const  spiker_sector_coordinate_c,
+            netlab::layer_index_type const  area_layer_index,
+            netlab::network_props const&  props,
+            vector3 const&  moved_area_center,
+            vector3&  area_center,
+            netlab::accessor_to_extra_data_for_spikers_in_layers&  extra_data_for_spikers
+            ) override;
+
     virtual bool  do_extra_data_hold_densities_of_ships_per_spikers_in_layers() override { return true; }
 
 private:
@@ -69,9 +114,10 @@ private:
     std::vector<bool>  m_updated;
     std::vector<bool>  m_solved;
     std::vector<float_32_bit>  m_ideal_average_ship_densities_in_layers;
+    std::vector< std::vector<float_64_bit> >  m_summed_densities_of_ships_in_layers; //!< A 3D Fenwick tree of densities of
+                                                                                    //!< ships in spiker sectors for each layer.
     natural_32_bit  m_max_iterations;
-    std::vector<float_32_bit>  m_dbg_scores_old;
-    std::vector<float_32_bit>  m_dbg_scores_new;
+    std::vector<float_64_bit>  m_dbg_sums_of_squared_distances_to_ideal_densities;
 };
 
 
@@ -27,6 +27,16 @@ struct  ship_controller_flat_space : public netlab::ship_controller
             netlab::network_props const&  props
             ) const;
 
+    vector3  accelerate_into_docks(
+            vector3 const&  ship_position,              //!< Coordinates in meters.
+            vector3 const&  ship_velocity,              //!< In meters per second.
+            vector3 const* const  docks_positions,      //!< Coordinates in meters.
+            natural_64_bit const  num_docks,
+            netlab::layer_index_type const  home_layer_index,//!< Index of layer where is the spiker the ship belongs to.
+            netlab::layer_index_type const  area_layer_index,//!< Index of layer where is the movement area in which the ship moves.
+            netlab::network_props const&  props
+            ) const;
+
 
     vector3  accelerate_from_ship(
             vector3 const&  ship_position,              //!< Coordinates in meters.
@@ -37,7 +47,22 @@ struct  ship_controller_flat_space : public netlab::ship_controller
             bool const  both_ship_and_dock_belongs_to_same_spiker,
             netlab::layer_index_type const  home_layer_index,//!< Index of layer where is the spiker the ship belongs to.
             netlab::layer_index_type const  area_layer_index,//!< Index of layer where is the movement area in which the ship moves.
-            netlab::network_props const&  props
+            netlab::network_props const&  props,
+            counter_based_random_generator&  random_generator
+            ) const;
+
+    vector3  accelerate_from_ships(
+            vector3 const&  ship_position,              //!< Coordinates in meters.
+            vector3 const&  ship_velocity,              //!< In meters per second.
+            vector3 const* const  other_ships_positions,//!< Coordinates in meters.
+            vector3 const* const  other_ships_velocities,//!< In meters per second.
+            natural_64_bit const  num_other_ships,
+            vector3 const&  nearest_dock_position,      //!< Coordinates in meters. It is nearest to the ship, not to the other ones.
+            bool const  both_ship_and_dock_belongs_to_same_spiker,
+            netlab::layer_index_type const  home_layer_index,//!< Index of layer where is the spiker the ship belongs to.
+            netlab::layer_index_type const  area_layer_index,//!< Index of layer where is the movement area in which the ship moves.
+            netlab::network_props const&  props,
+            counter_based_random_generator&  random_generator
             ) const;
 
 
@@ -47,6 +72,22 @@ struct  ship_controller_flat_space : public netlab::ship_controller
     float_32_bit  max_avoidance_distance_from_other_ship() const noexcept { return m_max_avoidance_distance_from_other_ship; }
 
 private:
+    /// Non-virtual implementations shared by the single and the batched versions of the methods above.
+    vector3  compute_acceleration_into_dock(
+            vector3 const&  ship_position,
+            vector3 const&  ship_velocity,
+            vector3 const&  dock_position,
+            netlab::network_props const&  props
+            ) const;
+    vector3  compute_acceleration_from_ship(
+            vector3 const&  ship_position,
+            vector3 const&  other_ship_position,
+            vector3 const&  nearest_dock_position,
+            bool const  both_ship_and_dock_belongs_to_same_spiker,
+            netlab::network_props const&  props,
+            counter_based_random_generator&  random_generator
+            ) const;
+
     float_32_bit  m_acceleration_to_dock;
     natural_32_bit  m_num_time_steps_to_stop_ship;
     float_32_bit  m_max_acceleration_from_other_ship;
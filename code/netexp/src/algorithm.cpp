@@ -10,9 +10,20 @@
 namespace netexp {
 
 
+counter_based_random_generator  make_random_generator_of_object(
+        natural_64_bit const  seed,
+        netlab::layer_index_type const  layer_index,
+        netlab::object_index_type const  object_index_into_layer
+        )
+{
+    return counter_based_random_generator(seed, layer_index, object_index_into_layer);
+}
+
+
+template<typename random_generator_type>
 netlab::layer_index_type  compute_layer_index_for_area_center(
         std::vector<natural_64_bit>&  counts_of_centers_into_layers,
-        random_generator_for_natural_32_bit&  generator
+        random_generator_type&  generator
         )
 {
     netlab::layer_index_type  layer_index =
@@ -99,6 +110,7 @@ void  compute_maximal_bbox_for_storing_movement_area_of_spiker_into(
 }
 
 
+template<typename random_generator_type>
 void  compute_initial_movement_area_center_for_ships_of_spiker_XYC(
         netlab::layer_index_type const  spiker_layer_index,
         netlab::object_index_type const  spiker_index_into_layer,
@@ -110,7 +122,7 @@ void  compute_initial_movement_area_center_for_ships_of_spiker_XYC(
         netlab::sector_coordinate_type const  max_distance_x,
         netlab::sector_coordinate_type const  max_distance_y,
         netlab::sector_coordinate_type const  max_distance_c,
-        random_generator_for_natural_32_bit&  position_generator,
+        random_generator_type&  position_generator,
         vector3&  area_center
         )
 {
@@ -186,12 +198,13 @@ void  compute_initial_movement_area_center_for_ships_of_spiker_XYC(
 }
 
 
+template<typename random_generator_type>
 void  compute_random_ship_position_in_movement_area(
         vector3 const&  area_center,
         float_32_bit const  half_size_of_ship_movement_area_along_x_axis_in_meters,
         float_32_bit const  half_size_of_ship_movement_area_along_y_axis_in_meters,
         float_32_bit const  half_size_of_ship_movement_area_along_c_axis_in_meters,
-        random_generator_for_natural_32_bit&   random_generator,
+        random_generator_type&   random_generator,
         vector3&  ship_position
         )
 {
@@ -216,10 +229,11 @@ void  compute_random_ship_position_in_movement_area(
             };
 }
 
+template<typename random_generator_type>
 void  compute_random_ship_velocity_in_movement_area(
         float_32_bit const  min_speed_of_ship_in_movement_area,
         float_32_bit const  max_speed_of_ship_in_movement_area,
-        random_generator_for_natural_32_bit&   random_generator,
+        random_generator_type&   random_generator,
         vector3&  ship_velocity
         )
 {
@@ -237,6 +251,78 @@ void  compute_random_ship_velocity_in_movement_area(
 }
 
 
+template netlab::layer_index_type  compute_layer_index_for_area_center<counter_based_random_generator>(
+        std::vector<natural_64_bit>&,
+        counter_based_random_generator&
+        );
+
+template void  compute_initial_movement_area_center_for_ships_of_spiker_XYC<counter_based_random_generator>(
+        netlab::layer_index_type const,
+        netlab::object_index_type const,
+        netlab::sector_coordinate_type const,
+        netlab::sector_coordinate_type const,
+        netlab::sector_coordinate_type const,
+        netlab::network_props const&,
+        netlab::layer_index_type const,
+        netlab::sector_coordinate_type const,
+        netlab::sector_coordinate_type const,
+        netlab::sector_coordinate_type const,
+        counter_based_random_generator&,
+        vector3&
+        );
+
+template void  compute_random_ship_position_in_movement_area<counter_based_random_generator>(
+        vector3 const&,
+        float_32_bit const,
+        float_32_bit const,
+        float_32_bit const,
+        counter_based_random_generator&,
+        vector3&
+        );
+
+template void  compute_random_ship_velocity_in_movement_area<counter_based_random_generator>(
+        float_32_bit const,
+        float_32_bit const,
+        counter_based_random_generator&,
+        vector3&
+        );
+
+template netlab::layer_index_type  compute_layer_index_for_area_center<random_generator_for_natural_32_bit>(
+        std::vector<natural_64_bit>&,
+        random_generator_for_natural_32_bit&
+        );
+
+template void  compute_initial_movement_area_center_for_ships_of_spiker_XYC<random_generator_for_natural_32_bit>(
+        netlab::layer_index_type const,
+        netlab::object_index_type const,
+        netlab::sector_coordinate_type const,
+        netlab::sector_coordinate_type const,
+        netlab::sector_coordinate_type const,
+        netlab::network_props const&,
+        netlab::layer_index_type const,
+        netlab::sector_coordinate_type const,
+        netlab::sector_coordinate_type const,
+        netlab::sector_coordinate_type const,
+        random_generator_for_natural_32_bit&,
+        vector3&
+        );
+
+template void  compute_random_ship_position_in_movement_area<random_generator_for_natural_32_bit>(
+        vector3 const&,
+        float_32_bit const,
+        float_32_bit const,
+        float_32_bit const,
+        random_generator_for_natural_32_bit&,
+        vector3&
+        );
+
+template void  compute_random_ship_velocity_in_movement_area<random_generator_for_natural_32_bit>(
+        float_32_bit const,
+        float_32_bit const,
+        random_generator_for_natural_32_bit&,
+        vector3&
+        );
+
 float_32_bit  exponential_increase_from_zero_to_one(
         float_32_bit const  x,
         float_32_bit const  X_MAX,
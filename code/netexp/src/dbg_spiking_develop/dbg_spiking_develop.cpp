@@ -25,6 +25,8 @@
 #include <memory>
 #include <array>
 #include <iomanip>
+#include <cmath>
+#include <cstring>
 
 namespace netexp { namespace dbg_spiking_develop { namespace {
 
@@ -391,12 +393,15 @@ void  initialiser_of_movement_area_centers::compute_initial_movement_area_center
 }
 
 
+/// Seed of streams of random numbers of the initialiser below. Each ship draws from its own stream.
+inline constexpr natural_64_bit  seed_of_ships_in_movement_areas() noexcept { return 2ULL; }
+
+
 struct  initialiser_of_ships_in_movement_areas : public netlab::initialiser_of_ships_in_movement_areas
 {
     initialiser_of_ships_in_movement_areas();
 
-    void  on_next_layer(netlab::layer_index_type const  layer_index, netlab::network_props const&  props)
-    { reset(random_generator()); }
+    bool  can_compute_ships_in_movement_areas_concurrently() const override { return true; }
 
     void  on_next_area(
             netlab::layer_index_type const  layer_index,
@@ -409,49 +414,49 @@ struct  initialiser_of_ships_in_movement_areas : public netlab::initialiser_of_s
             vector3 const&  center,
             natural_32_bit const  ship_index_in_the_area,
             netlab::layer_index_type const  home_layer_index,
+            netlab::object_index_type const  home_spiker_index,
             netlab::layer_index_type const  area_layer_index,
             netlab::network_props const&  props,
             vector3&  ship_position,
             vector3&  ship_velocity 
             );
-
-    random_generator_for_natural_32_bit&  random_generator() noexcept { return m_generator; }
-
-private:
-    random_generator_for_natural_32_bit  m_generator;
 };
 
 initialiser_of_ships_in_movement_areas::initialiser_of_ships_in_movement_areas()
     : netlab::initialiser_of_ships_in_movement_areas()
-    , m_generator()
 {}
 
 void  initialiser_of_ships_in_movement_areas::compute_ship_position_and_velocity_in_movement_area(
         vector3 const&  center,
         natural_32_bit const  ship_index_in_the_area,
         netlab::layer_index_type const  home_layer_index,
+        netlab::object_index_type const  home_spiker_index,
         netlab::layer_index_type const  area_layer_index,
         netlab::network_props const&  props,
         vector3&  ship_position,
         vector3&  ship_velocity 
         )
 {
-    (void)ship_index_in_the_area;
-
     netlab::network_layer_props const&  layer_props = props.layer_props().at(home_layer_index);
 
+    counter_based_random_generator  generator = make_random_generator_of_object(
+            seed_of_ships_in_movement_areas(),
+            home_layer_index,
+            layer_props.ships_begin_index_of_spiker(home_spiker_index) + ship_index_in_the_area
+            );
+
     compute_random_ship_position_in_movement_area(
             center,
             0.5f * layer_props.size_of_ship_movement_area_along_x_axis_in_meters(area_layer_index),
             0.5f * layer_props.size_of_ship_movement_area_along_y_axis_in_meters(area_layer_index),
             0.5f * layer_props.size_of_ship_movement_area_along_c_axis_in_meters(area_layer_index),
-            random_generator(),
+            generator,
             ship_position
             );
     compute_random_ship_velocity_in_movement_area(
             layer_props.min_speed_of_ship_in_meters_per_second(area_layer_index),
             layer_props.max_speed_of_ship_in_meters_per_second(area_layer_index),
-            random_generator(),
+            generator,
             ship_velocity
             );
 }
@@ -486,6 +491,21 @@ struct layer_of_spikers : public netlab::layer_of_spikers
         potential = potential + time_delta_in_seconds * potential_derivative;
     }
 
+    void  integrate_spiking_potential_over(
+            netlab::object_index_type const  spiker_index,
+            natural_64_bit const  num_time_steps,
+            float_32_bit const  time_step_in_seconds,
+            netlab::network_props const&  props
+            ) override
+    {
+        // Each step of 'integrate_spiking_potential' multiplies the distance of the potential from the resting
+        // potential by the same factor. So, the distance after all the steps is given by the power of the factor.
+        auto &potential = get_potential_ref(spiker_index);
+        float_32_bit const  factor_per_step = 1.0f + time_step_in_seconds * get_potential_cooling_coef();
+        potential = self::get_resting_potential() +
+                    std::pow(factor_per_step, (float_32_bit)num_time_steps) * (potential - self::get_resting_potential());
+    }
+
     bool  on_arrival_of_postsynaptic_potential(
             netlab::object_index_type const  spiker_index,
             float_32_bit const  potential_delta,
@@ -517,6 +537,12 @@ struct layer_of_spikers : public netlab::layer_of_spikers
         return ostr;
     }
 
+    natural_64_bit  num_bytes_of_payload() const override { return m_potential.size() * sizeof(float_32_bit); }
+    void  save_payload(natural_8_bit* const  payload) const override
+    { std::memcpy(payload, m_potential.data(), num_bytes_of_payload()); }
+    void  load_payload(natural_8_bit const* const  payload) override
+    { std::memcpy(m_potential.data(), payload, num_bytes_of_payload()); }
+
 private:
     float_32_bit&  get_potential_ref(netlab::object_index_type const  spiker_index) { return m_potential.at(spiker_index); }
 
@@ -6,6 +6,7 @@
 #include <utility/invariants.hpp>
 #include <utility/timeprof.hpp>
 #include <algorithm>
+#include <array>
 #include <limits>
 
 namespace netexp { namespace detail { namespace {
@@ -37,69 +38,269 @@ void  compute_both_change_bboxes(
 }
 
 
+/**
+ * The table of a layer is a 3D Fenwick tree (binary indexed tree) of densities of ships in spiker sectors.
+ * It has one more element than there are spikers along each axis, because the tree is indexed from 1 along
+ * each axis; elements with a zero coordinate are unused. Both updating a density in a single sector and
+ * computing a sum of densities in a box of sectors take O(log(X)*log(Y)*log(C)) time, where X,Y,C are
+ * numbers of spikers along the axes.
+ */
+natural_64_bit  index_into_fenwick_tree(
+        netlab::sector_coordinate_type const  x,
+        netlab::sector_coordinate_type const  y,
+        netlab::sector_coordinate_type const  c,
+        netlab::network_layer_props const&  layer_props
+        )
+{
+    return ((natural_64_bit)c * (layer_props.num_spikers_along_y_axis() + 1ULL) + (natural_64_bit)y)
+                * (layer_props.num_spikers_along_x_axis() + 1ULL)
+           + (natural_64_bit)x;
+}
+
+
+inline netlab::sector_coordinate_type  lowest_bit(netlab::sector_coordinate_type const  i) noexcept
+{
+    return i & (~i + 1U);
+}
+
+
+/// It builds the table from densities in all spiker sectors of the layer in a time linear in the number of sectors.
+void  build_fenwick_tree(
+        netlab::layer_index_type const  layer_index,
+        netlab::network_layer_props const&  layer_props,
+        netlab::accessor_to_extra_data_for_spikers_in_layers const&  extra_data_for_spikers,
+        std::vector<float_64_bit>&  table
+        )
+{
+    TMPROF_BLOCK();
+
+    netlab::sector_coordinate_type const  X = layer_props.num_spikers_along_x_axis();
+    netlab::sector_coordinate_type const  Y = layer_props.num_spikers_along_y_axis();
+    netlab::sector_coordinate_type const  C = layer_props.num_spikers_along_c_axis();
+
+    table.assign(index_into_fenwick_tree(X,Y,C,layer_props) + 1ULL, 0.0);
+
+    auto const  T = [&table, &layer_props](netlab::sector_coordinate_type const  x,
+                                            netlab::sector_coordinate_type const  y,
+                                            netlab::sector_coordinate_type const  c) -> float_64_bit& {
+        return table[index_into_fenwick_tree(x,y,c,layer_props)];
+    };
+
+    for (netlab::sector_coordinate_type c = 0U; c < C; ++c)
+        for (netlab::sector_coordinate_type y = 0U; y < Y; ++y)
+            for (netlab::sector_coordinate_type x = 0U; x < X; ++x)
+                T(x + 1U, y + 1U, c + 1U) = (float_64_bit)extra_data_for_spikers.get_extra_data_of_spiker(
+                                                    layer_index,
+                                                    layer_props.spiker_sector_index(x,y,c)
+                                                    );
+
+    // Each element adds itself to its parent along one axis at a time.
+    for (netlab::sector_coordinate_type c = 1U; c <= C; ++c)
+        for (netlab::sector_coordinate_type y = 1U; y <= Y; ++y)
+            for (netlab::sector_coordinate_type x = 1U; x <= X; ++x)
+                if (x + lowest_bit(x) <= X)
+                    T(x + lowest_bit(x), y, c) += T(x, y, c);
+    for (netlab::sector_coordinate_type c = 1U; c <= C; ++c)
+        for (netlab::sector_coordinate_type y = 1U; y <= Y; ++y)
+            for (netlab::sector_coordinate_type x = 1U; x <= X; ++x)
+                if (y + lowest_bit(y) <= Y)
+                    T(x, y + lowest_bit(y), c) += T(x, y, c);
+    for (netlab::sector_coordinate_type c = 1U; c <= C; ++c)
+        for (netlab::sector_coordinate_type y = 1U; y <= Y; ++y)
+            for (netlab::sector_coordinate_type x = 1U; x <= X; ++x)
+                if (c + lowest_bit(c) <= C)
+                    T(x, y, c + lowest_bit(c)) += T(x, y, c);
+}
+
+
+/// It adds 'delta' to the density in the spiker sector (x,y,c) in the table.
+void  add_to_fenwick_tree(
+        netlab::sector_coordinate_type const  x,
+        netlab::sector_coordinate_type const  y,
+        netlab::sector_coordinate_type const  c,
+        float_64_bit const  delta,
+        netlab::network_layer_props const&  layer_props,
+        std::vector<float_64_bit>&  table
+        )
+{
+    for (netlab::sector_coordinate_type k = c + 1U; k <= layer_props.num_spikers_along_c_axis(); k += lowest_bit(k))
+        for (netlab::sector_coordinate_type j = y + 1U; j <= layer_props.num_spikers_along_y_axis(); j += lowest_bit(j))
+            for (netlab::sector_coordinate_type i = x + 1U; i <= layer_props.num_spikers_along_x_axis(); i += lowest_bit(i))
+                table[index_into_fenwick_tree(i,j,k,layer_props)] += delta;
+}
+
+
+/// Returns the sum of densities of ships in spiker sectors (x,y,c) such that x < x_end, y < y_end, and c < c_end.
+float_64_bit  sum_of_densities_in_sectors_before(
+        netlab::sector_coordinate_type const  x_end,
+        netlab::sector_coordinate_type const  y_end,
+        netlab::sector_coordinate_type const  c_end,
+        netlab::network_layer_props const&  layer_props,
+        std::vector<float_64_bit> const&  table
+        )
+{
+    float_64_bit  sum = 0.0;
+    for (netlab::sector_coordinate_type k = c_end; k != 0U; k -= lowest_bit(k))
+        for (netlab::sector_coordinate_type j = y_end; j != 0U; j -= lowest_bit(j))
+            for (netlab::sector_coordinate_type i = x_end; i != 0U; i -= lowest_bit(i))
+                sum += table[index_into_fenwick_tree(i,j,k,layer_props)];
+    return sum;
+}
+
+
+/// Returns the sum of densities of ships in spiker sectors (x,y,c) such that x_lo <= x <= x_hi, y_lo <= y <= y_hi,
+/// and c_lo <= c <= c_hi.
+float_64_bit  sum_of_densities_in_sectors(
+        netlab::sector_coordinate_type const  x_lo,
+        netlab::sector_coordinate_type const  y_lo,
+        netlab::sector_coordinate_type const  c_lo,
+        netlab::sector_coordinate_type const  x_hi,
+        netlab::sector_coordinate_type const  y_hi,
+        netlab::sector_coordinate_type const  c_hi,
+        netlab::network_layer_props const&  layer_props,
+        std::vector<float_64_bit> const&  table
+        )
+{
+    auto const  S = [&table, &layer_props](netlab::sector_coordinate_type const  x,
+                                            netlab::sector_coordinate_type const  y,
+                                            netlab::sector_coordinate_type const  c) -> float_64_bit {
+        return sum_of_densities_in_sectors_before(x,y,c,layer_props,table);
+    };
+
+    return    S(x_hi + 1U, y_hi + 1U, c_hi + 1U)
+            - S(x_lo, y_hi + 1U, c_hi + 1U) - S(x_hi + 1U, y_lo, c_hi + 1U) - S(x_hi + 1U, y_hi + 1U, c_lo)
+            + S(x_lo, y_lo, c_hi + 1U) + S(x_lo, y_hi + 1U, c_lo) + S(x_hi + 1U, y_lo, c_lo)
+            - S(x_lo, y_lo, c_lo)
+            ;
+}
+
+
+struct  weighted_range_of_sectors
+{
+    float_64_bit  weight;
+    netlab::sector_coordinate_type  lo;
+    netlab::sector_coordinate_type  hi;
+};
+
+
+/**
+ * Let 'overlap(s)' be the length of the intersection of the interval [low,high] with the spiker sector 's' along
+ * the axis 'coord_index', for each sector 's' in [lo,hi]. The function computes ranges of sectors along the axis,
+ * such that for any values 'v(s)' the sum of 'weight * v(s)' over all the ranges equals the sum of 'overlap(s) * v(s)'
+ * over [lo,hi]. Only the first and the last sector may overlap only partially, so at most 3 ranges are needed.
+ * The function returns the number of the ranges. It also computes the sums of 'overlap(s)' and 'overlap(s)^2' over [lo,hi].
+ */
+natural_32_bit  compute_weighted_ranges_of_sectors_along_axis(
+        int const  coord_index,
+        float_32_bit const  low,
+        float_32_bit const  high,
+        netlab::sector_coordinate_type const  lo,
+        netlab::sector_coordinate_type const  hi,
+        netlab::network_layer_props const&  layer_props,
+        std::array<weighted_range_of_sectors, 3ULL>&  ranges,
+        float_64_bit&  sum_of_overlaps,
+        float_64_bit&  sum_of_squared_overlaps
+        )
+{
+    float_32_bit const  sector_size = layer_props.distance_of_spikers_in_meters()(coord_index);
+    float_32_bit const  low_of_sectors = layer_props.low_corner_of_spikers()(coord_index) - 0.5f * sector_size;
+    auto const  overlap = [low, high, low_of_sectors, sector_size](netlab::sector_coordinate_type const  s) -> float_64_bit {
+        float_32_bit const  sector_low = low_of_sectors + (float_32_bit)s * sector_size;
+        return std::max(0.0f, std::min(high, sector_low + sector_size) - std::max(low, sector_low));
+    };
+
+    float_64_bit const  overlap_lo = overlap(lo);
+    if (lo == hi)
+    {
+        ranges.at(0ULL) = { overlap_lo, lo, lo };
+        sum_of_overlaps = overlap_lo;
+        sum_of_squared_overlaps = overlap_lo * overlap_lo;
+        return 1U;
+    }
+    float_64_bit const  overlap_hi = overlap(hi);
+    ranges.at(0ULL) = { sector_size, lo, hi };
+    ranges.at(1ULL) = { overlap_lo - sector_size, lo, lo };
+    ranges.at(2ULL) = { overlap_hi - sector_size, hi, hi };
+    float_64_bit const  num_inner_sectors = (float_64_bit)(hi - lo - 1U);
+    sum_of_overlaps = overlap_lo + overlap_hi + num_inner_sectors * sector_size;
+    sum_of_squared_overlaps = overlap_lo * overlap_lo + overlap_hi * overlap_hi
+                              + num_inner_sectors * sector_size * sector_size;
+    return 3U;
+}
+
+
+/**
+ * When the density 'd' in a spiker sector changes by 'delta', then the score of the sector is the reduction
+ * of the squared distance to the ideal density 'D', i.e. (D - d)^2 - (D - d - delta)^2 = 2*delta*(D - d) - delta^2.
+ * Here 'delta' is proportional to the volume of the intersection of the box with the sector, and the volume
+ * is a product of overlaps along the axes. So, the sum of scores of all sectors intersecting the box is
+ * computed from sums of densities in at most 27 boxes of sectors, each obtained from the Fenwick tree.
+ */
 float_32_bit  compute_score(
         vector3 const&  low_corner,
         vector3 const&  high_corner,
         float_32_bit const  volume_mult,
         float_32_bit const  density_of_ships_in_movement_area,
         float_32_bit const  ideal_average_density_in_layer,
-        netlab::layer_index_type const  layer_index,
         netlab::network_layer_props const&  area_layer_props,
-        netlab::accessor_to_extra_data_for_spikers_in_layers const&  extra_data_for_spikers
+        std::vector<float_64_bit> const&  summed_densities_of_ships
         )
 {
     TMPROF_BLOCK();
 
-    float_32_bit  score = 0.0f;
     float_32_bit const  spiker_sector_volume = 
             area_layer_props.distance_of_spikers_in_meters()(0) *
             area_layer_props.distance_of_spikers_in_meters()(1) *
             area_layer_props.distance_of_spikers_in_meters()(2) ;
-    netlab::sector_coordinate_type  x_lo, y_lo, c_lo;
-    area_layer_props.spiker_sector_coordinates(low_corner,x_lo,y_lo,c_lo);
-    netlab::sector_coordinate_type  x_hi, y_hi, c_hi;
-    area_layer_props.spiker_sector_coordinates(high_corner,x_hi,y_hi,c_hi);
-    for (netlab::sector_coordinate_type x = x_lo; x <= x_hi; ++x)
-        for (netlab::sector_coordinate_type y = y_lo; y <= y_hi; ++y)
-            for (netlab::sector_coordinate_type c = c_lo; c <= c_hi; ++c)
-            {
-                vector3 const  spiker_position = area_layer_props.spiker_sector_centre(x,y,c);
-                netlab::object_index_type const  spiker_index = area_layer_props.spiker_sector_index(x,y,c);
-
-                vector3  intersection_low_corner, intersection_high_corner;
-                bool const  do_intersect = angeo::collision_bbox_bbox(
-                        spiker_position - 0.5f * area_layer_props.distance_of_spikers_in_meters(),
-                        spiker_position + 0.5f * area_layer_props.distance_of_spikers_in_meters(),
-                        low_corner,
-                        high_corner,
-                        intersection_low_corner,
-                        intersection_high_corner
-                        );
-                INVARIANT(do_intersect);
-
-                vector3 const  size = intersection_high_corner - intersection_low_corner;
-
-                float_32_bit const  volume = volume_mult * size(0) * size(1) * size(2);
-                float_32_bit const  density_delta = density_of_ships_in_movement_area * (volume / spiker_sector_volume);
-                float_32_bit const  orig_sector_density = extra_data_for_spikers.get_extra_data_of_spiker(layer_index,spiker_index);
-                ASSUMPTION(orig_sector_density >= 0.0f);
-                ASSUMPTION(orig_sector_density + density_delta >= 0.0f);
-
-                float_32_bit const  orig_distance_to_ideal =
-                        std::fabsf(ideal_average_density_in_layer - orig_sector_density);
-                float_32_bit const  new_distance_to_ideal =
-                        std::fabsf(ideal_average_density_in_layer - orig_sector_density - density_delta);
-
-                float_32_bit const  max_distance_to_ideal = std::max(orig_distance_to_ideal,new_distance_to_ideal);
-                float_32_bit const  distance_change = orig_distance_to_ideal - new_distance_to_ideal;
-
-                float_32_bit const  score_mult = 1000.0f;
-
-                float_32_bit const  sector_score = score_mult * distance_change * max_distance_to_ideal;
-
-                score += sector_score;
-            }
-    return score;
+    netlab::sector_coordinate_type  lo[3];
+    area_layer_props.spiker_sector_coordinates(low_corner,lo[0],lo[1],lo[2]);
+    netlab::sector_coordinate_type  hi[3];
+    area_layer_props.spiker_sector_coordinates(high_corner,hi[0],hi[1],hi[2]);
+
+    std::array<weighted_range_of_sectors, 3ULL>  ranges[3];
+    natural_32_bit  num_ranges[3];
+    float_64_bit  sum_of_overlaps[3];
+    float_64_bit  sum_of_squared_overlaps[3];
+    for (int i = 0; i != 3; ++i)
+        num_ranges[i] = compute_weighted_ranges_of_sectors_along_axis(
+                                i,
+                                low_corner(i),
+                                high_corner(i),
+                                lo[i],
+                                hi[i],
+                                area_layer_props,
+                                ranges[i],
+                                sum_of_overlaps[i],
+                                sum_of_squared_overlaps[i]
+                                );
+
+    float_64_bit  weighted_sum_of_densities = 0.0;
+    for (natural_32_bit i = 0U; i != num_ranges[0]; ++i)
+        for (natural_32_bit j = 0U; j != num_ranges[1]; ++j)
+            for (natural_32_bit k = 0U; k != num_ranges[2]; ++k)
+                weighted_sum_of_densities +=
+                        ranges[0][i].weight * ranges[1][j].weight * ranges[2][k].weight *
+                        sum_of_densities_in_sectors(
+                                ranges[0][i].lo, ranges[1][j].lo, ranges[2][k].lo,
+                                ranges[0][i].hi, ranges[1][j].hi, ranges[2][k].hi,
+                                area_layer_props,
+                                summed_densities_of_ships
+                                );
+
+    float_64_bit const  density_delta_per_volume =
+            volume_mult * density_of_ships_in_movement_area / spiker_sector_volume;
+    float_64_bit const  sum_of_distances_to_ideal =
+            (float_64_bit)ideal_average_density_in_layer * sum_of_overlaps[0] * sum_of_overlaps[1] * sum_of_overlaps[2]
+            - weighted_sum_of_densities;
+    float_64_bit const  sum_of_squared_volumes =
+            sum_of_squared_overlaps[0] * sum_of_squared_overlaps[1] * sum_of_squared_overlaps[2];
+
+    float_64_bit const  score_mult = 1000.0;
+
+    return (float_32_bit)(score_mult * (
+                    2.0 * density_delta_per_volume * sum_of_distances_to_ideal
+                    - density_delta_per_volume * density_delta_per_volume * sum_of_squared_volumes
+                    ));
 }
 
 
@@ -110,9 +311,8 @@ float_32_bit  compute_score(
         int const  coord_index,
         float_32_bit const  coord_shift,
         float_32_bit const  ideal_average_density_in_layer,
-        netlab::layer_index_type const  layer_index,
         netlab::network_layer_props const&  area_layer_props,
-        netlab::accessor_to_extra_data_for_spikers_in_layers const&  extra_data_for_spikers
+        std::vector<float_64_bit> const&  summed_densities_of_ships
         )
 {
     TMPROF_BLOCK();
@@ -144,9 +344,8 @@ float_32_bit  compute_score(
                 volume_mult_0,
                 density_of_ships,
                 ideal_average_density_in_layer,
-                layer_index,
                 area_layer_props,
-                extra_data_for_spikers
+                summed_densities_of_ships
                 )
             +
             compute_score(
@@ -155,13 +354,31 @@ float_32_bit  compute_score(
                 volume_mult_1,
                 density_of_ships,
                 ideal_average_density_in_layer,
-                layer_index,
                 area_layer_props,
-                extra_data_for_spikers
+                summed_densities_of_ships
                 );
 }
 
 
+float_64_bit  compute_sum_of_squared_distances_to_ideal_density(
+        netlab::layer_index_type const  layer_index,
+        netlab::network_layer_props const&  layer_props,
+        float_32_bit const  ideal_average_density_in_layer,
+        netlab::accessor_to_extra_data_for_spikers_in_layers const&  extra_data_for_spikers
+        )
+{
+    float_64_bit  sum = 0.0;
+    for (netlab::object_index_type spiker_index = 0ULL; spiker_index != layer_props.num_spikers(); ++spiker_index)
+    {
+        float_64_bit const  distance =
+                (float_64_bit)ideal_average_density_in_layer -
+                (float_64_bit)extra_data_for_spikers.get_extra_data_of_spiker(layer_index,spiker_index);
+        sum += distance * distance;
+    }
+    return sum;
+}
+
+
 float_32_bit  update_densities_in_bbox(
         vector3 const&  low_corner,
         vector3 const&  high_corner,
@@ -169,7 +386,8 @@ float_32_bit  update_densities_in_bbox(
         float_32_bit const  density_of_ships_in_movement_area,
         netlab::layer_index_type const  layer_index,
         netlab::network_layer_props const&  area_layer_props,
-        netlab::accessor_to_extra_data_for_spikers_in_layers&  extra_data_for_spikers
+        netlab::accessor_to_extra_data_for_spikers_in_layers&  extra_data_for_spikers,
+        std::vector<float_64_bit>&  summed_densities_of_ships
         )
 {
     TMPROF_BLOCK();
@@ -209,7 +427,16 @@ float_32_bit  update_densities_in_bbox(
                     ASSUMPTION(orig_sector_density >= 0.0f);
                     ASSUMPTION(orig_sector_density + density_delta >= 0.0f);
 
-                    extra_data_for_spikers.set_extra_data_of_spiker(layer_index,spiker_index,orig_sector_density + density_delta);
+                    float_32_bit const  new_sector_density = orig_sector_density + density_delta;
+                    extra_data_for_spikers.set_extra_data_of_spiker(layer_index,spiker_index,new_sector_density);
+                    add_to_fenwick_tree(
+                            x,
+                            y,
+                            c,
+                            (float_64_bit)new_sector_density - (float_64_bit)orig_sector_density,
+                            area_layer_props,
+                            summed_densities_of_ships
+                            );
                     total_density_delta += density_delta;
             }
     return total_density_delta;
@@ -224,6 +451,7 @@ void  shift_movement_area_center(
         netlab::layer_index_type const  layer_index,
         netlab::network_layer_props const&  area_layer_props,
         netlab::accessor_to_extra_data_for_spikers_in_layers&  extra_data_for_spikers,
+        std::vector<float_64_bit>&  summed_densities_of_ships,
         vector3&  area_center
         )
 {
@@ -258,7 +486,8 @@ void  shift_movement_area_center(
                 density_of_ships,
                 layer_index,
                 area_layer_props,
-                extra_data_for_spikers
+                extra_data_for_spikers,
+                summed_densities_of_ships
                 );
     total_density_delta += 
         update_densities_in_bbox(
@@ -268,7 +497,8 @@ void  shift_movement_area_center(
                 density_of_ships,
                 layer_index,
                 area_layer_props,
-                extra_data_for_spikers
+                extra_data_for_spikers,
+                summed_densities_of_ships
                 );
     INVARIANT(std::fabsf(total_density_delta) < 1e-3f);
 
@@ -291,14 +521,28 @@ void  incremental_initialiser_of_movement_area_centers::prepare_for_shifting_mov
 {
     TMPROF_BLOCK();
 
-    compute_densities_of_ships_per_spiker_in_layers(props, movement_area_centers, extra_data_for_spikers);
+    compute_densities_of_ships_per_spiker_in_layers(props, movement_area_centers, extra_data_for_spikers, nullptr, 1U);
     m_sources.resize(props.layer_props().size(),true);
     m_updated.resize(props.layer_props().size(),true);
     m_solved.resize(props.layer_props().size(),false);
     compute_ideal_densities_of_ships_in_layers(props,m_ideal_average_ship_densities_in_layers);
 
-    m_dbg_scores_old.resize(props.layer_props().size(),std::numeric_limits<float_32_bit>::max());
-    m_dbg_scores_new.resize(props.layer_props().size(),std::numeric_limits<float_32_bit>::max());
+    m_summed_densities_of_ships_in_layers.resize(props.layer_props().size());
+    for (netlab::layer_index_type layer_index = 0U; layer_index != props.layer_props().size(); ++layer_index)
+    {
+        netlab::network_layer_props const&  layer_props = props.layer_props().at(layer_index);
+        detail::build_fenwick_tree(
+                layer_index,
+                layer_props,
+                extra_data_for_spikers,
+                m_summed_densities_of_ships_in_layers.at(layer_index)
+                );
+    }
+
+    m_dbg_sums_of_squared_distances_to_ideal_densities.resize(
+            props.layer_props().size(),
+            std::numeric_limits<float_64_bit>::max()
+            );
 }
 
 
@@ -328,18 +572,67 @@ void  incremental_initialiser_of_movement_area_centers::get_indices_of_layers_wh
 
     std::fill(m_updated.begin(),m_updated.end(),false);
 
-    // I did not prove that the following invariant statement is really an invariant. However, 
-    // it is desired the score function to be non-increasing. So, the purpose of the statement
-    // should be treated as a debug code (to catch a case, then the score function becomes inreasing).
+    // Each accepted shift of a movement area center reduces the sum of squared distances of densities of ships
+    // in spiker sectors to the ideal density in the layer exactly by its (positive) score. So, the sum cannot
+    // increase, up to rounding errors of densities stored in 32-bit floats. The check should be treated as a debug
+    // code (to catch a case, when scores computed from Fenwick trees disagree with the densities).
     INVARIANT(
-        [](std::vector<float_32_bit> const&  old_scores, std::vector<float_32_bit> const&  new_scores) -> bool {
-            for (natural_64_bit  i = 0ULL; i != old_scores.size(); ++i)
-                if (old_scores.at(i) < new_scores.at(i))
+        [this](netlab::network_props const&  props,
+               netlab::accessor_to_extra_data_for_spikers_in_layers const&  extra_data_for_spikers) -> bool {
+            for (netlab::layer_index_type layer_index = 0U; layer_index != props.layer_props().size(); ++layer_index)
+            {
+                float_64_bit const  sum = detail::compute_sum_of_squared_distances_to_ideal_density(
+                                                layer_index,
+                                                props.layer_props().at(layer_index),
+                                                m_ideal_average_ship_densities_in_layers.at(layer_index),
+                                                extra_data_for_spikers
+                                                );
+                float_64_bit&  old_sum = m_dbg_sums_of_squared_distances_to_ideal_densities.at(layer_index);
+                if (sum > old_sum + 1e-4 * (1.0 + old_sum))
                     return false;
+                old_sum = sum;
+            }
             return true;
-        }(m_dbg_scores_old,m_dbg_scores_new));
-    std::copy(m_dbg_scores_new.cbegin(),m_dbg_scores_new.cend(),m_dbg_scores_old.begin());
-    std::fill(m_dbg_scores_new.begin(),m_dbg_scores_new.end(),0.0f);
+        }(props,extra_data_for_spikers));
+}
+
+
+std::array<natural_32_bit, 3ULL>  incremental_initialiser_of_movement_area_centers::get_extents_of_independent_shifts_of_movement_area_centers(
+        netlab::layer_index_type const  spiker_layer_index,
+        netlab::network_props const&  props
+        ) const
+{
+    TMPROF_BLOCK();
+
+    netlab::network_layer_props const&  spiker_layer_props = props.layer_props().at(spiker_layer_index);
+
+    // A shift reads and writes densities only inside the maximal bbox of the movement area of the spiker. So, spikers
+    // are independent, when the distance of their positions projected to the area layer exceeds the size of the bbox.
+    std::array<natural_32_bit, 3ULL>  extents = { 1U, 1U, 1U };
+    for (netlab::layer_index_type area_layer_index = 0U; area_layer_index != props.layer_props().size(); ++area_layer_index)
+    {
+        netlab::network_layer_props const&  area_layer_props = props.layer_props().at(area_layer_index);
+        std::array<natural_32_bit, 3ULL> const&  max_distances =
+                m_get_max_area_distance_from_spiker(spiker_layer_index,area_layer_index);
+        vector3 const&  size_of_area = spiker_layer_props.size_of_ship_movement_area_in_meters(area_layer_index);
+        for (int i = 0; i != 3; ++i)
+        {
+            float_32_bit const  size_of_bbox =
+                    2.0f * (float_32_bit)max_distances.at(i) * area_layer_props.distance_of_spikers_in_meters()(i)
+                    + size_of_area(i)
+                    + area_layer_props.distance_of_docks_in_meters();
+            float_32_bit const  distance_of_projected_spikers =
+                    area_layer_index == spiker_layer_index ?
+                            spiker_layer_props.distance_of_spikers_in_meters()(i) :
+                            spiker_layer_props.distance_of_spikers_in_meters()(i)
+                                * (area_layer_props.high_corner_of_ships()(i) - area_layer_props.low_corner_of_ships()(i))
+                                / (spiker_layer_props.high_corner_of_ships()(i) - spiker_layer_props.low_corner_of_ships()(i));
+            // One more sector covers rounding errors in computation of bboxes.
+            extents.at(i) = std::max(extents.at(i),
+                                     (natural_32_bit)std::ceil(size_of_bbox / distance_of_projected_spikers) + 1U);
+        }
+    }
+    return extents;
 }
 
 
@@ -358,13 +651,58 @@ void  incremental_initialiser_of_movement_area_centers::on_shift_movement_area_c
 {
     TMPROF_BLOCK();
 
+    vector3  moved_area_center;
+    if (compute_shift_of_movement_area_center_in_layer(
+                spiker_layer_index,
+                spiker_index_into_layer,
+                spiker_sector_coordinate_x,
+                spiker_sector_coordinate_y,
+                spiker_sector_coordinate_c,
+                area_layer_index,
+                props,
+                movement_area_centers,
+                area_center,
+                extra_data_for_spikers,
+                moved_area_center
+                ))
+        apply_shift_of_movement_area_center_in_layer(
+                spiker_layer_index,
+                spiker_index_into_layer,
+                spiker_sector_coordinate_x,
+                spiker_sector_coordinate_y,
+                spiker_sector_coordinate_c,
+                area_layer_index,
+                props,
+                moved_area_center,
+                area_center,
+                extra_data_for_spikers
+                );
+}
+
+
+bool  incremental_initialiser_of_movement_area_centers::compute_shift_of_movement_area_center_in_layer(
+        netlab::layer_index_type const  spiker_layer_index,
+        netlab::object_index_type const  spiker_index_into_layer,
+        netlab::sector_coordinate_type const  spiker_sector_coordinate_x,
+        netlab::sector_coordinate_type const  spiker_sector_coordinate_y,
+        netlab::sector_coordinate_type const  spiker_sector_coordinate_c,
+        netlab::layer_index_type const  area_layer_index,
+        netlab::network_props const&  props,
+        netlab::access_to_movement_area_centers const&  movement_area_centers,
+        vector3 const&  area_center,
+        netlab::accessor_to_extra_data_for_spikers_in_layers const&  extra_data_for_spikers,
+        vector3&  moved_area_center
+        ) const
+{
+    TMPROF_BLOCK();
+
     ASSUMPTION(spiker_layer_index < m_sources.size());
     ASSUMPTION(area_layer_index < m_sources.size());
     ASSUMPTION(m_sources.size() == props.layer_props().size());
     ASSUMPTION(spiker_index_into_layer < props.layer_props().at(spiker_layer_index).num_spikers());
 
     if (m_solved.at(area_layer_index) == true)
-        return;
+        return false;
 
     vector3 const  spiker_position =
             compute_spiker_position_projected_to_area_layer(
@@ -443,9 +781,8 @@ void  incremental_initialiser_of_movement_area_centers::on_shift_movement_area_c
                         index_shift.first,
                         moved_area_center(index_shift.first) - area_center(index_shift.first),
                         m_ideal_average_ship_densities_in_layers.at(area_layer_index),
-                        area_layer_index,
                         area_layer_props,
-                        extra_data_for_spikers
+                        m_summed_densities_of_ships_in_layers.at(area_layer_index)
                         );
         if (score > score_limit + 1e-3f && score > best_score)
         {
@@ -454,37 +791,84 @@ void  incremental_initialiser_of_movement_area_centers::on_shift_movement_area_c
         }
     }
 
-    if (best_score > score_limit)
-    {
-        detail::shift_movement_area_center(
-                size_of_area,
-                spiker_layer_props.num_ships_per_spiker(),
-                best_shift.first,
-                best_shift.second,
-                area_layer_index,
-                area_layer_props,
-                extra_data_for_spikers,
-                area_center
-                );
+    if (best_score <= score_limit)
+        return false;
 
-        INVARIANT(
-            std::fabsf(area_center(0) - spiker_position(0)) <
-                (float_32_bit)max_distances.at(0) * area_layer_props.distance_of_spikers_along_x_axis_in_meters() +
-                area_layer_props.distance_of_docks_in_meters() &&
-            std::fabsf(area_center(1) - spiker_position(1)) <
-                (float_32_bit)max_distances.at(1) * area_layer_props.distance_of_spikers_along_y_axis_in_meters() +
-                area_layer_props.distance_of_docks_in_meters() &&
-            std::fabsf(area_center(2) - spiker_position(2)) <
-                (float_32_bit)max_distances.at(2) * area_layer_props.distance_of_spikers_along_c_axis_in_meters() +
-                area_layer_props.distance_of_docks_in_meters()
+    moved_area_center = area_center;
+    moved_area_center(best_shift.first) += best_shift.second;
+
+    return true;
+}
+
+
+void  incremental_initialiser_of_movement_area_centers::apply_shift_of_movement_area_center_in_layer(
+        netlab::layer_index_type const  spiker_layer_index,
+        netlab::object_index_type const  spiker_index_into_layer,
+        netlab::sector_coordinate_type const  spiker_sector_coordinate_x,
+        netlab::sector_coordinate_type const  spiker_sector_coordinate_y,
+        netlab::sector_coordinate_type const  spiker_sector_coordinate_c,
+        netlab::layer_index_type const  area_layer_index,
+        netlab::network_props const&  props,
+        vector3 const&  moved_area_center,
+        vector3&  area_center,
+        netlab::accessor_to_extra_data_for_spikers_in_layers&  extra_data_for_spikers
+        )
+{
+    TMPROF_BLOCK();
+
+    ASSUMPTION(spiker_layer_index < m_sources.size());
+    ASSUMPTION(area_layer_index < m_sources.size());
+
+    int const  coord_index = moved_area_center(0) != area_center(0) ? 0 :
+                             moved_area_center(1) != area_center(1) ? 1 :
+                                                                      2 ;
+    ASSUMPTION(
+        [coord_index](vector3 const&  moved_area_center, vector3 const&  area_center) -> bool {
+            for (int i = 0; i != 3; ++i)
+                if (i != coord_index && moved_area_center(i) != area_center(i))
+                    return false;
+            return moved_area_center(coord_index) != area_center(coord_index);
+        }(moved_area_center, area_center)
+        );
+
+    netlab::network_layer_props const&  spiker_layer_props = props.layer_props().at(spiker_layer_index);
+    netlab::network_layer_props const&  area_layer_props = props.layer_props().at(area_layer_index);
+
+    detail::shift_movement_area_center(
+            spiker_layer_props.size_of_ship_movement_area_in_meters(area_layer_index),
+            spiker_layer_props.num_ships_per_spiker(),
+            coord_index,
+            moved_area_center(coord_index) - area_center(coord_index),
+            area_layer_index,
+            area_layer_props,
+            extra_data_for_spikers,
+            m_summed_densities_of_ships_in_layers.at(area_layer_index),
+            area_center
             );
 
-        m_sources.at(spiker_layer_index) = true;
-        m_updated.at(area_layer_index) = true;
+    INVARIANT(
+        [&](    netlab::sector_coordinate_type const  x,
+                netlab::sector_coordinate_type const  y,
+                netlab::sector_coordinate_type const  c) -> bool {
+            vector3 const  spiker_position =
+                    compute_spiker_position_projected_to_area_layer(spiker_layer_index, area_layer_index, x, y, c, props);
+            auto const&  max_distances = m_get_max_area_distance_from_spiker(spiker_layer_index,area_layer_index);
+            return
+                std::fabsf(area_center(0) - spiker_position(0)) <
+                    (float_32_bit)max_distances.at(0) * area_layer_props.distance_of_spikers_along_x_axis_in_meters() +
+                    area_layer_props.distance_of_docks_in_meters() &&
+                std::fabsf(area_center(1) - spiker_position(1)) <
+                    (float_32_bit)max_distances.at(1) * area_layer_props.distance_of_spikers_along_y_axis_in_meters() +
+                    area_layer_props.distance_of_docks_in_meters() &&
+                std::fabsf(area_center(2) - spiker_position(2)) <
+                    (float_32_bit)max_distances.at(2) * area_layer_props.distance_of_spikers_along_c_axis_in_meters() +
+                    area_layer_props.distance_of_docks_in_meters()
+                ;
+        }(spiker_sector_coordinate_x, spiker_sector_coordinate_y, spiker_sector_coordinate_c)
+        );
 
-        m_dbg_scores_new.at(area_layer_index) += best_score;
-    }
+    m_sources.at(spiker_layer_index) = true;
+    m_updated.at(area_layer_index) = true;
 }
 
-
 }
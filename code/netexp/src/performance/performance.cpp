@@ -158,11 +158,16 @@ std::shared_ptr<netlab::network_props>  get_network_props()
 }
 
 
+/// Seeds of streams of random numbers of initialisers below. Each spiker and each ship draws from its own stream.
+inline constexpr natural_64_bit  seed_of_movement_area_centers() noexcept { return 1ULL; }
+inline constexpr natural_64_bit  seed_of_ships_in_movement_areas() noexcept { return 2ULL; }
+
+
 struct  initialiser_of_movement_area_centers : public netlab::initialiser_of_movement_area_centers
 {
     initialiser_of_movement_area_centers();
 
-    void  on_next_layer(netlab::layer_index_type const  layer_index, netlab::network_props const&  props);
+    bool  can_compute_initial_movement_area_centers_concurrently() const override { return true; }
 
     void  compute_initial_movement_area_center_for_ships_of_spiker(
             netlab::layer_index_type const  spiker_layer_index,
@@ -177,12 +182,10 @@ struct  initialiser_of_movement_area_centers : public netlab::initialiser_of_mov
 
 private:
     std::vector<bar_random_distribution>  m_distribution_of_spiker_layer;
-    random_generator_for_natural_32_bit  m_generator_of_spiker_layer;
 
     std::vector<netlab::sector_coordinate_type>  m_max_distance_x;
     std::vector<netlab::sector_coordinate_type>  m_max_distance_y;
     std::vector<netlab::sector_coordinate_type>  m_max_distance_c;
-    random_generator_for_natural_32_bit  m_position_generator;
 };
 
 initialiser_of_movement_area_centers::initialiser_of_movement_area_centers()
@@ -203,8 +206,6 @@ initialiser_of_movement_area_centers::initialiser_of_movement_area_centers()
                 get_network_props()->layer_props().at(2UL).num_spikers(),
                 }),
             })
-    , m_generator_of_spiker_layer()
-
     , m_max_distance_x({
             get_network_props()->layer_props().at(0UL).num_spikers_along_x_axis(),
             get_network_props()->layer_props().at(1UL).num_spikers_along_x_axis(),
@@ -220,7 +221,6 @@ initialiser_of_movement_area_centers::initialiser_of_movement_area_centers()
            get_network_props()->layer_props().at(1UL).num_spikers_along_c_axis(),
            get_network_props()->layer_props().at(2UL).num_spikers_along_c_axis(),
            })
-    , m_position_generator()
 {
     ASSUMPTION(
         [](std::vector<bar_random_distribution> const&  distributions, natural_64_bit const  size) -> bool {
@@ -237,17 +237,6 @@ initialiser_of_movement_area_centers::initialiser_of_movement_area_centers()
     ASSUMPTION(m_max_distance_c.size() == get_network_props()->layer_props().size());
 }
 
-void  initialiser_of_movement_area_centers::on_next_layer(
-        netlab::layer_index_type const  layer_index,
-        netlab::network_props const&  props
-        )
-{
-    (void)layer_index;
-    (void)props;
-    reset(m_generator_of_spiker_layer);
-    reset(m_position_generator);
-}
-
 void  initialiser_of_movement_area_centers::compute_initial_movement_area_center_for_ships_of_spiker(
         netlab::layer_index_type const  spiker_layer_index,
         netlab::object_index_type const  spiker_index_into_layer,
@@ -259,8 +248,13 @@ void  initialiser_of_movement_area_centers::compute_initial_movement_area_center
         vector3&  area_center
         )
 {
+    counter_based_random_generator  generator = make_random_generator_of_object(
+            seed_of_movement_area_centers(),
+            spiker_layer_index,
+            spiker_index_into_layer
+            );
     area_layer_index = static_cast<netlab::layer_index_type>(
-                            get_random_bar_index(m_distribution_of_spiker_layer.at(spiker_layer_index),m_generator_of_spiker_layer)
+                            get_random_bar_index(m_distribution_of_spiker_layer.at(spiker_layer_index),generator)
                             );
     compute_initial_movement_area_center_for_ships_of_spiker_XYC(
             spiker_layer_index,
@@ -273,7 +267,7 @@ void  initialiser_of_movement_area_centers::compute_initial_movement_area_center
             m_max_distance_x.at(area_layer_index),
             m_max_distance_y.at(area_layer_index),
             m_max_distance_c.at(area_layer_index),
-            m_position_generator,
+            generator,
             area_center
             );
 }
@@ -283,8 +277,7 @@ struct  initialiser_of_ships_in_movement_areas : public netlab::initialiser_of_s
 {
     initialiser_of_ships_in_movement_areas();
 
-    void  on_next_layer(netlab::layer_index_type const  layer_index, netlab::network_props const&  props)
-    { reset(random_generator()); }
+    bool  can_compute_ships_in_movement_areas_concurrently() const override { return true; }
 
     void  on_next_area(
             netlab::layer_index_type const  layer_index,
@@ -297,49 +290,49 @@ struct  initialiser_of_ships_in_movement_areas : public netlab::initialiser_of_s
             vector3 const&  center,
             natural_32_bit const  ship_index_in_the_area,
             netlab::layer_index_type const  home_layer_index,
+            netlab::object_index_type const  home_spiker_index,
             netlab::layer_index_type const  area_layer_index,
             netlab::network_props const&  props,
             vector3&  ship_position,
             vector3&  ship_velocity 
             );
-
-    random_generator_for_natural_32_bit&  random_generator() noexcept { return m_generator; }
-
-private:
-    random_generator_for_natural_32_bit  m_generator;
 };
 
 initialiser_of_ships_in_movement_areas::initialiser_of_ships_in_movement_areas()
     : netlab::initialiser_of_ships_in_movement_areas()
-    , m_generator()
 {}
 
 void  initialiser_of_ships_in_movement_areas::compute_ship_position_and_velocity_in_movement_area(
         vector3 const&  center,
         natural_32_bit const  ship_index_in_the_area,
         netlab::layer_index_type const  home_layer_index,
+        netlab::object_index_type const  home_spiker_index,
         netlab::layer_index_type const  area_layer_index,
         netlab::network_props const&  props,
         vector3&  ship_position,
         vector3&  ship_velocity 
         )
 {
-    (void)ship_index_in_the_area;
-
     netlab::network_layer_props const&  layer_props = props.layer_props().at(home_layer_index);
 
+    counter_based_random_generator  generator = make_random_generator_of_object(
+            seed_of_ships_in_movement_areas(),
+            home_layer_index,
+            layer_props.ships_begin_index_of_spiker(home_spiker_index) + ship_index_in_the_area
+            );
+
     compute_random_ship_position_in_movement_area(
             center,
             0.5f * layer_props.size_of_ship_movement_area_along_x_axis_in_meters(area_layer_index),
             0.5f * layer_props.size_of_ship_movement_area_along_y_axis_in_meters(area_layer_index),
             0.5f * layer_props.size_of_ship_movement_area_along_c_axis_in_meters(area_layer_index),
-            random_generator(),
+            generator,
             ship_position
             );
     compute_random_ship_velocity_in_movement_area(
             layer_props.min_speed_of_ship_in_meters_per_second(area_layer_index),
             layer_props.max_speed_of_ship_in_meters_per_second(area_layer_index),
-            random_generator(),
+            generator,
             ship_velocity
             );
 }
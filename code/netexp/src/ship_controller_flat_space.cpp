@@ -40,16 +40,26 @@ vector3  ship_controller_flat_space::accelerate_into_dock(
 {
     TMPROF_BLOCK();
 
-    vector3 const  dock_ship_positions_delta = dock_position - ship_position;
-    float_32_bit const  distance_to_dock = length(dock_ship_positions_delta);
-    vector3 const  accel_dir =
-            (distance_to_dock < 0.001f) ? vector3_zero() : (1.0f / distance_to_dock) * dock_ship_positions_delta;
-    if (distance_to_dock >= props.max_connection_distance_in_meters())
-        return acceleration_to_dock() * accel_dir;
+    return compute_acceleration_into_dock(ship_position,ship_velocity,dock_position,props);
+}
 
-    float_32_bit const  desired_speed = distance_to_dock / (num_time_steps_to_stop_ship() * props.update_time_step_in_seconds());
 
-    return (1.0f / props.update_time_step_in_seconds()) * (desired_speed * accel_dir - ship_velocity);
+vector3  ship_controller_flat_space::accelerate_into_docks(
+        vector3 const&  ship_position,              //!< Coordinates in meters.
+        vector3 const&  ship_velocity,              //!< In meters per second.
+        vector3 const* const  docks_positions,      //!< Coordinates in meters.
+        natural_64_bit const  num_docks,
+        netlab::layer_index_type const  home_layer_index,//!< Index of layer where is the spiker the ship belongs to.
+        netlab::layer_index_type const  area_layer_index,//!< Index of layer where is the movement area in which the ship moves.
+        netlab::network_props const&  props
+        ) const
+{
+    TMPROF_BLOCK();
+
+    vector3  acceleration = vector3_zero();
+    for (natural_64_bit  i = 0ULL; i != num_docks; ++i)
+        acceleration += compute_acceleration_into_dock(ship_position,ship_velocity,docks_positions[i],props);
+    return acceleration;
 }
 
 
@@ -62,11 +72,82 @@ vector3  ship_controller_flat_space::accelerate_from_ship(
         bool const  both_ship_and_dock_belongs_to_same_spiker,
         netlab::layer_index_type const  home_layer_index,//!< Index of layer where is the spiker the ship belongs to.
         netlab::layer_index_type const  area_layer_index,//!< Index of layer where is the movement area in which the ship moves.
-        netlab::network_props const&  props
+        netlab::network_props const&  props,
+        counter_based_random_generator&  random_generator
         ) const
 {
     TMPROF_BLOCK();
 
+    return compute_acceleration_from_ship(
+                ship_position,
+                other_ship_position,
+                nearest_dock_position,
+                both_ship_and_dock_belongs_to_same_spiker,
+                props,
+                random_generator
+                );
+}
+
+
+vector3  ship_controller_flat_space::accelerate_from_ships(
+        vector3 const&  ship_position,              //!< Coordinates in meters.
+        vector3 const&  ship_velocity,              //!< In meters per second.
+        vector3 const* const  other_ships_positions,//!< Coordinates in meters.
+        vector3 const* const  other_ships_velocities,//!< In meters per second.
+        natural_64_bit const  num_other_ships,
+        vector3 const&  nearest_dock_position,      //!< Coordinates in meters. It is nearest to the ship, not to the other ones.
+        bool const  both_ship_and_dock_belongs_to_same_spiker,
+        netlab::layer_index_type const  home_layer_index,//!< Index of layer where is the spiker the ship belongs to.
+        netlab::layer_index_type const  area_layer_index,//!< Index of layer where is the movement area in which the ship moves.
+        netlab::network_props const&  props,
+        counter_based_random_generator&  random_generator
+        ) const
+{
+    TMPROF_BLOCK();
+
+    vector3  acceleration = vector3_zero();
+    for (natural_64_bit  i = 0ULL; i != num_other_ships; ++i)
+        acceleration += compute_acceleration_from_ship(
+                                ship_position,
+                                other_ships_positions[i],
+                                nearest_dock_position,
+                                both_ship_and_dock_belongs_to_same_spiker,
+                                props,
+                                random_generator
+                                );
+    return acceleration;
+}
+
+
+vector3  ship_controller_flat_space::compute_acceleration_into_dock(
+        vector3 const&  ship_position,
+        vector3 const&  ship_velocity,
+        vector3 const&  dock_position,
+        netlab::network_props const&  props
+        ) const
+{
+    vector3 const  dock_ship_positions_delta = dock_position - ship_position;
+    float_32_bit const  distance_to_dock = length(dock_ship_positions_delta);
+    vector3 const  accel_dir =
+            (distance_to_dock < 0.001f) ? vector3_zero() : (1.0f / distance_to_dock) * dock_ship_positions_delta;
+    if (distance_to_dock >= props.max_connection_distance_in_meters())
+        return acceleration_to_dock() * accel_dir;
+
+    float_32_bit const  desired_speed = distance_to_dock / (num_time_steps_to_stop_ship() * props.update_time_step_in_seconds());
+
+    return (1.0f / props.update_time_step_in_seconds()) * (desired_speed * accel_dir - ship_velocity);
+}
+
+
+vector3  ship_controller_flat_space::compute_acceleration_from_ship(
+        vector3 const&  ship_position,
+        vector3 const&  other_ship_position,
+        vector3 const&  nearest_dock_position,
+        bool const  both_ship_and_dock_belongs_to_same_spiker,
+        netlab::network_props const&  props,
+        counter_based_random_generator&  random_generator
+        ) const
+{
     //vector3 const  ship_positions_delta = ship_position - other_ship_position;
     //float_32_bit const  squared_distance_of_ships = length_squared(ship_positions_delta);
 
@@ -110,7 +191,7 @@ vector3  ship_controller_flat_space::accelerate_from_ship(
     if (squared_distance_of_ships < 1e-6f)
     {
         vector3  acceleration;
-        angeo::get_random_vector_of_magnitude(max_acceleration_from_other_ship(), default_random_generator(), acceleration);
+        angeo::get_random_vector_of_magnitude(max_acceleration_from_other_ship(), random_generator, acceleration);
         return acceleration;
     }
 
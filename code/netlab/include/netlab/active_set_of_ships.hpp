@@ -0,0 +1,63 @@
+#ifndef NETLAB_ACTIVE_SET_OF_SHIPS_HPP_INCLUDED
+#   define NETLAB_ACTIVE_SET_OF_SHIPS_HPP_INCLUDED
+
+#   include <netlab/network_indices.hpp>
+#   include <utility/basic_numeric_types.hpp>
+#   include <boost/noncopyable.hpp>
+#   include <vector>
+
+namespace netlab {
+
+
+/**
+ * A set of ships which are awake, i.e. which must be moved in the next update of the network. All other ships
+ * are asleep (docked) and they are not touched by the update at all. Ships are kept in a ring buffer, in the
+ * order of their insertion, and their membership is also stored as a single bit in a dense per-layer bitset.
+ * So, a ship is never inserted twice and the ring buffer (whose capacity is the number of all ships) cannot
+ * overflow.
+ */
+struct  active_set_of_ships : private boost::noncopyable
+{
+    explicit active_set_of_ships(std::vector<object_index_type> const&  num_ships_in_layers);
+
+    bool  contains(compressed_layer_and_object_indices const  ship_loc) const
+    { return (m_members.at(ship_loc.layer_index()).at(ship_loc.object_index() >> 6U) & bit_mask(ship_loc)) != 0ULL; }
+
+    /// It does nothing, if the ship is already in the set.
+    void  insert(compressed_layer_and_object_indices const  ship_loc);
+
+    /// It moves all ships of the set to the back of the passed vector, in the order of their insertion.
+    /// The set is empty afterwards.
+    void  extract_all(std::vector<compressed_layer_and_object_indices>&  output);
+
+    /// It calls 'func' for each ship in the set, in the order of their insertion. The set must not be modified by 'func'.
+    template<typename function_type>
+    void  for_each(function_type const&  func) const
+    {
+        natural_64_bit  index = m_first;
+        for (natural_64_bit  i = 0ULL; i != m_size; ++i)
+        {
+            func(m_ring[index]);
+            if (++index == m_ring.size())
+                index = 0ULL;
+        }
+    }
+
+    natural_64_bit  size() const { return m_size; }
+    natural_64_bit  capacity() const { return m_ring.size(); }
+    natural_64_bit  num_bytes() const;
+
+private:
+    static natural_64_bit  bit_mask(compressed_layer_and_object_indices const  ship_loc)
+    { return 1ULL << (ship_loc.object_index() & 63ULL); }
+
+    std::vector< std::vector<natural_64_bit> >  m_members;
+    std::vector<compressed_layer_and_object_indices>  m_ring;
+    natural_64_bit  m_first;    //!< Index into 'm_ring' of the least recently inserted ship.
+    natural_64_bit  m_size;
+};
+
+
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef NETLAB_CHECKPOINT_OF_NETWORK_HPP_INCLUDED
+#   define NETLAB_CHECKPOINT_OF_NETWORK_HPP_INCLUDED
+
+#   include <netlab/network.hpp>
+#   include <utility/basic_numeric_types.hpp>
+#   include <boost/filesystem/path.hpp>
+
+namespace netlab {
+
+
+/**
+ * A checkpoint is a binary file storing the state of a constructed network, so a simulation can be started
+ * from it without repeating the (slow) construction of the network. The file holds the update id, seeds of
+ * random streams, densities of ships in layers, movement area centers and last update ids of spikers,
+ * positions and velocities of ships, payloads of all layers (see the method 'num_bytes_of_payload' of layer
+ * classes), spikers which spike in the next update, and awake ships in the order of the update queue.
+ * Large arrays are written by single sequential writes.
+ *
+ * Properties of the network and classes of its layers are NOT stored. A checkpoint is loaded into a network
+ * which was just constructed from the same properties and the same factory of layers as the saved network.
+ * The checkpoint only records numbers of objects and sizes of payloads of layers, so that a mismatch can be
+ * detected. The map from dock sectors to ships is not stored either. It is rebuilt from positions of ships,
+ * which takes time proportional to the number of ships only.
+ *
+ * The file starts with a magic string, a version of the format, and a marker of the byte order of the machine
+ * which wrote the file. A checkpoint can only be loaded on a machine with the same byte order. The file is
+ * mapped into memory for loading, and it is never modified. So, any number of independent simulations can be
+ * started (forked) from the same checkpoint.
+ */
+
+
+natural_32_bit  version_of_format_of_checkpoint_of_network();
+
+
+/**
+ * The network must be in the state 'READY_FOR_SIMULATION_STEP', and it must not be split into domains
+ * (replicas of objects owned by other domains are not up to date).
+ */
+void  save_checkpoint_of_network(network const&  net, boost::filesystem::path const&  path_to_checkpoint_file);
+
+/**
+ * The network must be in the state 'READY_FOR_MOVEMENT_AREA_CENTERS_INITIALISATION' (i.e. just constructed).
+ * It is in the state 'READY_FOR_SIMULATION_STEP' after the call. It throws 'std::runtime_error', if the file
+ * cannot be mapped, if it is not a valid checkpoint of the current version written on a machine with the same
+ * byte order, or if the checkpoint does not match the layers of the network. The network must be discarded
+ * after an exception.
+ */
+void  load_checkpoint_of_network(network&  net, boost::filesystem::path const&  path_to_checkpoint_file);
+
+
+}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef NETLAB_DENSE_SET_OF_OBJECTS_HPP_INCLUDED
+#   define NETLAB_DENSE_SET_OF_OBJECTS_HPP_INCLUDED
+
+#   include <netlab/network_indices.hpp>
+#   include <utility/basic_numeric_types.hpp>
+#   include <boost/noncopyable.hpp>
+#   include <vector>
+
+namespace netlab {
+
+
+/**
+ * A set of objects (e.g. spikers) of the network, where layers have fixed numbers of objects. Membership of
+ * each object is stored as a single bit in a dense per-layer bitset, so 'insert', 'erase', and 'contains' are
+ * O(1) bit operations without any hashing. Objects are also appended to a worklist, when they are inserted
+ * for the first time since the last call to 'clear'. The worklist is what is enumerated by 'for_each', in the
+ * order of the first insertions, skipping objects erased meanwhile. The method 'clear' is proportional to the
+ * length of the worklist, not to the number of objects in the network.
+ */
+struct  dense_set_of_objects : private boost::noncopyable
+{
+    explicit dense_set_of_objects(std::vector<object_index_type> const&  num_objects_in_layers);
+
+    bool  contains(compressed_layer_and_object_indices const  loc) const
+    { return (m_members.at(loc.layer_index()).at(loc.object_index() >> 6U) & bit_mask(loc)) != 0ULL; }
+
+    /// It returns true, if the object was appended to the worklist.
+    bool  insert(compressed_layer_and_object_indices const  loc);
+    void  erase(compressed_layer_and_object_indices const  loc)
+    { m_members.at(loc.layer_index()).at(loc.object_index() >> 6U) &= ~bit_mask(loc); }
+
+    void  clear();
+
+    /// It calls 'func' for each object in the set. The set must not be modified by 'func'.
+    template<typename function_type>
+    void  for_each(function_type const&  func) const
+    {
+        for (compressed_layer_and_object_indices const  loc : m_worklist)
+            if (contains(loc))
+                func(loc);
+    }
+
+    /// The same as 'for_each', but only for the objects at positions [begin, end) of the worklist. So, the set can
+    /// be enumerated by several threads, each processing a different range of the worklist. The position of
+    /// the object in the worklist is passed to 'func' as the second argument.
+    template<typename function_type>
+    void  for_each_in_range(natural_64_bit const  begin, natural_64_bit const  end, function_type const&  func) const
+    {
+        for (natural_64_bit  i = begin; i < end; ++i)
+            if (contains(m_worklist[i]))
+                func(m_worklist[i], i);
+    }
+
+    natural_64_bit  size_of_worklist() const { return m_worklist.size(); }
+
+private:
+    static natural_64_bit  bit_mask(compressed_layer_and_object_indices const  loc)
+    { return 1ULL << (loc.object_index() & 63ULL); }
+
+    std::vector< std::vector<natural_64_bit> >  m_members;  //!< Bits of objects in the set.
+    std::vector< std::vector<natural_64_bit> >  m_listed;   //!< Bits of objects in the worklist.
+    std::vector<compressed_layer_and_object_indices>  m_worklist;
+};
+
+
+}
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef NETLAB_DOMAIN_OF_NETWORK_HPP_INCLUDED
+#   define NETLAB_DOMAIN_OF_NETWORK_HPP_INCLUDED
+
+#   include <netlab/network_props.hpp>
+#   include <netlab/network_indices.hpp>
+#   include <netlab/transport_between_domains.hpp>
+#   include <utility/basic_numeric_types.hpp>
+#   include <boost/noncopyable.hpp>
+#   include <vector>
+#   include <memory>
+
+namespace netlab {
+
+
+/**
+ * A network can be simulated by several processes, each of which simulates one domain of the network
+ * (see 'network::split_into_domains'). Domains are slabs of an equal width along the x or the y axis
+ * (the one along which spikers of all layers span a longer distance), and this object describes the slab
+ * of the calling process:
+ *      - A spiker belongs to the domain of the slab containing the centre of its sector. Docks of the spiker
+ *        belong to the same domain.
+ *      - A ship belongs to the domain of the dock sector containing the ship (in the layer of its movement area).
+ *        Ownership of ships changes, when they move across boundaries of slabs. Only the owner moves the ship
+ *        and delivers spikes and mini-spikes over its connection.
+ *      - Each dock sector has a range of interested domains, which own some dock sector in the distance, from
+ *        which ships of one domain can see ships of the other domain in their movement. Movements of ships are
+ *        sent to all domains interested in the old or the new sector of the ship (the halo exchange).
+ *
+ * SCOPE: Domains spread the work of simulation steps of one network over several processes (e.g. one process
+ *        per NUMA node, so each process works with its own local memory). Simulation of networks larger than
+ *        the memory of one process is not a goal: each process allocates and constructs the complete network,
+ *        and all objects are addressed by their global indices. Data of objects owned by other domains are kept
+ *        up to date only as far as the own domain needs them (e.g. ships in the halo), so results should only
+ *        be read for owned objects. Each domain draws mini-spikes only for chunks of ships containing an owned ship.
+ */
+struct  domain_of_network : private boost::noncopyable
+{
+    domain_of_network(
+            std::shared_ptr<network_props> const  network_properties,
+            std::shared_ptr<transport_between_domains> const  transport
+            );
+
+    natural_32_bit  num_domains() const { return m_transport->num_domains(); }
+    natural_32_bit  domain_index() const { return m_transport->domain_index(); }
+    transport_between_domains&  transport() const { return *m_transport; }
+
+    /// It is 0 for slabs along the x axis and 1 for slabs along the y axis.
+    natural_8_bit  axis_of_slabs() const { return m_axis_of_slabs; }
+    /// Coordinates of boundaries of slabs along the axis. The domain 'd' spans [boundary(d), boundary(d+1)).
+    float_32_bit  boundary_of_slab(natural_32_bit const  index) const;
+
+    natural_32_bit  domain_of_spiker(layer_index_type const  layer_index, object_index_type const  spiker_index) const;
+    natural_32_bit  domain_of_dock_sector(layer_index_type const  layer_index, object_index_type const  sector_index) const;
+    bool  owns_spiker(layer_index_type const  layer_index, object_index_type const  spiker_index) const
+    { return domain_of_spiker(layer_index, spiker_index) == domain_index(); }
+
+    /// The domains first,...,last are interested in movements of ships from or into the sector.
+    void  domains_interested_in_dock_sector(
+            layer_index_type const  layer_index,
+            object_index_type const  sector_index,
+            natural_32_bit&  first,
+            natural_32_bit&  last
+            ) const;
+
+    bool  owns_ship(compressed_layer_and_object_indices const  ship_loc) const
+    { return (m_owned_ships.at(ship_loc.layer_index()).at(ship_loc.object_index() >> 6U) & bit_mask(ship_loc)) != 0ULL; }
+    /// Whether the domain owns any of ships begin,...,end-1 of the layer.
+    bool  owns_some_ship(
+            layer_index_type const  layer_index,
+            object_index_type const  begin,
+            object_index_type const  end
+            ) const;
+    void  acquire_ship(compressed_layer_and_object_indices const  ship_loc);
+    void  release_ship(compressed_layer_and_object_indices const  ship_loc);
+    natural_64_bit  num_owned_ships() const { return m_num_owned_ships; }
+    natural_64_bit  num_owned_ships_with_controllers() const { return m_num_owned_ships_with_controllers; }
+
+    /// Messages for (and from) other domains passed to 'transport().exchange'. They are kept between updates only
+    /// to avoid reallocations. The method 'clear_messages' empties all of them.
+    std::vector< std::vector<natural_8_bit> >&  messages() { return m_messages; }
+    void  clear_messages();
+
+    natural_64_bit  num_bytes() const;
+
+private:
+    static natural_64_bit  bit_mask(compressed_layer_and_object_indices const  ship_loc)
+    { return 1ULL << (ship_loc.object_index() & 63ULL); }
+
+    std::shared_ptr<network_props>  m_properties;
+    std::shared_ptr<transport_between_domains>  m_transport;
+    natural_8_bit  m_axis_of_slabs;
+    std::vector<float_32_bit>  m_boundaries_of_slabs;
+
+    /// Tables per layer indexed by coordinates of sectors along the axis of slabs.
+    std::vector< std::vector<natural_32_bit> >  m_domains_of_spiker_coordinates;
+    std::vector< std::vector<natural_32_bit> >  m_first_interested_domains_of_dock_coordinates;
+    std::vector< std::vector<natural_32_bit> >  m_last_interested_domains_of_dock_coordinates;
+
+    std::vector< std::vector<natural_64_bit> >  m_owned_ships;     //!< Bits of owned ships.
+    natural_64_bit  m_num_owned_ships;
+    natural_64_bit  m_num_owned_ships_with_controllers;
+
+    std::vector< std::vector<natural_8_bit> >  m_messages;
+};
+
+
+}
+
+#endif
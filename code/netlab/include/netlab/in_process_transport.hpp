@@ -0,0 +1,42 @@
+#ifndef NETLAB_IN_PROCESS_TRANSPORT_HPP_INCLUDED
+#   define NETLAB_IN_PROCESS_TRANSPORT_HPP_INCLUDED
+
+#   include <netlab/transport_between_domains.hpp>
+#   include <utility/basic_numeric_types.hpp>
+#   include <memory>
+#   include <vector>
+
+namespace netlab {
+
+
+/**
+ * A transport for domains running as threads of one process. Domains exchange messages through mailboxes
+ * of a hub shared by all of them, so no data are copied: buffers of messages are only swapped. It is meant for
+ * tests and experiments with domains, which do not want to spawn processes.
+ *
+ * All domains must be created with the same hub, each domain with a different index, and each domain must
+ * call 'exchange' from its own thread.
+ */
+struct  in_process_transport : public transport_between_domains
+{
+    struct  hub;
+
+    static std::shared_ptr<hub>  create_hub(natural_32_bit const  num_domains, float_64_bit const  timeout_in_seconds = 30.0);
+
+    in_process_transport(std::shared_ptr<hub> const  hub_ptr, natural_32_bit const  domain_index);
+
+    natural_32_bit  num_domains() const override;
+    natural_32_bit  domain_index() const override { return m_domain_index; }
+
+    /// It throws 'std::runtime_error', if other domains do not call it in the time passed to 'create_hub'.
+    void  exchange(std::vector< std::vector<natural_8_bit> >&  messages) override;
+
+private:
+    std::shared_ptr<hub>  m_hub;
+    natural_32_bit  m_domain_index;
+};
+
+
+}
+
+#endif
@@ -7,6 +7,7 @@
 #   include <netlab/access_to_movement_area_centers.hpp>
 #   include <angeo/tensor_math.hpp>
 #   include <vector>
+#   include <array>
 
 namespace netlab {
 
@@ -17,6 +18,15 @@ struct  initialiser_of_movement_area_centers
 
     virtual void  on_next_layer(layer_index_type const  layer_index, network_props const&  props) {}
 
+    /**
+     * When it returns true, the network calls the method 'compute_initial_movement_area_center_for_ships_of_spiker'
+     * concurrently from several threads, each time for a different spiker of the same layer ('on_next_layer' is
+     * still called once before all spikers of the layer). The method then must not modify any shared state. Random
+     * numbers should be drawn from streams keyed by indices of the spiker, so that the computed centers do not depend
+     * on the number of threads.
+     */
+    virtual bool  can_compute_initial_movement_area_centers_concurrently() const { return false; }
+
     virtual void  compute_initial_movement_area_center_for_ships_of_spiker(
             layer_index_type const  spiker_layer_index,
             object_index_type const  spiker_index_into_layer,
@@ -56,6 +66,66 @@ struct  initialiser_of_movement_area_centers
             )
     {}
 
+    /**
+     * When it returns true, the network does not call the method 'on_shift_movement_area_center_in_layer'. Instead,
+     * it splits spikers of a layer into colours by their sector coordinates modulo the extents returned from the method
+     * 'get_extents_of_independent_shifts_of_movement_area_centers'. For all spikers of one colour, the network first
+     * calls the method 'compute_shift_of_movement_area_center_in_layer' concurrently from several threads, and then
+     * it calls the method 'apply_shift_of_movement_area_center_in_layer' serially, in the order of spikers, for those
+     * spikers whose centers should move. Colours are processed one after another in a fixed order. So, the resulting
+     * centers do not depend on the number of threads.
+     */
+    virtual bool  can_shift_movement_area_centers_concurrently() const { return false; }
+
+    /**
+     * Returns numbers of spiker sectors along axes x,y,c of the spiker layer, such that densities read and written,
+     * when shifting centers of any two spikers of the layer which are at least that far from each other along some
+     * axis, are disjoint. The default extents put each spiker of the layer to a different colour.
+     */
+    virtual std::array<natural_32_bit, 3ULL>  get_extents_of_independent_shifts_of_movement_area_centers(
+            layer_index_type const  spiker_layer_index,
+            network_props const&  props
+            ) const
+    {
+        network_layer_props const&  layer_props = props.layer_props().at(spiker_layer_index);
+        return { layer_props.num_spikers_along_x_axis(),
+                 layer_props.num_spikers_along_y_axis(),
+                 layer_props.num_spikers_along_c_axis() };
+    }
+
+    /**
+     * It must not modify any shared state. It returns true, if the center of the area should be moved to the
+     * position written to 'moved_area_center'.
+     */
+    virtual bool  compute_shift_of_movement_area_center_in_layer(
+            layer_index_type const  spiker_layer_index,
+            object_index_type const  spiker_index_into_layer,
+            sector_coordinate_type const  spiker_sector_coordinate_x,
+            sector_coordinate_type const  spiker_sector_coordinate_y,
+            sector_coordinate_type const  spiker_sector_coordinate_c,
+            layer_index_type const  area_layer_index,
+            network_props const&  props,
+            access_to_movement_area_centers const&  movement_area_centers,
+            vector3 const&  area_center,
+            accessor_to_extra_data_for_spikers_in_layers const&  extra_data_for_spikers,
+            vector3&  moved_area_center
+            ) const
+    { return false; }
+
+    virtual void  apply_shift_of_movement_area_center_in_layer(
+            layer_index_type const  spiker_layer_index,
+            object_index_type const  spiker_index_into_layer,
+            sector_coordinate_type const  spiker_sector_coordinate_x,
+            sector_coordinate_type const  spiker_sector_coordinate_y,
+            sector_coordinate_type const  spiker_sector_coordinate_c,
+            layer_index_type const  area_layer_index,
+            network_props const&  props,
+            vector3 const&  moved_area_center,
+            vector3&  area_center,
+            accessor_to_extra_data_for_spikers_in_layers&  extra_data_for_spikers
+            )
+    { area_center = moved_area_center; }
+
     virtual bool  do_extra_data_hold_densities_of_ships_per_spikers_in_layers() { return false; }
 };
 
@@ -18,6 +18,14 @@ struct  initialiser_of_ships_in_movement_areas
     virtual void  on_next_area(layer_index_type const  layer_index, object_index_type const  spiker_index,
                                network_props const&  props) {}
 
+    /**
+     * When it returns true, the network initialises ships of different movement areas of a layer concurrently from
+     * several threads ('on_next_layer' is still called once before all areas of the layer). The methods 'on_next_area'
+     * and 'compute_ship_position_and_velocity_in_movement_area' then must not modify any shared state. Random numbers
+     * should be drawn from streams keyed by indices of the ship, so that the ships do not depend on the number of threads.
+     */
+    virtual bool  can_compute_ships_in_movement_areas_concurrently() const { return false; }
+
     virtual void  compute_ship_position_and_velocity_in_movement_area(
             vector3 const&  center_of_movement_area,
                     //!< The center appears in the layer at index 'area_layer_index'.
@@ -25,6 +33,8 @@ struct  initialiser_of_ships_in_movement_areas
                     //!< In the range [0,props.layer_props().at(home_layer_index).num_ships_per_spiker()).
             layer_index_type const  home_layer_index,
                     //!< Index of layer where is the spiker the ship belongs to.
+            object_index_type const  home_spiker_index,
+                    //!< Index of the spiker (in the home layer) the ship belongs to.
             layer_index_type const  area_layer_index,
                     //!< Index of layer where is the movement area in which the ship moves.
             network_props const&  props,
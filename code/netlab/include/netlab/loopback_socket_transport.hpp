@@ -0,0 +1,50 @@
+#ifndef NETLAB_LOOPBACK_SOCKET_TRANSPORT_HPP_INCLUDED
+#   define NETLAB_LOOPBACK_SOCKET_TRANSPORT_HPP_INCLUDED
+
+#   include <netlab/transport_between_domains.hpp>
+#   include <utility/basic_numeric_types.hpp>
+#   include <memory>
+#   include <vector>
+
+namespace netlab {
+
+
+/**
+ * A transport for domains running as processes on the same machine, which exchange messages through TCP
+ * connections over the loopback interface. Each pair of domains is connected by one socket. The domain 'd'
+ * listens on the port 'first_port + d', it connects to all domains of lower indices, and it accepts
+ * connections from all domains of higher indices.
+ *
+ * It is slower than 'shared_memory_transport', but it needs no shared segment, and it is a template for
+ * a transport between machines (only the address of the listener differs).
+ */
+struct  loopback_socket_transport : public transport_between_domains
+{
+    /// It throws 'std::runtime_error', if the port cannot be listened on, or if other domains do not connect
+    /// in the passed time.
+    loopback_socket_transport(
+            natural_16_bit const  first_port,
+            natural_32_bit const  num_domains,
+            natural_32_bit const  domain_index,
+            float_64_bit const  timeout_in_seconds = 30.0
+            );
+    ~loopback_socket_transport();
+
+    natural_32_bit  num_domains() const override { return m_num_domains; }
+    natural_32_bit  domain_index() const override { return m_domain_index; }
+
+    void  exchange(std::vector< std::vector<natural_8_bit> >&  messages) override;
+
+private:
+    struct  connections;
+
+    natural_32_bit  m_num_domains;
+    natural_32_bit  m_domain_index;
+    float_64_bit  m_timeout_in_seconds;
+    std::unique_ptr<connections>  m_connections;
+};
+
+
+}
+
+#endif
@@ -12,14 +12,20 @@
 #   include <netlab/initialiser_of_ships_in_movement_areas.hpp>
 #   include <netlab/statistics_of_densities_of_ships_in_layers.hpp>
 #   include <netlab/tracked_object_stats.hpp>
+#   include <netlab/ships_in_dock_sectors.hpp>
+#   include <netlab/sector_resolver.hpp>
+#   include <netlab/dense_set_of_objects.hpp>
+#   include <netlab/active_set_of_ships.hpp>
+#   include <netlab/domain_of_network.hpp>
+#   include <netlab/transport_between_domains.hpp>
 #   include <utility/array_of_derived.hpp>
 #   include <utility/random.hpp>
+#   include <utility/thread_pool.hpp>
 #   include <angeo/tensor_math.hpp>
+#   include <boost/filesystem/path.hpp>
 #   include <vector>
 #   include <memory>
 #   include <string>
-#   include <deque>
-#   include <unordered_set>
 
 namespace netlab {
 
@@ -70,27 +76,55 @@ struct  network
     layer_of_ships const&  get_layer_of_ships(layer_index_type const  layer_index) const
     { return *m_layers_of_ships.at(layer_index); }
 
-    std::vector<compressed_layer_and_object_indices> const&  get_indices_of_ships_in_dock_sector(
+    ships_in_dock_sectors::range_of_ships  get_indices_of_ships_in_dock_sector(
             layer_index_type const  layer_index,
             object_index_type const  dock_sector_index
             ) const
-    { return m_ships_in_sectors.at(layer_index).at(dock_sector_index); }
+    { return m_ships_in_sectors->ships_in_sector(layer_index,dock_sector_index); }
+
+    ships_in_dock_sectors const&  get_ships_in_dock_sectors() const { return *m_ships_in_sectors; }
+
+    sector_resolver const&  get_sector_resolver() const { return *m_sector_resolver; }
 
     statistics_of_densities_of_ships_in_layers const&  densities_of_ships() const { return *m_densities_of_ships; }
 
     natural_64_bit  update_id() const noexcept { return  m_update_id; }
 
+    /// The number of spikers whose spikes will be propagated in the next simulation step.
+    natural_64_bit  num_spikers_to_spike_in_next_update() const;
+    dense_set_of_objects const&  get_spikers_to_spike_in_next_update() const { return *m_current_spikers; }
+
+    /// The number of mini-spikes generated by ships in the last simulation step. When the network is split into
+    /// domains, only mini-spikes of ships owned by the domain of this process are counted.
+    natural_64_bit  num_mini_spikes_in_last_update() const { return m_num_mini_spikes_in_last_update; }
+
     extra_data_for_spikers_in_one_layer::value_type  get_extra_data_of_spiker(
             layer_index_type const  layer_index,
             object_index_type const  object_index
             ) const;
 
+    /**
+     * When the update queue of ships is used, only awake ships are moved in a simulation step. A ship falls
+     * asleep when it gets docked, and it is woken up again only when some other ship, which stays awake, moves
+     * near it (i.e. into the distance 'ship_controller::docks_enumerations_distance_for_accelerate_from_ship' from
+     * dock sectors around the sleeping ship), or when 'wake_up_ship' or 'wake_up_ships_of_spiker' is called for
+     * it (e.g. after a change of the dock or the movement area of the ship). So, the cost of a step is proportional
+     * to the number of moving ships. When the queue is not used, all ships are moved in each step.
+     */
     using  element_type_in_update_queue_of_ships = compressed_layer_and_object_indices;
-    void  enable_usage_of_queues_in_update_of_ships(bool const  enable_state) { m_use_update_queue_of_ships = enable_state; }
+    void  enable_usage_of_queues_in_update_of_ships(bool const  enable_state);
     bool  is_update_queue_of_ships_used() const { return m_use_update_queue_of_ships; }
-    bool  is_update_queue_of_ships_overloaded() const { return m_is_update_queue_of_ships_overloaded; }
-    natural_64_bit  size_of_update_queue_of_ships() const { return m_update_queue_of_ships.size(); }
-    natural_64_bit  max_size_of_update_queue_of_ships() const { return m_max_size_of_update_queue_of_ships; }
+    natural_64_bit  size_of_update_queue_of_ships() const { return m_update_queue_of_ships->size(); }
+    natural_64_bit  max_size_of_update_queue_of_ships() const { return m_update_queue_of_ships->capacity(); }
+    active_set_of_ships const&  get_update_queue_of_ships() const { return *m_update_queue_of_ships; }
+    void  wake_up_ship(compressed_layer_and_object_indices const  ship_loc);
+    void  wake_up_ships_of_spiker(layer_index_type const  layer_index, object_index_type const  spiker_index);
+
+    natural_64_bit  seed_of_mini_spiking() const { return m_seed_of_mini_spiking; }
+    void  set_seed_of_mini_spiking(natural_64_bit const  seed) { m_seed_of_mini_spiking = seed; }
+
+    natural_64_bit  seed_of_movement_of_ships() const { return m_seed_of_movement_of_ships; }
+    void  set_seed_of_movement_of_ships(natural_64_bit const  seed) { m_seed_of_movement_of_ships = seed; }
 
     void  initialise_movement_area_centers(initialiser_of_movement_area_centers&  area_centers_initialiser);
     void  prepare_for_movement_area_centers_migration(initialiser_of_movement_area_centers&  area_centers_initialiser);
@@ -106,19 +140,104 @@ struct  network
             tracked_network_object_stats* const  stats_of_tracked_object = nullptr
             );
 
+    /**
+     * It makes this process simulate only one domain of the network, while other domains are simulated by other
+     * processes connected by the passed transport (see 'domain_of_network.hpp'). Each process must construct
+     * the same network (i.e. with the same properties, initialisers, and seeds) and then call this method with
+     * a transport of its domain. From then on, 'do_simulation_step' is a collective operation: all processes must
+     * call it with the same arguments. Movements of ships near boundaries of domains, ships migrating between
+     * domains, and spikers to spike in the next update are exchanged in each step, so the owned objects evolve
+     * bit-identically to the simulation of the whole network by a single process.
+     *
+     * The split divides only the work: each process holds the whole network, so the network must still fit
+     * into the memory of one process.
+     * It throws 'std::runtime_error', if the transport fails or if other processes hold a different network.
+     */
+    void  split_into_domains(std::shared_ptr<transport_between_domains> const  transport);
+    bool  is_split_into_domains() const { return m_domain != nullptr; }
+    /// It is nullptr, if the network is not split into domains.
+    domain_of_network const*  get_domain() const { return m_domain.get(); }
+
 private:
 
     network(network const&) = delete;
     network& operator=(network const&) = delete;
 
+    /// See the file 'checkpoint_of_network.hpp'.
+    friend void  save_checkpoint_of_network(network const&  net, boost::filesystem::path const&  path_to_checkpoint_file);
+    friend void  load_checkpoint_of_network(network&  net, boost::filesystem::path const&  path_to_checkpoint_file);
+
+    /// A result of the movement of one ship in one update, computed from the state of the network before the update.
+    struct  movement_of_ship
+    {
+        vector3  position;
+        vector3  velocity;
+        object_index_type  old_sector_index;
+        object_index_type  new_sector_index;
+        layer_index_type  area_layer_index;
+        bool  is_docked;
+    };
+
+    /// A movement of a ship owned by another domain, received in the current update, after which the ship stays awake.
+    struct  received_movement_of_ship
+    {
+        object_index_type  old_sector_index;
+        object_index_type  new_sector_index;
+        layer_index_type  area_layer_index;
+    };
+
+    /// Buffers of one thread for the computation of movements of ships. The first part holds docks and ships
+    /// enumerated for one ship, which are passed to its ship controller in batches. The second part holds
+    /// data of a block of ships which are integrated together; each coordinate has its own aligned array.
+    struct  buffers_for_movement_of_ship
+    {
+        std::vector<vector3>  positions_of_docks_to_accelerate_into;
+        std::vector<vector3>  positions_of_docks_to_accelerate_from;
+        std::vector<vector3>  positions_of_ships;
+        std::vector<vector3>  velocities_of_ships;
+
+        array_of_coordinates  positions[3];
+        array_of_coordinates  velocities[3];
+        array_of_coordinates  accelerations[3];
+        array_of_coordinates  speeds;
+        array_of_coordinates  min_speeds;
+        array_of_coordinates  max_speeds;
+        std::vector<vector3>  nearest_dock_positions;
+        std::vector<counter_based_random_generator>  random_generators;
+
+        void  resize(natural_32_bit const  size_of_block);
+    };
+
+    thread_pool*  get_thread_pool(natural_32_bit const  num_threads);
+
+    /// It creates the map from dock sectors to ships from current positions of ships and movement area centers.
+    void  build_map_from_dock_sectors_to_ships();
+    void  find_dock_sector_of_ship(
+            compressed_layer_and_object_indices const  ship_loc,
+            layer_index_type&  area_layer_index,
+            object_index_type&  sector_index
+            ) const;
+
     void  update_movement_of_ships(tracked_ship_stats* const  stats_of_tracked_ship);
-    void  update_movement_of_ship(
-            layer_index_type const  layer_index,
-            object_index_type const  ship_index_in_layer,
-            tracked_ship_stats*  stats_of_tracked_ship
-            );
+    void  wake_up_ships_near_dock_sector(layer_index_type const  area_layer_index, object_index_type const  sector_index);
+    /// It writes the movement of an owned ship into messages for interested domains. It returns true, if the ship
+    /// moved into another domain, which now owns it.
+    bool  send_movement_of_ship(compressed_layer_and_object_indices const  ship_loc, movement_of_ship const&  movement);
+    void  exchange_movements_of_ships();
+    void  compute_acceleration_of_ship(
+            compressed_layer_and_object_indices const  ship_loc,
+            movement_of_ship&  movement,
+            buffers_for_movement_of_ship&  buffers,
+            natural_32_bit const  index_in_block
+            ) const;
+    void  integrate_movement_of_ships(
+            compressed_layer_and_object_indices const* const  ships_locs,
+            movement_of_ship* const  movements,
+            natural_32_bit const  num_ships,
+            buffers_for_movement_of_ship&  buffers
+            ) const;
 
-    void  update_mini_spiking(
+    natural_64_bit  update_mini_spiking(
             const bool  use_spiking,
             tracked_network_object_stats* const  stats_of_tracked_object
             );
@@ -127,6 +246,59 @@ private:
             tracked_network_object_stats* const  stats_of_tracked_object
             );
 
+    /// A delivery of a spike over one connection of a ship with a dock. Either the spiker owning the ship spiked
+    /// (then the delivery goes from the ship to the dock), or the spiker owning the dock spiked (from the dock to
+    /// the ship). The delivery belongs to the bucket of the spiker owning the dock. Deliveries of a bucket are
+    /// applied in the increasing order of 'order', which is given by the position of the spiking spiker in
+    /// the worklist of current spikers and by the connection.
+    struct  spike_delivery
+    {
+        compressed_layer_and_object_indices  ship;
+        compressed_layer_and_object_indices  spiker_of_dock;
+        object_index_type  dock_index;
+        natural_64_bit  order;
+        bool  is_from_ship_to_dock;
+    };
+
+    /// Whether a spiker will spike in the next update, as decided by a delivery of a spike to the spiker.
+    /// The order is the one of the delivery.
+    struct  spiking_decision
+    {
+        compressed_layer_and_object_indices  spiker;
+        natural_64_bit  order;
+        bool  does_spike;
+    };
+
+    /// A mini-spike of a ship arriving to the spiker owning the dock the ship is connected to. The order is
+    /// the index of the ship among ships of all layers (mini-spikes of a ship drawn several times in an update
+    /// share the order and they are delivered one after another).
+    struct  mini_spike_delivery
+    {
+        compressed_layer_and_object_indices  spiker;
+        object_index_type  dock_index;
+        natural_64_bit  order;
+        bool  is_from_excitatory_spiker;
+    };
+
+    natural_64_bit  bucket_of_deliveries(layer_index_type const  layer_index, object_index_type const  spiker_index) const;
+    void  collect_deliveries_of_spiker(
+            compressed_layer_and_object_indices const  spiker_id,
+            natural_64_bit const  position_in_worklist,
+            std::vector< std::vector<spike_delivery> >&  deliveries
+            ) const;
+    void  apply_spike_delivery(spike_delivery const&  delivery, std::vector<spiking_decision>&  decisions);
+    void  collect_delivery_of_mini_spike(
+            layer_index_type const  layer_index,
+            object_index_type const  ship_index,
+            std::vector< std::vector<mini_spike_delivery> >&  deliveries
+            ) const;
+    void  apply_mini_spike_delivery(mini_spike_delivery const&  delivery, std::vector<spiking_decision>&  decisions);
+
+    /// It applies decisions of all buckets to the set of next spikers. The phase is 0 for mini-spikes and 1 for spikes.
+    void  apply_spiking_decisions(natural_64_bit const  phase);
+    /// It makes the set of current spikers the same in all domains, as if all decisions were applied by one process.
+    void  exchange_current_spikers();
+
     std::shared_ptr<network_props>  m_properties;
     NETWORK_STATE  m_state;
 
@@ -136,22 +308,52 @@ private:
     std::vector<std::unique_ptr<layer_of_docks> >  m_layers_of_docks;
     std::vector<std::unique_ptr<layer_of_ships> >  m_layers_of_ships;
 
-    std::vector< std::vector< std::vector<compressed_layer_and_object_indices> > >  m_ships_in_sectors;
+    std::unique_ptr<sector_resolver>  m_sector_resolver;
+
+    std::unique_ptr<ships_in_dock_sectors>  m_ships_in_sectors;
 
     std::unique_ptr<statistics_of_densities_of_ships_in_layers>  m_densities_of_ships;
 
     natural_64_bit  m_update_id;
     
     /// Data of update queue of ships
-    std::deque<element_type_in_update_queue_of_ships>  m_update_queue_of_ships;
-    natural_64_bit  m_max_size_of_update_queue_of_ships;
-    bool  m_is_update_queue_of_ships_overloaded;
+    std::unique_ptr<active_set_of_ships>  m_update_queue_of_ships;
+    natural_64_bit  m_num_ships_with_controllers;   //!< The maximal number of awake ships.
+    std::unique_ptr<dense_set_of_objects>  m_dock_sectors_to_wake_up_around;
     bool  m_use_update_queue_of_ships;
 
-    random_generator_for_natural_64_bit  m_mini_spiking_random_generator;
-
-    std::unique_ptr< std::unordered_set<compressed_layer_and_object_indices> >  m_current_spikers;
-    std::unique_ptr< std::unordered_set<compressed_layer_and_object_indices> >  m_next_spikers;
+    /// Data of the parallel movement of ships. They are kept between updates only to avoid reallocations.
+    std::vector<compressed_layer_and_object_indices>  m_ships_to_move;
+    std::vector<movement_of_ship>  m_movements_of_ships;
+    std::vector<buffers_for_movement_of_ship>  m_buffers_for_movement_of_ships;
+    std::unique_ptr<thread_pool>  m_thread_pool;
+    natural_64_bit  m_seed_of_movement_of_ships;    //!< Random decisions of a ship in an update are drawn from a stream
+                                                    //!< keyed by the seed, 'm_update_id', and indices of the ship.
+
+    natural_64_bit  m_seed_of_mini_spiking;    //!< Mini-spikes of each update are drawn from a stream keyed by the seed and 'm_update_id'.
+                                               //!< Keys of both streams also contain distinct tags, so the streams differ even
+                                               //!< for equal seeds.
+
+    natural_64_bit  m_num_mini_spikes_in_last_update;
+
+    std::unique_ptr<dense_set_of_objects>  m_current_spikers;
+    std::unique_ptr<dense_set_of_objects>  m_next_spikers;
+
+    /// Data of the parallel propagation of spikes and mini-spikes. Except the first two, they are kept between
+    /// updates only to avoid reallocations.
+    std::vector<natural_64_bit>  m_ships_begin_in_layers;   //!< Indices of the first ships of layers among all ships.
+    std::vector<natural_64_bit>  m_buckets_begin_in_layers;
+    std::vector< std::vector< std::vector<spike_delivery> > >  m_deliveries_of_threads;
+    std::vector< std::vector< std::vector<mini_spike_delivery> > >  m_mini_spike_deliveries_of_threads;
+    std::vector< std::vector<spiking_decision> >  m_spiking_decisions_in_buckets;
+
+    /// Data of the simulation of one domain of the network. The domain is nullptr, if the network is not split.
+    /// For each spiker in the worklist of next spikers, the vector of keys holds the pair of the phase and bucket,
+    /// and the order of the decision which inserted the spiker. The other vector is kept between updates only
+    /// to avoid reallocations.
+    std::unique_ptr<domain_of_network>  m_domain;
+    std::vector< std::pair<natural_64_bit, natural_64_bit> >  m_keys_of_next_spikers;
+    std::vector<received_movement_of_ship>  m_received_movements_of_ships;
 };
 
 
@@ -4,6 +4,8 @@
 #   include <netlab/network_indices.hpp>
 #   include <netlab/network_props.hpp>
 #   include <angeo/tensor_math.hpp>
+#   include <boost/align/aligned_allocator.hpp>
+#   include <boost/range/iterator_range.hpp>
 #   include <vector>
 #   include <string>
 #   include <iosfwd>
@@ -11,6 +13,19 @@
 namespace netlab {
 
 
+/**
+ * An array of single coordinates (e.g. x coordinates) of vectors of many objects. It starts at an address
+ * aligned to 64 bytes (a cache line), so loops over several such arrays can be vectorised by the compiler
+ * without peeling.
+ */
+using  array_of_coordinates = std::vector<float_32_bit, boost::alignment::aligned_allocator<float_32_bit, 64U> >;
+
+inline constexpr natural_64_bit  num_coordinates_in_cache_line() noexcept { return 64ULL / sizeof(float_32_bit); }
+
+using  range_of_coordinates = boost::iterator_range<float_32_bit*>;
+using  const_range_of_coordinates = boost::iterator_range<float_32_bit const*>;
+
+
 /**
  * It models spikers (neurons) of a single kind appearing in a certain layer of the neural tissue.
  * The layer is implementedas 1D array. Each spiker is thus associated with a unique index in the array.
@@ -28,6 +43,8 @@ struct  layer_of_spikers
     layer_index_type  layer_index() const { return m_layer_index; }
 
     natural_64_bit  last_update_id(object_index_type const  spiker_index) const { return m_last_update_ids.at(spiker_index); }
+    void  set_last_update_id(object_index_type const  spiker_index, natural_64_bit const  update_id)
+    { m_last_update_ids.at(spiker_index) = update_id; }
 
     const vector3 &get_movement_area_center(object_index_type const  spiker_index) const
     { return m_movement_area_center.at(spiker_index); }
@@ -37,9 +54,9 @@ struct  layer_of_spikers
 
     /**
      * The function is automatically called by the network in order to update the spiking potential
-     * function of the spiker to the current time of the network. This is implemented by calling the method
-     * @integrate_spiking_potential until the member @m_last_update_id does not match the current
-     * update id of the network, passed to the function as the parameter @current_update_id.
+     * function of the spiker to the current time of the network. This is implemented by a single call to
+     * the method @integrate_spiking_potential_over for all update steps between the member @m_last_update_id
+     * and the current update id of the network, passed to the function as the parameter @current_update_id.
      *
      * @param current_update_id  The id of the current update step of the network.
      */
@@ -69,6 +86,27 @@ struct  layer_of_spikers
             )
     {}
 
+    /**
+     * It integrates the potential function of the spiker over the passed number of consecutive time steps.
+     * The default implementation calls the method @integrate_spiking_potential once per step. Spikers which
+     * were idle for a long time thus cost one virtual call per missed step. A derived class should override
+     * this method, if it can integrate its potential over many steps at once (e.g. a leaky spiker, whose
+     * potential decays exponentially towards the resting potential, has a closed form solution).
+     *
+     * @param num_time_steps         The number of time steps to integrate over. It is always positive.
+     * @param time_step_in_seconds   The duration of a single time step.
+     */
+    virtual void  integrate_spiking_potential_over(
+            object_index_type const  spiker_index,
+            natural_64_bit const  num_time_steps,
+            float_32_bit const  time_step_in_seconds,
+            network_props const&  props
+            )
+    {
+        for (natural_64_bit  i = 0ULL; i != num_time_steps; ++i)
+            integrate_spiking_potential(spiker_index,time_step_in_seconds,props);
+    }
+
     /**
      * It performs an update of the potential function of the spiker according to an instant
      * change of the potential (impulse) arrived from some dock of the spiker.
@@ -93,6 +131,17 @@ struct  layer_of_spikers
             std::string const&  shift = ""
             ) const;
 
+    /**
+     * Hooks for saving and loading the layer in a checkpoint of the network (see 'checkpoint_of_network.hpp').
+     * A derived class holding its own data of spikers (e.g. their potentials) stores them in a payload of the
+     * size returned from @num_bytes_of_payload. That size must only depend on the number of spikers, because it
+     * is checked against the size recorded in the checkpoint. The method @load_payload gets exactly the bytes
+     * written by @save_payload. Data of the base class are saved and loaded by the checkpoint itself.
+     */
+    virtual natural_64_bit  num_bytes_of_payload() const { return 0ULL; }
+    virtual void  save_payload(natural_8_bit* const  payload) const {}
+    virtual void  load_payload(natural_8_bit const* const  payload) {}
+
 private:
     layer_of_spikers(layer_of_spikers const&) = delete;
     layer_of_spikers& operator=(layer_of_spikers const&) = delete;
@@ -219,6 +268,11 @@ struct  layer_of_docks
             ) const
     { return potential_of_spiker; }
 
+    /// Hooks for a checkpoint of the network. See the same methods of 'layer_of_spikers'.
+    virtual natural_64_bit  num_bytes_of_payload() const { return 0ULL; }
+    virtual void  save_payload(natural_8_bit* const  payload) const {}
+    virtual void  load_payload(natural_8_bit const* const  payload) {}
+
 private:
     layer_of_docks(layer_of_docks const&) = delete;
     layer_of_docks& operator=(layer_of_docks const&) = delete;
@@ -241,20 +295,36 @@ struct  layer_of_ships
     layer_of_ships(layer_index_type const  layer_index, object_index_type const  num_ships_in_the_layer);
     virtual ~layer_of_ships() {}
 
-    object_index_type size() const { return m_positions.size(); }
+    object_index_type size() const { return m_num_ships; }
 
     virtual natural_64_bit  num_bytes_per_ship() const { return 0UL; }
     static natural_64_bit  num_extra_bytes_per_ship() { return 2ULL * sizeof(vector3); }
 
     layer_index_type  layer_index() const { return m_layer_index; }
 
-    vector3 const&  position(object_index_type const  ship_index) const { return m_positions.at(ship_index); }
-    void  set_position(object_index_type const  ship_index, vector3 const&  pos) { m_positions.at(ship_index) = pos; }
-    vector3&  get_position_nonconst_reference(object_index_type const  ship_index) { return m_positions.at(ship_index); }
-
-    vector3 const&  velocity(object_index_type const  ship_index) const { return m_velocities.at(ship_index); }
-    void  set_velocity(object_index_type const  ship_index, vector3 const&  v) { m_velocities.at(ship_index) = v; }
-    vector3&  get_velocity_nonconst_reference(object_index_type const  ship_index) { return m_velocities.at(ship_index); }
+    /**
+     * Positions and velocities of ships are stored as structure of arrays: each coordinate has its own array,
+     * aligned to and padded by zeros to whole cache lines. Accessors of individual ships do NOT check the index.
+     */
+    vector3  position(object_index_type const  ship_index) const
+    { return { m_positions[0][ship_index], m_positions[1][ship_index], m_positions[2][ship_index] }; }
+    void  set_position(object_index_type const  ship_index, vector3 const&  pos)
+    { m_positions[0][ship_index] = pos(0); m_positions[1][ship_index] = pos(1); m_positions[2][ship_index] = pos(2); }
+
+    vector3  velocity(object_index_type const  ship_index) const
+    { return { m_velocities[0][ship_index], m_velocities[1][ship_index], m_velocities[2][ship_index] }; }
+    void  set_velocity(object_index_type const  ship_index, vector3 const&  v)
+    { m_velocities[0][ship_index] = v(0); m_velocities[1][ship_index] = v(1); m_velocities[2][ship_index] = v(2); }
+
+    /// Views of one coordinate (0 for x, 1 for y, 2 for c) of all ships. The views do not include the padding.
+    const_range_of_coordinates  positions_along_axis(natural_8_bit const  axis) const
+    { return { m_positions[axis].data(), m_positions[axis].data() + size() }; }
+    range_of_coordinates  positions_along_axis(natural_8_bit const  axis)
+    { return { m_positions[axis].data(), m_positions[axis].data() + size() }; }
+    const_range_of_coordinates  velocities_along_axis(natural_8_bit const  axis) const
+    { return { m_velocities[axis].data(), m_velocities[axis].data() + size() }; }
+    range_of_coordinates  velocities_along_axis(natural_8_bit const  axis)
+    { return { m_velocities[axis].data(), m_velocities[axis].data() + size() }; }
 
     virtual std::ostream&  get_info_text(
             object_index_type const  ship_index,
@@ -296,13 +366,27 @@ struct  layer_of_ships
             )
     {}
 
+    /// Hooks for a checkpoint of the network. See the same methods of 'layer_of_spikers'. Positions and velocities
+    /// of ships are saved by the checkpoint itself.
+    virtual natural_64_bit  num_bytes_of_payload() const { return 0ULL; }
+    virtual void  save_payload(natural_8_bit* const  payload) const {}
+    virtual void  load_payload(natural_8_bit const* const  payload) {}
+
+    /// Hooks for a migration of one ship between domains of the network (see 'domain_of_network.hpp'). A derived
+    /// class holding its own data of ships stores data of one ship in a payload of the returned size. Positions
+    /// and velocities of ships are sent by the network itself.
+    virtual natural_64_bit  num_bytes_of_payload_of_ship() const { return 0ULL; }
+    virtual void  save_payload_of_ship(object_index_type const  ship_index, natural_8_bit* const  payload) const {}
+    virtual void  load_payload_of_ship(object_index_type const  ship_index, natural_8_bit const* const  payload) {}
+
 private:
     layer_of_ships(layer_of_ships const&) = delete;
     layer_of_ships& operator=(layer_of_ships const&) = delete;
 
     layer_index_type  m_layer_index;
-    std::vector<vector3>  m_positions;
-    std::vector<vector3>  m_velocities;
+    object_index_type  m_num_ships;
+    array_of_coordinates  m_positions[3];
+    array_of_coordinates  m_velocities[3];
 };
 
 
@@ -74,6 +74,7 @@ struct  network_layer_props
     natural_64_bit  num_ships() const noexcept { return m_num_ships; }
 
     float_32_bit  distance_of_docks_in_meters() const noexcept { return m_distance_of_docks_in_meters; }
+    float_32_bit  inverted_distance_of_docks_in_meters() const noexcept { return m_inverted_distance_of_docks_in_meters; }
 
     vector3  distance_of_spikers_in_meters() const noexcept
     {
@@ -181,6 +182,7 @@ private:
     natural_64_bit  m_num_ships;
 
     float_32_bit  m_distance_of_docks_in_meters;
+    float_32_bit  m_inverted_distance_of_docks_in_meters;
 
     float_32_bit  m_distance_of_spikers_along_x_axis_in_meters;
     float_32_bit  m_distance_of_spikers_along_y_axis_in_meters;
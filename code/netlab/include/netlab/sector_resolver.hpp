@@ -0,0 +1,147 @@
+#ifndef NETLAB_SECTOR_RESOLVER_HPP_INCLUDED
+#   define NETLAB_SECTOR_RESOLVER_HPP_INCLUDED
+
+#   include <netlab/network_props.hpp>
+#   include <netlab/network_layer_props.hpp>
+#   include <netlab/network_indices.hpp>
+#   include <angeo/tensor_math.hpp>
+#   include <utility/assumptions.hpp>
+#   include <boost/noncopyable.hpp>
+#   include <array>
+#   include <vector>
+
+namespace netlab {
+
+
+/**
+ * It provides the same results as the corresponding methods of 'network_layer_props' and 'network_props'
+ * (for the network props passed to the constructor), but without integer divisions and binary searches.
+ *
+ * Both the index of a dock and the index of a spiker are sums of three terms, each depending on a single
+ * coordinate of the dock sector. So, the terms are precomputed for all coordinates along each axis, together
+ * with spiker coordinates and centres of sectors. The layer index is looked up in a table indexed by the
+ * quantised coordinate along the c axis, followed by a correction of at most a step in each direction.
+ */
+struct  sector_resolver : private boost::noncopyable
+{
+    explicit sector_resolver(network_props const&  props);
+
+    layer_index_type  find_layer_index(float_32_bit const  coord_along_c_axis) const;
+
+    void  dock_sector_coordinates(
+            layer_index_type const  layer_index,
+            vector3 const&  pos,
+            sector_coordinate_type&  x, sector_coordinate_type&  y, sector_coordinate_type&  c
+            ) const
+    {
+        layer_tables const&  tables = get_tables(layer_index);
+        vector3 const  u = (pos - tables.dock_sectors_origin) * tables.inverted_distance_of_docks;
+        x = clamp_coordinate(u(0), tables.spiker_x_of_dock_x.size());
+        y = clamp_coordinate(u(1), tables.spiker_y_of_dock_y.size());
+        c = clamp_coordinate(u(2), tables.spiker_c_of_dock_c.size());
+    }
+
+    object_index_type  dock_sector_index(
+            layer_index_type const  layer_index,
+            sector_coordinate_type const  x, sector_coordinate_type const  y, sector_coordinate_type const  c
+            ) const
+    {
+        layer_tables const&  tables = get_tables(layer_index);
+        return tables.dock_index_of_dock_x[x] + tables.dock_index_of_dock_y[y] + tables.dock_index_of_dock_c[c];
+    }
+
+    vector3  dock_sector_centre(
+            layer_index_type const  layer_index,
+            sector_coordinate_type const  x, sector_coordinate_type const  y, sector_coordinate_type const  c
+            ) const
+    {
+        layer_tables const&  tables = get_tables(layer_index);
+        return { tables.dock_centre_x[x], tables.dock_centre_y[y], tables.dock_centre_c[c] };
+    }
+
+    void  spiker_sector_coordinates_from_dock_sector_coordinates(
+            layer_index_type const  layer_index,
+            sector_coordinate_type const  dock_x, sector_coordinate_type const  dock_y, sector_coordinate_type const  dock_c,
+            sector_coordinate_type&  x, sector_coordinate_type&  y, sector_coordinate_type&  c
+            ) const
+    {
+        layer_tables const&  tables = get_tables(layer_index);
+        x = tables.spiker_x_of_dock_x[dock_x];
+        y = tables.spiker_y_of_dock_y[dock_y];
+        c = tables.spiker_c_of_dock_c[dock_c];
+    }
+
+    /// It is the same as 'spiker_sector_index' of the coordinates from 'spiker_sector_coordinates_from_dock_sector_coordinates'.
+    object_index_type  spiker_index_from_dock_sector_coordinates(
+            layer_index_type const  layer_index,
+            sector_coordinate_type const  dock_x, sector_coordinate_type const  dock_y, sector_coordinate_type const  dock_c
+            ) const
+    {
+        layer_tables const&  tables = get_tables(layer_index);
+        return tables.spiker_index_of_dock_x[dock_x] + tables.spiker_index_of_dock_y[dock_y] + tables.spiker_index_of_dock_c[dock_c];
+    }
+
+    vector3  spiker_sector_centre(
+            layer_index_type const  layer_index,
+            sector_coordinate_type const  x, sector_coordinate_type const  y, sector_coordinate_type const  c
+            ) const
+    {
+        layer_tables const&  tables = get_tables(layer_index);
+        return { tables.spiker_centre_x[x], tables.spiker_centre_y[y], tables.spiker_centre_c[c] };
+    }
+
+    natural_64_bit  num_bytes() const;
+
+private:
+    struct  layer_tables
+    {
+        vector3  dock_sectors_origin;
+        float_32_bit  inverted_distance_of_docks;
+
+        std::vector<object_index_type>  dock_index_of_dock_x;
+        std::vector<object_index_type>  dock_index_of_dock_y;
+        std::vector<object_index_type>  dock_index_of_dock_c;
+
+        std::vector<sector_coordinate_type>  spiker_x_of_dock_x;
+        std::vector<sector_coordinate_type>  spiker_y_of_dock_y;
+        std::vector<sector_coordinate_type>  spiker_c_of_dock_c;
+
+        std::vector<object_index_type>  spiker_index_of_dock_x;
+        std::vector<object_index_type>  spiker_index_of_dock_y;
+        std::vector<object_index_type>  spiker_index_of_dock_c;
+
+        std::vector<float_32_bit>  dock_centre_x;
+        std::vector<float_32_bit>  dock_centre_y;
+        std::vector<float_32_bit>  dock_centre_c;
+
+        std::vector<float_32_bit>  spiker_centre_x;
+        std::vector<float_32_bit>  spiker_centre_y;
+        std::vector<float_32_bit>  spiker_centre_c;
+    };
+
+    layer_tables const&  get_tables(layer_index_type const  layer_index) const
+    {
+        ASSUMPTION(layer_index < m_tables_of_layers.size());
+        return m_tables_of_layers[layer_index];
+    }
+
+    /// The same clamping as in 'network_layer_props::dock_sector_coordinates'.
+    static sector_coordinate_type  clamp_coordinate(float_32_bit const  u, natural_64_bit const  num_sectors)
+    {
+        return (u <= 0.0f) ? 0U :
+               (u >= (float_32_bit)num_sectors) ? (sector_coordinate_type)(num_sectors - 1ULL) :
+                                                  (sector_coordinate_type)u;
+    }
+
+    std::vector<layer_tables>  m_tables_of_layers;
+
+    std::vector<float_32_bit>  m_max_coords_along_c_axis;   //!< The same as in 'network_props'.
+    float_32_bit  m_low_coord_along_c_axis;                 //!< The coordinate of the first bucket of the lookup table.
+    float_32_bit  m_inverted_size_of_bucket_along_c_axis;
+    std::vector<layer_index_type>  m_layer_index_of_bucket;
+};
+
+
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef NETLAB_SHARED_MEMORY_TRANSPORT_HPP_INCLUDED
+#   define NETLAB_SHARED_MEMORY_TRANSPORT_HPP_INCLUDED
+
+#   include <netlab/transport_between_domains.hpp>
+#   include <utility/basic_numeric_types.hpp>
+#   include <memory>
+#   include <string>
+#   include <vector>
+
+namespace boost { namespace interprocess { class mapped_region; } }
+
+namespace netlab {
+
+
+/**
+ * A transport for domains running as processes on the same machine. Domains exchange messages through a single
+ * segment of shared memory, which holds a ring buffer (a channel) of a fixed capacity for each ordered pair of
+ * domains. A message larger than the capacity is streamed through the channel, while the receiver reads it.
+ * Processes wait for each other by spinning on counters of bytes in channels (yielding the processor), so no
+ * system call is made per message.
+ *
+ * All domains must be created with the same name, number of domains, and capacity of channels. The domain 0
+ * creates the segment (removing a segment of the same name left by a crashed run, if any), and other domains
+ * wait for it. The name is removed from the system as soon as all domains are attached to the segment, so the
+ * memory is released when the last process exits. The name should be unique per run.
+ */
+struct  shared_memory_transport : public transport_between_domains
+{
+    static natural_64_bit  default_capacity_of_channel_in_bytes() { return 1ULL << 20U; }
+
+    /// It throws 'std::runtime_error', if the segment cannot be created or opened, if it does not match the passed
+    /// arguments, or if other domains do not appear in the passed time.
+    shared_memory_transport(
+            std::string const&  name,
+            natural_32_bit const  num_domains,
+            natural_32_bit const  domain_index,
+            natural_64_bit const  capacity_of_channel_in_bytes = default_capacity_of_channel_in_bytes(),
+            float_64_bit const  timeout_in_seconds = 30.0
+            );
+    ~shared_memory_transport();
+
+    natural_32_bit  num_domains() const override { return m_num_domains; }
+    natural_32_bit  domain_index() const override { return m_domain_index; }
+
+    void  exchange(std::vector< std::vector<natural_8_bit> >&  messages) override;
+
+private:
+    struct  channel;
+
+    channel&  get_channel(natural_32_bit const  from_domain, natural_32_bit const  to_domain) const;
+
+    std::string  m_name;
+    natural_32_bit  m_num_domains;
+    natural_32_bit  m_domain_index;
+    natural_64_bit  m_capacity_of_channel;
+    float_64_bit  m_timeout_in_seconds;
+    std::unique_ptr<boost::interprocess::mapped_region>  m_region;
+    bool  m_is_name_removed;
+
+    /// Buffers of 'exchange', kept between calls only to avoid reallocations.
+    std::vector< std::vector<natural_8_bit> >  m_received_messages;
+};
+
+
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #   include <netlab/network_indices.hpp>
 #   include <angeo/tensor_math.hpp>
+#   include <utility/random.hpp>
 
 namespace netlab {
 struct  network_props;
@@ -22,6 +23,9 @@ struct  ship_controller
      * of the two distances is to allow the network to quickly skip all those docks
      * and ships which are obviously too far (e.g. in far space secktors) so that
      * they have to necessarily be beyond those limits.
+     *
+     * The network calls methods bellow for different ships concurrently from several
+     * threads. So, implementations must not modify any shared data.
      */
     ship_controller(
             float_32_bit const  docks_enumerations_distance_for_accelerate_into_dock,
@@ -113,10 +117,58 @@ struct  ship_controller
             bool const  both_ship_and_dock_belongs_to_same_spiker,
             layer_index_type const  home_layer_index,   //!< Index of layer where is the spiker the ship belongs to.
             layer_index_type const  area_layer_index,   //!< Index of layer where is the movement area in which the ship moves.
-            network_props const&  props
+            network_props const&  props,
+            counter_based_random_generator&  random_generator
+                                                        //!< For a random acceleration, e.g. when both ships are at the
+                                                        //!< same position. See the parameter of the method 'on_too_slow'.
             ) const = 0;
 
 
+    /**
+     * The following three methods are batched versions of the methods 'accelerate_into_dock',
+     * 'accelerate_from_dock', and 'accelerate_from_ship' above. The network calls them once per ship
+     * with all docks (or all other ships) it has enumerated for the ship, stored in contiguous arrays.
+     * Each method returns the sum of accelerations for all passed docks (ships).
+     *
+     * The default implementations call the corresponding method above for each passed dock (ship),
+     * in the order of the arrays. A controller may override them to process the arrays in tight loops
+     * without virtual calls per dock (ship).
+     */
+    virtual vector3  accelerate_into_docks(
+            vector3 const&  ship_position,              //!< Coordinates in meters.
+            vector3 const&  ship_velocity,              //!< In meters per second.
+            vector3 const* const  docks_positions,      //!< Coordinates in meters.
+            natural_64_bit const  num_docks,
+            layer_index_type const  home_layer_index,   //!< Index of layer where is the spiker the ship belongs to.
+            layer_index_type const  area_layer_index,   //!< Index of layer where is the movement area in which the ship moves.
+            network_props const&  props
+            ) const;
+
+    virtual vector3  accelerate_from_docks(
+            vector3 const&  ship_position,              //!< Coordinates in meters.
+            vector3 const&  ship_velocity,              //!< In meters per second.
+            vector3 const* const  docks_positions,      //!< Coordinates in meters.
+            natural_64_bit const  num_docks,
+            layer_index_type const  home_layer_index,   //!< Index of layer where is the spiker the ship belongs to.
+            layer_index_type const  area_layer_index,   //!< Index of layer where is the movement area in which the ship moves.
+            network_props const&  props
+            ) const;
+
+    virtual vector3  accelerate_from_ships(
+            vector3 const&  ship_position,              //!< Coordinates in meters.
+            vector3 const&  ship_velocity,              //!< In meters per second.
+            vector3 const* const  other_ships_positions,//!< Coordinates in meters.
+            vector3 const* const  other_ships_velocities,//!< In meters per second.
+            natural_64_bit const  num_other_ships,
+            vector3 const&  nearest_dock_position,      //!< Coordinates in meters. It is nearest to the ship, not to the other ones.
+            bool const  both_ship_and_dock_belongs_to_same_spiker,
+            layer_index_type const  home_layer_index,   //!< Index of layer where is the spiker the ship belongs to.
+            layer_index_type const  area_layer_index,   //!< Index of layer where is the movement area in which the ship moves.
+            network_props const&  props,
+            counter_based_random_generator&  random_generator
+            ) const;
+
+
     /**
       * Returns an acceleration vector of the ship induced by the environment the ship is moving in.
       *
@@ -139,7 +191,7 @@ struct  ship_controller
       *
       * The default implementation leaves the velocity vector of the ship unchanged, if the ship
       * is within a connection radius of some dock. Otherwise a random velocity vector (using the
-      * default random generator) of magnitude in the middile between minimal and maximal speed
+      * passed random generator) of magnitude in the middile between minimal and maximal speed
       * is computed.
       */
     virtual  void  on_too_slow(
@@ -149,7 +201,11 @@ struct  ship_controller
             vector3 const&  nearest_dock_position,
             layer_index_type const  home_layer_index,   //!< Index of layer where is the spiker the ship belongs to.
             layer_index_type const  area_layer_index,   //!< Index of layer where is the movement area in which the ship moves.
-            network_props const&  props
+            network_props const&  props,
+            counter_based_random_generator&  random_generator
+                                                        //!< A stream dedicated to the ship and the current update
+                                                        //!< of the network. So, results do not depend on the order
+                                                        //!< (and the threads) in which ships are processed.
             ) const;
 
 
@@ -0,0 +1,97 @@
+#ifndef NETLAB_SHIPS_IN_DOCK_SECTORS_HPP_INCLUDED
+#   define NETLAB_SHIPS_IN_DOCK_SECTORS_HPP_INCLUDED
+
+#   include <netlab/network_indices.hpp>
+#   include <utility/basic_numeric_types.hpp>
+#   include <utility/thread_pool.hpp>
+#   include <boost/range/iterator_range.hpp>
+#   include <boost/noncopyable.hpp>
+#   include <vector>
+#   include <utility>
+
+namespace netlab {
+
+
+/**
+ * It is a map from dock sectors of all layers to ships inside them, stored as a cell list (in the compressed
+ * sparse row form): indices of all ships of the network are stored in one contiguous array, sorted by dock
+ * sectors, and each dock sector is identified with a range in that array given by arrays of begins and ends.
+ * Each sector has a free slot after its range (it is reserved by each rebuild). Ships inside one dock sector
+ * appear in the increasing order of their indices. So, the content of the map does not depend on the order in
+ * which ships changed their sectors, nor on whether the map was updated in place or rebuilt.
+ *
+ * A ship's new sector is recorded by the method 'set_sector_of_ship', and the map is then updated by the method
+ * 'update'. It moves few ships in place between ranges of their sectors (using the free slots), and it falls back
+ * to the method 'rebuild' (a counting sort of all ships) when many ships changed sectors or a sector is full.
+ */
+struct  ships_in_dock_sectors : private boost::noncopyable
+{
+    using  range_of_ships = boost::iterator_range<compressed_layer_and_object_indices const*>;
+
+    ships_in_dock_sectors(
+            std::vector<object_index_type> const&  num_docks_in_layers,
+            std::vector<object_index_type> const&  num_ships_in_layers
+            );
+
+    range_of_ships  ships_in_sector(layer_index_type const  area_layer_index, object_index_type const  sector_index) const;
+
+    /**
+     * It records that the ship is in the passed dock sector of the passed layer. The change becomes visible
+     * in the ranges returned from 'ships_in_sector' only after the next call to 'update' or 'rebuild'. Calls for
+     * different ships may run concurrently, if 'is_rebuild_needed' returns true (e.g. after the construction),
+     * because no shared data are written then.
+     */
+    void  set_sector_of_ship(
+            compressed_layer_and_object_indices const  ship_loc,
+            layer_index_type const  area_layer_index,
+            object_index_type const  sector_index
+            );
+
+    bool  is_rebuild_needed() const noexcept { return m_is_rebuild_needed; }
+
+    /**
+     * It makes all changes recorded by 'set_sector_of_ship' visible. Ships which changed their sectors are moved
+     * in place, unless a rebuild is needed, or there are so many of them that 'rebuild' is cheaper, or some sector
+     * has no free slot for an incoming ship. In these cases 'rebuild' is called with the passed arguments.
+     */
+    void  update(thread_pool* const  pool, natural_32_bit const  num_threads);
+
+    /**
+     * It rebuilds the map from sectors recorded by 'set_sector_of_ship'. Each thread of the pool owns a contiguous
+     * range of sectors. Ships are first partitioned (in parallel over chunks of ships) by the ranges of their
+     * sectors, and then each thread sorts ships of its range by sectors. The result does not depend on the number
+     * of threads. The pool may be nullptr, if num_threads == 1.
+     */
+    void  rebuild(thread_pool* const  pool, natural_32_bit const  num_threads);
+
+    natural_64_bit  num_bytes() const;
+
+private:
+    natural_64_bit  index_of_ship(compressed_layer_and_object_indices const  ship_loc) const
+    { return m_ships_begin_in_layers.at(ship_loc.layer_index()) + ship_loc.object_index(); }
+
+    void  remove_ship_from_sector(natural_64_bit const  ship, natural_64_bit const  sector);
+    bool  insert_ship_into_sector(natural_64_bit const  ship, natural_64_bit const  sector);
+
+    std::vector<natural_64_bit>  m_sectors_begin_in_layers;     //!< Index of the first sector of each layer in 'm_offsets'.
+    std::vector<natural_64_bit>  m_ships_begin_in_layers;       //!< Index of the first ship of each layer in 'm_sector_of_ship'.
+    std::vector<natural_64_bit>  m_offsets;                     //!< Ships of the sector 'i' are in the range
+                                                                //!< [m_offsets[i], m_ends[i]) of 'm_ships', and
+                                                                //!< [m_ends[i], m_offsets[i+1]) are its free slots.
+    std::vector<natural_64_bit>  m_ends;
+    std::vector<compressed_layer_and_object_indices>  m_ships;
+    std::vector<natural_64_bit>  m_sector_of_ship;              //!< Index into 'm_offsets' of the recorded sector of each ship.
+    std::vector< std::pair<natural_64_bit, natural_64_bit> >  m_moved_ships;   //!< Ships which changed sectors since
+                                                                                //!< the last update, with their sectors
+                                                                                //!< in 'm_ships' before the change.
+    std::vector<natural_64_bit>  m_ships_in_ranges_of_sectors;  //!< Indices of ships partitioned by ranges of sectors of threads.
+    std::vector< std::vector<natural_64_bit> >  m_counters_of_threads;  //!< Numbers of ships of each chunk in each range of
+                                                                        //!< sectors. Both are kept between rebuilds only
+                                                                        //!< to avoid reallocations.
+    bool  m_is_rebuild_needed;
+};
+
+
+}
+
+#endif
@@ -7,6 +7,7 @@
 #   include <netlab/extra_data_for_spikers.hpp>
 #   include <netlab/access_to_movement_area_centers.hpp>
 #   include <utility/basic_numeric_types.hpp>
+#   include <utility/thread_pool.hpp>
 #   include <vector>
 #   include <array>
 
@@ -57,10 +58,18 @@ void  initialise_densities_of_ships_per_spiker_in_layers(
         accessor_to_extra_data_for_spikers_in_layers&  extra_data_accessor
         );
 
+/**
+ * It adds densities of ships of all movement areas to spikers whose sectors the areas intersect. Threads of the pool
+ * process contiguous ranges of movement areas, and then they add collected densities to disjoint ranges of spikers,
+ * in the order of the areas. So, the result does not depend on the number of threads. The pool may be nullptr, if
+ * num_threads == 1.
+ */
 void  compute_densities_of_ships_per_spiker_in_layers(
         network_props const&  props,
         access_to_movement_area_centers const&  movement_area_centers,
-        accessor_to_extra_data_for_spikers_in_layers&  extra_data_accessor
+        accessor_to_extra_data_for_spikers_in_layers&  extra_data_accessor,
+        thread_pool* const  pool,
+        natural_32_bit const  num_threads
         );
 
 void  compute_statistics_of_density_of_ships_in_layers(
@@ -0,0 +1,115 @@
+#ifndef NETLAB_TRANSPORT_BETWEEN_DOMAINS_HPP_INCLUDED
+#   define NETLAB_TRANSPORT_BETWEEN_DOMAINS_HPP_INCLUDED
+
+#   include <utility/basic_numeric_types.hpp>
+#   include <utility/msgstream.hpp>
+#   include <boost/noncopyable.hpp>
+#   include <vector>
+#   include <cstring>
+#   include <stdexcept>
+#   include <type_traits>
+
+namespace netlab {
+
+
+/**
+ * It delivers messages between domains of a network split into several processes (see 'domain_of_network.hpp').
+ * Domains are numbered 0,...,num_domains()-1, and each process holds one transport object of its domain.
+ * A message is just a sequence of bytes. The network does not know how the bytes are carried, so a new kind
+ * of transport (e.g. over a cluster interconnect) only implements this interface.
+ */
+struct  transport_between_domains : private boost::noncopyable
+{
+    virtual ~transport_between_domains() {}
+
+    virtual natural_32_bit  num_domains() const = 0;
+    virtual natural_32_bit  domain_index() const = 0;
+
+    /**
+     * It is a collective operation: all domains must call it the same number of times. Before the call,
+     * 'messages[d]' holds the message for the domain 'd'. After the call, it holds the message received from
+     * the domain 'd'. Messages may be empty, and the message at the index 'domain_index()' is left untouched.
+     * Sending and receiving are interleaved, so the call does not deadlock on messages larger than buffers of
+     * the transport. It throws 'std::runtime_error', if the transport fails (e.g. when some domain does not
+     * respond in time).
+     */
+    virtual void  exchange(std::vector< std::vector<natural_8_bit> >&  messages) = 0;
+};
+
+
+/// It appends trivially copyable values to a message.
+struct  message_writer
+{
+    explicit message_writer(std::vector<natural_8_bit>&  message)
+        : m_message(message)
+    {}
+
+    template<typename T>
+    void  write(T const  value)
+    {
+        write_array(&value, 1ULL);
+    }
+
+    template<typename T>
+    void  write_array(T const* const  values, natural_64_bit const  num_values)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be written.");
+        natural_64_bit const  offset = m_message.size();
+        m_message.resize(offset + num_values * sizeof(T));
+        if (num_values != 0ULL)
+            std::memcpy(m_message.data() + offset, values, num_values * sizeof(T));
+    }
+
+    /// It returns a pointer to the passed number of bytes appended to the message, to be filled in by the caller.
+    natural_8_bit*  append(natural_64_bit const  num_bytes)
+    {
+        natural_64_bit const  offset = m_message.size();
+        m_message.resize(offset + num_bytes);
+        return m_message.data() + offset;
+    }
+
+private:
+    std::vector<natural_8_bit>&  m_message;
+};
+
+
+/// It reads values from a message in the order they were written by 'message_writer'. Reading past the end
+/// of the message throws 'std::runtime_error', because the message is then corrupted.
+struct  message_reader
+{
+    explicit message_reader(std::vector<natural_8_bit> const&  message)
+        : m_message(message)
+        , m_offset(0ULL)
+    {}
+
+    bool  done() const { return m_offset == m_message.size(); }
+
+    template<typename T>
+    T  read()
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read.");
+        T  value;
+        std::memcpy(&value, skip(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    natural_8_bit const*  skip(natural_64_bit const  num_bytes)
+    {
+        if (num_bytes > m_message.size() - m_offset)
+            throw std::runtime_error(msgstream() << "A message between domains is corrupted: cannot read "
+                                                 << num_bytes << " bytes at the offset " << m_offset
+                                                 << " of the message of " << m_message.size() << " bytes.");
+        natural_8_bit const* const  result = m_message.data() + m_offset;
+        m_offset += num_bytes;
+        return result;
+    }
+
+private:
+    std::vector<natural_8_bit> const&  m_message;
+    natural_64_bit  m_offset;
+};
+
+
+}
+
+#endif
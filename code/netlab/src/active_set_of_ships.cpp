@@ -0,0 +1,64 @@
+#include <netlab/active_set_of_ships.hpp>
+#include <utility/assumptions.hpp>
+#include <utility/invariants.hpp>
+
+namespace netlab {
+
+
+active_set_of_ships::active_set_of_ships(std::vector<object_index_type> const&  num_ships_in_layers)
+    : m_members()
+    , m_ring()
+    , m_first(0ULL)
+    , m_size(0ULL)
+{
+    ASSUMPTION(num_ships_in_layers.size() <= max_number_of_layers());
+    natural_64_bit  num_ships = 0ULL;
+    for (object_index_type const  num_ships_in_layer : num_ships_in_layers)
+    {
+        m_members.push_back(std::vector<natural_64_bit>((num_ships_in_layer + 63ULL) >> 6U, 0ULL));
+        num_ships += num_ships_in_layer;
+    }
+    m_ring.resize(num_ships, {0U,0ULL});
+}
+
+
+void  active_set_of_ships::insert(compressed_layer_and_object_indices const  ship_loc)
+{
+    natural_64_bit&  word = m_members.at(ship_loc.layer_index()).at(ship_loc.object_index() >> 6U);
+    natural_64_bit const  mask = bit_mask(ship_loc);
+    if ((word & mask) != 0ULL)
+        return;
+    word |= mask;
+    INVARIANT(m_size < m_ring.size());
+    natural_64_bit  last = m_first + m_size;
+    if (last >= m_ring.size())
+        last -= m_ring.size();
+    m_ring[last] = ship_loc;
+    ++m_size;
+}
+
+
+void  active_set_of_ships::extract_all(std::vector<compressed_layer_and_object_indices>&  output)
+{
+    output.reserve(output.size() + m_size);
+    for ( ; m_size != 0ULL; --m_size)
+    {
+        compressed_layer_and_object_indices const  ship_loc = m_ring[m_first];
+        m_members.at(ship_loc.layer_index()).at(ship_loc.object_index() >> 6U) &= ~bit_mask(ship_loc);
+        output.push_back(ship_loc);
+        if (++m_first == m_ring.size())
+            m_first = 0ULL;
+    }
+}
+
+
+natural_64_bit  active_set_of_ships::num_bytes() const
+{
+    natural_64_bit  result = sizeof(active_set_of_ships) + m_ring.capacity() * sizeof(compressed_layer_and_object_indices);
+    for (std::vector<natural_64_bit> const&  words : m_members)
+        result += words.capacity() * sizeof(natural_64_bit);
+    return result;
+}
+
+
+}
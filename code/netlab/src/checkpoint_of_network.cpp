@@ -0,0 +1,356 @@
+#include <netlab/checkpoint_of_network.hpp>
+#include <utility/msgstream.hpp>
+#include <utility/assumptions.hpp>
+#include <utility/timeprof.hpp>
+#include <utility/log.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace netlab { namespace private_internal_implementation_details {
+
+
+char const  magic_of_checkpoint_file[8] = { 'E', '2', 'N', 'E', 'T', 'W', 'R', 'K' };
+natural_32_bit const  byte_order_marker = 0x01020304U;
+
+struct  checkpoint_writer
+{
+    explicit checkpoint_writer(boost::filesystem::ofstream&  ostr)
+        : m_ostr(ostr)
+    {}
+
+    template<typename T>
+    void  write(T const  value)
+    {
+        write_array(&value, 1ULL);
+    }
+
+    template<typename T>
+    void  write_array(T const* const  values, natural_64_bit const  num_values)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be written.");
+        m_ostr.write(reinterpret_cast<char const*>(values), num_values * sizeof(T));
+    }
+
+    /// Indices of objects are written as two arrays: of layer indices and of object indices.
+    void  write_objects(std::vector<compressed_layer_and_object_indices> const&  objects)
+    {
+        std::vector<layer_index_type>  layer_indices;
+        std::vector<object_index_type>  object_indices;
+        layer_indices.reserve(objects.size());
+        object_indices.reserve(objects.size());
+        for (compressed_layer_and_object_indices const  loc : objects)
+        {
+            layer_indices.push_back(loc.layer_index());
+            object_indices.push_back(loc.object_index());
+        }
+        write((natural_64_bit)objects.size());
+        write_array(layer_indices.data(), layer_indices.size());
+        write_array(object_indices.data(), object_indices.size());
+    }
+
+private:
+    boost::filesystem::ofstream&  m_ostr;
+};
+
+
+struct  checkpoint_reader
+{
+    checkpoint_reader(natural_8_bit const* const  begin, natural_8_bit const* const  end,
+                      std::string const&  path_to_checkpoint_file)
+        : m_cursor(begin)
+        , m_end(end)
+        , m_path(path_to_checkpoint_file)
+    {}
+
+    template<typename T>
+    T  read()
+    {
+        T  value;
+        read_array(&value, 1ULL);
+        return value;
+    }
+
+    template<typename T>
+    void  read_array(T* const  values, natural_64_bit const  num_values)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read.");
+        std::memcpy(values, skip(num_values * sizeof(T)), num_values * sizeof(T));
+    }
+
+    /// It returns the pointer to the next 'num_bytes' bytes of the file and it moves behind them.
+    natural_8_bit const*  skip(natural_64_bit const  num_bytes)
+    {
+        if ((natural_64_bit)(m_end - m_cursor) < num_bytes)
+            throw std::runtime_error(msgstream() << "The checkpoint file '" << m_path << "' is truncated.");
+        natural_8_bit const* const  result = m_cursor;
+        m_cursor += num_bytes;
+        return result;
+    }
+
+    std::vector<compressed_layer_and_object_indices>  read_objects(std::vector<object_index_type> const&  num_objects_in_layers)
+    {
+        natural_64_bit const  num_objects = read<natural_64_bit>();
+        if ((natural_64_bit)(m_end - m_cursor) / (sizeof(layer_index_type) + sizeof(object_index_type)) < num_objects)
+            throw std::runtime_error(msgstream() << "The checkpoint file '" << m_path << "' is truncated.");
+        std::vector<layer_index_type>  layer_indices(num_objects);
+        std::vector<object_index_type>  object_indices(num_objects);
+        read_array(layer_indices.data(), num_objects);
+        read_array(object_indices.data(), num_objects);
+        std::vector<compressed_layer_and_object_indices>  objects;
+        objects.reserve(num_objects);
+        for (natural_64_bit  i = 0ULL; i != num_objects; ++i)
+        {
+            if (layer_indices.at(i) >= num_objects_in_layers.size() ||
+                object_indices.at(i) >= num_objects_in_layers.at(layer_indices.at(i)))
+                throw std::runtime_error(msgstream() << "The checkpoint file '" << m_path << "' is corrupted.");
+            objects.push_back({ layer_indices.at(i), object_indices.at(i) });
+        }
+        return objects;
+    }
+
+private:
+    natural_8_bit const*  m_cursor;
+    natural_8_bit const*  m_end;
+    std::string  m_path;
+};
+
+
+}}
+
+namespace netlab {
+
+
+natural_32_bit  version_of_format_of_checkpoint_of_network()
+{
+    return 1U;
+}
+
+
+void  save_checkpoint_of_network(network const&  net, boost::filesystem::path const&  path_to_checkpoint_file)
+{
+    TMPROF_BLOCK();
+
+    using namespace private_internal_implementation_details;
+
+    ASSUMPTION(net.get_state() == NETWORK_STATE::READY_FOR_SIMULATION_STEP);
+    ASSUMPTION(!net.is_split_into_domains());
+    ASSUMPTION(net.m_densities_of_ships != nullptr);
+
+    boost::filesystem::ofstream  ostr(path_to_checkpoint_file, std::ios_base::binary);
+    if (!ostr.good())
+        throw std::runtime_error(msgstream() << "Cannot open the checkpoint file '" << path_to_checkpoint_file
+                                             << "' for writing.");
+    checkpoint_writer  writer(ostr);
+
+    for (char const  c : magic_of_checkpoint_file)
+        writer.write(c);
+    writer.write(version_of_format_of_checkpoint_of_network());
+    writer.write(byte_order_marker);
+
+    layer_index_type const  num_layers = (layer_index_type)net.properties()->layer_props().size();
+    writer.write(num_layers);
+    for (layer_index_type  layer_index = 0U; layer_index != num_layers; ++layer_index)
+    {
+        writer.write(net.get_layer_of_spikers(layer_index).size());
+        writer.write(net.get_layer_of_docks(layer_index).size());
+        writer.write(net.get_layer_of_ships(layer_index).size());
+        writer.write(net.get_layer_of_spikers(layer_index).num_bytes_of_payload());
+        writer.write(net.get_layer_of_docks(layer_index).num_bytes_of_payload());
+        writer.write(net.get_layer_of_ships(layer_index).num_bytes_of_payload());
+    }
+
+    writer.write(net.update_id());
+    writer.write(net.seed_of_movement_of_ships());
+    writer.write(net.seed_of_mini_spiking());
+
+    statistics_of_densities_of_ships_in_layers const&  densities = net.densities_of_ships();
+    writer.write_array(densities.ideal_densities().data(), num_layers);
+    writer.write_array(densities.minimal_densities().data(), num_layers);
+    writer.write_array(densities.maximal_densities().data(), num_layers);
+    writer.write_array(densities.average_densities().data(), num_layers);
+    writer.write_array(densities.distribution_of_spikers_by_densities_of_ships().data(), num_layers);
+
+    std::vector<float_32_bit>  coordinates_of_centers;
+    std::vector<natural_64_bit>  last_update_ids;
+    std::vector<natural_8_bit>  payload;
+    for (layer_index_type  layer_index = 0U; layer_index != num_layers; ++layer_index)
+    {
+        layer_of_spikers const&  spikers = net.get_layer_of_spikers(layer_index);
+        coordinates_of_centers.resize(3ULL * spikers.size());
+        last_update_ids.resize(spikers.size());
+        for (object_index_type  spiker_index = 0ULL; spiker_index != spikers.size(); ++spiker_index)
+        {
+            vector3 const&  center = spikers.get_movement_area_center(spiker_index);
+            for (natural_8_bit  axis = 0U; axis != 3U; ++axis)
+                coordinates_of_centers.at(3ULL * spiker_index + axis) = center(axis);
+            last_update_ids.at(spiker_index) = spikers.last_update_id(spiker_index);
+        }
+        writer.write_array(coordinates_of_centers.data(), coordinates_of_centers.size());
+        writer.write_array(last_update_ids.data(), last_update_ids.size());
+        payload.resize(spikers.num_bytes_of_payload());
+        spikers.save_payload(payload.data());
+        writer.write_array(payload.data(), payload.size());
+
+        layer_of_docks const&  docks = net.get_layer_of_docks(layer_index);
+        payload.resize(docks.num_bytes_of_payload());
+        docks.save_payload(payload.data());
+        writer.write_array(payload.data(), payload.size());
+
+        layer_of_ships const&  ships = net.get_layer_of_ships(layer_index);
+        for (natural_8_bit  axis = 0U; axis != 3U; ++axis)
+        {
+            writer.write_array(ships.positions_along_axis(axis).begin(), ships.size());
+            writer.write_array(ships.velocities_along_axis(axis).begin(), ships.size());
+        }
+        payload.resize(ships.num_bytes_of_payload());
+        ships.save_payload(payload.data());
+        writer.write_array(payload.data(), payload.size());
+    }
+
+    std::vector<compressed_layer_and_object_indices>  objects;
+    net.m_current_spikers->for_each(
+            [&objects](compressed_layer_and_object_indices const  spiker_loc) -> void { objects.push_back(spiker_loc); }
+            );
+    writer.write_objects(objects);
+
+    objects.clear();
+    net.m_update_queue_of_ships->for_each(
+            [&objects](compressed_layer_and_object_indices const  ship_loc) -> void { objects.push_back(ship_loc); }
+            );
+    writer.write_objects(objects);
+
+    if (ostr.bad())
+        throw std::runtime_error(msgstream() << "Cannot write to the checkpoint file '" << path_to_checkpoint_file << "'.");
+}
+
+
+void  load_checkpoint_of_network(network&  net, boost::filesystem::path const&  path_to_checkpoint_file)
+{
+    TMPROF_BLOCK();
+
+    using namespace private_internal_implementation_details;
+
+    ASSUMPTION(net.get_state() == NETWORK_STATE::READY_FOR_MOVEMENT_AREA_CENTERS_INITIALISATION);
+
+    std::unique_ptr<boost::interprocess::mapped_region>  region;
+    try
+    {
+        boost::interprocess::file_mapping const  file(path_to_checkpoint_file.string().c_str(), boost::interprocess::read_only);
+        region = std::make_unique<boost::interprocess::mapped_region>(file, boost::interprocess::read_only);
+    }
+    catch (boost::interprocess::interprocess_exception const&  e)
+    {
+        throw std::runtime_error(msgstream() << "Cannot map the checkpoint file '" << path_to_checkpoint_file
+                                             << "' into memory: " << e.what());
+    }
+
+    natural_8_bit const* const  begin_of_file = static_cast<natural_8_bit const*>(region->get_address());
+    checkpoint_reader  reader(begin_of_file, begin_of_file + region->get_size(), path_to_checkpoint_file.string());
+
+    for (char const  c : magic_of_checkpoint_file)
+        if (reader.read<char>() != c)
+            throw std::runtime_error(msgstream() << "The file '" << path_to_checkpoint_file
+                                                 << "' is not a checkpoint of a network.");
+    natural_32_bit const  version = reader.read<natural_32_bit>();
+    if (version != version_of_format_of_checkpoint_of_network())
+        throw std::runtime_error(msgstream() << "The checkpoint file '" << path_to_checkpoint_file
+                                             << "' has unsupported version " << version << ".");
+    if (reader.read<natural_32_bit>() != byte_order_marker)
+        throw std::runtime_error(msgstream() << "The checkpoint file '" << path_to_checkpoint_file
+                                             << "' was written on a machine with a different byte order.");
+
+    // The network is modified only after the layers were checked. A truncated or corrupted file may still be
+    // detected later, when the network is already partially loaded.
+    layer_index_type const  num_layers = (layer_index_type)net.properties()->layer_props().size();
+    if (reader.read<layer_index_type>() != num_layers)
+        throw std::runtime_error(msgstream() << "The checkpoint file '" << path_to_checkpoint_file
+                                             << "' does not match the network.");
+    std::vector<object_index_type>  num_spikers_in_layers;
+    std::vector<object_index_type>  num_ships_in_layers;
+    for (layer_index_type  layer_index = 0U; layer_index != num_layers; ++layer_index)
+    {
+        num_spikers_in_layers.push_back(net.m_layers_of_spikers.at(layer_index)->size());
+        num_ships_in_layers.push_back(net.m_layers_of_ships.at(layer_index)->size());
+        if (reader.read<object_index_type>() != net.m_layers_of_spikers.at(layer_index)->size() ||
+            reader.read<object_index_type>() != net.m_layers_of_docks.at(layer_index)->size() ||
+            reader.read<object_index_type>() != net.m_layers_of_ships.at(layer_index)->size() ||
+            reader.read<natural_64_bit>() != net.m_layers_of_spikers.at(layer_index)->num_bytes_of_payload() ||
+            reader.read<natural_64_bit>() != net.m_layers_of_docks.at(layer_index)->num_bytes_of_payload() ||
+            reader.read<natural_64_bit>() != net.m_layers_of_ships.at(layer_index)->num_bytes_of_payload())
+            throw std::runtime_error(msgstream() << "The checkpoint file '" << path_to_checkpoint_file
+                                                 << "' does not match the network.");
+    }
+
+    net.m_update_id = reader.read<natural_64_bit>();
+    net.m_seed_of_movement_of_ships = reader.read<natural_64_bit>();
+    net.m_seed_of_mini_spiking = reader.read<natural_64_bit>();
+
+    {
+        std::vector<float_32_bit>  ideal_densities(num_layers);
+        std::vector<float_32_bit>  minimal_densities(num_layers);
+        std::vector<float_32_bit>  maximal_densities(num_layers);
+        std::vector<float_32_bit>  average_densities(num_layers);
+        std::vector<distribution_of_spikers_by_density_of_ships>  distribution_of_spikers(num_layers);
+        reader.read_array(ideal_densities.data(), num_layers);
+        reader.read_array(minimal_densities.data(), num_layers);
+        reader.read_array(maximal_densities.data(), num_layers);
+        reader.read_array(average_densities.data(), num_layers);
+        reader.read_array(distribution_of_spikers.data(), num_layers);
+        net.m_densities_of_ships = std::make_unique<statistics_of_densities_of_ships_in_layers>(
+                ideal_densities,
+                minimal_densities,
+                maximal_densities,
+                average_densities,
+                distribution_of_spikers
+                );
+    }
+
+    std::vector<float_32_bit>  coordinates_of_centers;
+    std::vector<natural_64_bit>  last_update_ids;
+    for (layer_index_type  layer_index = 0U; layer_index != num_layers; ++layer_index)
+    {
+        layer_of_spikers&  spikers = *net.m_layers_of_spikers.at(layer_index);
+        coordinates_of_centers.resize(3ULL * spikers.size());
+        reader.read_array(coordinates_of_centers.data(), coordinates_of_centers.size());
+        last_update_ids.resize(spikers.size());
+        reader.read_array(last_update_ids.data(), last_update_ids.size());
+        for (object_index_type  spiker_index = 0ULL; spiker_index != spikers.size(); ++spiker_index)
+        {
+            vector3&  center = spikers.get_movement_area_center(spiker_index);
+            for (natural_8_bit  axis = 0U; axis != 3U; ++axis)
+                center(axis) = coordinates_of_centers.at(3ULL * spiker_index + axis);
+            spikers.set_last_update_id(spiker_index, last_update_ids.at(spiker_index));
+        }
+        spikers.load_payload(reader.skip(spikers.num_bytes_of_payload()));
+
+        layer_of_docks&  docks = *net.m_layers_of_docks.at(layer_index);
+        docks.load_payload(reader.skip(docks.num_bytes_of_payload()));
+
+        layer_of_ships&  ships = *net.m_layers_of_ships.at(layer_index);
+        for (natural_8_bit  axis = 0U; axis != 3U; ++axis)
+        {
+            reader.read_array(ships.positions_along_axis(axis).begin(), ships.size());
+            reader.read_array(ships.velocities_along_axis(axis).begin(), ships.size());
+        }
+        ships.load_payload(reader.skip(ships.num_bytes_of_payload()));
+    }
+
+    for (compressed_layer_and_object_indices const  spiker_loc : reader.read_objects(num_spikers_in_layers))
+        net.m_current_spikers->insert(spiker_loc);
+    for (compressed_layer_and_object_indices const  ship_loc : reader.read_objects(num_ships_in_layers))
+        net.m_update_queue_of_ships->insert(ship_loc);
+
+    net.build_map_from_dock_sectors_to_ships();
+
+    net.m_state = NETWORK_STATE::READY_FOR_SIMULATION_STEP;
+
+    LOG(debug,"Loaded the checkpoint of network from the file '" << path_to_checkpoint_file << "'.");
+}
+
+
+}
@@ -0,0 +1,48 @@
+#include <netlab/dense_set_of_objects.hpp>
+#include <utility/assumptions.hpp>
+
+namespace netlab {
+
+
+dense_set_of_objects::dense_set_of_objects(std::vector<object_index_type> const&  num_objects_in_layers)
+    : m_members()
+    , m_listed()
+    , m_worklist()
+{
+    ASSUMPTION(num_objects_in_layers.size() <= max_number_of_layers());
+    for (object_index_type const  num_objects : num_objects_in_layers)
+    {
+        m_members.push_back(std::vector<natural_64_bit>((num_objects + 63ULL) >> 6U, 0ULL));
+        m_listed.push_back(std::vector<natural_64_bit>((num_objects + 63ULL) >> 6U, 0ULL));
+    }
+}
+
+
+bool  dense_set_of_objects::insert(compressed_layer_and_object_indices const  loc)
+{
+    natural_64_bit const  mask = bit_mask(loc);
+    m_members.at(loc.layer_index()).at(loc.object_index() >> 6U) |= mask;
+    natural_64_bit&  listed_word = m_listed.at(loc.layer_index()).at(loc.object_index() >> 6U);
+    if ((listed_word & mask) == 0ULL)
+    {
+        listed_word |= mask;
+        m_worklist.push_back(loc);
+        return true;
+    }
+    return false;
+}
+
+
+void  dense_set_of_objects::clear()
+{
+    // Each set bit belongs to an object in the worklist, so clearing whole words of listed objects clears all bits.
+    for (compressed_layer_and_object_indices const  loc : m_worklist)
+    {
+        m_members.at(loc.layer_index()).at(loc.object_index() >> 6U) = 0ULL;
+        m_listed.at(loc.layer_index()).at(loc.object_index() >> 6U) = 0ULL;
+    }
+    m_worklist.clear();
+}
+
+
+}
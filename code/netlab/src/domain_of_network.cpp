@@ -0,0 +1,229 @@
+#include <netlab/domain_of_network.hpp>
+#include <utility/assumptions.hpp>
+#include <utility/invariants.hpp>
+#include <utility/timeprof.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace netlab { namespace detail {
+
+
+/// A number of dock sectors along the axis of slabs, which are added to the distance, from which a ship can see
+/// other ships, in the computation of ranges of interested domains. It covers positions of ships inside their
+/// sectors and the extension of the range of sectors of ships woken up by a moved ship.
+inline constexpr natural_32_bit  num_extra_dock_sectors_in_halo() noexcept { return 2U; }
+
+
+}}
+
+namespace netlab {
+
+
+domain_of_network::domain_of_network(
+        std::shared_ptr<network_props> const  network_properties,
+        std::shared_ptr<transport_between_domains> const  transport
+        )
+    : m_properties(network_properties)
+    , m_transport(transport)
+    , m_axis_of_slabs(0U)
+    , m_boundaries_of_slabs()
+    , m_domains_of_spiker_coordinates()
+    , m_first_interested_domains_of_dock_coordinates()
+    , m_last_interested_domains_of_dock_coordinates()
+    , m_owned_ships()
+    , m_num_owned_ships(0ULL)
+    , m_num_owned_ships_with_controllers(0ULL)
+    , m_messages()
+{
+    TMPROF_BLOCK();
+
+    ASSUMPTION(m_properties != nullptr && m_transport != nullptr);
+    ASSUMPTION(num_domains() > 0U && domain_index() < num_domains());
+
+    std::vector<network_layer_props> const&  layers = m_properties->layer_props();
+    ASSUMPTION(!layers.empty());
+
+    // Slabs are cut along the axis, along which centres of spikers of all layers span the longer distance.
+    vector3  lo = layers.front().low_corner_of_spikers();
+    vector3  hi = layers.front().high_corner_of_spikers();
+    for (network_layer_props const&  layer_props : layers)
+        for (natural_8_bit  axis = 0U; axis != 2U; ++axis)
+        {
+            lo(axis) = std::min(lo(axis), layer_props.low_corner_of_spikers()(axis));
+            hi(axis) = std::max(hi(axis), layer_props.high_corner_of_spikers()(axis));
+        }
+    m_axis_of_slabs = (hi(1) - lo(1) > hi(0) - lo(0)) ? 1U : 0U;
+
+    float_32_bit const  low = lo(m_axis_of_slabs);
+    float_32_bit const  width = (hi(m_axis_of_slabs) - low) / (float_32_bit)num_domains();
+    for (natural_32_bit  d = 0U; d != num_domains(); ++d)
+        m_boundaries_of_slabs.push_back(low + (float_32_bit)d * width);
+    m_boundaries_of_slabs.push_back(hi(m_axis_of_slabs));
+
+    auto const  domain_of_coordinate =
+        [this, low, width](float_32_bit const  coord) -> natural_32_bit {
+            if (!(width > 0.0f) || coord <= low)
+                return 0U;
+            return std::min(num_domains() - 1U, (natural_32_bit)((coord - low) / width));
+        };
+
+    for (network_layer_props const&  layer_props : layers)
+    {
+        natural_32_bit const  num_spiker_coords =
+                m_axis_of_slabs == 0U ? layer_props.num_spikers_along_x_axis() : layer_props.num_spikers_along_y_axis();
+        natural_32_bit const  num_docks_per_spiker_coord =
+                m_axis_of_slabs == 0U ? layer_props.num_docks_along_x_axis_per_spiker() :
+                                        layer_props.num_docks_along_y_axis_per_spiker();
+
+        m_domains_of_spiker_coordinates.push_back({});
+        std::vector<natural_32_bit>&  domains = m_domains_of_spiker_coordinates.back();
+        for (sector_coordinate_type  coord = 0U; coord != num_spiker_coords; ++coord)
+        {
+            vector3 const  centre = m_axis_of_slabs == 0U ? layer_props.spiker_sector_centre(coord, 0U, 0U) :
+                                                            layer_props.spiker_sector_centre(0U, coord, 0U);
+            domains.push_back(domain_of_coordinate(centre(m_axis_of_slabs)));
+        }
+
+        // Domains are ordered along the axis, so the interested domains of a dock sector are those owning the first
+        // and the last dock sector in the halo around the sector, and all domains in between.
+        natural_32_bit  halo = 1U;
+        if (layer_props.ship_controller_ptr() != nullptr)
+            halo = (natural_32_bit)std::ceil(
+                        layer_props.ship_controller_ptr()->docks_enumerations_distance_for_accelerate_from_ship() *
+                        layer_props.inverted_distance_of_docks_in_meters()
+                        ) + detail::num_extra_dock_sectors_in_halo();
+        natural_32_bit const  num_dock_coords = num_spiker_coords * num_docks_per_spiker_coord;
+        m_first_interested_domains_of_dock_coordinates.push_back({});
+        m_last_interested_domains_of_dock_coordinates.push_back({});
+        for (sector_coordinate_type  coord = 0U; coord != num_dock_coords; ++coord)
+        {
+            sector_coordinate_type const  first_coord = coord < halo ? 0U : coord - halo;
+            sector_coordinate_type const  last_coord = std::min(num_dock_coords - 1U, coord + halo);
+            m_first_interested_domains_of_dock_coordinates.back().push_back(domains.at(first_coord / num_docks_per_spiker_coord));
+            m_last_interested_domains_of_dock_coordinates.back().push_back(domains.at(last_coord / num_docks_per_spiker_coord));
+        }
+
+        m_owned_ships.push_back(std::vector<natural_64_bit>((layer_props.num_ships() + 63ULL) >> 6U, 0ULL));
+    }
+
+    m_messages.resize(num_domains());
+}
+
+
+float_32_bit  domain_of_network::boundary_of_slab(natural_32_bit const  index) const
+{
+    return m_boundaries_of_slabs.at(index);
+}
+
+
+natural_32_bit  domain_of_network::domain_of_spiker(
+        layer_index_type const  layer_index,
+        object_index_type const  spiker_index
+        ) const
+{
+    sector_coordinate_type  x, y, c;
+    m_properties->layer_props().at(layer_index).spiker_sector_coordinates(spiker_index, x, y, c);
+    return m_domains_of_spiker_coordinates.at(layer_index).at(m_axis_of_slabs == 0U ? x : y);
+}
+
+
+natural_32_bit  domain_of_network::domain_of_dock_sector(
+        layer_index_type const  layer_index,
+        object_index_type const  sector_index
+        ) const
+{
+    network_layer_props const&  layer_props = m_properties->layer_props().at(layer_index);
+    sector_coordinate_type  x, y, c;
+    layer_props.dock_sector_coordinates(sector_index, x, y, c);
+    return m_domains_of_spiker_coordinates.at(layer_index).at(
+                m_axis_of_slabs == 0U ? x / layer_props.num_docks_along_x_axis_per_spiker() :
+                                        y / layer_props.num_docks_along_y_axis_per_spiker()
+                );
+}
+
+
+void  domain_of_network::domains_interested_in_dock_sector(
+        layer_index_type const  layer_index,
+        object_index_type const  sector_index,
+        natural_32_bit&  first,
+        natural_32_bit&  last
+        ) const
+{
+    sector_coordinate_type  x, y, c;
+    m_properties->layer_props().at(layer_index).dock_sector_coordinates(sector_index, x, y, c);
+    sector_coordinate_type const  coord = m_axis_of_slabs == 0U ? x : y;
+    first = m_first_interested_domains_of_dock_coordinates.at(layer_index).at(coord);
+    last = m_last_interested_domains_of_dock_coordinates.at(layer_index).at(coord);
+}
+
+
+bool  domain_of_network::owns_some_ship(
+        layer_index_type const  layer_index,
+        object_index_type const  begin,
+        object_index_type const  end
+        ) const
+{
+    ASSUMPTION(begin <= end && end <= m_properties->layer_props().at(layer_index).num_ships());
+    if (begin == end)
+        return false;
+    std::vector<natural_64_bit> const&  owned_ships = m_owned_ships.at(layer_index);
+    natural_64_bit const  first_word = begin >> 6U;
+    natural_64_bit const  last_word = (end - 1ULL) >> 6U;
+    natural_64_bit const  first_mask = ~0ULL << (begin & 63ULL);
+    natural_64_bit const  last_mask = ~0ULL >> (63ULL - ((end - 1ULL) & 63ULL));
+    if (first_word == last_word)
+        return (owned_ships.at(first_word) & first_mask & last_mask) != 0ULL;
+    if ((owned_ships.at(first_word) & first_mask) != 0ULL || (owned_ships.at(last_word) & last_mask) != 0ULL)
+        return true;
+    for (natural_64_bit  word = first_word + 1ULL; word < last_word; ++word)
+        if (owned_ships.at(word) != 0ULL)
+            return true;
+    return false;
+}
+
+
+void  domain_of_network::acquire_ship(compressed_layer_and_object_indices const  ship_loc)
+{
+    ASSUMPTION(!owns_ship(ship_loc));
+    m_owned_ships.at(ship_loc.layer_index()).at(ship_loc.object_index() >> 6U) |= bit_mask(ship_loc);
+    ++m_num_owned_ships;
+    if (m_properties->layer_props().at(ship_loc.layer_index()).ship_controller_ptr() != nullptr)
+        ++m_num_owned_ships_with_controllers;
+}
+
+
+void  domain_of_network::release_ship(compressed_layer_and_object_indices const  ship_loc)
+{
+    ASSUMPTION(owns_ship(ship_loc));
+    m_owned_ships.at(ship_loc.layer_index()).at(ship_loc.object_index() >> 6U) &= ~bit_mask(ship_loc);
+    --m_num_owned_ships;
+    if (m_properties->layer_props().at(ship_loc.layer_index()).ship_controller_ptr() != nullptr)
+        --m_num_owned_ships_with_controllers;
+}
+
+
+void  domain_of_network::clear_messages()
+{
+    for (std::vector<natural_8_bit>&  message : m_messages)
+        message.clear();
+}
+
+
+natural_64_bit  domain_of_network::num_bytes() const
+{
+    natural_64_bit  result = sizeof(domain_of_network) + m_boundaries_of_slabs.capacity() * sizeof(float_32_bit);
+    for (std::vector<natural_32_bit> const&  table : m_domains_of_spiker_coordinates)
+        result += table.capacity() * sizeof(natural_32_bit);
+    for (std::vector<natural_32_bit> const&  table : m_first_interested_domains_of_dock_coordinates)
+        result += table.capacity() * sizeof(natural_32_bit);
+    for (std::vector<natural_32_bit> const&  table : m_last_interested_domains_of_dock_coordinates)
+        result += table.capacity() * sizeof(natural_32_bit);
+    for (std::vector<natural_64_bit> const&  bits : m_owned_ships)
+        result += bits.capacity() * sizeof(natural_64_bit);
+    for (std::vector<natural_8_bit> const&  message : m_messages)
+        result += message.capacity();
+    return result;
+}
+
+
+}
@@ -0,0 +1,104 @@
+#include <netlab/in_process_transport.hpp>
+#include <utility/msgstream.hpp>
+#include <utility/assumptions.hpp>
+#include <utility/timeprof.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+
+namespace netlab {
+
+
+struct  in_process_transport::hub
+{
+    hub(natural_32_bit const  num_domains_, float_64_bit const  timeout_in_seconds_)
+        : num_domains(num_domains_)
+        , timeout_in_seconds(timeout_in_seconds_)
+        , mailboxes(num_domains_ * num_domains_)
+        , mutex()
+        , condition()
+        , num_waiting_domains(0U)
+        , generation(0ULL)
+    {}
+
+    /// The mailbox of messages from the domain 'from_domain' to the domain 'to_domain'.
+    std::vector<natural_8_bit>&  mailbox(natural_32_bit const  from_domain, natural_32_bit const  to_domain)
+    { return mailboxes.at(from_domain * num_domains + to_domain); }
+
+    /// It returns, when all domains called it. It throws 'std::runtime_error', if they do not do so in time.
+    void  wait_for_all_domains()
+    {
+        std::unique_lock<std::mutex>  lock(mutex);
+        natural_64_bit const  my_generation = generation;
+        if (++num_waiting_domains == num_domains)
+        {
+            num_waiting_domains = 0U;
+            ++generation;
+            condition.notify_all();
+            return;
+        }
+        if (!condition.wait_for(lock,
+                                std::chrono::duration<float_64_bit>(timeout_in_seconds),
+                                [this, my_generation]() { return generation != my_generation; }))
+            throw std::runtime_error(msgstream() << "Domains did not exchange messages in " << timeout_in_seconds
+                                                 << " seconds.");
+    }
+
+    natural_32_bit const  num_domains;
+    float_64_bit const  timeout_in_seconds;
+    std::vector< std::vector<natural_8_bit> >  mailboxes;
+    std::mutex  mutex;
+    std::condition_variable  condition;
+    natural_32_bit  num_waiting_domains;
+    natural_64_bit  generation;
+};
+
+
+std::shared_ptr<in_process_transport::hub>  in_process_transport::create_hub(
+        natural_32_bit const  num_domains,
+        float_64_bit const  timeout_in_seconds
+        )
+{
+    ASSUMPTION(num_domains > 0U);
+    ASSUMPTION(timeout_in_seconds > 0.0);
+    return std::make_shared<hub>(num_domains, timeout_in_seconds);
+}
+
+
+in_process_transport::in_process_transport(std::shared_ptr<hub> const  hub_ptr, natural_32_bit const  domain_index)
+    : m_hub(hub_ptr)
+    , m_domain_index(domain_index)
+{
+    ASSUMPTION(m_hub != nullptr && m_domain_index < m_hub->num_domains);
+}
+
+
+natural_32_bit  in_process_transport::num_domains() const
+{
+    return m_hub->num_domains;
+}
+
+
+void  in_process_transport::exchange(std::vector< std::vector<natural_8_bit> >&  messages)
+{
+    TMPROF_BLOCK();
+
+    ASSUMPTION(messages.size() == m_hub->num_domains);
+
+    // Outgoing messages are swapped into the mailboxes of this domain. When all domains did so, incoming messages
+    // are swapped out of mailboxes of other domains. The second wait keeps a fast domain from filling its mailboxes
+    // for the next exchange, before other domains took messages of this one.
+
+    for (natural_32_bit  d = 0U; d != m_hub->num_domains; ++d)
+        if (d != m_domain_index)
+            m_hub->mailbox(m_domain_index, d).swap(messages.at(d));
+    m_hub->wait_for_all_domains();
+    for (natural_32_bit  d = 0U; d != m_hub->num_domains; ++d)
+        if (d != m_domain_index)
+            messages.at(d).swap(m_hub->mailbox(d, m_domain_index));
+    m_hub->wait_for_all_domains();
+}
+
+
+}
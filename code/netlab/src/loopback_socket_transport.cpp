@@ -0,0 +1,224 @@
+#include <netlab/loopback_socket_transport.hpp>
+#include <utility/msgstream.hpp>
+#include <utility/assumptions.hpp>
+#include <utility/invariants.hpp>
+#include <utility/timeprof.hpp>
+#include <boost/asio.hpp>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <stdexcept>
+
+namespace netlab {
+
+
+struct  loopback_socket_transport::connections
+{
+    boost::asio::io_context  io;
+    std::vector< std::unique_ptr<boost::asio::ip::tcp::socket> >  sockets;  //!< The socket at the own index is null.
+
+    /// Buffers of 'exchange', kept between calls only to avoid reallocations.
+    std::vector<natural_64_bit>  sizes_of_outgoing;
+    std::vector<natural_64_bit>  sizes_of_incoming;
+    std::vector< std::vector<natural_8_bit> >  received_messages;
+};
+
+
+}
+
+namespace netlab { namespace detail { namespace {
+
+
+/// It runs handlers of asynchronous operations started on the passed context for at most the passed time. It returns
+/// true, if all the operations completed. Otherwise, it cancels the operations on the passed sockets and returns false.
+bool  run_with_timeout(
+        boost::asio::io_context&  io,
+        float_64_bit const  timeout_in_seconds,
+        std::function<void()> const&  cancel
+        )
+{
+    io.restart();
+    io.run_for(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<float_64_bit>(timeout_in_seconds)));
+    if (io.stopped())
+        return true;
+    cancel();
+    io.restart();
+    io.run();
+    return false;
+}
+
+
+}}}
+
+namespace netlab {
+
+
+loopback_socket_transport::loopback_socket_transport(
+        natural_16_bit const  first_port,
+        natural_32_bit const  num_domains,
+        natural_32_bit const  domain_index,
+        float_64_bit const  timeout_in_seconds
+        )
+    : m_num_domains(num_domains)
+    , m_domain_index(domain_index)
+    , m_timeout_in_seconds(timeout_in_seconds)
+    , m_connections(std::make_unique<connections>())
+{
+    TMPROF_BLOCK();
+
+    using boost::asio::ip::tcp;
+
+    ASSUMPTION(m_num_domains > 0U && m_domain_index < m_num_domains);
+    ASSUMPTION((natural_32_bit)first_port + m_num_domains <= 65536U);
+    ASSUMPTION(m_timeout_in_seconds > 0.0);
+
+    connections&  c = *m_connections;
+    c.sockets.resize(m_num_domains);
+    c.sizes_of_outgoing.resize(m_num_domains, 0ULL);
+    c.sizes_of_incoming.resize(m_num_domains, 0ULL);
+    c.received_messages.resize(m_num_domains);
+
+    boost::asio::ip::address const  loopback = boost::asio::ip::address_v4::loopback();
+    auto const  endpoint_of_domain =
+        [first_port, &loopback](natural_32_bit const  index) -> tcp::endpoint {
+            return tcp::endpoint(loopback, (natural_16_bit)(first_port + index));
+        };
+
+    tcp::acceptor  acceptor(c.io);
+    boost::system::error_code  error;
+    acceptor.open(tcp::v4(), error);
+    if (!error)
+        acceptor.set_option(tcp::acceptor::reuse_address(true), error);
+    if (!error)
+        acceptor.bind(endpoint_of_domain(m_domain_index), error);
+    if (!error)
+        acceptor.listen(boost::asio::socket_base::max_listen_connections, error);
+    if (error)
+        throw std::runtime_error(msgstream() << "The domain " << m_domain_index << " cannot listen on the port "
+                                             << first_port + m_domain_index << ": " << error.message());
+
+    std::chrono::steady_clock::time_point const  start_time = std::chrono::steady_clock::now();
+    auto const  remaining_seconds =
+        [this, start_time]() -> float_64_bit {
+            return m_timeout_in_seconds -
+                   std::chrono::duration<float_64_bit>(std::chrono::steady_clock::now() - start_time).count();
+        };
+
+    // Listeners of lower domains may not exist yet, so a refused connection is retried until the timeout.
+    for (natural_32_bit  d = 0U; d != m_domain_index; ++d)
+    {
+        std::unique_ptr<tcp::socket>  socket = std::make_unique<tcp::socket>(c.io);
+        while (true)
+        {
+            socket->connect(endpoint_of_domain(d), error);
+            if (!error)
+                break;
+            socket->close();
+            if (remaining_seconds() <= 0.0)
+                throw std::runtime_error(msgstream() << "The domain " << m_domain_index << " cannot connect to the domain "
+                                                     << d << ": " << error.message());
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        socket->set_option(tcp::no_delay(true));
+        boost::asio::write(*socket, boost::asio::buffer(&m_domain_index, sizeof(m_domain_index)), error);
+        if (error)
+            throw std::runtime_error(msgstream() << "The domain " << m_domain_index << " cannot introduce itself to the domain "
+                                                 << d << ": " << error.message());
+        c.sockets.at(d) = std::move(socket);
+    }
+
+    for (natural_32_bit  i = m_domain_index + 1U; i != m_num_domains; ++i)
+    {
+        std::unique_ptr<tcp::socket>  socket = std::make_unique<tcp::socket>(c.io);
+        natural_32_bit  peer_index = m_num_domains;
+        acceptor.async_accept(
+                *socket,
+                [&socket, &peer_index, &error](boost::system::error_code const&  accept_error) -> void {
+                    error = accept_error;
+                    if (!error)
+                        boost::asio::async_read(
+                                *socket,
+                                boost::asio::buffer(&peer_index, sizeof(peer_index)),
+                                [&error](boost::system::error_code const&  read_error, std::size_t) -> void {
+                                    error = read_error;
+                                });
+                });
+        if (!detail::run_with_timeout(c.io, std::max(0.0, remaining_seconds()), [&acceptor, &socket]() { acceptor.cancel(); socket->close(); }))
+            throw std::runtime_error(msgstream() << "Only " << i - 1U << " of " << m_num_domains - 1U
+                                                 << " domains connected to the domain " << m_domain_index << " in time.");
+        if (error)
+            throw std::runtime_error(msgstream() << "The domain " << m_domain_index << " cannot accept a connection: "
+                                                 << error.message());
+        if (peer_index <= m_domain_index || peer_index >= m_num_domains || c.sockets.at(peer_index) != nullptr)
+            throw std::runtime_error(msgstream() << "The domain " << m_domain_index << " was connected by an unexpected domain "
+                                                 << peer_index << ".");
+        socket->set_option(tcp::no_delay(true));
+        c.sockets.at(peer_index) = std::move(socket);
+    }
+}
+
+
+loopback_socket_transport::~loopback_socket_transport()
+{}
+
+
+void  loopback_socket_transport::exchange(std::vector< std::vector<natural_8_bit> >&  messages)
+{
+    TMPROF_BLOCK();
+
+    ASSUMPTION(messages.size() == m_num_domains);
+
+    connections&  c = *m_connections;
+    boost::system::error_code  first_error;
+    auto const  record_error =
+        [&first_error](boost::system::error_code const&  error) -> void {
+            if (error && !first_error)
+                first_error = error;
+        };
+
+    // Each message is preceded by its size. All writes and reads are started at once and the context runs them
+    // concurrently, so no domain waits for a peer to read before it reads from the peer itself.
+    for (natural_32_bit  d = 0U; d != m_num_domains; ++d)
+    {
+        if (d == m_domain_index)
+            continue;
+        boost::asio::ip::tcp::socket&  socket = *c.sockets.at(d);
+
+        c.sizes_of_outgoing.at(d) = messages.at(d).size();
+        std::array<boost::asio::const_buffer, 2>  outgoing = {{
+            boost::asio::buffer(&c.sizes_of_outgoing.at(d), sizeof(natural_64_bit)),
+            boost::asio::buffer(messages.at(d))
+            }};
+        boost::asio::async_write(socket, outgoing, [&record_error](boost::system::error_code const&  error, std::size_t) -> void {
+            record_error(error);
+        });
+
+        boost::asio::async_read(
+                socket,
+                boost::asio::buffer(&c.sizes_of_incoming.at(d), sizeof(natural_64_bit)),
+                [&c, &socket, &record_error, d](boost::system::error_code const&  error, std::size_t) -> void {
+                    record_error(error);
+                    if (error)
+                        return;
+                    std::vector<natural_8_bit>&  message = c.received_messages.at(d);
+                    message.resize(c.sizes_of_incoming.at(d));
+                    boost::asio::async_read(socket, boost::asio::buffer(message), [&record_error](boost::system::error_code const&  error, std::size_t) -> void {
+                        record_error(error);
+                    });
+                });
+    }
+
+    if (!detail::run_with_timeout(c.io, m_timeout_in_seconds, [&c]() { for (auto&  socket : c.sockets) if (socket != nullptr) socket->cancel(); }))
+        throw std::runtime_error(msgstream() << "The domain " << m_domain_index << " did not exchange messages with other domains in time.");
+    if (first_error)
+        throw std::runtime_error(msgstream() << "The domain " << m_domain_index << " failed to exchange messages with other domains: "
+                                             << first_error.message());
+
+    for (natural_32_bit  d = 0U; d != m_num_domains; ++d)
+        if (d != m_domain_index)
+            messages.at(d).swap(c.received_messages.at(d));
+}
+
+
+}
@@ -5,10 +5,13 @@
 #include <utility/timeprof.hpp>
 #include <utility/log.hpp>
 #include <utility/development.hpp>
+#include <utility/msgstream.hpp>
 #include <array>
 #include <algorithm>
 #include <limits>
+#include <cmath>
 #include <iterator>
+#include <stdexcept>
 
 namespace netlab { namespace detail {
 
@@ -26,6 +29,128 @@ std::unique_ptr<extra_data_for_spikers_in_layers>  create_extra_data_for_spikers
 }
 
 
+std::vector<object_index_type>  num_spikers_in_layers(network_props const&  props)
+{
+    std::vector<object_index_type>  result;
+    for (network_layer_props const&  layer_props : props.layer_props())
+        result.push_back(layer_props.num_spikers());
+    return result;
+}
+
+
+std::vector<object_index_type>  num_docks_in_layers(network_props const&  props)
+{
+    std::vector<object_index_type>  result;
+    for (network_layer_props const&  layer_props : props.layer_props())
+        result.push_back(layer_props.num_docks());
+    return result;
+}
+
+
+std::vector<object_index_type>  num_ships_in_layers(network_props const&  props)
+{
+    std::vector<object_index_type>  result;
+    for (network_layer_props const&  layer_props : props.layer_props())
+        result.push_back(layer_props.num_ships());
+    return result;
+}
+
+
+/// Number of spikers in one bucket of deliveries of spikes. It is a multiple of 64, so buckets never share
+/// a word of bitsets of spiking spikers.
+inline constexpr natural_64_bit  num_spikers_in_bucket_of_deliveries() noexcept { return 4096ULL; }
+
+
+/// Number of ships of a layer whose mini-spikes are drawn from one stream of random numbers.
+inline constexpr natural_64_bit  num_ships_in_chunk_of_mini_spiking() noexcept { return 256ULL; }
+
+
+/// Returns a binomially distributed number of mini-spikes, out of 'num_mini_spikes', which fall into the first part
+/// of a range of ships, where 'probability' is the ratio of the number of ships in the first part to the number
+/// of all ships in the range. Few mini-spikes are tried one by one; otherwise the distribution is inverted by
+/// a search started at its mode, so the expected cost is proportional to the standard deviation.
+inline natural_64_bit  num_mini_spikes_in_first_part(
+        natural_64_bit const  num_mini_spikes,
+        float_64_bit const  probability,
+        counter_based_random_generator&  generator
+        )
+{
+    if (probability <= 0.0)
+        return 0ULL;
+    if (probability >= 1.0)
+        return num_mini_spikes;
+    if (num_mini_spikes <= 16ULL)
+    {
+        natural_64_bit  result = 0ULL;
+        for (natural_64_bit  i = 0ULL; i != num_mini_spikes; ++i)
+            if (((float_64_bit)generator() + 0.5) / 4294967296.0 < probability)
+                ++result;
+        return result;
+    }
+    float_64_bit const  n = (float_64_bit)num_mini_spikes;
+    float_64_bit const  ratio = probability / (1.0 - probability);
+    natural_64_bit const  mode = std::min(num_mini_spikes, (natural_64_bit)std::floor((n + 1.0) * probability));
+    float_64_bit const  m = (float_64_bit)mode;
+    float_64_bit  u = ((float_64_bit)generator() + 0.5) / 4294967296.0;
+    float_64_bit  probability_of_low = std::exp(std::lgamma(n + 1.0) - std::lgamma(m + 1.0) - std::lgamma(n - m + 1.0)
+                                                + m * std::log(probability) + (n - m) * std::log1p(-probability));
+    float_64_bit  probability_of_high = probability_of_low;
+    u -= probability_of_low;
+    for (natural_64_bit  low = mode, high = mode; u > 0.0 && (low != 0ULL || high != num_mini_spikes); )
+    {
+        if (high != num_mini_spikes)
+        {
+            probability_of_high *= ((n - (float_64_bit)high) / ((float_64_bit)high + 1.0)) * ratio;
+            ++high;
+            u -= probability_of_high;
+            if (u <= 0.0)
+                return high;
+        }
+        if (low != 0ULL)
+        {
+            probability_of_low *= (float_64_bit)low / ((n - (float_64_bit)low + 1.0) * ratio);
+            --low;
+            u -= probability_of_low;
+            if (u <= 0.0)
+                return low;
+        }
+    }
+    return mode;
+}
+
+
+/// Number of ships whose accelerations are computed first and then they are integrated together.
+inline constexpr natural_32_bit  size_of_block_of_ships_to_integrate() noexcept { return 64U; }
+
+
+/// Tags mixed into keys of random streams of the network, so that streams of different purposes (which may have
+/// equal seeds and are keyed by similar steps and substreams) never coincide.
+inline constexpr natural_64_bit  tag_of_random_stream_of_movement_of_ships() noexcept { return 0x6d6f76656d656e74ULL; }
+inline constexpr natural_64_bit  tag_of_random_stream_of_mini_spiking() noexcept { return 0x6d696e692d73706bULL; }
+
+
+/// Flags of a movement of a ship sent to another domain.
+inline constexpr natural_8_bit  flag_of_docked_ship() noexcept { return 1U; }
+inline constexpr natural_8_bit  flag_of_migrating_ship() noexcept { return 2U; }
+
+
+void  write_vector3(message_writer&  writer, vector3 const&  u)
+{
+    writer.write<float_32_bit>(u(0));
+    writer.write<float_32_bit>(u(1));
+    writer.write<float_32_bit>(u(2));
+}
+
+
+vector3  read_vector3(message_reader&  reader)
+{
+    float_32_bit const  x = reader.read<float_32_bit>();
+    float_32_bit const  y = reader.read<float_32_bit>();
+    float_32_bit const  z = reader.read<float_32_bit>();
+    return { x, y, z };
+}
+
+
 }}
 
 
@@ -58,16 +183,31 @@ network::network(std::shared_ptr<network_props> const  network_properties,
     , m_layers_of_spikers()
     , m_layers_of_docks()
     , m_layers_of_ships()
+    , m_sector_resolver(std::make_unique<sector_resolver>(*network_properties))
     , m_ships_in_sectors()
     , m_densities_of_ships()
     , m_update_id(0UL)
-    , m_update_queue_of_ships()
-    , m_max_size_of_update_queue_of_ships(0ULL)
-    , m_is_update_queue_of_ships_overloaded(true)
+    , m_update_queue_of_ships(std::make_unique<active_set_of_ships>(detail::num_ships_in_layers(*network_properties)))
+    , m_num_ships_with_controllers(0ULL)
+    , m_dock_sectors_to_wake_up_around(std::make_unique<dense_set_of_objects>(detail::num_docks_in_layers(*network_properties)))
     , m_use_update_queue_of_ships(true)
-    , m_mini_spiking_random_generator()
-    , m_current_spikers(std::make_unique< std::unordered_set<compressed_layer_and_object_indices> >())
-    , m_next_spikers(std::make_unique< std::unordered_set<compressed_layer_and_object_indices> >())
+    , m_ships_to_move()
+    , m_movements_of_ships()
+    , m_buffers_for_movement_of_ships()
+    , m_thread_pool()
+    , m_seed_of_movement_of_ships(0ULL)
+    , m_seed_of_mini_spiking(0ULL)
+    , m_num_mini_spikes_in_last_update(0ULL)
+    , m_current_spikers(std::make_unique<dense_set_of_objects>(detail::num_spikers_in_layers(*network_properties)))
+    , m_next_spikers(std::make_unique<dense_set_of_objects>(detail::num_spikers_in_layers(*network_properties)))
+    , m_ships_begin_in_layers{0ULL}
+    , m_buckets_begin_in_layers{0ULL}
+    , m_deliveries_of_threads()
+    , m_mini_spike_deliveries_of_threads()
+    , m_spiking_decisions_in_buckets()
+    , m_domain()
+    , m_keys_of_next_spikers()
+    , m_received_movements_of_ships()
 {
     TMPROF_BLOCK();
 
@@ -91,11 +231,17 @@ network::network(std::shared_ptr<network_props> const  network_properties,
         m_layers_of_ships.emplace_back(layers_factory->create_layer_of_ships(layer_index, layer_props.num_ships()));
         ASSUMPTION(m_layers_of_ships.back()->size() == layer_props.num_ships());
 
-        m_max_size_of_update_queue_of_ships += layer_props.num_ships();
-    }
+        m_ships_begin_in_layers.push_back(m_ships_begin_in_layers.back() + layer_props.num_ships());
+        if (layer_props.ship_controller_ptr() != nullptr)
+            m_num_ships_with_controllers += layer_props.num_ships();
 
-    m_max_size_of_update_queue_of_ships =
-            std::max(1ULL,(natural_64_bit)std::round((float_64_bit)m_max_size_of_update_queue_of_ships * 1.0));
+        m_buckets_begin_in_layers.push_back(
+                m_buckets_begin_in_layers.back() +
+                (layer_props.num_spikers() + detail::num_spikers_in_bucket_of_deliveries() - 1ULL)
+                        / detail::num_spikers_in_bucket_of_deliveries()
+                );
+    }
+    m_spiking_decisions_in_buckets.resize(m_buckets_begin_in_layers.back());
 
     m_state = NETWORK_STATE::READY_FOR_MOVEMENT_AREA_CENTERS_INITIALISATION;
 }
@@ -115,12 +261,21 @@ void  network::initialise_movement_area_centers(initialiser_of_movement_area_cen
 
         layer_of_spikers&  spikers = *m_layers_of_spikers.at(layer_index);
 
-        object_index_type  spiker_index = 0UL;
-        for (sector_coordinate_type  c = 0U; c < layer_props.num_spikers_along_c_axis(); ++c)
-            for (sector_coordinate_type  y = 0U; y < layer_props.num_spikers_along_y_axis(); ++y)
-                for (sector_coordinate_type  x = 0U; x < layer_props.num_spikers_along_x_axis(); ++x)
+        natural_32_bit const  num_threads =
+                !area_centers_initialiser.can_compute_initial_movement_area_centers_concurrently() ? 1U :
+                        std::max(1U, (natural_32_bit)std::min((natural_64_bit)properties()->num_threads_to_use(),
+                                                              layer_props.num_spikers()));
+
+        auto const  compute_movement_area_centers_of_thread =
+            [this, layer_index, num_threads, &layer_props, &spikers, &area_centers_initialiser](
+                    natural_32_bit const  thread_index) -> void {
+                for (object_index_type  spiker_index = (layer_props.num_spikers() * thread_index) / num_threads,
+                                        end = (layer_props.num_spikers() * (thread_index + 1U)) / num_threads;
+                     spiker_index != end;
+                     ++spiker_index)
                 {
-                    INVARIANT(spiker_index == layer_props.spiker_sector_index(x,y,c));
+                    sector_coordinate_type  x, y, c;
+                    layer_props.spiker_sector_coordinates(spiker_index, x, y, c);
 
                     layer_index_type  area_layer_index;
                     area_centers_initialiser.compute_initial_movement_area_center_for_ships_of_spiker(
@@ -160,9 +315,13 @@ void  network::initialise_movement_area_centers(initialiser_of_movement_area_cen
                                   spikers.get_movement_area_center(spiker_index),
                                   layer_props.size_of_ship_movement_area_in_meters(area_layer_index))
                             );
-
-                    ++spiker_index;
                 }
+            };
+
+        if (num_threads == 1U)
+            compute_movement_area_centers_of_thread(0U);
+        else
+            get_thread_pool(num_threads)->run_and_wait(num_threads, compute_movement_area_centers_of_thread);
     }
 
     m_state = NETWORK_STATE::READY_FOR_MOVEMENT_AREA_CENTERS_MIGRATION_STARTUP;
@@ -213,61 +372,175 @@ void  network::do_movement_area_centers_migration_step(initialiser_of_movement_a
     }
 
     access_to_movement_area_centers  movement_area_centers(&m_layers_of_spikers);
+
+    auto const  check_movement_area_center =
+        [this](layer_index_type const  layer_index, layer_index_type const  area_layer_index,
+               sector_coordinate_type const  x, sector_coordinate_type const  y, sector_coordinate_type const  c,
+               vector3 const&  center) -> void {
+            network_layer_props const&  layer_props = properties()->layer_props().at(layer_index);
+            ASSUMPTION(
+                    [](vector3 const&  center, vector3 const&  size_of_ship_movement_area_in_meters,
+                        vector3 const&  low_corner, vector3 const&  high_corner) -> bool {
+                        vector3 const  area_shift = 0.5f * size_of_ship_movement_area_in_meters;
+                        for (int i = 0; i != 3; ++i)
+                            if (center(i) - area_shift(i) < low_corner(i) - 0.001f ||
+                                center(i) + area_shift(i) > high_corner(i) + 0.001f )
+                                return false;
+                        return true;
+                        }(center,layer_props.size_of_ship_movement_area_in_meters(area_layer_index),
+                          properties()->layer_props().at(area_layer_index).low_corner_of_ships(),
+                          properties()->layer_props().at(area_layer_index).high_corner_of_ships())
+                    );
+            ASSUMPTION(
+                    area_layer_index != layer_index ||
+                    [](vector3 const&  spiker_pos, vector3 const&  spikers_dist,
+                        vector3 const&  area_center, vector3 const&  area_size) -> bool {
+                        vector3 const  area_shift = 0.5f * area_size;
+                        vector3 const  delta = area_center - spiker_pos;
+                        return std::abs(delta(0)) >= area_shift(0) + 0.5f * spikers_dist(0) ||
+                                std::abs(delta(1)) >= area_shift(1) + 0.5f * spikers_dist(1) ||
+                                std::abs(delta(2)) >= area_shift(2) + 0.5f * spikers_dist(2) ;
+                        }(layer_props.spiker_sector_centre(x,y,c),layer_props.distance_of_spikers_in_meters(),
+                          center,layer_props.size_of_ship_movement_area_in_meters(area_layer_index))
+                    );
+        };
+
+    if (false == area_centers_initialiser.can_shift_movement_area_centers_concurrently())
+    {
+        // A shift of a center changes densities of ships in sectors of spikers, which are then read when shifting
+        // centers of the following spikers. So, the initialiser is called for spikers one by one.
+        for (layer_index_type const  layer_index : layers_to_update)
+        {
+            network_layer_props const&  layer_props = properties()->layer_props().at(layer_index);
+
+            layer_of_spikers&  spikers = *m_layers_of_spikers.at(layer_index);
+
+            object_index_type  spiker_index = 0UL;
+            for (sector_coordinate_type  c = 0U; c < layer_props.num_spikers_along_c_axis(); ++c)
+                for (sector_coordinate_type  y = 0U; y < layer_props.num_spikers_along_y_axis(); ++y)
+                    for (sector_coordinate_type  x = 0U; x < layer_props.num_spikers_along_x_axis(); ++x)
+                    {
+                        INVARIANT(spiker_index == layer_props.spiker_sector_index(x,y,c));
+
+                        vector3&  center = spikers.get_movement_area_center(spiker_index);
+
+                        layer_index_type const  area_layer_index = properties()->find_layer_index(center(2));
+
+                        area_centers_initialiser.on_shift_movement_area_center_in_layer(
+                                layer_index,
+                                spiker_index,
+                                x,y,c,
+                                area_layer_index,
+                                *properties(),
+                                movement_area_centers,
+                                center,
+                                extra_data_accessor
+                                );
+
+                        check_movement_area_center(layer_index, area_layer_index, x, y, c, center);
+
+                        ++spiker_index;
+                    }
+        }
+        return;
+    }
+
+    // Spikers of one colour are at least the extents apart along some axis, so their shifts read and write disjoint
+    // densities. Therefore, shifts of all spikers of a colour are computed in parallel from the densities left by
+    // previous colours, and then they are applied in the order of spikers.
+    std::vector<object_index_type>  spikers_of_colour;
+    std::vector<vector3>  moved_centers;
+    std::vector<natural_8_bit>  do_move_centers;
     for (layer_index_type const  layer_index : layers_to_update)
     {
         network_layer_props const&  layer_props = properties()->layer_props().at(layer_index);
 
         layer_of_spikers&  spikers = *m_layers_of_spikers.at(layer_index);
 
-        object_index_type  spiker_index = 0UL;
-        for (sector_coordinate_type  c = 0U; c < layer_props.num_spikers_along_c_axis(); ++c)
-            for (sector_coordinate_type  y = 0U; y < layer_props.num_spikers_along_y_axis(); ++y)
-                for (sector_coordinate_type  x = 0U; x < layer_props.num_spikers_along_x_axis(); ++x)
+        std::array<natural_32_bit, 3ULL> const  extents =
+                area_centers_initialiser.get_extents_of_independent_shifts_of_movement_area_centers(layer_index, *properties());
+        sector_coordinate_type const  num_colours_along_x_axis =
+                std::max(1U, std::min(extents.at(0ULL), layer_props.num_spikers_along_x_axis()));
+        sector_coordinate_type const  num_colours_along_y_axis =
+                std::max(1U, std::min(extents.at(1ULL), layer_props.num_spikers_along_y_axis()));
+        sector_coordinate_type const  num_colours_along_c_axis =
+                std::max(1U, std::min(extents.at(2ULL), layer_props.num_spikers_along_c_axis()));
+
+        for (sector_coordinate_type  colour_c = 0U; colour_c != num_colours_along_c_axis; ++colour_c)
+            for (sector_coordinate_type  colour_y = 0U; colour_y != num_colours_along_y_axis; ++colour_y)
+                for (sector_coordinate_type  colour_x = 0U; colour_x != num_colours_along_x_axis; ++colour_x)
                 {
-                    INVARIANT(spiker_index == layer_props.spiker_sector_index(x,y,c));
+                    spikers_of_colour.clear();
+                    for (sector_coordinate_type  c = colour_c; c < layer_props.num_spikers_along_c_axis(); c += num_colours_along_c_axis)
+                        for (sector_coordinate_type  y = colour_y; y < layer_props.num_spikers_along_y_axis(); y += num_colours_along_y_axis)
+                            for (sector_coordinate_type  x = colour_x; x < layer_props.num_spikers_along_x_axis(); x += num_colours_along_x_axis)
+                                spikers_of_colour.push_back(layer_props.spiker_sector_index(x,y,c));
+                    moved_centers.resize(spikers_of_colour.size());
+                    do_move_centers.assign(spikers_of_colour.size(), 0U);
+
+                    natural_32_bit const  num_threads =
+                            std::max(1U, (natural_32_bit)std::min((natural_64_bit)properties()->num_threads_to_use(),
+                                                                  (natural_64_bit)spikers_of_colour.size()));
+
+                    auto const  compute_shifts_of_thread =
+                        [this, layer_index, num_threads, &layer_props, &spikers, &spikers_of_colour, &moved_centers,
+                         &do_move_centers, &movement_area_centers, &extra_data_accessor, &area_centers_initialiser](
+                                natural_32_bit const  thread_index) -> void {
+                            for (natural_64_bit  i = (spikers_of_colour.size() * thread_index) / num_threads,
+                                                 end = (spikers_of_colour.size() * (thread_index + 1U)) / num_threads;
+                                 i != end;
+                                 ++i)
+                            {
+                                object_index_type const  spiker_index = spikers_of_colour.at(i);
+                                sector_coordinate_type  x, y, c;
+                                layer_props.spiker_sector_coordinates(spiker_index, x, y, c);
+
+                                vector3 const&  center = spikers.get_movement_area_center(spiker_index);
+
+                                do_move_centers.at(i) =
+                                        area_centers_initialiser.compute_shift_of_movement_area_center_in_layer(
+                                                layer_index,
+                                                spiker_index,
+                                                x,y,c,
+                                                properties()->find_layer_index(center(2)),
+                                                *properties(),
+                                                movement_area_centers,
+                                                center,
+                                                extra_data_accessor,
+                                                moved_centers.at(i)
+                                                ) ? 1U : 0U;
+                            }
+                        };
 
-                    vector3&  center = spikers.get_movement_area_center(spiker_index);
+                    if (num_threads == 1U)
+                        compute_shifts_of_thread(0U);
+                    else
+                        get_thread_pool(num_threads)->run_and_wait(num_threads, compute_shifts_of_thread);
 
-                    layer_index_type const  area_layer_index = properties()->find_layer_index(center(2));
+                    for (natural_64_bit  i = 0ULL; i != spikers_of_colour.size(); ++i)
+                        if (do_move_centers.at(i) != 0U)
+                        {
+                            object_index_type const  spiker_index = spikers_of_colour.at(i);
+                            sector_coordinate_type  x, y, c;
+                            layer_props.spiker_sector_coordinates(spiker_index, x, y, c);
 
-                    area_centers_initialiser.on_shift_movement_area_center_in_layer(
-                            layer_index,
-                            spiker_index,
-                            x,y,c,
-                            area_layer_index,
-                            *properties(),
-                            movement_area_centers,
-                            center,
-                            extra_data_accessor
-                            );
-                        
-                    ASSUMPTION(
-                            [](vector3 const&  center, vector3 const&  size_of_ship_movement_area_in_meters,
-                                vector3 const&  low_corner, vector3 const&  high_corner) -> bool {
-                                vector3 const  area_shift = 0.5f * size_of_ship_movement_area_in_meters;
-                                for (int i = 0; i != 3; ++i)
-                                    if (center(i) - area_shift(i) < low_corner(i) - 0.001f ||
-                                        center(i) + area_shift(i) > high_corner(i) + 0.001f )
-                                        return false;
-                                return true;
-                                }(center,layer_props.size_of_ship_movement_area_in_meters(area_layer_index),
-                                  properties()->layer_props().at(area_layer_index).low_corner_of_ships(),
-                                  properties()->layer_props().at(area_layer_index).high_corner_of_ships())
-                            );
-                    ASSUMPTION(
-                            area_layer_index != layer_index ||
-                            [](vector3 const&  spiker_pos, vector3 const&  spikers_dist,
-                                vector3 const&  area_center, vector3 const&  area_size) -> bool {
-                                vector3 const  area_shift = 0.5f * area_size;
-                                vector3 const  delta = area_center - spiker_pos;
-                                return std::abs(delta(0)) >= area_shift(0) + 0.5f * spikers_dist(0) ||
-                                        std::abs(delta(1)) >= area_shift(1) + 0.5f * spikers_dist(1) ||
-                                        std::abs(delta(2)) >= area_shift(2) + 0.5f * spikers_dist(2) ;
-                                }(layer_props.spiker_sector_centre(x,y,c),layer_props.distance_of_spikers_in_meters(),
-                                  center,layer_props.size_of_ship_movement_area_in_meters(area_layer_index))
-                            );
+                            vector3&  center = spikers.get_movement_area_center(spiker_index);
 
-                    ++spiker_index;
+                            layer_index_type const  area_layer_index = properties()->find_layer_index(center(2));
+
+                            area_centers_initialiser.apply_shift_of_movement_area_center_in_layer(
+                                    layer_index,
+                                    spiker_index,
+                                    x,y,c,
+                                    area_layer_index,
+                                    *properties(),
+                                    moved_centers.at(i),
+                                    center,
+                                    extra_data_accessor
+                                    );
+
+                            check_movement_area_center(layer_index, area_layer_index, x, y, c, center);
+                        }
                 }
     }
 }
@@ -287,7 +560,13 @@ void  network::compute_densities_of_ships_in_layers()
         initialise_densities_of_ships_per_spiker_in_layers(*properties(),extra_data_accessor);
 
         access_to_movement_area_centers  movement_area_centers(&m_layers_of_spikers);
-        compute_densities_of_ships_per_spiker_in_layers(*properties(),movement_area_centers,extra_data_accessor);
+        compute_densities_of_ships_per_spiker_in_layers(
+                *properties(),
+                movement_area_centers,
+                extra_data_accessor,
+                get_thread_pool(properties()->num_threads_to_use()),
+                properties()->num_threads_to_use()
+                );
     }
     {
         std::vector<float_32_bit>  ideal_densities;
@@ -339,13 +618,19 @@ void  network::lunch_ships_into_movement_areas(initialiser_of_ships_in_movement_
         layer_of_ships&  ships = *m_layers_of_ships.at(layer_index);
         layer_of_spikers&  spikers = *m_layers_of_spikers.at(layer_index);
 
-        object_index_type  spiker_index = 0UL;
-        for (sector_coordinate_type  c = 0U; c < layer_props.num_spikers_along_c_axis(); ++c)
-            for (sector_coordinate_type  y = 0U; y < layer_props.num_spikers_along_y_axis(); ++y)
-                for (sector_coordinate_type  x = 0U; x < layer_props.num_spikers_along_x_axis(); ++x)
+        natural_32_bit const  num_threads =
+                !ships_initialiser.can_compute_ships_in_movement_areas_concurrently() ? 1U :
+                        std::max(1U, (natural_32_bit)std::min((natural_64_bit)properties()->num_threads_to_use(),
+                                                              layer_props.num_spikers()));
+
+        auto const  lunch_ships_of_thread =
+            [this, layer_index, num_threads, &layer_props, &ships, &spikers, &ships_initialiser](
+                    natural_32_bit const  thread_index) -> void {
+                for (object_index_type  spiker_index = (layer_props.num_spikers() * thread_index) / num_threads,
+                                        end = (layer_props.num_spikers() * (thread_index + 1U)) / num_threads;
+                     spiker_index != end;
+                     ++spiker_index)
                 {
-                    INVARIANT(spiker_index == layer_props.spiker_sector_index(x,y,c));
-
                     ships_initialiser.on_next_area(layer_index, spiker_index, *properties());
 
                     vector3&  center = spikers.get_movement_area_center(spiker_index);
@@ -355,15 +640,20 @@ void  network::lunch_ships_into_movement_areas(initialiser_of_ships_in_movement_
                     object_index_type const  ships_begin_index = layer_props.ships_begin_index_of_spiker(spiker_index);
                     for (natural_32_bit  i = 0U; i < layer_props.num_ships_per_spiker(); ++i)
                     {
+                        vector3  ship_position = ships.position(ships_begin_index + i);
+                        vector3  ship_velocity = ships.velocity(ships_begin_index + i);
                         ships_initialiser.compute_ship_position_and_velocity_in_movement_area(
                                     center,
                                     i,
                                     layer_index,
+                                    spiker_index,
                                     area_layer_index,
                                     *properties(),
-                                    ships.get_position_nonconst_reference(ships_begin_index + i),
-                                    ships.get_velocity_nonconst_reference(ships_begin_index + i)
+                                    ship_position,
+                                    ship_velocity
                                     );
+                        ships.set_position(ships_begin_index + i, ship_position);
+                        ships.set_velocity(ships_begin_index + i, ship_velocity);
                         ASSUMPTION(
                                 [](vector3 const&  center, network_layer_props const&  props,
                                    layer_index_type const  area_layer_index, vector3 const&  ship_position,
@@ -386,9 +676,13 @@ void  network::lunch_ships_into_movement_areas(initialiser_of_ships_in_movement_
                                       ships.position(ships_begin_index + i),ships.velocity(ships_begin_index + i))
                                 );
                     }
-
-                    ++spiker_index;
                 }
+            };
+
+        if (num_threads == 1U)
+            lunch_ships_of_thread(0U);
+        else
+            get_thread_pool(num_threads)->run_and_wait(num_threads, lunch_ships_of_thread);
     }
 
     m_state = NETWORK_STATE::READY_FOR_INITIALISATION_OF_MAP_FROM_DOCK_SECTORS_TO_SHIPS;
@@ -401,37 +695,141 @@ void  network::initialise_map_from_dock_sectors_to_ships()
 
     ASSUMPTION(get_state() == NETWORK_STATE::READY_FOR_INITIALISATION_OF_MAP_FROM_DOCK_SECTORS_TO_SHIPS);
 
-    m_ships_in_sectors.resize(properties()->layer_props().size());
+    build_map_from_dock_sectors_to_ships();
 
     for (layer_index_type  layer_index = 0U; layer_index < properties()->layer_props().size(); ++layer_index)
+        for (object_index_type  ship_index = 0UL; ship_index < m_layers_of_ships.at(layer_index)->size(); ++ship_index)
+            wake_up_ship({ layer_index, ship_index });
+
+    m_state = NETWORK_STATE::READY_FOR_SIMULATION_STEP;
+}
+
+
+void  network::build_map_from_dock_sectors_to_ships()
+{
+    TMPROF_BLOCK();
+
     {
-        network_layer_props const&  layer_props = properties()->layer_props().at(layer_index);
+        std::vector<object_index_type>  num_docks_in_layers;
+        std::vector<object_index_type>  num_ships_in_layers;
+        for (layer_index_type  layer_index = 0U; layer_index < properties()->layer_props().size(); ++layer_index)
+        {
+            num_docks_in_layers.push_back(properties()->layer_props().at(layer_index).num_docks());
+            num_ships_in_layers.push_back(m_layers_of_ships.at(layer_index)->size());
+        }
+        m_ships_in_sectors = std::make_unique<ships_in_dock_sectors>(num_docks_in_layers,num_ships_in_layers);
+    }
+
+    // Threads resolve dock sectors of disjoint ranges of ships. The map is freshly created, so its sectors of ships
+    // can be recorded concurrently (see 'ships_in_dock_sectors::set_sector_of_ship').
+    INVARIANT(m_ships_in_sectors->is_rebuild_needed());
+
+    natural_64_bit const  num_ships = m_ships_begin_in_layers.back();
+    natural_32_bit const  num_threads =
+            std::max(1U, (natural_32_bit)std::min((natural_64_bit)properties()->num_threads_to_use(), num_ships));
+
+    auto const  record_sectors_of_ships_of_thread =
+        [this, num_ships, num_threads](natural_32_bit const  thread_index) -> void {
+            layer_index_type  layer_index = 0U;
+            for (natural_64_bit  i = (num_ships * thread_index) / num_threads, end = (num_ships * (thread_index + 1U)) / num_threads;
+                 i != end;
+                 ++i)
+            {
+                while (i >= m_ships_begin_in_layers.at(layer_index + 1U))
+                    ++layer_index;
+                object_index_type const  ship_index = i - m_ships_begin_in_layers.at(layer_index);
+
+                layer_index_type  area_layer_index;
+                object_index_type  sector_index;
+                find_dock_sector_of_ship({ layer_index, ship_index }, area_layer_index, sector_index);
+                m_ships_in_sectors->set_sector_of_ship({ layer_index, ship_index }, area_layer_index, sector_index);
+            }
+        };
+
+    if (num_threads == 1U)
+        record_sectors_of_ships_of_thread(0U);
+    else
+        get_thread_pool(num_threads)->run_and_wait(num_threads, record_sectors_of_ships_of_thread);
+
+    m_ships_in_sectors->rebuild(get_thread_pool(properties()->num_threads_to_use()), properties()->num_threads_to_use());
+}
 
-        std::vector<compressed_layer_and_object_indices>  empty_dock_sector;
-        empty_dock_sector.reserve(3UL + layer_props.num_ships() / layer_props.num_docks());
-        m_ships_in_sectors.at(layer_index).resize(layer_props.num_docks(), empty_dock_sector);
+
+void  network::find_dock_sector_of_ship(
+        compressed_layer_and_object_indices const  ship_loc,
+        layer_index_type&  area_layer_index,
+        object_index_type&  sector_index
+        ) const
+{
+    layer_index_type const  layer_index = ship_loc.layer_index();
+    object_index_type const  ship_index = ship_loc.object_index();
+    network_layer_props const&  ship_layer_props = properties()->layer_props().at(layer_index);
+    object_index_type const  spiker_sector_index = ship_layer_props.spiker_index_from_ship_index(ship_index);
+    vector3 const&  movement_area_center = m_layers_of_spikers.at(layer_index)->get_movement_area_center(spiker_sector_index);
+    area_layer_index = m_sector_resolver->find_layer_index(movement_area_center(2));
+    ASSUMPTION(area_layer_index < properties()->layer_props().size());
+    {
+        sector_coordinate_type  x, y, c;
+        m_sector_resolver->dock_sector_coordinates(area_layer_index, m_layers_of_ships.at(layer_index)->position(ship_index), x, y, c);
+        sector_index = m_sector_resolver->dock_sector_index(area_layer_index, x, y, c);
     }
+    ASSUMPTION(sector_index < properties()->layer_props().at(area_layer_index).num_docks());
+}
+
+
+void  network::split_into_domains(std::shared_ptr<transport_between_domains> const  transport)
+{
+    TMPROF_BLOCK();
+
+    ASSUMPTION(get_state() == NETWORK_STATE::READY_FOR_SIMULATION_STEP);
+    ASSUMPTION(!is_split_into_domains() && transport != nullptr);
+
+    m_domain = std::make_unique<domain_of_network>(properties(), transport);
 
     for (layer_index_type  layer_index = 0U; layer_index < properties()->layer_props().size(); ++layer_index)
         for (object_index_type  ship_index = 0UL; ship_index < m_layers_of_ships.at(layer_index)->size(); ++ship_index)
         {
-            network_layer_props const&  ship_layer_props = properties()->layer_props().at(layer_index);
-            object_index_type const  spiker_sector_index = ship_layer_props.spiker_index_from_ship_index(ship_index);
-            vector3 const&  movement_area_center = m_layers_of_spikers.at(layer_index)->get_movement_area_center(spiker_sector_index);
-            layer_index_type const  area_layer_index = properties()->find_layer_index(movement_area_center(2));
-            ASSUMPTION(area_layer_index < properties()->layer_props().size());
-            network_layer_props const&  area_layer_props = properties()->layer_props().at(area_layer_index);
+            layer_index_type  area_layer_index;
             object_index_type  sector_index;
-            {
-                sector_coordinate_type  x, y, c;
-                area_layer_props.dock_sector_coordinates(m_layers_of_ships.at(layer_index)->position(ship_index), x, y, c);
-                sector_index = area_layer_props.dock_sector_index(x, y, c);
-            }
-            ASSUMPTION(sector_index < m_ships_in_sectors.at(area_layer_index).size());
-            m_ships_in_sectors.at(area_layer_index).at(sector_index).push_back({ layer_index, ship_index });
+            find_dock_sector_of_ship({ layer_index, ship_index }, area_layer_index, sector_index);
+            if (m_domain->domain_of_dock_sector(area_layer_index, sector_index) == m_domain->domain_index())
+                m_domain->acquire_ship({ layer_index, ship_index });
         }
 
-    m_state = NETWORK_STATE::READY_FOR_SIMULATION_STEP;
+    // Only owned ships stay awake. The order of the remaining ones is preserved.
+    m_ships_to_move.clear();
+    m_update_queue_of_ships->extract_all(m_ships_to_move);
+    for (compressed_layer_and_object_indices const  ship_loc : m_ships_to_move)
+        if (m_domain->owns_ship(ship_loc))
+            m_update_queue_of_ships->insert(ship_loc);
+    m_ships_to_move.clear();
+
+    // All domains must simulate the same network from the same state. We check at least what is cheap to check.
+    m_domain->clear_messages();
+    for (natural_32_bit  d = 0U; d != m_domain->num_domains(); ++d)
+        if (d != m_domain->domain_index())
+        {
+            message_writer  writer(m_domain->messages().at(d));
+            writer.write(m_update_id);
+            writer.write(properties()->num_ships());
+            writer.write(m_seed_of_movement_of_ships);
+            writer.write(m_seed_of_mini_spiking);
+        }
+    m_domain->transport().exchange(m_domain->messages());
+    for (natural_32_bit  d = 0U; d != m_domain->num_domains(); ++d)
+        if (d != m_domain->domain_index())
+        {
+            message_reader  reader(m_domain->messages().at(d));
+            natural_64_bit const  update_id = reader.read<natural_64_bit>();
+            natural_64_bit const  num_ships = reader.read<natural_64_bit>();
+            natural_64_bit const  seed_of_movement_of_ships = reader.read<natural_64_bit>();
+            natural_64_bit const  seed_of_mini_spiking = reader.read<natural_64_bit>();
+            if (update_id != m_update_id || num_ships != properties()->num_ships() ||
+                seed_of_movement_of_ships != m_seed_of_movement_of_ships || seed_of_mini_spiking != m_seed_of_mini_spiking)
+                throw std::runtime_error(msgstream() << "The domain " << d << " holds a different network than the domain "
+                                                     << m_domain->domain_index() << ".");
+        }
+    m_domain->clear_messages();
 }
 
 
@@ -447,6 +845,14 @@ extra_data_for_spikers_in_one_layer::value_type  network::get_extra_data_of_spik
 }
 
 
+natural_64_bit  network::num_spikers_to_spike_in_next_update() const
+{
+    natural_64_bit  result = 0ULL;
+    m_current_spikers->for_each([&result](compressed_layer_and_object_indices const) -> void { ++result; });
+    return result;
+}
+
+
 void  network::do_simulation_step(
         const bool  use_spiking,
         const bool  use_mini_spiking,
@@ -463,109 +869,351 @@ void  network::do_simulation_step(
     if (use_movement_of_ships)
         update_movement_of_ships(dynamic_cast<tracked_ship_stats*>(stats_of_tracked_object));
 
-    if (use_mini_spiking)
-        update_mini_spiking(use_spiking,stats_of_tracked_object);
+    m_num_mini_spikes_in_last_update = use_mini_spiking ? update_mini_spiking(use_spiking,stats_of_tracked_object) : 0ULL;
 
     if (use_spiking)
         update_spiking(stats_of_tracked_object);
 }
 
 
+void  network::buffers_for_movement_of_ship::resize(natural_32_bit const  size_of_block)
+{
+    for (natural_8_bit  axis = 0U; axis != 3U; ++axis)
+    {
+        positions[axis].resize(size_of_block);
+        velocities[axis].resize(size_of_block);
+        accelerations[axis].resize(size_of_block);
+    }
+    speeds.resize(size_of_block);
+    min_speeds.resize(size_of_block);
+    max_speeds.resize(size_of_block);
+    nearest_dock_positions.resize(size_of_block, vector3_zero());
+    random_generators.resize(size_of_block);
+}
+
+
+natural_64_bit  network::bucket_of_deliveries(
+        layer_index_type const  layer_index,
+        object_index_type const  spiker_index
+        ) const
+{
+    return m_buckets_begin_in_layers.at(layer_index) + spiker_index / detail::num_spikers_in_bucket_of_deliveries();
+}
+
+
+thread_pool*  network::get_thread_pool(natural_32_bit const  num_threads)
+{
+    if (num_threads <= 1U)
+        return nullptr;
+    if (m_thread_pool == nullptr || m_thread_pool->num_workers() + 1U < num_threads)
+        m_thread_pool = std::make_unique<thread_pool>(num_threads - 1U);
+    return m_thread_pool.get();
+}
+
+
 void  network::update_movement_of_ships(tracked_ship_stats* const  stats_of_tracked_ship)
 {
     TMPROF_BLOCK();
 
-    if (is_update_queue_of_ships_overloaded() || !is_update_queue_of_ships_used())
+    // The update runs in three passes. First we collect ships to be moved. Then we compute their new positions
+    // and velocities in parallel, all from the unchanged (read-only) state of ships and sectors. Each thread
+    // processes its ships in blocks: it computes accelerations of ships of a block one by one, and then it
+    // integrates velocities and positions of all ships of the block together (see 'integrate_movement_of_ships').
+    // Finally, we write the results back, record new dock sectors of ships and rebuild the update queue. The last pass processes
+    // ships in the order of collection, so the result does not depend on the number of threads. The map from
+    // dock sectors to ships is then rebuilt at once, if any ship changed its sector. When the update queue is used,
+    // only awake ships are collected. Moved ships which are not docked stay awake, and sleeping ships near their old
+    // and new positions are woken up. Docked ships wake up nobody, otherwise they would wake up themselves.
+    //
+    // When the network is split into domains, only owned ships are moved. Their movements are then exchanged with
+    // other domains (see 'exchange_movements_of_ships'), and sleeping owned ships are woken up also around
+    // the received movements.
+
+    m_ships_to_move.clear();
+    if (!is_update_queue_of_ships_used())
     {
-        m_is_update_queue_of_ships_overloaded = !is_update_queue_of_ships_used();
-        m_update_queue_of_ships.clear();
-
         for (layer_index_type  layer_index = 0U; layer_index < properties()->layer_props().size(); ++layer_index)
         {
             if (properties()->layer_props().at(layer_index).ship_controller_ptr() == nullptr)
                 continue;
-
-            network_layer_props const&  ship_layer_props = properties()->layer_props().at(layer_index);
-
             for (object_index_type  ship_index_in_layer = 0ULL, num_ships = m_layers_of_ships.at(layer_index)->size();
                     ship_index_in_layer < num_ships;
                     ++ship_index_in_layer
                     )
-            {
-                update_movement_of_ship(layer_index,ship_index_in_layer,stats_of_tracked_ship);
+                if (m_domain == nullptr || m_domain->owns_ship({layer_index,ship_index_in_layer}))
+                    m_ships_to_move.push_back({layer_index,ship_index_in_layer});
+        }
+    }
+    else
+        m_update_queue_of_ships->extract_all(m_ships_to_move);
 
-                layer_index_type const  area_layer_index =
-                        properties()->find_layer_index(
-                            m_layers_of_spikers.at(layer_index)->get_movement_area_center(
-                                ship_layer_props.spiker_index_from_ship_index(ship_index_in_layer)
-                                )(2)
-                            );
-                network_layer_props const&  area_layer_props = properties()->layer_props().at(area_layer_index);
+    m_movements_of_ships.resize(m_ships_to_move.size());
 
-                layer_of_ships const&  ships = *m_layers_of_ships.at(layer_index);
-                if (!is_update_queue_of_ships_overloaded() && is_update_queue_of_ships_used() &&
-                    !area_layer_props.ship_controller_ptr()->is_ship_docked(
-                            ships.position(ship_index_in_layer),
-                            ships.velocity(ship_index_in_layer),
-                            area_layer_index,
-                            *properties()
-                            ))
+    natural_32_bit const  num_threads =
+            std::max(1U, (natural_32_bit)std::min((natural_64_bit)properties()->num_threads_to_use(),
+                                                  (natural_64_bit)m_ships_to_move.size()));
+    if (m_buffers_for_movement_of_ships.size() < num_threads)
+        m_buffers_for_movement_of_ships.resize(num_threads);
+    {
+        TMPROF_BLOCK();
+
+        auto const  compute_movements_of_ships_of_thread =
+            [this, num_threads](natural_32_bit const  thread_index) -> void {
+                natural_64_bit const  num_ships = m_ships_to_move.size();
+                natural_64_bit const  end = (num_ships * (thread_index + 1U)) / num_threads;
+                buffers_for_movement_of_ship&  buffers = m_buffers_for_movement_of_ships.at(thread_index);
+                buffers.resize(detail::size_of_block_of_ships_to_integrate());
+                for (natural_64_bit  block_begin = (num_ships * thread_index) / num_threads; block_begin < end; )
                 {
-                    m_update_queue_of_ships.push_back({layer_index,ship_index_in_layer});
-                    if (m_update_queue_of_ships.size() > max_size_of_update_queue_of_ships())
-                        m_is_update_queue_of_ships_overloaded = true;
+                    natural_32_bit const  block_size =
+                            (natural_32_bit)std::min(end - block_begin,
+                                                     (natural_64_bit)detail::size_of_block_of_ships_to_integrate());
+                    for (natural_32_bit  i = 0U; i != block_size; ++i)
+                        compute_acceleration_of_ship(m_ships_to_move.at(block_begin + i),
+                                                     m_movements_of_ships.at(block_begin + i),
+                                                     buffers,
+                                                     i);
+                    integrate_movement_of_ships(&m_ships_to_move.at(block_begin),
+                                                &m_movements_of_ships.at(block_begin),
+                                                block_size,
+                                                buffers);
+                    block_begin += block_size;
                 }
-            }
-        }
+            };
+        if (num_threads == 1U)
+            compute_movements_of_ships_of_thread(0U);
+        else
+            get_thread_pool(num_threads)->run_and_wait(num_threads, compute_movements_of_ships_of_thread);
     }
-    else
+
+    if (m_domain != nullptr)
+        m_domain->clear_messages();
+    for (natural_64_bit  i = 0ULL; i != m_ships_to_move.size(); ++i)
     {
-        for (natural_64_bit  i = 0ULL, n = m_update_queue_of_ships.size(); i != n; ++i)
+        compressed_layer_and_object_indices const  ship_loc = m_ships_to_move.at(i);
+        movement_of_ship const&  movement = m_movements_of_ships.at(i);
+
+        layer_of_ships&  ships = *m_layers_of_ships.at(ship_loc.layer_index());
+        ships.set_position(ship_loc.object_index(),movement.position);
+        ships.set_velocity(ship_loc.object_index(),movement.velocity);
+
+        if (movement.new_sector_index != movement.old_sector_index)
+            m_ships_in_sectors->set_sector_of_ship(ship_loc, movement.area_layer_index, movement.new_sector_index);
+
+        bool const  is_migrating = m_domain != nullptr && send_movement_of_ship(ship_loc, movement);
+
+        if (!movement.is_docked && is_update_queue_of_ships_used() && !is_migrating)
+            m_update_queue_of_ships->insert(ship_loc);
+    }
+
+    m_received_movements_of_ships.clear();
+    if (m_domain != nullptr)
+        exchange_movements_of_ships();
+
+    m_ships_in_sectors->update(get_thread_pool(properties()->num_threads_to_use()), properties()->num_threads_to_use());
+
+    // Each sector is processed only once, no matter how many ships moved in or out of it. When no ship sleeps,
+    // there is nothing to wake up.
+    natural_64_bit const  num_ships_to_keep_awake =
+            m_domain == nullptr ? m_num_ships_with_controllers : m_domain->num_owned_ships_with_controllers();
+    if (is_update_queue_of_ships_used() && size_of_update_queue_of_ships() != num_ships_to_keep_awake)
+    {
+        for (natural_64_bit  i = 0ULL; i != m_ships_to_move.size(); ++i)
         {
-            INVARIANT(!m_update_queue_of_ships.empty());
+            movement_of_ship const&  movement = m_movements_of_ships.at(i);
+            if (movement.is_docked)
+                continue;
+            m_dock_sectors_to_wake_up_around->insert({ movement.area_layer_index, movement.new_sector_index });
+            m_dock_sectors_to_wake_up_around->insert({ movement.area_layer_index, movement.old_sector_index });
+        }
+        for (received_movement_of_ship const&  movement : m_received_movements_of_ships)
+        {
+            m_dock_sectors_to_wake_up_around->insert({ movement.area_layer_index, movement.new_sector_index });
+            m_dock_sectors_to_wake_up_around->insert({ movement.area_layer_index, movement.old_sector_index });
+        }
+        m_dock_sectors_to_wake_up_around->for_each(
+                [this](compressed_layer_and_object_indices const  sector_loc) -> void {
+                    wake_up_ships_near_dock_sector(sector_loc.layer_index(), sector_loc.object_index());
+                });
+        m_dock_sectors_to_wake_up_around->clear();
+    }
+}
 
-            auto const  ship_id = m_update_queue_of_ships.front();
-            m_update_queue_of_ships.pop_front();
 
-            update_movement_of_ship(ship_id.layer_index(),ship_id.object_index(),stats_of_tracked_ship);
+void  network::enable_usage_of_queues_in_update_of_ships(bool const  enable_state)
+{
+    if (enable_state && !m_use_update_queue_of_ships && get_state() == NETWORK_STATE::READY_FOR_SIMULATION_STEP)
+        for (layer_index_type  layer_index = 0U; layer_index < properties()->layer_props().size(); ++layer_index)
+            for (object_index_type  ship_index = 0UL; ship_index < m_layers_of_ships.at(layer_index)->size(); ++ship_index)
+                wake_up_ship({ layer_index, ship_index });
+    m_use_update_queue_of_ships = enable_state;
+}
 
-            network_layer_props const&  ship_layer_props = properties()->layer_props().at(ship_id.layer_index());
-            layer_index_type const  area_layer_index =
-                    properties()->find_layer_index(
-                        m_layers_of_spikers.at(ship_id.layer_index())->get_movement_area_center(
-                            ship_layer_props.spiker_index_from_ship_index(ship_id.object_index())
-                            )(2)
-                        );
-            network_layer_props const&  area_layer_props = properties()->layer_props().at(area_layer_index);
 
-            layer_of_ships const&  ships = *m_layers_of_ships.at(ship_id.layer_index());
-            if (!area_layer_props.ship_controller_ptr()->is_ship_docked(
-                        ships.position(ship_id.object_index()),
-                        ships.velocity(ship_id.object_index()),
-                        area_layer_index,
-                        *properties()
-                        ))
-                m_update_queue_of_ships.push_back(ship_id);
+void  network::wake_up_ship(compressed_layer_and_object_indices const  ship_loc)
+{
+    if (properties()->layer_props().at(ship_loc.layer_index()).ship_controller_ptr() != nullptr &&
+        (m_domain == nullptr || m_domain->owns_ship(ship_loc)))
+        m_update_queue_of_ships->insert(ship_loc);
+}
+
+
+void  network::wake_up_ships_of_spiker(layer_index_type const  layer_index, object_index_type const  spiker_index)
+{
+    network_layer_props const&  layer_props = properties()->layer_props().at(layer_index);
+    object_index_type const  ships_begin_index = layer_props.ships_begin_index_of_spiker(spiker_index);
+    for (natural_32_bit  i = 0U; i != layer_props.num_ships_per_spiker(); ++i)
+        wake_up_ship({ layer_index, ships_begin_index + i });
+}
+
+
+void  network::wake_up_ships_near_dock_sector(layer_index_type const  area_layer_index, object_index_type const  sector_index)
+{
+    network_layer_props const&  area_layer_props = properties()->layer_props().at(area_layer_index);
+
+    // Ships in these sectors are all those, which may enumerate ships in the passed sector in the computation of
+    // their accelerations (see 'compute_acceleration_of_ship'). The range is extended by a half of a sector, because
+    // ships may be anywhere inside their sectors.
+    sector_coordinate_type  x_lo, y_lo, c_lo;
+    sector_coordinate_type  x_hi, y_hi, c_hi;
+    {
+        sector_coordinate_type  x, y, c;
+        area_layer_props.dock_sector_coordinates(sector_index, x, y, c);
+        vector3 const  sector_centre = m_sector_resolver->dock_sector_centre(area_layer_index, x, y, c);
+        float_32_bit const  distance =
+                area_layer_props.ship_controller_ptr()->docks_enumerations_distance_for_accelerate_from_ship() +
+                0.5f * area_layer_props.distance_of_docks_in_meters();
+        vector3 const  range_vector(distance, distance, distance);
+        m_sector_resolver->dock_sector_coordinates(area_layer_index, sector_centre - range_vector, x_lo, y_lo, c_lo);
+        m_sector_resolver->dock_sector_coordinates(area_layer_index, sector_centre + range_vector, x_hi, y_hi, c_hi);
+    }
+    for (sector_coordinate_type x = x_lo; x <= x_hi; ++x)
+        for (sector_coordinate_type y = y_lo; y <= y_hi; ++y)
+            for (sector_coordinate_type c = c_lo; c <= c_hi; ++c)
+                for (compressed_layer_and_object_indices const  ship_loc :
+                        m_ships_in_sectors->ships_in_sector(area_layer_index, m_sector_resolver->dock_sector_index(area_layer_index, x, y, c)))
+                    wake_up_ship(ship_loc);
+}
+
+
+bool  network::send_movement_of_ship(compressed_layer_and_object_indices const  ship_loc, movement_of_ship const&  movement)
+{
+    // The movement is sent to all domains interested in the old or the new sector of the ship. Both ranges of domains
+    // are contiguous, but they may not overlap, when the ship jumped over a whole domain in one update. The owner
+    // of the new sector is always interested in it, so it gets the message. If it is another domain, the ship
+    // migrates there together with its payload.
+
+    natural_32_bit const  new_owner = m_domain->domain_of_dock_sector(movement.area_layer_index, movement.new_sector_index);
+    bool const  is_migrating = new_owner != m_domain->domain_index();
+    if (is_migrating)
+        m_domain->release_ship(ship_loc);
+
+    natural_32_bit  first_old, last_old, first_new, last_new;
+    m_domain->domains_interested_in_dock_sector(movement.area_layer_index, movement.old_sector_index, first_old, last_old);
+    m_domain->domains_interested_in_dock_sector(movement.area_layer_index, movement.new_sector_index, first_new, last_new);
+    for (natural_32_bit  d = std::min(first_old, first_new), end = std::max(last_old, last_new) + 1U; d != end; ++d)
+    {
+        if (d == m_domain->domain_index() || ((d < first_old || d > last_old) && (d < first_new || d > last_new)))
+            continue;
+
+        natural_8_bit  flags = movement.is_docked ? detail::flag_of_docked_ship() : 0U;
+        if (d == new_owner)
+            flags |= detail::flag_of_migrating_ship();
+
+        message_writer  writer(m_domain->messages().at(d));
+        writer.write<layer_index_type>(ship_loc.layer_index());
+        writer.write<object_index_type>(ship_loc.object_index());
+        writer.write<layer_index_type>(movement.area_layer_index);
+        writer.write<object_index_type>(movement.old_sector_index);
+        writer.write<object_index_type>(movement.new_sector_index);
+        detail::write_vector3(writer, movement.position);
+        detail::write_vector3(writer, movement.velocity);
+        writer.write<natural_8_bit>(flags);
+        if (d == new_owner)
+        {
+            layer_of_ships const&  ships = *m_layers_of_ships.at(ship_loc.layer_index());
+            ships.save_payload_of_ship(ship_loc.object_index(), writer.append(ships.num_bytes_of_payload_of_ship()));
         }
     }
+
+    return is_migrating;
 }
 
 
-void  network::update_movement_of_ship(
-        layer_index_type const  layer_index,
-        object_index_type const  ship_index_in_layer,
-        tracked_ship_stats*  stats_of_tracked_ship
-        )
+void  network::exchange_movements_of_ships()
 {
     TMPROF_BLOCK();
 
-    vector3&  ship_position_ref = m_layers_of_ships.at(layer_index)->get_position_nonconst_reference(ship_index_in_layer);
-    vector3&  ship_velocity_ref = m_layers_of_ships.at(layer_index)->get_velocity_nonconst_reference(ship_index_in_layer);
+    // Messages are processed in the order of domains, so all replicas of a ship moved by another domain end up
+    // in the same state. Owned ships are never moved by other domains.
+
+    m_domain->transport().exchange(m_domain->messages());
+
+    for (natural_32_bit  d = 0U; d != m_domain->num_domains(); ++d)
+    {
+        if (d == m_domain->domain_index())
+            continue;
+        message_reader  reader(m_domain->messages().at(d));
+        while (!reader.done())
+        {
+            layer_index_type const  layer_index = reader.read<layer_index_type>();
+            object_index_type const  ship_index = reader.read<object_index_type>();
+            layer_index_type const  area_layer_index = reader.read<layer_index_type>();
+            object_index_type const  old_sector_index = reader.read<object_index_type>();
+            object_index_type const  new_sector_index = reader.read<object_index_type>();
+            vector3 const  position = detail::read_vector3(reader);
+            vector3 const  velocity = detail::read_vector3(reader);
+            natural_8_bit const  flags = reader.read<natural_8_bit>();
+
+            if (layer_index >= m_layers_of_ships.size() || ship_index >= m_layers_of_ships.at(layer_index)->size() ||
+                area_layer_index >= properties()->layer_props().size() ||
+                old_sector_index >= properties()->layer_props().at(area_layer_index).num_docks() ||
+                new_sector_index >= properties()->layer_props().at(area_layer_index).num_docks())
+                throw std::runtime_error(msgstream() << "The domain " << d << " sent a movement of an unknown ship.");
+
+            compressed_layer_and_object_indices const  ship_loc{ layer_index, ship_index };
+            INVARIANT(!m_domain->owns_ship(ship_loc));
+
+            layer_of_ships&  ships = *m_layers_of_ships.at(layer_index);
+            ships.set_position(ship_index, position);
+            ships.set_velocity(ship_index, velocity);
+            m_ships_in_sectors->set_sector_of_ship(ship_loc, area_layer_index, new_sector_index);
+
+            if ((flags & detail::flag_of_migrating_ship()) != 0U)
+            {
+                m_domain->acquire_ship(ship_loc);
+                ships.load_payload_of_ship(ship_index, reader.skip(ships.num_bytes_of_payload_of_ship()));
+                if ((flags & detail::flag_of_docked_ship()) == 0U && is_update_queue_of_ships_used())
+                    m_update_queue_of_ships->insert(ship_loc);
+            }
+
+            if ((flags & detail::flag_of_docked_ship()) == 0U)
+                m_received_movements_of_ships.push_back({ old_sector_index, new_sector_index, area_layer_index });
+        }
+    }
+}
 
-    compressed_layer_and_object_indices const  ship_loc(layer_index,ship_index_in_layer);
 
-    if (stats_of_tracked_ship != nullptr && ship_loc != stats_of_tracked_ship->indices())
-        stats_of_tracked_ship = nullptr;
+void  network::compute_acceleration_of_ship(
+        compressed_layer_and_object_indices const  ship_loc,
+        movement_of_ship&  movement,
+        buffers_for_movement_of_ship&  buffers,
+        natural_32_bit const  index_in_block
+        ) const
+{
+    layer_index_type const  layer_index = ship_loc.layer_index();
+    object_index_type const  ship_index_in_layer = ship_loc.object_index();
+
+    vector3 const  ship_position_ref = m_layers_of_ships.at(layer_index)->position(ship_index_in_layer);
+    vector3 const  ship_velocity_ref = m_layers_of_ships.at(layer_index)->velocity(ship_index_in_layer);
+
+    // All random decisions for the ship in this update are drawn from a stream dedicated to the ship and the update.
+    counter_based_random_generator&  random_generator = buffers.random_generators.at(index_in_block);
+    random_generator = counter_based_random_generator(
+            m_seed_of_movement_of_ships ^ detail::tag_of_random_stream_of_movement_of_ships(),
+            (natural_32_bit)m_update_id,
+            ship_loc.get_raw_data()
+            );
 
     network_layer_props const&  ship_layer_props = properties()->layer_props().at(layer_index);
 
@@ -573,36 +1221,26 @@ void  network::update_movement_of_ship(
 
     vector3 const&  movement_area_center = m_layers_of_spikers.at(layer_index)->get_movement_area_center(spiker_sector_index);
 
-    layer_index_type const  area_layer_index = properties()->find_layer_index(movement_area_center(2));
+    layer_index_type const  area_layer_index = m_sector_resolver->find_layer_index(movement_area_center(2));
 
     vector3 const  movement_area_low_corner =
             movement_area_center - 0.5f * ship_layer_props.size_of_ship_movement_area_in_meters(area_layer_index);
     vector3 const  movement_area_high_corner =
             movement_area_center + 0.5f * ship_layer_props.size_of_ship_movement_area_in_meters(area_layer_index);
 
-    std::vector< std::vector<compressed_layer_and_object_indices> >&  ships_in_sectors =
-            m_ships_in_sectors.at(area_layer_index);
-
     network_layer_props const&  area_layer_props = properties()->layer_props().at(area_layer_index);
 
     vector3  dock_sector_center_of_ship;
     bool  dock_sector_belongs_to_the_same_spiker_as_the_ship;
     {
         sector_coordinate_type  x, y, c;
-        area_layer_props.dock_sector_coordinates(ship_position_ref, x,y,c);
-        dock_sector_center_of_ship = area_layer_props.dock_sector_centre(x,y,c);
+        m_sector_resolver->dock_sector_coordinates(area_layer_index, ship_position_ref, x,y,c);
+        dock_sector_center_of_ship = m_sector_resolver->dock_sector_centre(area_layer_index, x,y,c);
 
         if (layer_index == area_layer_index)
         {
-            object_index_type  spiker_index;
-            {
-                sector_coordinate_type  spiker_x, spiker_y, spiker_c;
-                area_layer_props.spiker_sector_coordinates_from_dock_sector_coordinates(
-                        x, y, c,
-                        spiker_x, spiker_y, spiker_c
-                        );
-                spiker_index = area_layer_props.spiker_sector_index(spiker_x, spiker_y, spiker_c);
-            }
+            object_index_type const  spiker_index =
+                    m_sector_resolver->spiker_index_from_dock_sector_coordinates(area_layer_index, x, y, c);
             dock_sector_belongs_to_the_same_spiker_as_the_ship = (spiker_index == spiker_sector_index);
         }
         else
@@ -633,14 +1271,16 @@ void  network::update_movement_of_ship(
                     area_layer_props.ship_controller_ptr()->docks_enumerations_distance_for_accelerate_into_dock(),
                     area_layer_props.ship_controller_ptr()->docks_enumerations_distance_for_accelerate_into_dock()
                     );
-            area_layer_props.dock_sector_coordinates(ship_position_ref - range_vector, x_lo, y_lo, c_lo);
-            area_layer_props.dock_sector_coordinates(ship_position_ref + range_vector, x_hi, y_hi, c_hi);
+            m_sector_resolver->dock_sector_coordinates(area_layer_index, ship_position_ref - range_vector, x_lo, y_lo, c_lo);
+            m_sector_resolver->dock_sector_coordinates(area_layer_index, ship_position_ref + range_vector, x_hi, y_hi, c_hi);
         }
+        buffers.positions_of_docks_to_accelerate_from.clear();
+        buffers.positions_of_docks_to_accelerate_into.clear();
         for (sector_coordinate_type x = x_lo; x <= x_hi; ++x)
             for (sector_coordinate_type y = y_lo; y <= y_hi; ++y)
                 for (sector_coordinate_type c = c_lo; c <= c_hi; ++c)
                 {
-                    vector3 const  sector_centre = area_layer_props.dock_sector_centre(x,y,c);
+                    vector3 const  sector_centre = m_sector_resolver->dock_sector_centre(area_layer_index, x,y,c);
 
                     if (sector_centre(0) < movement_area_low_corner(0) || sector_centre(0) > movement_area_high_corner(0) || 
                         sector_centre(1) < movement_area_low_corner(1) || sector_centre(1) > movement_area_high_corner(1) || 
@@ -651,15 +1291,8 @@ void  network::update_movement_of_ship(
                     {
                         if (layer_index == area_layer_index)
                         {
-                            object_index_type  spiker_index;
-                            {
-                                sector_coordinate_type  spiker_x, spiker_y, spiker_c;
-                                area_layer_props.spiker_sector_coordinates_from_dock_sector_coordinates(
-                                            x,y,c,
-                                            spiker_x,spiker_y,spiker_c
-                                            );
-                                spiker_index = area_layer_props.spiker_sector_index(spiker_x,spiker_y,spiker_c);
-                            }
+                            object_index_type const  spiker_index =
+                                    m_sector_resolver->spiker_index_from_dock_sector_coordinates(area_layer_index,x,y,c);
                             dock_belongs_to_the_same_spiker_as_the_ship = (spiker_index == spiker_sector_index);
                         }
                         else
@@ -667,24 +1300,28 @@ void  network::update_movement_of_ship(
                     }
 
                     if (dock_belongs_to_the_same_spiker_as_the_ship)
-                        ship_acceleration += area_layer_props.ship_controller_ptr()->accelerate_from_dock(
-                                ship_position_ref,
-                                ship_velocity_ref,
-                                sector_centre,
-                                layer_index,
-                                area_layer_index,
-                                *properties()
-                                );
+                        buffers.positions_of_docks_to_accelerate_from.push_back(sector_centre);
                     else
-                        ship_acceleration += area_layer_props.ship_controller_ptr()->accelerate_into_dock(
-                                ship_position_ref,
-                                ship_velocity_ref,
-                                sector_centre,
-                                layer_index,
-                                area_layer_index,
-                                *properties()
-                                );
+                        buffers.positions_of_docks_to_accelerate_into.push_back(sector_centre);
                 }
+        ship_acceleration += area_layer_props.ship_controller_ptr()->accelerate_from_docks(
+                ship_position_ref,
+                ship_velocity_ref,
+                buffers.positions_of_docks_to_accelerate_from.data(),
+                buffers.positions_of_docks_to_accelerate_from.size(),
+                layer_index,
+                area_layer_index,
+                *properties()
+                );
+        ship_acceleration += area_layer_props.ship_controller_ptr()->accelerate_into_docks(
+                ship_position_ref,
+                ship_velocity_ref,
+                buffers.positions_of_docks_to_accelerate_into.data(),
+                buffers.positions_of_docks_to_accelerate_into.size(),
+                layer_index,
+                area_layer_index,
+                *properties()
+                );
 
         if (ship_position_ref(0) >= movement_area_low_corner(0) && ship_position_ref(0) <= movement_area_high_corner(0) &&
             ship_position_ref(1) >= movement_area_low_corner(1) && ship_position_ref(1) <= movement_area_high_corner(1) &&
@@ -695,305 +1332,767 @@ void  network::update_movement_of_ship(
                 area_layer_props.ship_controller_ptr()->docks_enumerations_distance_for_accelerate_from_ship(),
                 area_layer_props.ship_controller_ptr()->docks_enumerations_distance_for_accelerate_from_ship()
                 );
-            area_layer_props.dock_sector_coordinates(ship_position_ref- range_vector, x_lo, y_lo, c_lo);
-            area_layer_props.dock_sector_coordinates(ship_position_ref + range_vector, x_hi, y_hi, c_hi);
+            m_sector_resolver->dock_sector_coordinates(area_layer_index, ship_position_ref- range_vector, x_lo, y_lo, c_lo);
+            m_sector_resolver->dock_sector_coordinates(area_layer_index, ship_position_ref + range_vector, x_hi, y_hi, c_hi);
+            buffers.positions_of_ships.clear();
+            buffers.velocities_of_ships.clear();
             for (sector_coordinate_type x = x_lo; x <= x_hi; ++x)
                 for (sector_coordinate_type y = y_lo; y <= y_hi; ++y)
                     for (sector_coordinate_type c = c_lo; c <= c_hi; ++c)
                     {
-                        object_index_type const  sector_index = area_layer_props.dock_sector_index(x,y,c);
-                        for (compressed_layer_and_object_indices const  loc : ships_in_sectors.at(sector_index))
+                        object_index_type const  sector_index = m_sector_resolver->dock_sector_index(area_layer_index, x,y,c);
+                        for (compressed_layer_and_object_indices const  loc :
+                                m_ships_in_sectors->ships_in_sector(area_layer_index,sector_index))
                             if (loc != ship_loc)
-                                ship_acceleration += area_layer_props.ship_controller_ptr()->accelerate_from_ship(
-                                        ship_position_ref,
-                                        ship_velocity_ref,
-                                        m_layers_of_ships.at(loc.layer_index())->position(loc.object_index()),
-                                        m_layers_of_ships.at(loc.layer_index())->velocity(loc.object_index()),
-                                        dock_sector_center_of_ship,
-                                        dock_sector_belongs_to_the_same_spiker_as_the_ship,
-                                        layer_index,
-                                        area_layer_index,
-                                        *properties()
-                                        );
+                            {
+                                buffers.positions_of_ships.push_back(
+                                        m_layers_of_ships.at(loc.layer_index())->position(loc.object_index()));
+                                buffers.velocities_of_ships.push_back(
+                                        m_layers_of_ships.at(loc.layer_index())->velocity(loc.object_index()));
+                            }
                     }
+            ship_acceleration += area_layer_props.ship_controller_ptr()->accelerate_from_ships(
+                    ship_position_ref,
+                    ship_velocity_ref,
+                    buffers.positions_of_ships.data(),
+                    buffers.velocities_of_ships.data(),
+                    buffers.positions_of_ships.size(),
+                    dock_sector_center_of_ship,
+                    dock_sector_belongs_to_the_same_spiker_as_the_ship,
+                    layer_index,
+                    area_layer_index,
+                    *properties(),
+                    random_generator
+                    );
         }
     }
 
+    for (natural_8_bit  axis = 0U; axis != 3U; ++axis)
+    {
+        buffers.positions[axis][index_in_block] = ship_position_ref(axis);
+        buffers.velocities[axis][index_in_block] = ship_velocity_ref(axis);
+        buffers.accelerations[axis][index_in_block] = ship_acceleration(axis);
+    }
+    buffers.min_speeds[index_in_block] = ship_layer_props.min_speed_of_ship_in_meters_per_second(area_layer_index);
+    buffers.max_speeds[index_in_block] = ship_layer_props.max_speed_of_ship_in_meters_per_second(area_layer_index);
+    buffers.nearest_dock_positions.at(index_in_block) = dock_sector_center_of_ship;
+
+    movement.area_layer_index = area_layer_index;
+    {
+        sector_coordinate_type  x, y, c;
+        m_sector_resolver->dock_sector_coordinates(area_layer_index, ship_position_ref, x, y, c);
+        movement.old_sector_index = m_sector_resolver->dock_sector_index(area_layer_index, x,y,c);
+    }
+}
+
+
+void  network::integrate_movement_of_ships(
+        compressed_layer_and_object_indices const* const  ships_locs,
+        movement_of_ship* const  movements,
+        natural_32_bit const  num_ships,
+        buffers_for_movement_of_ship&  buffers
+        ) const
+{
     float_32_bit const  dt = properties()->update_time_step_in_seconds();
 
-    vector3  new_velocity = ship_velocity_ref + dt * ship_acceleration;
+    // The loops over coordinates of all ships of the block below are written so that the compiler can vectorise them.
+
+    float_32_bit* const  px = buffers.positions[0].data();
+    float_32_bit* const  py = buffers.positions[1].data();
+    float_32_bit* const  pz = buffers.positions[2].data();
+    float_32_bit* const  vx = buffers.velocities[0].data();
+    float_32_bit* const  vy = buffers.velocities[1].data();
+    float_32_bit* const  vz = buffers.velocities[2].data();
+    float_32_bit const* const  ax = buffers.accelerations[0].data();
+    float_32_bit const* const  ay = buffers.accelerations[1].data();
+    float_32_bit const* const  az = buffers.accelerations[2].data();
+    float_32_bit* const  speeds = buffers.speeds.data();
+
+    for (natural_32_bit  i = 0U; i < num_ships; ++i)
+    {
+        vx[i] += dt * ax[i];
+        vy[i] += dt * ay[i];
+        vz[i] += dt * az[i];
+        speeds[i] = std::sqrt(vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i]);
+    }
+
+    for (natural_32_bit  i = 0U; i < num_ships; ++i)
     {
-        float_32_bit const  new_speed = length(new_velocity);
-        if (new_speed < ship_layer_props.min_speed_of_ship_in_meters_per_second(area_layer_index))
-            area_layer_props.ship_controller_ptr()->on_too_slow(
+        bool const  is_too_slow = speeds[i] < buffers.min_speeds[i];
+        bool const  is_too_fast = speeds[i] > buffers.max_speeds[i];
+        if (!is_too_slow && !is_too_fast)
+            continue;
+
+        ship_controller const&  controller =
+                *properties()->layer_props().at(movements[i].area_layer_index).ship_controller_ptr();
+        vector3 const  ship_position(px[i], py[i], pz[i]);
+        vector3  new_velocity(vx[i], vy[i], vz[i]);
+        if (is_too_slow)
+            controller.on_too_slow(
                     new_velocity,
-                    ship_position_ref,
-                    new_speed,
-                    dock_sector_center_of_ship,
-                    layer_index,
-                    area_layer_index,
-                    *properties()
+                    ship_position,
+                    speeds[i],
+                    buffers.nearest_dock_positions.at(i),
+                    ships_locs[i].layer_index(),
+                    movements[i].area_layer_index,
+                    *properties(),
+                    buffers.random_generators.at(i)
                     );
-        else if (new_speed > ship_layer_props.max_speed_of_ship_in_meters_per_second(area_layer_index))
-            area_layer_props.ship_controller_ptr()->on_too_fast(
+        else
+            controller.on_too_fast(
                     new_velocity,
-                    ship_position_ref,
-                    new_speed,
-                    dock_sector_center_of_ship,
-                    layer_index,
-                    area_layer_index,
+                    ship_position,
+                    speeds[i],
+                    buffers.nearest_dock_positions.at(i),
+                    ships_locs[i].layer_index(),
+                    movements[i].area_layer_index,
                     *properties()
                     );
+        vx[i] = new_velocity(0);
+        vy[i] = new_velocity(1);
+        vz[i] = new_velocity(2);
     }
 
-    vector3 const  new_position = ship_position_ref + dt * new_velocity;
+    for (natural_32_bit  i = 0U; i < num_ships; ++i)
+    {
+        px[i] += dt * vx[i];
+        py[i] += dt * vy[i];
+        pz[i] += dt * vz[i];
+    }
 
-    object_index_type  old_sector_index;
+    for (natural_32_bit  i = 0U; i < num_ships; ++i)
     {
-        sector_coordinate_type  x, y, c;
-        area_layer_props.dock_sector_coordinates(ship_position_ref, x, y, c);
-        old_sector_index = area_layer_props.dock_sector_index(x,y,c);
+        movement_of_ship&  movement = movements[i];
+        network_layer_props const&  area_layer_props = properties()->layer_props().at(movement.area_layer_index);
+
+        movement.position = vector3(px[i], py[i], pz[i]);
+        movement.velocity = vector3(vx[i], vy[i], vz[i]);
+        {
+            sector_coordinate_type  x, y, c;
+            m_sector_resolver->dock_sector_coordinates(movement.area_layer_index, movement.position, x, y, c);
+            movement.new_sector_index = m_sector_resolver->dock_sector_index(movement.area_layer_index, x, y, c);
+        }
+        movement.is_docked = area_layer_props.ship_controller_ptr()->is_ship_docked(
+                movement.position,
+                movement.velocity,
+                movement.area_layer_index,
+                *properties()
+                );
     }
-    object_index_type  new_sector_index;
+}
+
+
+natural_64_bit  network::update_mini_spiking(
+        const bool  use_spiking,
+        tracked_network_object_stats* const  stats_of_tracked_object
+        )
+{
+    TMPROF_BLOCK();
+
+    // Each update generates exactly 'num_mini_spikes_to_generate_per_simulation_step' mini-spikes of ships drawn
+    // uniformly (with repetition) from all ships of the network. Ships of each layer are split into chunks of a fixed
+    // size, and the mini-spikes are split between chunks by a binary tree over the sequence of all chunks: each node
+    // of the tree splits its mini-spikes between its two halves by a binomially distributed number, and each leaf
+    // (a chunk) draws ships of its mini-spikes uniformly from its ships. Each node uses its own stream keyed by the
+    // seed, the update id (its low and high halves are used as the step and the high half of the substream of the
+    // generator), and the index of the node. Threads process contiguous ranges of leaves with some mini-spikes, and
+    // mini-spikes of a leaf are processed in the order of ships. Just like in 'update_spiking', each mini-spike is
+    // recorded as a delivery into the bucket of the spiker it arrives to, and then threads apply deliveries of
+    // disjoint ranges of buckets in the order of ships. So, the mini-spikes are reproducible for any order of
+    // updates and for any number of threads. When the network is split into domains, each domain descends only into
+    // nodes with some owned ship (the splits of the visited nodes are the same as in a single process), and it
+    // delivers only mini-spikes of owned ships. Ships are connected to docks of the same domain, so all deliveries
+    // are applied by the owner of the spiker.
+
+    std::vector<natural_64_bit>  chunks_begin_in_layers{ 0ULL };
+    for (network_layer_props const&  layer_props : properties()->layer_props())
+        chunks_begin_in_layers.push_back(
+                chunks_begin_in_layers.back() +
+                (layer_props.num_ships() + detail::num_ships_in_chunk_of_mini_spiking() - 1ULL)
+                        / detail::num_ships_in_chunk_of_mini_spiking()
+                );
+    natural_64_bit const  num_chunks = chunks_begin_in_layers.back();
+    natural_64_bit const  num_buckets = m_buckets_begin_in_layers.back();
+
+    auto const  layer_of_chunk = [&chunks_begin_in_layers](natural_64_bit const  chunk) -> layer_index_type {
+        return (layer_index_type)(
+                std::upper_bound(chunks_begin_in_layers.cbegin(), chunks_begin_in_layers.cend(), chunk)
+                - chunks_begin_in_layers.cbegin() - 1
+                );
+    };
+    auto const  num_ships_before_chunk = [this, num_chunks, &chunks_begin_in_layers, &layer_of_chunk](
+            natural_64_bit const  chunk) -> natural_64_bit {
+        if (chunk == num_chunks)
+            return m_ships_begin_in_layers.back();
+        layer_index_type const  layer_index = layer_of_chunk(chunk);
+        return m_ships_begin_in_layers.at(layer_index) +
+               (chunk - chunks_begin_in_layers.at(layer_index)) * detail::num_ships_in_chunk_of_mini_spiking();
+    };
+
+    // The number of chunks with some owned ship before each chunk, so the tree is searched only where it matters.
+    std::vector<natural_64_bit>  num_owned_chunks_before_chunk;
+    if (m_domain != nullptr)
     {
-        sector_coordinate_type  x, y, c;
-        area_layer_props.dock_sector_coordinates(new_position, x, y, c);
-        new_sector_index = area_layer_props.dock_sector_index(x,y,c);
+        num_owned_chunks_before_chunk.reserve(num_chunks + 1ULL);
+        num_owned_chunks_before_chunk.push_back(0ULL);
+        for (layer_index_type  layer_index = 0U; layer_index + 1U < chunks_begin_in_layers.size(); ++layer_index)
+        {
+            object_index_type const  num_ships = properties()->layer_props().at(layer_index).num_ships();
+            for (object_index_type  begin = 0ULL; begin < num_ships; begin += detail::num_ships_in_chunk_of_mini_spiking())
+                num_owned_chunks_before_chunk.push_back(
+                        num_owned_chunks_before_chunk.back() +
+                        (m_domain->owns_some_ship(
+                                layer_index,
+                                begin,
+                                std::min(begin + detail::num_ships_in_chunk_of_mini_spiking(), num_ships)
+                                ) ? 1ULL : 0ULL)
+                        );
+        }
     }
-    if (new_sector_index != old_sector_index)
+
+    struct  node_of_split
+    {
+        natural_64_bit  begin_chunk;
+        natural_64_bit  end_chunk;
+        natural_64_bit  num_mini_spikes;
+        natural_64_bit  index;  //!< The root is 1, and children of a node 'i' are '2i' and '2i+1'.
+    };
+    std::vector<node_of_split>  leaves;
+    std::vector<node_of_split>  nodes_to_split;
+    natural_64_bit const  num_mini_spikes = properties()->num_mini_spikes_to_generate_per_simulation_step();
+    if (num_chunks != 0ULL && num_mini_spikes != 0ULL)
+        nodes_to_split.push_back({ 0ULL, num_chunks, num_mini_spikes, 1ULL });
+    while (!nodes_to_split.empty())
     {
-        std::vector<compressed_layer_and_object_indices>&  old_sector = ships_in_sectors.at(old_sector_index);
-        auto  it = old_sector.begin();
-        while (true)
+        node_of_split const  node = nodes_to_split.back();
+        nodes_to_split.pop_back();
+        if (node.num_mini_spikes == 0ULL)
+            continue;
+        if (m_domain != nullptr &&
+                num_owned_chunks_before_chunk.at(node.begin_chunk) == num_owned_chunks_before_chunk.at(node.end_chunk))
+            continue;
+        if (node.end_chunk - node.begin_chunk == 1ULL)
         {
-            INVARIANT(it != old_sector.end());
-            if (*it == ship_loc)
-                break;
-            ++it;
+            leaves.push_back(node);
+            continue;
         }
-        *it = old_sector.back();
-        old_sector.pop_back();
+        natural_64_bit const  middle_chunk = (node.begin_chunk + node.end_chunk) / 2ULL;
+        natural_64_bit const  begin_ship = num_ships_before_chunk(node.begin_chunk);
+        counter_based_random_generator  generator(
+                m_seed_of_mini_spiking ^ detail::tag_of_random_stream_of_mini_spiking(),
+                (natural_32_bit)m_update_id,
+                ((m_update_id >> 32U) << 32U) | node.index
+                );
+        natural_64_bit const  num_mini_spikes_in_first_half = detail::num_mini_spikes_in_first_part(
+                node.num_mini_spikes,
+                (float_64_bit)(num_ships_before_chunk(middle_chunk) - begin_ship) /
+                        (float_64_bit)(num_ships_before_chunk(node.end_chunk) - begin_ship),
+                generator
+                );
+        // The second half is pushed first, so leaves are found in the order of chunks.
+        nodes_to_split.push_back({ middle_chunk, node.end_chunk, node.num_mini_spikes - num_mini_spikes_in_first_half,
+                                   2ULL * node.index + 1ULL });
+        nodes_to_split.push_back({ node.begin_chunk, middle_chunk, num_mini_spikes_in_first_half, 2ULL * node.index });
+    }
+
+    natural_32_bit const  num_threads =
+            std::max(1U, (natural_32_bit)std::min((natural_64_bit)properties()->num_threads_to_use(),
+                                                  (natural_64_bit)leaves.size()));
+    if (m_mini_spike_deliveries_of_threads.size() < num_threads)
+        m_mini_spike_deliveries_of_threads.resize(num_threads);
+    for (natural_32_bit  thread_index = 0U; thread_index != num_threads; ++thread_index)
+        m_mini_spike_deliveries_of_threads.at(thread_index).resize(num_buckets);
+
+    std::vector<natural_64_bit>  num_mini_spikes_of_threads(num_threads, 0ULL);
+
+    auto const  collect_deliveries_of_thread =
+        [this, num_threads, &leaves, &chunks_begin_in_layers, &layer_of_chunk, &num_mini_spikes_of_threads](
+                natural_32_bit const  thread_index) -> void {
+            std::vector< std::vector<mini_spike_delivery> >&  deliveries =
+                    m_mini_spike_deliveries_of_threads.at(thread_index);
+            for (std::vector<mini_spike_delivery>&  bucket : deliveries)
+                bucket.clear();
+            std::vector<natural_64_bit>  ship_indices;
+            for (natural_64_bit  leaf = (leaves.size() * thread_index) / num_threads,
+                                 end = (leaves.size() * (thread_index + 1U)) / num_threads;
+                 leaf != end;
+                 ++leaf)
+            {
+                node_of_split const&  node = leaves.at(leaf);
+                layer_index_type const  layer_index = layer_of_chunk(node.begin_chunk);
+                object_index_type const  begin_ship_index =
+                        (node.begin_chunk - chunks_begin_in_layers.at(layer_index))
+                        * detail::num_ships_in_chunk_of_mini_spiking();
+                object_index_type const  end_ship_index =
+                        std::min(begin_ship_index + detail::num_ships_in_chunk_of_mini_spiking(),
+                                 properties()->layer_props().at(layer_index).num_ships());
+
+                counter_based_random_generator  generator(
+                        m_seed_of_mini_spiking ^ detail::tag_of_random_stream_of_mini_spiking(),
+                        (natural_32_bit)m_update_id,
+                        ((m_update_id >> 32U) << 32U) | node.index
+                        );
+                ship_indices.resize(node.num_mini_spikes);
+                fill_by_random_natural_64_bit_in_range(
+                        ship_indices.data(),
+                        ship_indices.data() + ship_indices.size(),
+                        begin_ship_index,
+                        end_ship_index - 1ULL,
+                        generator
+                        );
+                std::sort(ship_indices.begin(), ship_indices.end());
+                for (natural_64_bit const  ship_index : ship_indices)
+                    if (m_domain == nullptr || m_domain->owns_ship({ layer_index, ship_index }))
+                    {
+                        collect_delivery_of_mini_spike(layer_index, ship_index, deliveries);
+                        ++num_mini_spikes_of_threads.at(thread_index);
+                    }
+            }
+        };
+
+    auto const  apply_deliveries_of_thread =
+        [this, num_threads, num_buckets](natural_32_bit const  thread_index) -> void {
+            for (natural_64_bit  bucket = (num_buckets * thread_index) / num_threads,
+                                 end = (num_buckets * (thread_index + 1U)) / num_threads;
+                 bucket != end;
+                 ++bucket)
+            {
+                std::vector<spiking_decision>&  decisions = m_spiking_decisions_in_buckets.at(bucket);
+                decisions.clear();
+                for (natural_32_bit  source_thread_index = 0U; source_thread_index != num_threads; ++source_thread_index)
+                    for (mini_spike_delivery const&  delivery :
+                            m_mini_spike_deliveries_of_threads.at(source_thread_index).at(bucket))
+                        apply_mini_spike_delivery(delivery, decisions);
+            }
+        };
 
-        ships_in_sectors.at(new_sector_index).push_back(ship_loc);
+    if (num_threads == 1U)
+    {
+        collect_deliveries_of_thread(0U);
+        apply_deliveries_of_thread(0U);
     }
+    else
+    {
+        thread_pool* const  pool = get_thread_pool(num_threads);
+        pool->run_and_wait(num_threads, collect_deliveries_of_thread);
+        pool->run_and_wait(num_threads, apply_deliveries_of_thread);
+    }
+
+    if (use_spiking)
+        apply_spiking_decisions(0ULL);
 
-    ship_position_ref = new_position;
-    ship_velocity_ref = new_velocity;
+    natural_64_bit  num_mini_spikes_in_update = 0ULL;
+    for (natural_64_bit const  num_mini_spikes_of_thread : num_mini_spikes_of_threads)
+        num_mini_spikes_in_update += num_mini_spikes_of_thread;
+    return num_mini_spikes_in_update;
 }
 
 
-void  network::update_mini_spiking(
-        const bool  use_spiking,
+void  network::collect_delivery_of_mini_spike(
+        layer_index_type const  layer_index,
+        object_index_type const  ship_index,
+        std::vector< std::vector<mini_spike_delivery> >&  deliveries
+        ) const
+{
+    network_layer_props const&  ship_layer_props = properties()->layer_props().at(layer_index);
+    INVARIANT(ship_index < ship_layer_props.num_ships());
+
+    layer_index_type const  area_layer_index = m_sector_resolver->find_layer_index(
+        m_layers_of_spikers.at(layer_index)->get_movement_area_center(ship_layer_props.spiker_index_from_ship_index(ship_index))(2)
+        );
+    vector3 const  ship_position = m_layers_of_ships.at(layer_index)->position(ship_index);
+    sector_coordinate_type  dock_x,dock_y,dock_c;
+    m_sector_resolver->dock_sector_coordinates(area_layer_index, ship_position,dock_x,dock_y,dock_c);
+    vector3 const  nearest_dock_pos = m_sector_resolver->dock_sector_centre(area_layer_index, dock_x,dock_y,dock_c);
+
+    if (are_ship_and_dock_connected(
+                ship_position,
+                nearest_dock_pos,
+                properties()->max_connection_distance_in_meters()))
+    {
+        object_index_type const  spiker_index =
+                m_sector_resolver->spiker_index_from_dock_sector_coordinates(area_layer_index,dock_x,dock_y,dock_c);
+
+        deliveries.at(bucket_of_deliveries(area_layer_index,spiker_index)).push_back({
+                { area_layer_index, spiker_index },
+                m_sector_resolver->dock_sector_index(area_layer_index, dock_x,dock_y,dock_c),
+                m_ships_begin_in_layers.at(layer_index) + ship_index,
+                ship_layer_props.are_spikers_excitatory()
+                });
+    }
+}
+
+
+void  network::apply_mini_spike_delivery(mini_spike_delivery const&  delivery, std::vector<spiking_decision>&  decisions)
+{
+    layer_index_type const  area_layer_index = delivery.spiker.layer_index();
+    object_index_type const  spiker_index = delivery.spiker.object_index();
+    network_layer_props const&  area_layer_props = properties()->layer_props().at(area_layer_index);
+
+    vector3  spiker_pos;
+    {
+        sector_coordinate_type  x,y,c;
+        area_layer_props.spiker_sector_coordinates(spiker_index,x,y,c);
+        spiker_pos = m_sector_resolver->spiker_sector_centre(area_layer_index, x,y,c);
+    }
+    vector3  nearest_dock_pos;
+    {
+        sector_coordinate_type  x,y,c;
+        area_layer_props.dock_sector_coordinates(delivery.dock_index,x,y,c);
+        nearest_dock_pos = m_sector_resolver->dock_sector_centre(area_layer_index, x,y,c);
+    }
+
+    float_32_bit const  mini_potential_on_spiker =
+            m_layers_of_docks.at(area_layer_index)->on_arrival_of_mini_spiking_potential(
+                    delivery.dock_index,
+                    delivery.is_from_excitatory_spiker,
+                    spiker_pos,
+                    nearest_dock_pos,
+                    *properties()
+                    );
+
+    m_layers_of_spikers.at(area_layer_index)->update_spiking_potential(spiker_index,m_update_id,*properties());
+
+    bool const  did_mini_spike_cause_spike_generation =
+            m_layers_of_spikers.at(area_layer_index)->on_arrival_of_postsynaptic_potential(
+                    spiker_index,
+                    mini_potential_on_spiker,
+                    *properties());
+
+    decisions.push_back({ delivery.spiker, delivery.order, did_mini_spike_cause_spike_generation });
+}
+
+
+void  network::update_spiking(
         tracked_network_object_stats* const  stats_of_tracked_object
         )
 {
     TMPROF_BLOCK();
 
-    std::vector<natural_64_bit>  counts_of_ships{0ULL};
-    for (layer_index_type  layer_index = 0U; layer_index != properties()->layer_props().size(); ++layer_index)
-        counts_of_ships.push_back(counts_of_ships.back() + properties()->layer_props().at(layer_index).num_ships());
+    // The update runs in two parallel phases. In the first one, threads enumerate connections of spiking spikers
+    // (taken in contiguous chunks of the worklist of current spikers) with other spikers, without modifying anything.
+    // Each connection is recorded as a delivery into the bucket of the spiker owning the dock of the connection.
+    // In the second phase, threads apply deliveries of disjoint ranges of buckets. All objects modified by a delivery
+    // (the dock, its spiker, and the ship connected to the dock) belong to the bucket, so no locks are needed.
+    // Deliveries of a bucket are applied in the order of the worklist of current spikers, and buckets are defined
+    // independently of the number of threads. So, the result does not depend on the number of threads.
+    //
+    // When the network is split into domains, each domain enumerates connections of spiking spikers only for
+    // owned ships and for docks of owned spikers. A ship is always connected to a dock of its own domain, so all
+    // objects modified by a delivery are owned by the domain, which collected the delivery. Finally, domains
+    // exchange the spikers which will spike in the next update (see 'exchange_current_spikers').
+
+    natural_64_bit const  num_buckets = m_buckets_begin_in_layers.back();
+
+    natural_64_bit const  num_current_spikers = m_current_spikers->size_of_worklist();
+    natural_32_bit const  num_threads =
+            std::max(1U, (natural_32_bit)std::min((natural_64_bit)properties()->num_threads_to_use(),
+                                                  num_current_spikers));
+    if (m_deliveries_of_threads.size() < num_threads)
+        m_deliveries_of_threads.resize(num_threads);
+    for (natural_32_bit  thread_index = 0U; thread_index != num_threads; ++thread_index)
+        m_deliveries_of_threads.at(thread_index).resize(num_buckets);
+
+    auto const  collect_deliveries_of_thread =
+        [this, num_threads, num_current_spikers](natural_32_bit const  thread_index) -> void {
+            std::vector< std::vector<spike_delivery> >&  deliveries = m_deliveries_of_threads.at(thread_index);
+            for (std::vector<spike_delivery>&  bucket : deliveries)
+                bucket.clear();
+            m_current_spikers->for_each_in_range(
+                    (num_current_spikers * thread_index) / num_threads,
+                    (num_current_spikers * (thread_index + 1U)) / num_threads,
+                    [this, &deliveries](compressed_layer_and_object_indices const  spiker_id,
+                                        natural_64_bit const  position_in_worklist) -> void {
+                        collect_deliveries_of_spiker(spiker_id, position_in_worklist, deliveries);
+                    });
+        };
+
+    auto const  apply_deliveries_of_thread =
+        [this, num_threads, num_buckets](natural_32_bit const  thread_index) -> void {
+            for (natural_64_bit  bucket = (num_buckets * thread_index) / num_threads,
+                                 end = (num_buckets * (thread_index + 1U)) / num_threads;
+                 bucket != end;
+                 ++bucket)
+            {
+                std::vector<spiking_decision>&  decisions = m_spiking_decisions_in_buckets.at(bucket);
+                decisions.clear();
+                for (natural_32_bit  source_thread_index = 0U; source_thread_index != num_threads; ++source_thread_index)
+                    for (spike_delivery const&  delivery : m_deliveries_of_threads.at(source_thread_index).at(bucket))
+                        apply_spike_delivery(delivery, decisions);
+            }
+        };
 
-    for (natural_64_bit i = 0ULL, n = properties()->num_mini_spikes_to_generate_per_simulation_step(); i != n; ++i)
+    if (num_threads == 1U)
+    {
+        collect_deliveries_of_thread(0U);
+        apply_deliveries_of_thread(0U);
+    }
+    else
     {
-        natural_64_bit const  ship_super_index =
-                get_random_natural_64_bit_in_range(0ULL,properties()->num_ships() - 1ULL,m_mini_spiking_random_generator);
+        thread_pool* const  pool = get_thread_pool(num_threads);
+        pool->run_and_wait(num_threads, collect_deliveries_of_thread);
+        pool->run_and_wait(num_threads, apply_deliveries_of_thread);
+    }
 
-        auto const  layer_it = std::upper_bound(counts_of_ships.cbegin(),counts_of_ships.cend(),ship_super_index);
-        INVARIANT(layer_it != counts_of_ships.cbegin() && layer_it != counts_of_ships.cend());
-        layer_index_type const  layer_index =
-            (layer_index_type)std::distance(counts_of_ships.cbegin(),layer_it) - 1U;
-        INVARIANT(layer_index < properties()->layer_props().size());
-        object_index_type const  ship_index = ship_super_index - counts_of_ships.at(layer_index);
-        network_layer_props const&  ship_layer_props = properties()->layer_props().at(layer_index);
-        INVARIANT(ship_index < ship_layer_props.num_ships());
+    apply_spiking_decisions(1ULL);
 
-        layer_index_type const  area_layer_index = properties()->find_layer_index(
-            m_layers_of_spikers.at(layer_index)->get_movement_area_center(ship_layer_props.spiker_index_from_ship_index(ship_index))(2)
-            );
-        network_layer_props const&  area_layer_props = properties()->layer_props().at(area_layer_index);
-        sector_coordinate_type  dock_x,dock_y,dock_c;
-        area_layer_props.dock_sector_coordinates(m_layers_of_ships.at(layer_index)->position(ship_index),dock_x,dock_y,dock_c);
-        vector3 const  nearest_dock_pos = area_layer_props.dock_sector_centre(dock_x,dock_y,dock_c);
+    std::swap(m_current_spikers, m_next_spikers);
+    m_next_spikers->clear();
 
-        if (are_ship_and_dock_connected(
-                    m_layers_of_ships.at(layer_index)->position(ship_index),
-                    nearest_dock_pos,
-                    properties()->max_connection_distance_in_meters()))
+    if (m_domain != nullptr)
+        exchange_current_spikers();
+}
+
+
+void  network::apply_spiking_decisions(natural_64_bit const  phase)
+{
+    natural_64_bit const  num_buckets = m_buckets_begin_in_layers.back();
+    for (natural_64_bit  bucket = 0ULL; bucket != num_buckets; ++bucket)
+        for (spiking_decision const&  decision : m_spiking_decisions_in_buckets.at(bucket))
+            if (decision.does_spike)
+            {
+                if (m_next_spikers->insert(decision.spiker) && m_domain != nullptr)
+                    m_keys_of_next_spikers.push_back({ phase * num_buckets + bucket, decision.order });
+            }
+            else
+                m_next_spikers->erase(decision.spiker);
+}
+
+
+void  network::exchange_current_spikers()
+{
+    TMPROF_BLOCK();
+
+    // A single process would list the spikers in the order of the decisions which inserted them, i.e. in the order
+    // of their keys. Each domain decides only about its own spikers, in the increasing order of keys. So, sorting
+    // spikers of all domains by their keys gives the same worklist, up to the spikers erased meanwhile, which are
+    // not sent. The order of spikers in the worklist defines the order of deliveries in the next update.
+
+    INVARIANT(m_keys_of_next_spikers.size() == m_current_spikers->size_of_worklist());
+
+    struct  spiker_with_key
+    {
+        std::pair<natural_64_bit, natural_64_bit>  key;
+        layer_index_type  layer_index;
+        object_index_type  spiker_index;
+    };
+    std::vector<spiker_with_key>  spikers;
+    m_current_spikers->for_each_in_range(
+            0ULL,
+            m_current_spikers->size_of_worklist(),
+            [this, &spikers](compressed_layer_and_object_indices const  spiker_id, natural_64_bit const  position_in_worklist) -> void {
+                spikers.push_back({ m_keys_of_next_spikers.at(position_in_worklist), spiker_id.layer_index(), spiker_id.object_index() });
+            });
+    m_keys_of_next_spikers.clear();
+
+    m_domain->clear_messages();
+    for (natural_32_bit  d = 0U; d != m_domain->num_domains(); ++d)
+        if (d != m_domain->domain_index())
         {
-            sector_coordinate_type  spiker_x,spiker_y,spiker_c;
-            area_layer_props.spiker_sector_coordinates_from_dock_sector_coordinates(dock_x,dock_y,dock_c,spiker_x,spiker_y,spiker_c);
-
-            object_index_type const  spiker_index = area_layer_props.spiker_sector_index(spiker_x,spiker_y,spiker_c);
-            vector3 const  spiker_pos = area_layer_props.spiker_sector_centre(spiker_x,spiker_y,spiker_c);
-
-            object_index_type const  dock_index = area_layer_props.dock_sector_index(dock_x,dock_y,dock_c);
-            float_32_bit const  mini_potential_on_spiker =
-                    m_layers_of_docks.at(area_layer_index)->on_arrival_of_mini_spiking_potential(
-                            dock_index,
-                            properties()->layer_props().at(layer_index).are_spikers_excitatory(),
-                            spiker_pos,
-                            nearest_dock_pos,
-                            *properties()
-                            );
+            message_writer  writer(m_domain->messages().at(d));
+            for (spiker_with_key const&  spiker : spikers)
+            {
+                writer.write(spiker.key.first);
+                writer.write(spiker.key.second);
+                writer.write(spiker.layer_index);
+                writer.write(spiker.spiker_index);
+            }
+        }
 
-            m_layers_of_spikers.at(area_layer_index)->update_spiking_potential(spiker_index,m_update_id,*properties());
+    m_domain->transport().exchange(m_domain->messages());
 
-            bool const  did_mini_spike_cause_spike_generation =
-                    m_layers_of_spikers.at(area_layer_index)->on_arrival_of_postsynaptic_potential(
-                            spiker_index,
-                            mini_potential_on_spiker,
-                            *properties());
-
-            if (use_spiking)
-                if (did_mini_spike_cause_spike_generation)
-                    m_next_spikers->insert({area_layer_index,spiker_index});
-                else
-                    m_next_spikers->erase({area_layer_index,spiker_index});
+    for (natural_32_bit  d = 0U; d != m_domain->num_domains(); ++d)
+    {
+        if (d == m_domain->domain_index())
+            continue;
+        message_reader  reader(m_domain->messages().at(d));
+        while (!reader.done())
+        {
+            spiker_with_key  spiker;
+            spiker.key.first = reader.read<natural_64_bit>();
+            spiker.key.second = reader.read<natural_64_bit>();
+            spiker.layer_index = reader.read<layer_index_type>();
+            spiker.spiker_index = reader.read<object_index_type>();
+            if (spiker.layer_index >= m_layers_of_spikers.size() ||
+                spiker.spiker_index >= m_layers_of_spikers.at(spiker.layer_index)->size())
+                throw std::runtime_error(msgstream() << "The domain " << d << " sent an unknown spiker.");
+            spikers.push_back(spiker);
         }
     }
+
+    std::sort(spikers.begin(), spikers.end(),
+              [](spiker_with_key const&  a, spiker_with_key const&  b) -> bool { return a.key < b.key; });
+    m_current_spikers->clear();
+    for (spiker_with_key const&  spiker : spikers)
+        m_current_spikers->insert({ spiker.layer_index, spiker.spiker_index });
 }
 
 
-void  network::update_spiking(
-        tracked_network_object_stats* const  stats_of_tracked_object
-        )
+void  network::collect_deliveries_of_spiker(
+        compressed_layer_and_object_indices const  spiker_id,
+        natural_64_bit const  position_in_worklist,
+        std::vector< std::vector<spike_delivery> >&  deliveries
+        ) const
 {
-    TMPROF_BLOCK();
+    // Connections of the spiker are ordered by its position in the worklist, then by its ships, then by its docks.
+    layer_index_type const  spiker_layer_index = spiker_id.layer_index();
+    object_index_type const  spiker_index = spiker_id.object_index();
 
-    for (auto const spiker_id : *m_current_spikers)
-    {
-        layer_index_type const  spiker_layer_index = spiker_id.layer_index();
-        object_index_type const  spiker_index = spiker_id.object_index();
+    network_layer_props const&  spiker_layer_props = properties()->layer_props().at(spiker_layer_index);
 
-        network_layer_props const&  spiker_layer_props = properties()->layer_props().at(spiker_layer_index);
+    layer_index_type const  area_layer_index = m_sector_resolver->find_layer_index(
+            m_layers_of_spikers.at(spiker_layer_index)->get_movement_area_center(spiker_index)(2)
+            );
 
-        sector_coordinate_type  spiker_x,spiker_y,spiker_c;
-        spiker_layer_props.spiker_sector_coordinates(spiker_index, spiker_x,spiker_y,spiker_c);
-        vector3 const  spiker_position = spiker_layer_props.spiker_sector_centre(spiker_x,spiker_y,spiker_c);
+    object_index_type const  ships_begin_index = spiker_layer_props.ships_begin_index_of_spiker(spiker_index);
+    natural_64_bit const  order_of_first_connection = position_in_worklist << 32U;
+    for (natural_32_bit  i = 0U; i != spiker_layer_props.num_ships_per_spiker(); ++i)
+    {
+        if (m_domain != nullptr && !m_domain->owns_ship({ spiker_layer_index, ships_begin_index + i }))
+            continue;
 
-        layer_index_type const  area_layer_index = properties()->find_layer_index(
-                m_layers_of_spikers.at(spiker_layer_index)->get_movement_area_center(spiker_index)(2)
-                );
-        network_layer_props const&  area_layer_props = properties()->layer_props().at(area_layer_index);
+        layer_of_ships const&  ships = *m_layers_of_ships.at(spiker_layer_index);
 
-        object_index_type const  ships_begin_index = spiker_layer_props.ships_begin_index_of_spiker(spiker_index);
-        for (natural_32_bit  i = 0U; i != spiker_layer_props.num_ships_per_spiker(); ++i)
+        sector_coordinate_type  dock_x,dock_y,dock_c;
+        m_sector_resolver->dock_sector_coordinates(area_layer_index, ships.position(ships_begin_index + i),dock_x,dock_y,dock_c);
+        vector3 const  dock_position = m_sector_resolver->dock_sector_centre(area_layer_index, dock_x,dock_y,dock_c);
+
+        if (are_ship_and_dock_connected(
+                    ships.position(ships_begin_index + i),
+                    dock_position,
+                    properties()->max_connection_distance_in_meters()))
         {
-            layer_of_ships&  ships = *m_layers_of_ships.at(spiker_layer_index);
+            object_index_type const  target_spiker_index =
+                    m_sector_resolver->spiker_index_from_dock_sector_coordinates(area_layer_index,dock_x,dock_y,dock_c);
+
+            deliveries.at(bucket_of_deliveries(area_layer_index,target_spiker_index)).push_back({
+                    { spiker_layer_index, ships_begin_index + i },
+                    { area_layer_index, target_spiker_index },
+                    m_sector_resolver->dock_sector_index(area_layer_index, dock_x,dock_y,dock_c),
+                    order_of_first_connection + i,
+                    true
+                    });
+        }
+    }
+
+    if (m_domain != nullptr && !m_domain->owns_spiker(spiker_layer_index, spiker_index))
+        return;
 
-            sector_coordinate_type  dock_x,dock_y,dock_c;
-            area_layer_props.dock_sector_coordinates(ships.position(ships_begin_index + i),dock_x,dock_y,dock_c);
-            vector3 const  dock_position = area_layer_props.dock_sector_centre(dock_x,dock_y,dock_c);
+    natural_64_bit const  bucket = bucket_of_deliveries(spiker_layer_index,spiker_index);
+    object_index_type const  docks_begin_index = spiker_layer_props.docks_begin_index_of_spiker(spiker_index);
+    for (natural_32_bit  i = 0U; i != spiker_layer_props.num_docks_per_spiker(); ++i)
+    {
+        sector_coordinate_type  dock_x,dock_y,dock_c;
+        spiker_layer_props.dock_sector_coordinates(docks_begin_index + i,dock_x,dock_y,dock_c);
+        vector3 const  dock_position = m_sector_resolver->dock_sector_centre(spiker_layer_index, dock_x,dock_y,dock_c);
 
+        for (compressed_layer_and_object_indices const  ship_idx :
+                m_ships_in_sectors->ships_in_sector(spiker_layer_index,docks_begin_index + i))
             if (are_ship_and_dock_connected(
-                        ships.position(ships_begin_index + i),
+                        m_layers_of_ships.at(ship_idx.layer_index())->position(ship_idx.object_index()),
                         dock_position,
                         properties()->max_connection_distance_in_meters()))
             {
-                sector_coordinate_type  target_spiker_x,target_spiker_y,target_spiker_c;
-                area_layer_props.spiker_sector_coordinates_from_dock_sector_coordinates(
-                        dock_x,dock_y,dock_c,
-                        target_spiker_x,target_spiker_y,target_spiker_c
-                        );
-                vector3 const  target_spiker_position = area_layer_props.spiker_sector_centre(
-                        target_spiker_x,target_spiker_y,target_spiker_c
-                        );
-                object_index_type const  target_spiker_index =
-                        area_layer_props.spiker_sector_index(target_spiker_x,target_spiker_y,target_spiker_c);
-
-                layer_of_spikers&  target_spikers = *m_layers_of_spikers.at(area_layer_index);
-                layer_of_docks&  docks = *m_layers_of_docks.at(area_layer_index);
+                deliveries.at(bucket).push_back({
+                        ship_idx,
+                        spiker_id,
+                        docks_begin_index + i,
+                        order_of_first_connection + spiker_layer_props.num_ships_per_spiker() + i,
+                        false
+                        });
+                break;
+            }
+    }
+}
 
-                object_index_type const  dock_index = area_layer_props.dock_sector_index(dock_x,dock_y,dock_c);
 
-                float_32_bit const  potential_of_the_target_spiker_at_dock =
-                        docks.compute_potential_of_spiker_at_dock(
-                                dock_index,
-                                target_spikers.get_potential(target_spiker_index),
-                                target_spiker_position,
-                                dock_position,
-                                *properties()
-                                );
+void  network::apply_spike_delivery(spike_delivery const&  delivery, std::vector<spiking_decision>&  decisions)
+{
+    layer_index_type const  dock_layer_index = delivery.spiker_of_dock.layer_index();
+    object_index_type const  spiker_index = delivery.spiker_of_dock.object_index();
+    network_layer_props const&  dock_layer_props = properties()->layer_props().at(dock_layer_index);
 
-                float_32_bit const  potential_delta_at_dock =
-                        ships.on_arrival_of_presynaptic_potential(
-                                ships_begin_index + i,
-                                potential_of_the_target_spiker_at_dock,
-                                area_layer_index,
-                                *properties()
-                                );
+    vector3  spiker_position;
+    {
+        sector_coordinate_type  x,y,c;
+        dock_layer_props.spiker_sector_coordinates(spiker_index,x,y,c);
+        spiker_position = m_sector_resolver->spiker_sector_centre(dock_layer_index, x,y,c);
+    }
+    vector3  dock_position;
+    {
+        sector_coordinate_type  x,y,c;
+        dock_layer_props.dock_sector_coordinates(delivery.dock_index,x,y,c);
+        dock_position = m_sector_resolver->dock_sector_centre(dock_layer_index, x,y,c);
+    }
 
-                float_32_bit const  potential_delta_at_target_spiker =
-                        docks.on_arrival_of_postsynaptic_potential(
-                                dock_index,
-                                potential_delta_at_dock,
-                                target_spiker_position,
-                                dock_position,
-                                spiker_layer_index,
-                                *properties()
-                                );
+    layer_of_spikers&  spikers = *m_layers_of_spikers.at(dock_layer_index);
+    layer_of_docks&  docks = *m_layers_of_docks.at(dock_layer_index);
+    layer_of_ships&  ships = *m_layers_of_ships.at(delivery.ship.layer_index());
 
-                bool const  does_posynaptic_potential_causes_generation_of_spike =
-                        target_spikers.on_arrival_of_postsynaptic_potential(
-                                target_spiker_index,
-                                potential_delta_at_target_spiker,
-                                *properties()
-                                );
+    if (delivery.is_from_ship_to_dock)
+    {
+        float_32_bit const  potential_of_the_target_spiker_at_dock =
+                docks.compute_potential_of_spiker_at_dock(
+                        delivery.dock_index,
+                        spikers.get_potential(spiker_index),
+                        spiker_position,
+                        dock_position,
+                        *properties()
+                        );
 
-                if (does_posynaptic_potential_causes_generation_of_spike)
-                    m_next_spikers->insert({area_layer_index,target_spiker_index});
-                else
-                    m_next_spikers->erase({area_layer_index,target_spiker_index});
-            }
-        }
+        float_32_bit const  potential_delta_at_dock =
+                ships.on_arrival_of_presynaptic_potential(
+                        delivery.ship.object_index(),
+                        potential_of_the_target_spiker_at_dock,
+                        dock_layer_index,
+                        *properties()
+                        );
 
-        object_index_type const  docks_begin_index = spiker_layer_props.docks_begin_index_of_spiker(spiker_index);
-        for (natural_32_bit  i = 0U; i != spiker_layer_props.num_docks_per_spiker(); ++i)
-        {
-            sector_coordinate_type  dock_x,dock_y,dock_c;
-            spiker_layer_props.dock_sector_coordinates(docks_begin_index + i,dock_x,dock_y,dock_c);
-            vector3 const  dock_position = spiker_layer_props.dock_sector_centre(dock_x,dock_y,dock_c);
+        float_32_bit const  potential_delta_at_target_spiker =
+                docks.on_arrival_of_postsynaptic_potential(
+                        delivery.dock_index,
+                        potential_delta_at_dock,
+                        spiker_position,
+                        dock_position,
+                        delivery.ship.layer_index(),
+                        *properties()
+                        );
 
-            for (compressed_layer_and_object_indices const  ship_idx : m_ships_in_sectors.at(spiker_layer_index).at(docks_begin_index + i))
-            {
-                layer_of_ships&  ships = *m_layers_of_ships.at(ship_idx.layer_index());
-                if (are_ship_and_dock_connected(
-                            ships.position(ship_idx.object_index()),
-                            dock_position,
-                            properties()->max_connection_distance_in_meters()))
-                {
-                    float_32_bit const  potential_of_the_target_spiker_at_dock =
-                            m_layers_of_docks.at(spiker_layer_index)->compute_potential_of_spiker_at_dock(
-                                    docks_begin_index + i,
-                                    m_layers_of_spikers.at(spiker_layer_index)->get_potential(spiker_index),
-                                    spiker_position,
-                                    dock_position,
-                                    *properties()
-                                    );
+        bool const  does_posynaptic_potential_causes_generation_of_spike =
+                spikers.on_arrival_of_postsynaptic_potential(
+                        spiker_index,
+                        potential_delta_at_target_spiker,
+                        *properties()
+                        );
 
-                    float_32_bit const  potential_delta_for_connected_ship =
-                            m_layers_of_docks.at(spiker_layer_index)->on_arrival_of_presynaptic_potential(
-                                    docks_begin_index + i,
-                                    m_layers_of_spikers.at(spiker_layer_index)->get_potential(spiker_index),
-                                    ship_idx.layer_index(),
-                                    *properties()
-                                    );
+        decisions.push_back({ delivery.spiker_of_dock, delivery.order, does_posynaptic_potential_causes_generation_of_spike });
+    }
+    else
+    {
+        float_32_bit const  potential_of_the_target_spiker_at_dock =
+                docks.compute_potential_of_spiker_at_dock(
+                        delivery.dock_index,
+                        spikers.get_potential(spiker_index),
+                        spiker_position,
+                        dock_position,
+                        *properties()
+                        );
 
-                    ships.on_arrival_of_postsynaptic_potential(
-                            ship_idx.object_index(),
-                            potential_delta_for_connected_ship,
-                            ship_idx.layer_index(),
-                            *properties()
-                            );
+        float_32_bit const  potential_delta_for_connected_ship =
+                docks.on_arrival_of_presynaptic_potential(
+                        delivery.dock_index,
+                        spikers.get_potential(spiker_index),
+                        delivery.ship.layer_index(),
+                        *properties()
+                        );
 
-                    break;
-                }
-            }
-        }
+        ships.on_arrival_of_postsynaptic_potential(
+                delivery.ship.object_index(),
+                potential_delta_for_connected_ship,
+                delivery.ship.layer_index(),
+                *properties()
+                );
     }
-
-    std::swap(m_current_spikers, m_next_spikers);
-    m_next_spikers->clear();
 }
 
 
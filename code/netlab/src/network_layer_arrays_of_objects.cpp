@@ -23,8 +23,16 @@ void  layer_of_spikers::update_spiking_potential(
         )
 {
     natural_64_bit& last_update_id = m_last_update_ids.at(spiker_index);
-    for ( ; last_update_id < current_update_id; ++last_update_id)
-        integrate_spiking_potential(spiker_index,props.update_time_step_in_seconds(),props);
+    if (last_update_id < current_update_id)
+    {
+        integrate_spiking_potential_over(
+                spiker_index,
+                current_update_id - last_update_id,
+                props.update_time_step_in_seconds(),
+                props
+                );
+        last_update_id = current_update_id;
+    }
 }
 
 std::ostream&  layer_of_spikers::get_info_text(
@@ -53,10 +61,19 @@ layer_of_docks::layer_of_docks(layer_index_type const  layer_index, object_index
 
 layer_of_ships::layer_of_ships(layer_index_type const  layer_index, object_index_type const  num_ships_in_the_layer)
     : m_layer_index(layer_index)
-    , m_positions(num_ships_in_the_layer,{0.0f,0.0f,0.0f})
-    , m_velocities(num_ships_in_the_layer,{0.0f,0.0f,0.0f})
+    , m_num_ships(num_ships_in_the_layer)
+    , m_positions()
+    , m_velocities()
 {
-    ASSUMPTION(!m_positions.empty());
+    ASSUMPTION(m_num_ships != 0ULL);
+    natural_64_bit const  padded_size =
+            ((m_num_ships + num_coordinates_in_cache_line() - 1ULL) / num_coordinates_in_cache_line())
+            * num_coordinates_in_cache_line();
+    for (natural_8_bit  axis = 0U; axis != 3U; ++axis)
+    {
+        m_positions[axis].resize(padded_size, 0.0f);
+        m_velocities[axis].resize(padded_size, 0.0f);
+    }
 }
 
 std::ostream&  layer_of_ships::get_info_text(
@@ -54,6 +54,7 @@ network_layer_props::network_layer_props(
     , m_num_ships(checked_mul_64_bit(m_num_ships_per_spiker, m_num_spikers))
 
     , m_distance_of_docks_in_meters(distance_of_docks_in_meters)
+    , m_inverted_distance_of_docks_in_meters(1.0f / distance_of_docks_in_meters)
 
     , m_distance_of_spikers_along_x_axis_in_meters(
           static_cast<float_32_bit>(m_num_docks_along_x_axis_per_spiker) * m_distance_of_docks_in_meters
@@ -189,8 +190,9 @@ void  network_layer_props::dock_sector_coordinates(
         sector_coordinate_type&  x, sector_coordinate_type&  y, sector_coordinate_type&  c
         ) const
 {
-    vector3 const  D(distance_of_docks_in_meters(),distance_of_docks_in_meters(),distance_of_docks_in_meters());
-    vector3 const  u = (pos - (low_corner_of_docks() - 0.5f * D)).array() / D.array();
+    // The low corner of ships is the low corner of the first dock sector. We multiply by the precomputed inverted
+    // distance of docks instead of dividing by the distance (see also 'sector_resolver::dock_sector_coordinates').
+    vector3 const  u = (pos - low_corner_of_ships()) * inverted_distance_of_docks_in_meters();
     x = (u(0) <= 0.0) ? 0UL : (u(0) >= num_docks_along_x_axis()) ? num_docks_along_x_axis() - 1UL : static_cast<sector_coordinate_type>(u(0));
     y = (u(1) <= 0.0) ? 0UL : (u(1) >= num_docks_along_y_axis()) ? num_docks_along_y_axis() - 1UL : static_cast<sector_coordinate_type>(u(1));
     c = (u(2) <= 0.0) ? 0UL : (u(2) >= num_docks_along_c_axis()) ? num_docks_along_c_axis() - 1UL : static_cast<sector_coordinate_type>(u(2));
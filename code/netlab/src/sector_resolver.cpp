@@ -0,0 +1,135 @@
+#include <netlab/sector_resolver.hpp>
+#include <utility/assumptions.hpp>
+#include <utility/invariants.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace netlab { namespace detail {
+
+
+/// The lookup table of layers along the c axis never has more buckets than this.
+inline constexpr natural_64_bit  max_num_buckets_along_c_axis() noexcept { return 1ULL << 16U; }
+
+
+}}
+
+namespace netlab {
+
+
+sector_resolver::sector_resolver(network_props const&  props)
+    : m_tables_of_layers()
+    , m_max_coords_along_c_axis()
+    , m_low_coord_along_c_axis(props.layer_props().front().low_corner_of_ships()(2))
+    , m_inverted_size_of_bucket_along_c_axis(0.0f)
+    , m_layer_index_of_bucket()
+{
+    for (network_layer_props const&  layer_props : props.layer_props())
+    {
+        m_tables_of_layers.push_back({});
+        layer_tables&  tables = m_tables_of_layers.back();
+
+        tables.dock_sectors_origin = layer_props.low_corner_of_ships();
+        tables.inverted_distance_of_docks = layer_props.inverted_distance_of_docks_in_meters();
+
+        for (sector_coordinate_type  x = 0U; x != layer_props.num_docks_along_x_axis(); ++x)
+        {
+            tables.dock_index_of_dock_x.push_back(layer_props.dock_sector_index(x,0U,0U));
+            tables.spiker_x_of_dock_x.push_back(x / layer_props.num_docks_along_x_axis_per_spiker());
+            tables.spiker_index_of_dock_x.push_back(layer_props.spiker_sector_index(tables.spiker_x_of_dock_x.back(),0U,0U));
+            tables.dock_centre_x.push_back(layer_props.dock_sector_centre(x,0U,0U)(0));
+        }
+        for (sector_coordinate_type  y = 0U; y != layer_props.num_docks_along_y_axis(); ++y)
+        {
+            tables.dock_index_of_dock_y.push_back(layer_props.dock_sector_index(0U,y,0U));
+            tables.spiker_y_of_dock_y.push_back(y / layer_props.num_docks_along_y_axis_per_spiker());
+            tables.spiker_index_of_dock_y.push_back(layer_props.spiker_sector_index(0U,tables.spiker_y_of_dock_y.back(),0U));
+            tables.dock_centre_y.push_back(layer_props.dock_sector_centre(0U,y,0U)(1));
+        }
+        for (sector_coordinate_type  c = 0U; c != layer_props.num_docks_along_c_axis(); ++c)
+        {
+            tables.dock_index_of_dock_c.push_back(layer_props.dock_sector_index(0U,0U,c));
+            tables.spiker_c_of_dock_c.push_back(c / layer_props.num_docks_along_c_axis_per_spiker());
+            tables.spiker_index_of_dock_c.push_back(layer_props.spiker_sector_index(0U,0U,tables.spiker_c_of_dock_c.back()));
+            tables.dock_centre_c.push_back(layer_props.dock_sector_centre(0U,0U,c)(2));
+        }
+
+        for (sector_coordinate_type  x = 0U; x != layer_props.num_spikers_along_x_axis(); ++x)
+            tables.spiker_centre_x.push_back(layer_props.spiker_sector_centre(x,0U,0U)(0));
+        for (sector_coordinate_type  y = 0U; y != layer_props.num_spikers_along_y_axis(); ++y)
+            tables.spiker_centre_y.push_back(layer_props.spiker_sector_centre(0U,y,0U)(1));
+        for (sector_coordinate_type  c = 0U; c != layer_props.num_spikers_along_c_axis(); ++c)
+            tables.spiker_centre_c.push_back(layer_props.spiker_sector_centre(0U,0U,c)(2));
+    }
+
+    float_32_bit  min_thickness_of_layer = 0.0f;
+    for (layer_index_type  i = 0U; i != props.layer_props().size(); ++i)
+    {
+        m_max_coords_along_c_axis.push_back(
+                i + 1U < props.layer_props().size() ?
+                        0.5f * ( props.layer_props().at(i).high_corner_of_ships()(2) +
+                                 props.layer_props().at(i + 1U).low_corner_of_ships()(2) ) :
+                        props.layer_props().at(i).high_corner_of_ships()(2)
+                );
+        float_32_bit const  thickness =
+                m_max_coords_along_c_axis.back() - (i == 0U ? m_low_coord_along_c_axis : m_max_coords_along_c_axis.at(i - 1U));
+        if (i == 0U || thickness < min_thickness_of_layer)
+            min_thickness_of_layer = thickness;
+    }
+
+    // With buckets not larger than the thinnest layer, a bucket contains at most one boundary between layers.
+    // So, a look up needs at most one correction step, except for rounding errors near the boundaries.
+    float_32_bit const  range_along_c_axis = m_max_coords_along_c_axis.back() - m_low_coord_along_c_axis;
+    natural_64_bit const  num_buckets = std::min<natural_64_bit>(
+            detail::max_num_buckets_along_c_axis(),
+            min_thickness_of_layer > 0.0f ?
+                    (natural_64_bit)std::ceil(range_along_c_axis / min_thickness_of_layer) + 1ULL :
+                    (natural_64_bit)1ULL
+            );
+    m_inverted_size_of_bucket_along_c_axis =
+            range_along_c_axis > 0.0f ? (float_32_bit)num_buckets / range_along_c_axis : 0.0f;
+    for (natural_64_bit  i = 0ULL; i != num_buckets; ++i)
+        m_layer_index_of_bucket.push_back(props.find_layer_index(
+                m_low_coord_along_c_axis + (float_32_bit)i * range_along_c_axis / (float_32_bit)num_buckets
+                ));
+}
+
+
+layer_index_type  sector_resolver::find_layer_index(float_32_bit const  coord_along_c_axis) const
+{
+    float_32_bit const  u = (coord_along_c_axis - m_low_coord_along_c_axis) * m_inverted_size_of_bucket_along_c_axis;
+    natural_64_bit const  bucket =
+            (u <= 0.0f) ? 0ULL :
+            (u >= (float_32_bit)m_layer_index_of_bucket.size()) ? m_layer_index_of_bucket.size() - 1ULL :
+                                                                   (natural_64_bit)u;
+    // The result must be the first layer whose maximal coordinate is not less than the passed one, or the last
+    // layer, if there is no such layer (see 'network_props::find_layer_index').
+    layer_index_type  layer_index = m_layer_index_of_bucket[bucket];
+    while (layer_index + 1U < m_max_coords_along_c_axis.size() && m_max_coords_along_c_axis[layer_index] < coord_along_c_axis)
+        ++layer_index;
+    while (layer_index > 0U && m_max_coords_along_c_axis[layer_index - 1U] >= coord_along_c_axis)
+        --layer_index;
+    return layer_index;
+}
+
+
+natural_64_bit  sector_resolver::num_bytes() const
+{
+    natural_64_bit  result = sizeof(sector_resolver) +
+                             m_max_coords_along_c_axis.capacity() * sizeof(float_32_bit) +
+                             m_layer_index_of_bucket.capacity() * sizeof(layer_index_type);
+    for (layer_tables const&  tables : m_tables_of_layers)
+        result += sizeof(layer_tables) +
+                  (tables.dock_index_of_dock_x.capacity() + tables.dock_index_of_dock_y.capacity() +
+                        tables.dock_index_of_dock_c.capacity() + tables.spiker_index_of_dock_x.capacity() +
+                        tables.spiker_index_of_dock_y.capacity() + tables.spiker_index_of_dock_c.capacity())
+                        * sizeof(object_index_type) +
+                  (tables.spiker_x_of_dock_x.capacity() + tables.spiker_y_of_dock_y.capacity() +
+                        tables.spiker_c_of_dock_c.capacity()) * sizeof(sector_coordinate_type) +
+                  (tables.dock_centre_x.capacity() + tables.dock_centre_y.capacity() + tables.dock_centre_c.capacity() +
+                        tables.spiker_centre_x.capacity() + tables.spiker_centre_y.capacity() +
+                        tables.spiker_centre_c.capacity()) * sizeof(float_32_bit);
+    return result;
+}
+
+
+}
@@ -0,0 +1,340 @@
+#include <netlab/shared_memory_transport.hpp>
+#include <utility/msgstream.hpp>
+#include <utility/assumptions.hpp>
+#include <utility/invariants.hpp>
+#include <utility/timeprof.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Counters of bytes in channels must be lock-free to work across processes.");
+
+namespace netlab { namespace detail { namespace {
+
+
+inline constexpr natural_32_bit  magic_of_initialised_segment() noexcept { return 0x45324e54U; }
+
+
+/// The counters are monotonic. The sender writes bytes at the position 'num_bytes_written' (modulo the capacity)
+/// of data of the channel, which follow the counters in the segment.
+struct  counters_of_channel
+{
+    alignas(64) std::atomic<natural_64_bit>  num_bytes_written;
+    alignas(64) std::atomic<natural_64_bit>  num_bytes_read;
+};
+
+
+struct  header_of_segment
+{
+    std::atomic<natural_32_bit>  state;         //!< It is 'magic_of_initialised_segment()' once the header is valid.
+    std::atomic<natural_32_bit>  num_attached;  //!< The number of domains which mapped the segment.
+    natural_32_bit  num_domains;
+    natural_64_bit  capacity_of_channel;
+};
+
+
+inline constexpr natural_64_bit  size_of_header_of_segment() noexcept { return 128ULL; }
+
+static_assert(sizeof(header_of_segment) <= size_of_header_of_segment(), "The header does not fit into its space.");
+
+
+natural_64_bit  size_of_channel_with_data(natural_64_bit const  capacity)
+{
+    return sizeof(counters_of_channel) + capacity;
+}
+
+
+natural_64_bit  size_of_segment(natural_32_bit const  num_domains, natural_64_bit const  capacity)
+{
+    return size_of_header_of_segment() +
+           (natural_64_bit)num_domains * (natural_64_bit)num_domains * size_of_channel_with_data(capacity);
+}
+
+
+float_64_bit  seconds_since(std::chrono::steady_clock::time_point const  start_time)
+{
+    return std::chrono::duration<float_64_bit>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+
+void  wait_a_while()
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+
+/// It writes as many of the passed bytes into the channel as there is a free space for. It returns the number
+/// of written bytes.
+natural_64_bit  write_into_channel(
+        counters_of_channel&  channel,
+        natural_64_bit const  capacity,
+        natural_8_bit const* const  bytes,
+        natural_64_bit const  num_bytes
+        )
+{
+    natural_64_bit const  num_written = channel.num_bytes_written.load(std::memory_order_relaxed);
+    natural_64_bit const  num_read = channel.num_bytes_read.load(std::memory_order_acquire);
+    natural_64_bit const  count = std::min(num_bytes, capacity - (num_written - num_read));
+    if (count == 0ULL)
+        return 0ULL;
+    natural_8_bit* const  data = reinterpret_cast<natural_8_bit*>(&channel + 1);
+    natural_64_bit const  position = num_written % capacity;
+    natural_64_bit const  count_to_end = std::min(count, capacity - position);
+    std::memcpy(data + position, bytes, count_to_end);
+    std::memcpy(data, bytes + count_to_end, count - count_to_end);
+    channel.num_bytes_written.store(num_written + count, std::memory_order_release);
+    return count;
+}
+
+
+/// It reads at most the passed number of bytes available in the channel. It returns the number of read bytes.
+natural_64_bit  read_from_channel(
+        counters_of_channel&  channel,
+        natural_64_bit const  capacity,
+        natural_8_bit* const  bytes,
+        natural_64_bit const  num_bytes
+        )
+{
+    natural_64_bit const  num_read = channel.num_bytes_read.load(std::memory_order_relaxed);
+    natural_64_bit const  num_written = channel.num_bytes_written.load(std::memory_order_acquire);
+    natural_64_bit const  count = std::min(num_bytes, num_written - num_read);
+    if (count == 0ULL)
+        return 0ULL;
+    natural_8_bit const* const  data = reinterpret_cast<natural_8_bit const*>(&channel + 1);
+    natural_64_bit const  position = num_read % capacity;
+    natural_64_bit const  count_to_end = std::min(count, capacity - position);
+    std::memcpy(bytes, data + position, count_to_end);
+    std::memcpy(bytes + count_to_end, data, count - count_to_end);
+    channel.num_bytes_read.store(num_read + count, std::memory_order_release);
+    return count;
+}
+
+
+}}}
+
+namespace netlab {
+
+
+struct  shared_memory_transport::channel : public detail::counters_of_channel
+{};
+
+
+shared_memory_transport::shared_memory_transport(
+        std::string const&  name,
+        natural_32_bit const  num_domains,
+        natural_32_bit const  domain_index,
+        natural_64_bit const  capacity_of_channel_in_bytes,
+        float_64_bit const  timeout_in_seconds
+        )
+    : m_name(name)
+    , m_num_domains(num_domains)
+    , m_domain_index(domain_index)
+    , m_capacity_of_channel(capacity_of_channel_in_bytes)
+    , m_timeout_in_seconds(timeout_in_seconds)
+    , m_region()
+    , m_is_name_removed(false)
+    , m_received_messages(num_domains)
+{
+    TMPROF_BLOCK();
+
+    namespace bip = boost::interprocess;
+
+    ASSUMPTION(!m_name.empty());
+    ASSUMPTION(m_num_domains > 0U && m_domain_index < m_num_domains);
+    ASSUMPTION(m_capacity_of_channel > 0ULL && m_capacity_of_channel % 64ULL == 0ULL);
+    ASSUMPTION(m_timeout_in_seconds > 0.0);
+
+    natural_64_bit const  segment_size = detail::size_of_segment(m_num_domains, m_capacity_of_channel);
+    std::chrono::steady_clock::time_point const  start_time = std::chrono::steady_clock::now();
+
+    try
+    {
+        if (m_domain_index == 0U)
+        {
+            bip::shared_memory_object::remove(m_name.c_str());
+            bip::shared_memory_object  segment(bip::create_only, m_name.c_str(), bip::read_write);
+            segment.truncate((bip::offset_t)segment_size);
+            m_region = std::make_unique<bip::mapped_region>(segment, bip::read_write);
+
+            // The memory of a new segment is zeroed, so the counters of all channels are zero already.
+            detail::header_of_segment* const  header = new (m_region->get_address()) detail::header_of_segment;
+            header->num_attached.store(0U, std::memory_order_relaxed);
+            header->num_domains = m_num_domains;
+            header->capacity_of_channel = m_capacity_of_channel;
+            header->state.store(detail::magic_of_initialised_segment(), std::memory_order_release);
+        }
+        else
+            while (true)
+            {
+                try
+                {
+                    bip::shared_memory_object  segment(bip::open_only, m_name.c_str(), bip::read_write);
+                    bip::offset_t  size;
+                    if (segment.get_size(size) && (natural_64_bit)size == segment_size)
+                    {
+                        m_region = std::make_unique<bip::mapped_region>(segment, bip::read_write);
+                        break;
+                    }
+                }
+                catch (bip::interprocess_exception const&)
+                {
+                    // The domain 0 has not created the segment yet.
+                }
+                if (detail::seconds_since(start_time) > m_timeout_in_seconds)
+                    throw std::runtime_error(msgstream() << "The shared memory segment '" << m_name
+                                                         << "' of " << segment_size << " bytes did not appear in time.");
+                detail::wait_a_while();
+            }
+    }
+    catch (bip::interprocess_exception const&  e)
+    {
+        throw std::runtime_error(msgstream() << "Cannot create the shared memory segment '" << m_name << "': " << e.what());
+    }
+
+    detail::header_of_segment* const  header = reinterpret_cast<detail::header_of_segment*>(m_region->get_address());
+    while (header->state.load(std::memory_order_acquire) != detail::magic_of_initialised_segment())
+    {
+        if (detail::seconds_since(start_time) > m_timeout_in_seconds)
+            throw std::runtime_error(msgstream() << "The shared memory segment '" << m_name << "' was not initialised in time.");
+        detail::wait_a_while();
+    }
+    if (header->num_domains != m_num_domains || header->capacity_of_channel != m_capacity_of_channel)
+        throw std::runtime_error(msgstream() << "The shared memory segment '" << m_name << "' was created for "
+                                             << header->num_domains << " domains and channels of "
+                                             << header->capacity_of_channel << " bytes.");
+    header->num_attached.fetch_add(1U, std::memory_order_acq_rel);
+
+    if (m_domain_index == 0U)
+    {
+        while (header->num_attached.load(std::memory_order_acquire) != m_num_domains)
+        {
+            if (detail::seconds_since(start_time) > m_timeout_in_seconds)
+                throw std::runtime_error(msgstream() << "Only " << header->num_attached.load() << " of " << m_num_domains
+                                                     << " domains attached to the shared memory segment '" << m_name
+                                                     << "' in time.");
+            detail::wait_a_while();
+        }
+        bip::shared_memory_object::remove(m_name.c_str());
+        m_is_name_removed = true;
+    }
+}
+
+
+shared_memory_transport::~shared_memory_transport()
+{
+    if (m_domain_index == 0U && !m_is_name_removed)
+        boost::interprocess::shared_memory_object::remove(m_name.c_str());
+}
+
+
+shared_memory_transport::channel&  shared_memory_transport::get_channel(
+        natural_32_bit const  from_domain,
+        natural_32_bit const  to_domain
+        ) const
+{
+    natural_64_bit const  offset =
+            detail::size_of_header_of_segment() +
+            ((natural_64_bit)from_domain * m_num_domains + to_domain) * detail::size_of_channel_with_data(m_capacity_of_channel);
+    return *reinterpret_cast<channel*>(reinterpret_cast<natural_8_bit*>(m_region->get_address()) + offset);
+}
+
+
+void  shared_memory_transport::exchange(std::vector< std::vector<natural_8_bit> >&  messages)
+{
+    TMPROF_BLOCK();
+
+    ASSUMPTION(messages.size() == m_num_domains);
+
+    // Each message is preceded by its size in the channel. Bytes of all outgoing and incoming messages are moved
+    // in turns, as much as free space and available data in channels allow, until all messages are transferred.
+
+    std::vector<natural_64_bit>  sizes_of_outgoing(m_num_domains);
+    std::vector<natural_64_bit>  num_bytes_sent(m_num_domains, 0ULL);
+    std::vector<natural_64_bit>  sizes_of_incoming(m_num_domains, 0ULL);
+    std::vector<natural_64_bit>  num_bytes_received(m_num_domains, 0ULL);
+    for (natural_32_bit  d = 0U; d != m_num_domains; ++d)
+        sizes_of_outgoing.at(d) = messages.at(d).size();
+
+    natural_64_bit const  size_of_prefix = sizeof(natural_64_bit);
+    std::chrono::steady_clock::time_point  time_of_last_progress = std::chrono::steady_clock::now();
+    while (true)
+    {
+        bool  is_done = true;
+        bool  is_progress = false;
+        for (natural_32_bit  d = 0U; d != m_num_domains; ++d)
+        {
+            if (d == m_domain_index)
+                continue;
+
+            channel&  outgoing = get_channel(m_domain_index, d);
+            natural_64_bit&  num_sent = num_bytes_sent.at(d);
+            if (num_sent < size_of_prefix)
+                num_sent += detail::write_into_channel(
+                        outgoing,
+                        m_capacity_of_channel,
+                        reinterpret_cast<natural_8_bit const*>(&sizes_of_outgoing.at(d)) + num_sent,
+                        size_of_prefix - num_sent
+                        );
+            if (num_sent >= size_of_prefix)
+                num_sent += detail::write_into_channel(
+                        outgoing,
+                        m_capacity_of_channel,
+                        messages.at(d).data() + (num_sent - size_of_prefix),
+                        size_of_prefix + sizes_of_outgoing.at(d) - num_sent
+                        );
+
+            channel&  incoming = get_channel(d, m_domain_index);
+            natural_64_bit&  num_received = num_bytes_received.at(d);
+            natural_64_bit const  num_received_before = num_received;
+            if (num_received < size_of_prefix)
+            {
+                num_received += detail::read_from_channel(
+                        incoming,
+                        m_capacity_of_channel,
+                        reinterpret_cast<natural_8_bit*>(&sizes_of_incoming.at(d)) + num_received,
+                        size_of_prefix - num_received
+                        );
+                if (num_received == size_of_prefix)
+                    m_received_messages.at(d).resize(sizes_of_incoming.at(d));
+            }
+            if (num_received >= size_of_prefix)
+                num_received += detail::read_from_channel(
+                        incoming,
+                        m_capacity_of_channel,
+                        m_received_messages.at(d).data() + (num_received - size_of_prefix),
+                        size_of_prefix + sizes_of_incoming.at(d) - num_received
+                        );
+
+            if (num_received != num_received_before)
+                is_progress = true;
+            if (num_sent != size_of_prefix + sizes_of_outgoing.at(d) ||
+                num_received < size_of_prefix || num_received != size_of_prefix + sizes_of_incoming.at(d))
+                is_done = false;
+        }
+        if (is_done)
+            break;
+        if (is_progress)
+            time_of_last_progress = std::chrono::steady_clock::now();
+        else
+        {
+            if (detail::seconds_since(time_of_last_progress) > m_timeout_in_seconds)
+                throw std::runtime_error(msgstream() << "The domain " << m_domain_index << " received no data through "
+                                                     << "the shared memory segment '" << m_name << "' in time.");
+            std::this_thread::yield();
+        }
+    }
+
+    for (natural_32_bit  d = 0U; d != m_num_domains; ++d)
+        if (d != m_domain_index)
+            messages.at(d).swap(m_received_messages.at(d));
+}
+
+
+}
@@ -55,6 +55,72 @@ vector3  ship_controller::accelerate_into_space_box(
 }
 
 
+vector3  ship_controller::accelerate_into_docks(
+        vector3 const&  ship_position,              //!< Coordinates in meters.
+        vector3 const&  ship_velocity,              //!< In meters per second.
+        vector3 const* const  docks_positions,      //!< Coordinates in meters.
+        natural_64_bit const  num_docks,
+        layer_index_type const  home_layer_index,   //!< Index of layer where is the spiker the ship belongs to.
+        layer_index_type const  area_layer_index,   //!< Index of layer where is the movement area in which the ship moves.
+        network_props const&  props
+        ) const
+{
+    vector3  acceleration = vector3_zero();
+    for (natural_64_bit  i = 0ULL; i != num_docks; ++i)
+        acceleration += accelerate_into_dock(ship_position,ship_velocity,docks_positions[i],home_layer_index,area_layer_index,props);
+    return acceleration;
+}
+
+
+vector3  ship_controller::accelerate_from_docks(
+        vector3 const&  ship_position,              //!< Coordinates in meters.
+        vector3 const&  ship_velocity,              //!< In meters per second.
+        vector3 const* const  docks_positions,      //!< Coordinates in meters.
+        natural_64_bit const  num_docks,
+        layer_index_type const  home_layer_index,   //!< Index of layer where is the spiker the ship belongs to.
+        layer_index_type const  area_layer_index,   //!< Index of layer where is the movement area in which the ship moves.
+        network_props const&  props
+        ) const
+{
+    vector3  acceleration = vector3_zero();
+    for (natural_64_bit  i = 0ULL; i != num_docks; ++i)
+        acceleration += accelerate_from_dock(ship_position,ship_velocity,docks_positions[i],home_layer_index,area_layer_index,props);
+    return acceleration;
+}
+
+
+vector3  ship_controller::accelerate_from_ships(
+        vector3 const&  ship_position,              //!< Coordinates in meters.
+        vector3 const&  ship_velocity,              //!< In meters per second.
+        vector3 const* const  other_ships_positions,//!< Coordinates in meters.
+        vector3 const* const  other_ships_velocities,//!< In meters per second.
+        natural_64_bit const  num_other_ships,
+        vector3 const&  nearest_dock_position,      //!< Coordinates in meters. It is nearest to the ship, not to the other ones.
+        bool const  both_ship_and_dock_belongs_to_same_spiker,
+        layer_index_type const  home_layer_index,   //!< Index of layer where is the spiker the ship belongs to.
+        layer_index_type const  area_layer_index,   //!< Index of layer where is the movement area in which the ship moves.
+        network_props const&  props,
+        counter_based_random_generator&  random_generator
+        ) const
+{
+    vector3  acceleration = vector3_zero();
+    for (natural_64_bit  i = 0ULL; i != num_other_ships; ++i)
+        acceleration += accelerate_from_ship(
+                ship_position,
+                ship_velocity,
+                other_ships_positions[i],
+                other_ships_velocities[i],
+                nearest_dock_position,
+                both_ship_and_dock_belongs_to_same_spiker,
+                home_layer_index,
+                area_layer_index,
+                props,
+                random_generator
+                );
+    return acceleration;
+}
+
+
 void  ship_controller::on_too_slow(
         vector3&  ship_velocity,                    //!< In meters per second.
         vector3 const&  ship_position,              //!< Coordinates in meters.
@@ -62,14 +128,15 @@ void  ship_controller::on_too_slow(
         vector3 const&  nearest_dock_position,
         layer_index_type const  home_layer_index,   //!< Index of layer where is the spiker the ship belongs to.
         layer_index_type const  area_layer_index,   //!< Index of layer where is the movement area in which the ship moves.
-        network_props const&  props
+        network_props const&  props,
+        counter_based_random_generator&  random_generator
         ) const
 {
     if (!are_ship_and_dock_connected(ship_position,nearest_dock_position,props.max_connection_distance_in_meters()))
         angeo::get_random_vector_of_magnitude(
                 0.5f * (props.layer_props().at(home_layer_index).min_speed_of_ship_in_meters_per_second(area_layer_index) +
                         props.layer_props().at(home_layer_index).max_speed_of_ship_in_meters_per_second(area_layer_index)),
-                default_random_generator(),
+                random_generator,
                 ship_velocity
                 );
 }
@@ -0,0 +1,325 @@
+#include <netlab/ships_in_dock_sectors.hpp>
+#include <utility/assumptions.hpp>
+#include <utility/invariants.hpp>
+#include <utility/timeprof.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace netlab { namespace detail {
+
+
+/// Number of free slots after ships of each dock sector. Each rebuild reserves them for ships moving in later.
+inline constexpr natural_64_bit  num_free_slots_in_sector() noexcept { return 1ULL; }
+
+/// A rebuild visits each ship and each sector a few times, while moving a ship in place costs about as much as
+/// visiting this number of ships.
+inline constexpr natural_64_bit  cost_of_moving_ship_in_place() noexcept { return 32ULL; }
+
+
+}}
+
+namespace netlab {
+
+
+ships_in_dock_sectors::ships_in_dock_sectors(
+        std::vector<object_index_type> const&  num_docks_in_layers,
+        std::vector<object_index_type> const&  num_ships_in_layers
+        )
+    : m_sectors_begin_in_layers()
+    , m_ships_begin_in_layers()
+    , m_offsets()
+    , m_ends()
+    , m_ships()
+    , m_sector_of_ship()
+    , m_moved_ships()
+    , m_ships_in_ranges_of_sectors()
+    , m_counters_of_threads()
+    , m_is_rebuild_needed(true)
+{
+    ASSUMPTION(num_docks_in_layers.size() == num_ships_in_layers.size());
+    ASSUMPTION(num_docks_in_layers.size() <= max_number_of_layers());
+
+    natural_64_bit  num_sectors = 0ULL;
+    natural_64_bit  num_ships = 0ULL;
+    for (layer_index_type  layer_index = 0U; layer_index != num_docks_in_layers.size(); ++layer_index)
+    {
+        m_sectors_begin_in_layers.push_back(num_sectors);
+        m_ships_begin_in_layers.push_back(num_ships);
+        num_sectors += num_docks_in_layers.at(layer_index);
+        num_ships += num_ships_in_layers.at(layer_index);
+    }
+    m_sectors_begin_in_layers.push_back(num_sectors);
+    m_ships_begin_in_layers.push_back(num_ships);
+
+    m_offsets.resize(num_sectors + 1ULL, 0ULL);
+    m_ends.resize(num_sectors, 0ULL);
+    m_ships.resize(num_ships + num_sectors * detail::num_free_slots_in_sector(), {0U,0ULL});
+    m_sector_of_ship.resize(num_ships, std::numeric_limits<natural_64_bit>::max());
+}
+
+
+ships_in_dock_sectors::range_of_ships  ships_in_dock_sectors::ships_in_sector(
+        layer_index_type const  area_layer_index,
+        object_index_type const  sector_index
+        ) const
+{
+    ASSUMPTION(m_sectors_begin_in_layers.at(area_layer_index) + sector_index < m_sectors_begin_in_layers.at(area_layer_index + 1U));
+    natural_64_bit const  i = m_sectors_begin_in_layers.at(area_layer_index) + sector_index;
+    compressed_layer_and_object_indices const* const  ships = m_ships.data();
+    return { ships + m_offsets.at(i), ships + m_ends.at(i) };
+}
+
+
+void  ships_in_dock_sectors::set_sector_of_ship(
+        compressed_layer_and_object_indices const  ship_loc,
+        layer_index_type const  area_layer_index,
+        object_index_type const  sector_index
+        )
+{
+    ASSUMPTION(m_sectors_begin_in_layers.at(area_layer_index) + sector_index < m_sectors_begin_in_layers.at(area_layer_index + 1U));
+    natural_64_bit const  i = m_sectors_begin_in_layers.at(area_layer_index) + sector_index;
+    natural_64_bit&  sector_of_ship = m_sector_of_ship.at(index_of_ship(ship_loc));
+    if (sector_of_ship != i)
+    {
+        if (!m_is_rebuild_needed)
+            m_moved_ships.push_back({ index_of_ship(ship_loc), sector_of_ship });
+        sector_of_ship = i;
+    }
+}
+
+
+void  ships_in_dock_sectors::update(thread_pool* const  pool, natural_32_bit const  num_threads)
+{
+    TMPROF_BLOCK();
+
+    if (!m_is_rebuild_needed && !m_moved_ships.empty())
+    {
+        if (m_moved_ships.size() * detail::cost_of_moving_ship_in_place() > m_sector_of_ship.size() + m_ends.size())
+            m_is_rebuild_needed = true;
+        else
+        {
+            // A ship may have changed its sector several times. Its first record holds the sector it is stored in.
+            std::stable_sort(
+                    m_moved_ships.begin(),
+                    m_moved_ships.end(),
+                    [](std::pair<natural_64_bit, natural_64_bit> const&  left,
+                       std::pair<natural_64_bit, natural_64_bit> const&  right) -> bool {
+                        return left.first < right.first;
+                    });
+            m_moved_ships.erase(
+                    std::unique(
+                            m_moved_ships.begin(),
+                            m_moved_ships.end(),
+                            [](std::pair<natural_64_bit, natural_64_bit> const&  left,
+                               std::pair<natural_64_bit, natural_64_bit> const&  right) -> bool {
+                                return left.first == right.first;
+                            }),
+                    m_moved_ships.end()
+                    );
+
+            // All ships leave their old sectors first, so they free slots for ships moving in.
+            for (std::pair<natural_64_bit, natural_64_bit> const&  ship_and_sector : m_moved_ships)
+                if (ship_and_sector.second != m_sector_of_ship.at(ship_and_sector.first))
+                    remove_ship_from_sector(ship_and_sector.first, ship_and_sector.second);
+            for (std::pair<natural_64_bit, natural_64_bit> const&  ship_and_sector : m_moved_ships)
+                if (ship_and_sector.second != m_sector_of_ship.at(ship_and_sector.first) &&
+                    !insert_ship_into_sector(ship_and_sector.first, m_sector_of_ship.at(ship_and_sector.first)))
+                {
+                    m_is_rebuild_needed = true;
+                    break;
+                }
+        }
+    }
+    m_moved_ships.clear();
+
+    if (m_is_rebuild_needed)
+        rebuild(pool, num_threads);
+}
+
+
+void  ships_in_dock_sectors::remove_ship_from_sector(natural_64_bit const  ship, natural_64_bit const  sector)
+{
+    compressed_layer_and_object_indices* const  begin = m_ships.data() + m_offsets.at(sector);
+    compressed_layer_and_object_indices* const  end = m_ships.data() + m_ends.at(sector);
+    compressed_layer_and_object_indices* const  it = std::lower_bound(
+            begin,
+            end,
+            ship,
+            [this](compressed_layer_and_object_indices const  ship_loc, natural_64_bit const  index) -> bool {
+                return index_of_ship(ship_loc) < index;
+            });
+    INVARIANT(it != end && index_of_ship(*it) == ship);
+    std::move(it + 1, end, it);
+    --m_ends.at(sector);
+}
+
+
+bool  ships_in_dock_sectors::insert_ship_into_sector(natural_64_bit const  ship, natural_64_bit const  sector)
+{
+    if (m_ends.at(sector) == m_offsets.at(sector + 1ULL))
+        return false;
+    compressed_layer_and_object_indices* const  begin = m_ships.data() + m_offsets.at(sector);
+    compressed_layer_and_object_indices* const  end = m_ships.data() + m_ends.at(sector);
+    compressed_layer_and_object_indices* const  it = std::lower_bound(
+            begin,
+            end,
+            ship,
+            [this](compressed_layer_and_object_indices const  ship_loc, natural_64_bit const  index) -> bool {
+                return index_of_ship(ship_loc) < index;
+            });
+    std::move_backward(it, end, end + 1);
+    layer_index_type const  layer_index = (layer_index_type)(
+            std::upper_bound(m_ships_begin_in_layers.cbegin(), m_ships_begin_in_layers.cend(), ship)
+            - m_ships_begin_in_layers.cbegin() - 1
+            );
+    *it = { layer_index, ship - m_ships_begin_in_layers.at(layer_index) };
+    ++m_ends.at(sector);
+    return true;
+}
+
+
+void  ships_in_dock_sectors::rebuild(thread_pool* const  pool, natural_32_bit const  num_threads)
+{
+    TMPROF_BLOCK();
+
+    ASSUMPTION(num_threads >= 1U && (num_threads == 1U || (pool != nullptr && num_threads <= pool->num_workers() + 1U)));
+
+    natural_64_bit const  num_sectors = m_ends.size();
+    natural_64_bit const  num_ships = m_sector_of_ship.size();
+
+    // The thread 't' owns sectors in [sectors_begin_of_thread(t), sectors_begin_of_thread(t+1)), and in the first
+    // pass it partitions ships in [ships_begin_of_thread(t), ships_begin_of_thread(t+1)).
+    natural_32_bit const  num_used_threads =
+            (natural_32_bit)std::max<natural_64_bit>(1ULL, std::min<natural_64_bit>(num_threads, num_sectors));
+
+    auto const  sectors_begin_of_thread =
+        [num_sectors, num_used_threads](natural_32_bit const  thread_index) -> natural_64_bit {
+            return (num_sectors * thread_index) / num_used_threads;
+        };
+    auto const  thread_of_sector =
+        [num_sectors, num_used_threads](natural_64_bit const  sector) -> natural_32_bit {
+            return (natural_32_bit)(((sector + 1ULL) * num_used_threads + num_sectors - 1ULL) / num_sectors - 1ULL);
+        };
+    auto const  ships_begin_of_thread =
+        [num_ships, num_used_threads](natural_32_bit const  thread_index) -> natural_64_bit {
+            return (num_ships * thread_index) / num_used_threads;
+        };
+
+    m_counters_of_threads.resize(num_used_threads);
+    for (std::vector<natural_64_bit>&  counters : m_counters_of_threads)
+        counters.assign(num_used_threads, 0ULL);
+    if (num_used_threads > 1U)
+        m_ships_in_ranges_of_sectors.resize(num_ships);
+
+    auto const  count_ships_of_thread =
+        [this, &ships_begin_of_thread, &thread_of_sector](natural_32_bit const  thread_index) -> void {
+            std::vector<natural_64_bit>&  counters = m_counters_of_threads.at(thread_index);
+            for (natural_64_bit  i = ships_begin_of_thread(thread_index), end = ships_begin_of_thread(thread_index + 1U);
+                 i != end;
+                 ++i)
+            {
+                INVARIANT(m_sector_of_ship[i] < m_ends.size());
+                ++counters[thread_of_sector(m_sector_of_ship[i])];
+            }
+        };
+
+    // Ships of each chunk keep their order inside each range. So, ships of each range are in the increasing order.
+    auto const  partition_ships_of_thread =
+        [this, &ships_begin_of_thread, &thread_of_sector](natural_32_bit const  thread_index) -> void {
+            std::vector<natural_64_bit>&  counters = m_counters_of_threads.at(thread_index);
+            for (natural_64_bit  i = ships_begin_of_thread(thread_index), end = ships_begin_of_thread(thread_index + 1U);
+                 i != end;
+                 ++i)
+                m_ships_in_ranges_of_sectors[counters[thread_of_sector(m_sector_of_ship[i])]++] = i;
+        };
+
+    // The layer index of a ship is found by walking along 'm_ships_begin_in_layers', because the ships of each
+    // range are visited in the increasing order of their indices. Ends of sectors serve as cursors of the scatter.
+    std::vector<natural_64_bit>  ships_begin_in_ranges(num_used_threads + 1ULL, 0ULL);
+    auto const  sort_ships_of_thread =
+        [this, num_used_threads, &sectors_begin_of_thread, &ships_begin_in_ranges](
+                natural_32_bit const  thread_index) -> void {
+            natural_64_bit const  sectors_begin = sectors_begin_of_thread(thread_index);
+            natural_64_bit const  sectors_end = sectors_begin_of_thread(thread_index + 1U);
+            natural_64_bit const* const  ships_begin = num_used_threads == 1U ?
+                    nullptr : m_ships_in_ranges_of_sectors.data() + ships_begin_in_ranges.at(thread_index);
+            natural_64_bit const  num_ships_in_range =
+                    ships_begin_in_ranges.at(thread_index + 1U) - ships_begin_in_ranges.at(thread_index);
+
+            std::fill(m_ends.begin() + sectors_begin, m_ends.begin() + sectors_end, 0ULL);
+            for (natural_64_bit  k = 0ULL; k != num_ships_in_range; ++k)
+                ++m_ends[m_sector_of_ship[ships_begin == nullptr ? k : ships_begin[k]]];
+
+            natural_64_bit  offset = ships_begin_in_ranges.at(thread_index) +
+                                     sectors_begin * detail::num_free_slots_in_sector();
+            for (natural_64_bit  sector = sectors_begin; sector != sectors_end; ++sector)
+            {
+                natural_64_bit const  count = m_ends[sector];
+                m_offsets[sector] = offset;
+                m_ends[sector] = offset;
+                offset += count + detail::num_free_slots_in_sector();
+            }
+
+            layer_index_type  layer_index = 0U;
+            for (natural_64_bit  k = 0ULL; k != num_ships_in_range; ++k)
+            {
+                natural_64_bit const  i = ships_begin == nullptr ? k : ships_begin[k];
+                while (i >= m_ships_begin_in_layers.at(layer_index + 1U))
+                    ++layer_index;
+                m_ships[m_ends[m_sector_of_ship[i]]++] = { layer_index, i - m_ships_begin_in_layers.at(layer_index) };
+            }
+        };
+
+    if (num_used_threads == 1U)
+        ships_begin_in_ranges.at(1U) = num_ships;
+    else
+    {
+        pool->run_and_wait(num_used_threads, count_ships_of_thread);
+
+        // Exclusive prefix sum over ranges, and inside each range over chunks. Each counter then holds the position
+        // in 'm_ships_in_ranges_of_sectors' of the first ship its chunk writes into the range.
+        natural_64_bit  offset = 0ULL;
+        for (natural_32_bit  range = 0U; range != num_used_threads; ++range)
+        {
+            ships_begin_in_ranges.at(range) = offset;
+            for (std::vector<natural_64_bit>&  counters : m_counters_of_threads)
+            {
+                natural_64_bit const  count = counters[range];
+                counters[range] = offset;
+                offset += count;
+            }
+        }
+        INVARIANT(offset == num_ships);
+        ships_begin_in_ranges.at(num_used_threads) = offset;
+
+        pool->run_and_wait(num_used_threads, partition_ships_of_thread);
+    }
+
+    if (num_used_threads == 1U)
+        sort_ships_of_thread(0U);
+    else
+        pool->run_and_wait(num_used_threads, sort_ships_of_thread);
+    INVARIANT(num_sectors == 0ULL || m_ends[num_sectors - 1ULL] + detail::num_free_slots_in_sector() == m_ships.size());
+    m_offsets[num_sectors] = m_ships.size();
+
+    m_moved_ships.clear();
+    m_is_rebuild_needed = false;
+}
+
+
+natural_64_bit  ships_in_dock_sectors::num_bytes() const
+{
+    natural_64_bit  result = sizeof(ships_in_dock_sectors) +
+                             m_offsets.capacity() * sizeof(natural_64_bit) +
+                             m_ends.capacity() * sizeof(natural_64_bit) +
+                             m_ships.capacity() * sizeof(compressed_layer_and_object_indices) +
+                             m_sector_of_ship.capacity() * sizeof(natural_64_bit) +
+                             m_ships_in_ranges_of_sectors.capacity() * sizeof(natural_64_bit) +
+                             m_moved_ships.capacity() * sizeof(std::pair<natural_64_bit, natural_64_bit>);
+    for (std::vector<natural_64_bit> const&  counters : m_counters_of_threads)
+        result += counters.capacity() * sizeof(natural_64_bit);
+    return result;
+}
+
+
+}
@@ -2,8 +2,102 @@
 #include <angeo/collide.hpp>
 #include <utility/assumptions.hpp>
 #include <utility/invariants.hpp>
+#include <utility/timeprof.hpp>
+#include <algorithm>
 #include <limits>
 
+namespace netlab { namespace detail { namespace {
+
+
+/// Number of spikers in one bucket of densities collected by a thread in 'compute_densities_of_ships_per_spiker_in_layers'.
+inline constexpr natural_64_bit  num_spikers_in_bucket_of_densities() noexcept { return 4096ULL; }
+
+
+struct  density_of_ships_in_sector
+{
+    compressed_layer_and_object_indices  spiker;
+    float_32_bit  density;
+};
+
+
+/**
+ * It calls 'func(area_spiker, density)' for each spiker whose sector intersects the movement area of ships of a spiker
+ * in the passed layer. The density is the part of the density of ships of the area falling into the sector. Spikers are
+ * visited in the same order for the same area.
+ */
+template<typename function_type>
+void  for_each_density_of_ships_in_movement_area(
+        network_props const&  props,
+        layer_index_type const  layer_index,
+        vector3 const&  area_center,
+        function_type const&  func
+        )
+{
+    network_layer_props const&  layer_props = props.layer_props().at(layer_index);
+
+    layer_index_type const  area_layer_index = props.find_layer_index(area_center(2));
+    network_layer_props const&  area_layer_props = props.layer_props().at(area_layer_index);
+
+    float_32_bit const  from_meters_to_num_docks = 1.0f / area_layer_props.distance_of_docks_in_meters();
+
+    vector3 const  corner_shift = 0.5f * layer_props.size_of_ship_movement_area_in_meters(area_layer_index);
+    vector3 const  area_lo_corner = area_center - corner_shift;
+    vector3 const  area_hi_corner = area_center + corner_shift;
+    vector3 const  area_size = from_meters_to_num_docks * (area_hi_corner - area_lo_corner);
+    float_32_bit const  area_volume = area_size(0) * area_size(1) * area_size(2);
+    ASSUMPTION(area_volume >= 1e-3f);
+
+    vector3 const  sector_corner_shift = 0.5f * area_layer_props.distance_of_spikers_in_meters();
+    sector_coordinate_type  x_lo,y_lo,c_lo;
+    area_layer_props.spiker_sector_coordinates(area_lo_corner,x_lo,y_lo,c_lo);
+    sector_coordinate_type  x_hi,y_hi,c_hi;
+    area_layer_props.spiker_sector_coordinates(area_hi_corner,x_hi,y_hi,c_hi);
+
+    for (sector_coordinate_type c = c_lo; c <= c_hi; ++c)
+        for (sector_coordinate_type y = y_lo; y <= y_hi; ++y)
+            for (sector_coordinate_type x = x_lo; x <= x_hi; ++x)
+            {
+                vector3 const  sector_center = area_layer_props.spiker_sector_centre(x,y,c);
+                vector3 const  sector_lo_corner = sector_center - sector_corner_shift;
+                vector3 const  sector_hi_corner = sector_center + sector_corner_shift;
+
+                vector3 intersection_lo_corner;
+                vector3 intersection_hi_corner;
+                if (angeo::collision_bbox_bbox(
+                            area_lo_corner,
+                            area_hi_corner,
+                            sector_lo_corner,
+                            sector_hi_corner,
+                            intersection_lo_corner,
+                            intersection_hi_corner
+                            ))
+                {
+                    vector3 const  sector_size = sector_hi_corner - sector_lo_corner;
+                    float_32_bit const  sector_volume = sector_size(0) * sector_size(1) * sector_size(2);
+                    ASSUMPTION(sector_volume >= 1e-3f);
+
+                    vector3 const  intersection_size = intersection_hi_corner - intersection_lo_corner;
+                    float_32_bit const  intersection_volume =
+                        std::fabs(intersection_size(0) * intersection_size(1) * intersection_size(2));
+
+                    float_32_bit const  scale = std::min(std::max(0.0f,intersection_volume / sector_volume),1.0f);
+                    float_32_bit const  sector_density =
+                        std::fabs(scale * ((float_32_bit)layer_props.num_ships_per_spiker() / area_volume));
+
+                    func(compressed_layer_and_object_indices{ area_layer_index, area_layer_props.spiker_sector_index(x,y,c) },
+                         sector_density);
+                }
+                else
+                {
+                    UNREACHABLE();
+                }
+            }
+}
+
+
+}}}
+
+
 namespace netlab {
 
 
@@ -83,76 +177,101 @@ void  initialise_densities_of_ships_per_spiker_in_layers(
 void  compute_densities_of_ships_per_spiker_in_layers(
         network_props const&  props,
         access_to_movement_area_centers const&  movement_area_centers,
-        accessor_to_extra_data_for_spikers_in_layers&  extra_data_accessor
+        accessor_to_extra_data_for_spikers_in_layers&  extra_data_accessor,
+        thread_pool* const  pool,
+        natural_32_bit const  num_threads
         )
 {
-    for (layer_index_type layer_index = 0U; layer_index < props.layer_props().size(); ++layer_index)
+    TMPROF_BLOCK();
+
+    ASSUMPTION(num_threads >= 1U && (num_threads == 1U || (pool != nullptr && num_threads <= pool->num_workers() + 1U)));
+
+    std::vector<natural_64_bit>  spikers_begin_in_layers{ 0ULL };
+    std::vector<natural_64_bit>  buckets_begin_in_layers{ 0ULL };
+    for (network_layer_props const&  layer_props : props.layer_props())
     {
-        network_layer_props const&  layer_props = props.layer_props().at(layer_index);
-        for (object_index_type spiker_index = 0ULL; spiker_index != layer_props.num_spikers(); ++spiker_index)
-        {
-            vector3 const&  area_center = movement_area_centers.area_center(layer_index, spiker_index);
-
-            layer_index_type const  area_layer_index = props.find_layer_index(area_center(2));
-            network_layer_props const&  area_layer_props = props.layer_props().at(area_layer_index);
-
-            float_32_bit const  from_meters_to_num_docks = 1.0f / area_layer_props.distance_of_docks_in_meters();
-
-            vector3 const  corner_shift = 0.5f * layer_props.size_of_ship_movement_area_in_meters(area_layer_index);
-            vector3 const  area_lo_corner = area_center - corner_shift;
-            vector3 const  area_hi_corner = area_center + corner_shift;
-            vector3 const  area_size = from_meters_to_num_docks * (area_hi_corner - area_lo_corner);
-            float_32_bit const  area_volume = area_size(0) * area_size(1) * area_size(2);
-            ASSUMPTION(area_volume >= 1e-3f);
-            float_32_bit const  area_density = (float_32_bit)layer_props.num_ships_per_spiker() / area_volume;
-
-            vector3 const  sector_corner_shift = 0.5f * area_layer_props.distance_of_spikers_in_meters();
-            sector_coordinate_type  x_lo,y_lo,c_lo;
-            area_layer_props.spiker_sector_coordinates(area_lo_corner,x_lo,y_lo,c_lo);
-            sector_coordinate_type  x_hi,y_hi,c_hi;
-            area_layer_props.spiker_sector_coordinates(area_hi_corner,x_hi,y_hi,c_hi);
-
-            for (sector_coordinate_type c = c_lo; c <= c_hi; ++c)
-                for (sector_coordinate_type y = y_lo; y <= y_hi; ++y)
-                    for (sector_coordinate_type x = x_lo; x <= x_hi; ++x)
-                    {
-                        vector3 const  sector_center = area_layer_props.spiker_sector_centre(x,y,c);
-                        vector3 const  sector_lo_corner = sector_center - sector_corner_shift;
-                        vector3 const  sector_hi_corner = sector_center + sector_corner_shift;
-
-                        vector3 intersection_lo_corner;
-                        vector3 intersection_hi_corner;
-                        if (angeo::collision_bbox_bbox(
-                                    area_lo_corner,
-                                    area_hi_corner,
-                                    sector_lo_corner,
-                                    sector_hi_corner,
-                                    intersection_lo_corner,
-                                    intersection_hi_corner
-                                    ))
-                        {
-                            vector3 const  sector_size = sector_hi_corner - sector_lo_corner;
-                            float_32_bit const  sector_volume = sector_size(0) * sector_size(1) * sector_size(2);
-                            ASSUMPTION(sector_volume >= 1e-3f);
-
-                            vector3 const  intersection_size = intersection_hi_corner - intersection_lo_corner;
-                            float_32_bit const  intersection_volume =
-                                std::fabs(intersection_size(0) * intersection_size(1) * intersection_size(2));
-
-                            float_32_bit const  scale = std::min(std::max(0.0f,intersection_volume / sector_volume),1.0f);
-                            float_32_bit const  sector_density =
-                                std::fabs(scale * ((float_32_bit)layer_props.num_ships_per_spiker() / area_volume));
-
-                            object_index_type const  area_spiker_index = area_layer_props.spiker_sector_index(x,y,c);
-                            extra_data_accessor.add_value_to_extra_data_of_spiker(area_layer_index,area_spiker_index,sector_density);
-                        }
-                        else
-                        {
-                            UNREACHABLE();
-                        }
-                    }
-        }
+        spikers_begin_in_layers.push_back(spikers_begin_in_layers.back() + layer_props.num_spikers());
+        buckets_begin_in_layers.push_back(
+                buckets_begin_in_layers.back() +
+                (layer_props.num_spikers() + detail::num_spikers_in_bucket_of_densities() - 1ULL)
+                        / detail::num_spikers_in_bucket_of_densities()
+                );
     }
+    natural_64_bit const  num_spikers = spikers_begin_in_layers.back();
+    natural_64_bit const  num_buckets = buckets_begin_in_layers.back();
+
+    natural_32_bit const  num_used_threads =
+            std::max(1U, (natural_32_bit)std::min((natural_64_bit)num_threads, num_spikers));
+
+    if (num_used_threads == 1U)
+    {
+        for (layer_index_type layer_index = 0U; layer_index < props.layer_props().size(); ++layer_index)
+            for (object_index_type spiker_index = 0ULL; spiker_index != props.layer_props().at(layer_index).num_spikers(); ++spiker_index)
+                detail::for_each_density_of_ships_in_movement_area(
+                        props,
+                        layer_index,
+                        movement_area_centers.area_center(layer_index, spiker_index),
+                        [&extra_data_accessor](compressed_layer_and_object_indices const  area_spiker, float_32_bit const  density) {
+                            extra_data_accessor.add_value_to_extra_data_of_spiker(
+                                    area_spiker.layer_index(),
+                                    area_spiker.object_index(),
+                                    density
+                                    );
+                        });
+        return;
+    }
+
+    // Each thread collects densities of its contiguous range of movement areas into buckets of spikers the densities
+    // belong to. Then each thread adds densities of its own range of buckets, taking them from threads in the order
+    // of their ranges of areas. So, densities are added to each spiker in the same order as in the loop above.
+
+    std::vector< std::vector< std::vector<detail::density_of_ships_in_sector> > >  densities_of_threads(
+            num_used_threads,
+            std::vector< std::vector<detail::density_of_ships_in_sector> >(num_buckets)
+            );
+
+    auto const  collect_densities_of_thread =
+        [&props, &movement_area_centers, &spikers_begin_in_layers, &buckets_begin_in_layers, &densities_of_threads,
+         num_spikers, num_used_threads](natural_32_bit const  thread_index) -> void {
+            std::vector< std::vector<detail::density_of_ships_in_sector> >&  buckets = densities_of_threads.at(thread_index);
+            layer_index_type  layer_index = 0U;
+            for (natural_64_bit  i = (num_spikers * thread_index) / num_used_threads,
+                                 end = (num_spikers * (thread_index + 1U)) / num_used_threads;
+                 i != end;
+                 ++i)
+            {
+                while (i >= spikers_begin_in_layers.at(layer_index + 1U))
+                    ++layer_index;
+                detail::for_each_density_of_ships_in_movement_area(
+                        props,
+                        layer_index,
+                        movement_area_centers.area_center(layer_index, i - spikers_begin_in_layers.at(layer_index)),
+                        [&buckets, &buckets_begin_in_layers](compressed_layer_and_object_indices const  area_spiker,
+                                                             float_32_bit const  density) {
+                            buckets.at(buckets_begin_in_layers.at(area_spiker.layer_index()) +
+                                       area_spiker.object_index() / detail::num_spikers_in_bucket_of_densities())
+                                   .push_back({ area_spiker, density });
+                        });
+            }
+        };
+
+    auto const  add_densities_of_thread =
+        [&extra_data_accessor, &densities_of_threads, num_buckets, num_used_threads](natural_32_bit const  thread_index) -> void {
+            for (natural_64_bit  bucket = (num_buckets * thread_index) / num_used_threads,
+                                 end = (num_buckets * (thread_index + 1U)) / num_used_threads;
+                 bucket != end;
+                 ++bucket)
+                for (natural_32_bit  source_thread_index = 0U; source_thread_index != num_used_threads; ++source_thread_index)
+                    for (detail::density_of_ships_in_sector const&  record : densities_of_threads.at(source_thread_index).at(bucket))
+                        extra_data_accessor.add_value_to_extra_data_of_spiker(
+                                record.spiker.layer_index(),
+                                record.spiker.object_index(),
+                                record.density
+                                );
+        };
+
+    pool->run_and_wait(num_used_threads, collect_densities_of_thread);
+    pool->run_and_wait(num_used_threads, add_densities_of_thread);
 }
 
 
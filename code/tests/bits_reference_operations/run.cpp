@@ -94,6 +94,44 @@ static void test_swap_bits()
             }
 }
 
+static void test_copy_bits()
+{
+    TMPROF_BLOCK();
+
+    natural_8_bit const  num_bytes = 16U;
+    natural_8_bit const  num_bits = num_bytes * 8U;
+    std::array<natural_8_bit,num_bytes+1U> const  source_field = {
+        0xCD, 0xAB, 0xBE, 0xED,
+        0xEB, 0xAC, 0xED, 0xBA,
+        0xBE, 0xCD, 0xCE, 0xBD,
+        0xED, 0xAB, 0xCE, 0xCA, 0xCD
+    };
+    std::array<natural_8_bit,num_bytes+1U> const  original_target_field = {
+        0xAE, 0xBD, 0xCB, 0xAC,
+        0xDC, 0xBE, 0xCA, 0xDB,
+        0xBE, 0xCD, 0xAB, 0xBA,
+        0xAC, 0xED, 0xDA, 0xCE, 0xEB
+    };
+
+    for (natural_8_bit  source_shift = 0U; source_shift < 8U; ++source_shift)
+        for (natural_8_bit  target_shift = 0U; target_shift < 8U; ++target_shift)
+            for (natural_16_bit  nbits = 1U; nbits <= num_bits; ++nbits)
+            {
+                std::array<natural_8_bit,num_bytes+1U>  target_field = original_target_field;
+                bits_const_reference const  source_bits(&source_field.at(0),source_shift,nbits);
+                bits_reference  target_bits(&target_field.at(0),target_shift,nbits);
+                copy_referenced_bits(source_bits,target_bits);
+                bits_const_reference const  original_bits(&original_target_field.at(0),0U,num_bits + 8U);
+                bits_const_reference const  all_target_bits(&target_field.at(0),0U,num_bits + 8U);
+                for (natural_16_bit  j = 0U; j < num_bits + 8U; ++j)
+                    if (j < target_shift || j >= target_shift + nbits)
+                        TEST_SUCCESS(get_bit(all_target_bits,j) == get_bit(original_bits,j))
+                    else
+                        TEST_SUCCESS(get_bit(all_target_bits,j) == get_bit(source_bits,j - target_shift))
+                TEST_PROGRESS_UPDATE();
+            }
+}
+
 static void test_conversions_bits_and_32_bit_values()
 {
     TMPROF_BLOCK();
@@ -113,7 +151,14 @@ static void test_conversions_bits_and_32_bit_values()
                         natural_32_bit  value = versions.at(version);
                         natural_32_bit const  correct_final_value = value & ((1ULL << num_transferred_bits) - 1U);
                         bits_reference  bits(&bits_field.at(0),shift,nbits);
+                        std::array<natural_8_bit,num_bytes+1U> const  original_bits_field = bits_field;
                         value_to_bits(value,bits,bit_index,num_transferred_bits);
+                        for (natural_16_bit  j = 0U; j < nbits; ++j)
+                            if (j < bit_index || j >= bit_index + num_transferred_bits)
+                                TEST_SUCCESS(get_bit(bits,j) ==
+                                             get_bit(bits_const_reference(&original_bits_field.at(0),shift,nbits),j))
+                            else
+                                TEST_SUCCESS(get_bit(bits,j) == (((value >> (j - bit_index)) & 1U) != 0U))
                         bits_to_value(bits,bit_index,num_transferred_bits,value);
                         TEST_SUCCESS(value == correct_final_value);
                     }
@@ -128,6 +173,7 @@ void run()
     TEST_PROGRESS_SHOW();
     test_get_set_bit();
     test_swap_bits();
+    test_copy_bits();
     test_conversions_bits_and_32_bit_values();
     TEST_PROGRESS_HIDE();
 
@@ -0,0 +1,17 @@
+#include "./program_info.hpp"
+
+std::string  get_program_name()
+{
+    return "checkpoint_of_network";
+}
+
+std::string  get_program_version()
+{
+    return "0.01";
+}
+
+std::string  get_program_description()
+{
+    return "This program tests saving of a constructed network into a checkpoint file\n"
+           "and loading of the network back from the file.";
+}
@@ -0,0 +1,10 @@
+#ifndef E2_TEST_CHECKPOINT_OF_NETWORK_PROGRAM_INFO_HPP_INCLUDED
+#   define E2_TEST_CHECKPOINT_OF_NETWORK_PROGRAM_INFO_HPP_INCLUDED
+
+#   include <string>
+
+std::string  get_program_name();
+std::string  get_program_version();
+std::string  get_program_description();
+
+#endif
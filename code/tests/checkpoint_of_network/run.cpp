@@ -0,0 +1,230 @@
+#include "./program_info.hpp"
+#include <common/network_layers_with_payloads.hpp>
+#include <netexp/experiment_factory.hpp>
+#include <netlab/network.hpp>
+#include <netlab/network_layers_factory.hpp>
+#include <netlab/checkpoint_of_network.hpp>
+#include <utility/basic_numeric_types.hpp>
+#include <utility/test.hpp>
+#include <utility/timeprof.hpp>
+#include <utility/log.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <memory>
+#include <string>
+#include <stdexcept>
+
+
+static std::unique_ptr<netlab::network>  create_network(std::string const&  experiment, bool const  use_payloads)
+{
+    netexp::experiment_factory const&  factory = netexp::experiment_factory::instance();
+    std::unique_ptr<netlab::network>  net = std::make_unique<netlab::network>(
+            factory.create_network_props(experiment),
+            use_payloads ? std::make_shared<factory_of_layers_with_payloads>() :
+                           factory.create_network_layers_factory(experiment)
+            );
+    net->enable_usage_of_queues_in_update_of_ships(true);
+    return net;
+}
+
+
+static void  construct_network(netlab::network&  net, std::string const&  experiment)
+{
+    netexp::experiment_factory const&  factory = netexp::experiment_factory::instance();
+    std::shared_ptr<netlab::initialiser_of_movement_area_centers> const  centers_initialiser =
+            factory.create_initialiser_of_movement_area_centers(experiment);
+    std::shared_ptr<netlab::initialiser_of_ships_in_movement_areas> const  ships_initialiser =
+            factory.create_initialiser_of_ships_in_movement_areas(experiment);
+    while (net.get_state() != netlab::NETWORK_STATE::READY_FOR_SIMULATION_STEP)
+        switch (net.get_state())
+        {
+        case netlab::NETWORK_STATE::READY_FOR_MOVEMENT_AREA_CENTERS_INITIALISATION:
+            net.initialise_movement_area_centers(*centers_initialiser);
+            break;
+        case netlab::NETWORK_STATE::READY_FOR_MOVEMENT_AREA_CENTERS_MIGRATION_STARTUP:
+            net.prepare_for_movement_area_centers_migration(*centers_initialiser);
+            break;
+        case netlab::NETWORK_STATE::READY_FOR_MOVEMENT_AREA_CENTERS_MIGRATION_STEP:
+            net.do_movement_area_centers_migration_step(*centers_initialiser);
+            break;
+        case netlab::NETWORK_STATE::READY_FOR_COMPUTATION_OF_SHIP_DENSITIES_IN_LAYERS:
+            net.compute_densities_of_ships_in_layers();
+            break;
+        case netlab::NETWORK_STATE::READY_FOR_LUNCHING_SHIPS_INTO_MOVEMENT_AREAS:
+            net.lunch_ships_into_movement_areas(*ships_initialiser);
+            break;
+        case netlab::NETWORK_STATE::READY_FOR_INITIALISATION_OF_MAP_FROM_DOCK_SECTORS_TO_SHIPS:
+            net.initialise_map_from_dock_sectors_to_ships();
+            break;
+        default:
+            throw std::runtime_error("Unexpected state of the constructed network.");
+        }
+}
+
+
+template<typename layer_type>
+static std::vector<natural_8_bit>  payload_of_layer(layer_type const&  layer)
+{
+    std::vector<natural_8_bit>  payload(layer.num_bytes_of_payload());
+    layer.save_payload(payload.data());
+    return payload;
+}
+
+
+static std::vector<netlab::compressed_layer_and_object_indices>  spikers_to_spike_in_next_update(netlab::network const&  net)
+{
+    std::vector<netlab::compressed_layer_and_object_indices>  spikers;
+    net.get_spikers_to_spike_in_next_update().for_each(
+            [&spikers](netlab::compressed_layer_and_object_indices const  loc) { spikers.push_back(loc); }
+            );
+    std::sort(spikers.begin(),spikers.end(),
+              [](netlab::compressed_layer_and_object_indices const  a, netlab::compressed_layer_and_object_indices const  b) {
+                  return a.get_raw_data() < b.get_raw_data();
+              });
+    return spikers;
+}
+
+
+static std::vector<netlab::compressed_layer_and_object_indices>  awake_ships_in_order_of_update_queue(netlab::network const&  net)
+{
+    std::vector<netlab::compressed_layer_and_object_indices>  ships;
+    net.get_update_queue_of_ships().for_each(
+            [&ships](netlab::compressed_layer_and_object_indices const  loc) { ships.push_back(loc); }
+            );
+    return ships;
+}
+
+
+static void  test_equal_networks(netlab::network const&  left, netlab::network const&  right)
+{
+    TEST_SUCCESS(left.get_state() == right.get_state());
+    TEST_SUCCESS(left.update_id() == right.update_id());
+    TEST_SUCCESS(left.seed_of_movement_of_ships() == right.seed_of_movement_of_ships());
+    TEST_SUCCESS(left.seed_of_mini_spiking() == right.seed_of_mini_spiking());
+
+    for (netlab::layer_index_type  layer_index = 0U; layer_index != left.properties()->layer_props().size(); ++layer_index)
+    {
+        netlab::layer_of_spikers const&  left_spikers = left.get_layer_of_spikers(layer_index);
+        netlab::layer_of_spikers const&  right_spikers = right.get_layer_of_spikers(layer_index);
+        TEST_SUCCESS(left_spikers.size() == right_spikers.size());
+        bool  are_spikers_equal = true;
+        for (netlab::object_index_type  i = 0ULL; i != left_spikers.size(); ++i)
+            if (left_spikers.get_movement_area_center(i) != right_spikers.get_movement_area_center(i) ||
+                left_spikers.get_potential(i) != right_spikers.get_potential(i))
+                are_spikers_equal = false;
+        TEST_SUCCESS(are_spikers_equal);
+        TEST_SUCCESS(payload_of_layer(left_spikers) == payload_of_layer(right_spikers));
+
+        TEST_SUCCESS(payload_of_layer(left.get_layer_of_docks(layer_index)) ==
+                     payload_of_layer(right.get_layer_of_docks(layer_index)));
+
+        netlab::layer_of_ships const&  left_ships = left.get_layer_of_ships(layer_index);
+        netlab::layer_of_ships const&  right_ships = right.get_layer_of_ships(layer_index);
+        TEST_SUCCESS(left_ships.size() == right_ships.size());
+        bool  are_ships_equal = true;
+        for (netlab::object_index_type  i = 0ULL; i != left_ships.size(); ++i)
+            if (left_ships.position(i) != right_ships.position(i) || left_ships.velocity(i) != right_ships.velocity(i))
+                are_ships_equal = false;
+        TEST_SUCCESS(are_ships_equal);
+        TEST_SUCCESS(payload_of_layer(left_ships) == payload_of_layer(right_ships));
+    }
+
+    TEST_SUCCESS(spikers_to_spike_in_next_update(left) == spikers_to_spike_in_next_update(right));
+    TEST_SUCCESS(awake_ships_in_order_of_update_queue(left) == awake_ships_in_order_of_update_queue(right));
+}
+
+
+static bool  does_loading_fail(std::string const&  experiment, bool const  use_payloads, boost::filesystem::path const&  path)
+{
+    std::unique_ptr<netlab::network> const  net = create_network(experiment,use_payloads);
+    try
+    {
+        netlab::load_checkpoint_of_network(*net,path);
+    }
+    catch (std::runtime_error const&)
+    {
+        return true;
+    }
+    return false;
+}
+
+
+static void  test_checkpoint_of_network(std::string const&  experiment, std::string const&  other_experiment, bool const  use_payloads)
+{
+    TMPROF_BLOCK();
+
+    std::unique_ptr<netlab::network> const  net = create_network(experiment,use_payloads);
+    construct_network(*net,experiment);
+    net->set_seed_of_movement_of_ships(11ULL);
+    net->set_seed_of_mini_spiking(13ULL);
+    // Ships need some time to connect to docks. The network is saved when some spikers are about to spike.
+    do
+        net->do_simulation_step();
+    while (net->update_id() < 10ULL || (use_payloads && net->num_spikers_to_spike_in_next_update() == 0ULL && net->update_id() < 200ULL));
+    TEST_SUCCESS(!use_payloads || net->num_spikers_to_spike_in_next_update() > 0ULL);
+
+    boost::filesystem::path const  path =
+            boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("E2-network-%%%%-%%%%.checkpoint");
+    netlab::save_checkpoint_of_network(*net,path);
+
+    std::unique_ptr<netlab::network> const  loaded_net = create_network(experiment,use_payloads);
+    netlab::load_checkpoint_of_network(*loaded_net,path);
+    test_equal_networks(*net,*loaded_net);
+
+    // The loaded network continues the simulation exactly as the saved one.
+    net->do_simulation_step();
+    loaded_net->do_simulation_step();
+    test_equal_networks(*net,*loaded_net);
+    TEST_PROGRESS_UPDATE();
+
+    // A checkpoint of a different network, or with different layers, is rejected.
+    TEST_SUCCESS(does_loading_fail(other_experiment,use_payloads,path));
+    TEST_SUCCESS(does_loading_fail(experiment,!use_payloads,path));
+
+    // A truncated or a corrupted file is rejected.
+    std::vector<char>  bytes(boost::filesystem::file_size(path));
+    {
+        boost::filesystem::ifstream  istr(path,std::ios_base::binary);
+        istr.read(bytes.data(),bytes.size());
+    }
+    boost::filesystem::path const  damaged_path =
+            boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("E2-network-%%%%-%%%%.checkpoint");
+    for (natural_64_bit const  size : { (natural_64_bit)bytes.size() / 2ULL, (natural_64_bit)bytes.size() - 1ULL, 4ULL })
+    {
+        {
+            boost::filesystem::ofstream  ostr(damaged_path,std::ios_base::binary);
+            ostr.write(bytes.data(),size);
+        }
+        TEST_SUCCESS(does_loading_fail(experiment,use_payloads,damaged_path));
+    }
+    {
+        std::vector<char>  damaged_bytes = bytes;
+        damaged_bytes.at(0U) = 'X';
+        boost::filesystem::ofstream  ostr(damaged_path,std::ios_base::binary);
+        ostr.write(damaged_bytes.data(),damaged_bytes.size());
+    }
+    TEST_SUCCESS(does_loading_fail(experiment,use_payloads,damaged_path));
+    TEST_PROGRESS_UPDATE();
+
+    boost::filesystem::remove(damaged_path);
+    boost::filesystem::remove(path);
+}
+
+
+void run()
+{
+    TMPROF_BLOCK();
+
+    TEST_PROGRESS_SHOW();
+
+    test_checkpoint_of_network("calibration","dbg_spiking_develop",false);
+    test_checkpoint_of_network("calibration","dbg_spiking_develop",true);
+    test_checkpoint_of_network("dbg_spiking_develop","calibration",true);
+
+    TEST_PROGRESS_HIDE();
+
+    TEST_PRINT_STATISTICS();
+}
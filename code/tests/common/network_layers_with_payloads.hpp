@@ -0,0 +1,156 @@
+#ifndef E2_TESTS_COMMON_NETWORK_LAYERS_WITH_PAYLOADS_HPP_INCLUDED
+#   define E2_TESTS_COMMON_NETWORK_LAYERS_WITH_PAYLOADS_HPP_INCLUDED
+
+#   include <netlab/network_layer_arrays_of_objects.hpp>
+#   include <netlab/network_layers_factory.hpp>
+#   include <netlab/network_props.hpp>
+#   include <utility/basic_numeric_types.hpp>
+#   include <vector>
+#   include <memory>
+#   include <cstring>
+
+
+/**
+ * Layers with their own data of objects, which are saved into (and loaded from) payloads of layers (e.g. in
+ * checkpoints) and of ships (when ships migrate between domains). Potentials of spikers decide about spiking,
+ * so the whole simulation depends on the data. Tests of networks share these layers.
+ */
+struct  spikers_with_potentials : public netlab::layer_of_spikers
+{
+    spikers_with_potentials(netlab::layer_index_type const  layer_index, netlab::object_index_type const  num_spikers)
+        : netlab::layer_of_spikers(layer_index,num_spikers)
+        , m_potentials(num_spikers,0.0f)
+    {}
+
+    float_32_bit  get_potential(netlab::object_index_type const  spiker_index) const override
+    { return m_potentials.at(spiker_index); }
+
+    void  integrate_spiking_potential(
+            netlab::object_index_type const  spiker_index,
+            float_32_bit const  time_delta_in_seconds,
+            netlab::network_props const&  props
+            ) override
+    { m_potentials.at(spiker_index) *= 0.95f; }
+
+    bool  on_arrival_of_postsynaptic_potential(
+            netlab::object_index_type const  spiker_index,
+            float_32_bit const  potential_delta,
+            netlab::network_props const&  props
+            ) override
+    {
+        float_32_bit&  potential = m_potentials.at(spiker_index);
+        potential = 0.9f * potential + 5.0f * potential_delta;
+        if (potential > get_firing_potential())
+        {
+            potential -= 1.5f;
+            return true;
+        }
+        return false;
+    }
+
+    natural_64_bit  num_bytes_of_payload() const override { return m_potentials.size() * sizeof(float_32_bit); }
+    void  save_payload(natural_8_bit* const  payload) const override
+    { std::memcpy(payload,m_potentials.data(),num_bytes_of_payload()); }
+    void  load_payload(natural_8_bit const* const  payload) override
+    { std::memcpy(m_potentials.data(),payload,num_bytes_of_payload()); }
+
+private:
+    std::vector<float_32_bit>  m_potentials;
+};
+
+
+struct  docks_with_weights : public netlab::layer_of_docks
+{
+    docks_with_weights(netlab::layer_index_type const  layer_index, netlab::object_index_type const  num_docks)
+        : netlab::layer_of_docks(layer_index,num_docks)
+        , m_weights(num_docks,0.0f)
+    {}
+
+    float_32_bit  weight(netlab::object_index_type const  dock_index) const { return m_weights.at(dock_index); }
+
+    float_32_bit  on_arrival_of_postsynaptic_potential(
+            netlab::object_index_type const  dock_index,
+            float_32_bit const  potential_delta,
+            vector3 const&  spiker_position,
+            vector3 const&  dock_position,
+            netlab::layer_index_type const  layer_index_of_spiker_owning_the_connected_ship,
+            netlab::network_props const&  props
+            ) override
+    {
+        float_32_bit&  weight = m_weights.at(dock_index);
+        weight = 0.7f * weight + potential_delta;
+        return weight;
+    }
+
+    natural_64_bit  num_bytes_of_payload() const override { return m_weights.size() * sizeof(float_32_bit); }
+    void  save_payload(natural_8_bit* const  payload) const override
+    { std::memcpy(payload,m_weights.data(),num_bytes_of_payload()); }
+    void  load_payload(natural_8_bit const* const  payload) override
+    { std::memcpy(m_weights.data(),payload,num_bytes_of_payload()); }
+
+private:
+    std::vector<float_32_bit>  m_weights;
+};
+
+
+struct  ships_with_weights : public netlab::layer_of_ships
+{
+    ships_with_weights(netlab::layer_index_type const  layer_index, netlab::object_index_type const  num_ships)
+        : netlab::layer_of_ships(layer_index,num_ships)
+        , m_weights(num_ships,0.0f)
+    {}
+
+    float_32_bit  weight(netlab::object_index_type const  ship_index) const { return m_weights.at(ship_index); }
+
+    float_32_bit  on_arrival_of_presynaptic_potential(
+            netlab::object_index_type const  ship_index,
+            float_32_bit const  potential_of_the_other_spiker_at_connected_dock,
+            netlab::layer_index_type const  area_layer_index,
+            netlab::network_props const&  props
+            ) override
+    {
+        float_32_bit&  weight = m_weights.at(ship_index);
+        weight = 0.5f * weight + potential_of_the_other_spiker_at_connected_dock;
+        return 0.1f * weight + 0.5f;
+    }
+
+    natural_64_bit  num_bytes_of_payload() const override { return m_weights.size() * sizeof(float_32_bit); }
+    void  save_payload(natural_8_bit* const  payload) const override
+    { std::memcpy(payload,m_weights.data(),num_bytes_of_payload()); }
+    void  load_payload(natural_8_bit const* const  payload) override
+    { std::memcpy(m_weights.data(),payload,num_bytes_of_payload()); }
+
+    natural_64_bit  num_bytes_of_payload_of_ship() const override { return sizeof(float_32_bit); }
+    void  save_payload_of_ship(netlab::object_index_type const  ship_index, natural_8_bit* const  payload) const override
+    { std::memcpy(payload,&m_weights.at(ship_index),sizeof(float_32_bit)); }
+    void  load_payload_of_ship(netlab::object_index_type const  ship_index, natural_8_bit const* const  payload) override
+    { std::memcpy(&m_weights.at(ship_index),payload,sizeof(float_32_bit)); }
+
+private:
+    std::vector<float_32_bit>  m_weights;
+};
+
+
+struct  factory_of_layers_with_payloads : public netlab::network_layers_factory
+{
+    std::unique_ptr<netlab::layer_of_spikers>  create_layer_of_spikers(
+            netlab::layer_index_type const  layer_index,
+            netlab::object_index_type const  num_spikers
+            ) const override
+    { return std::make_unique<spikers_with_potentials>(layer_index,num_spikers); }
+
+    std::unique_ptr<netlab::layer_of_docks>  create_layer_of_docks(
+            netlab::layer_index_type const  layer_index,
+            netlab::object_index_type const  num_docks
+            ) const override
+    { return std::make_unique<docks_with_weights>(layer_index,num_docks); }
+
+    std::unique_ptr<netlab::layer_of_ships>  create_layer_of_ships(
+            netlab::layer_index_type const  layer_index,
+            netlab::object_index_type const  num_ships
+            ) const override
+    { return std::make_unique<ships_with_weights>(layer_index,num_ships); }
+};
+
+
+#endif
@@ -11,6 +11,7 @@
 #include <utility/timeprof.hpp>
 #include <algorithm>
 #include <limits>
+#include <vector>
 #include <memory>
 #include <stdexcept>
 
@@ -184,6 +185,55 @@ static void test_3Darray_of_units(natural_16_bit const num_bits_per_unit,
     }
 }
 
+static void test_tiled_enumeration(natural_32_bit const num_units_along_x_axis,
+                                   natural_32_bit const num_units_along_y_axis,
+                                   natural_32_bit const num_units_along_columnar_axis,
+                                   natural_32_bit const num_cells_in_tile,
+                                   natural_32_bit const num_threads)
+{
+    std::vector<natural_32_bit>  num_visits(
+            num_units_along_x_axis * num_units_along_y_axis * num_units_along_columnar_axis,
+            0U
+            );
+    for (natural_32_bit thread_index = 0U; thread_index < num_threads; ++thread_index)
+    {
+        natural_32_bit x_coord, y_coord, c_coord;
+        if (!cellab::go_to_first_coordinates_in_tiles(
+                    x_coord,y_coord,c_coord,
+                    thread_index,
+                    num_cells_in_tile,
+                    num_units_along_x_axis,
+                    num_units_along_y_axis,
+                    num_units_along_columnar_axis
+                    ))
+            continue;
+        natural_32_bit  index_in_tile = 0U;
+        natural_32_bit  last_linear_index = 0U;
+        bool  is_first = true;
+        do
+        {
+            natural_32_bit const  linear_index =
+                    (y_coord * num_units_along_x_axis + x_coord) * num_units_along_columnar_axis + c_coord;
+            TEST_SUCCESS(linear_index < num_visits.size());
+            TEST_SUCCESS((linear_index / num_cells_in_tile) % num_threads == thread_index);
+            TEST_SUCCESS(is_first || linear_index > last_linear_index);
+            ++num_visits.at(linear_index);
+            last_linear_index = linear_index;
+            is_first = false;
+        }
+        while (cellab::go_to_next_coordinates_in_tiles(
+                    x_coord,y_coord,c_coord,
+                    index_in_tile,
+                    num_cells_in_tile,
+                    num_threads,
+                    num_units_along_x_axis,
+                    num_units_along_y_axis,
+                    num_units_along_columnar_axis
+                    ));
+    }
+    TEST_SUCCESS(std::all_of(num_visits.cbegin(),num_visits.cend(),[](natural_32_bit const n) { return n == 1U; }));
+}
+
 void run()
 {
     TMPROF_BLOCK();
@@ -238,6 +288,14 @@ void run()
         TEST_PROGRESS_UPDATE();
     }
 
+    for (natural_32_bit num_threads = 1U; num_threads <= 17U; num_threads += 4U)
+        for (natural_32_bit num_cells_in_tile = 1U; num_cells_in_tile <= 200U; num_cells_in_tile += 13U)
+        {
+            test_tiled_enumeration(7U,5U,3U,num_cells_in_tile,num_threads);
+            test_tiled_enumeration(1U,11U,16U,num_cells_in_tile,num_threads);
+            TEST_PROGRESS_UPDATE();
+        }
+
     TEST_PROGRESS_HIDE();
 
     TEST_PRINT_STATISTICS();
@@ -9,6 +9,7 @@
 #include <utility/invariants.hpp>
 #include <functional>
 #include <vector>
+#include <algorithm>
 #include <cmath>
 
 void prepare_data_vector(
@@ -178,12 +179,102 @@ void present_statistics_vector(
     std::cout << title << "_END\n\n\n";
 }
 
+void test_counter_based_random_generator()
+{
+    // Known answers of Philox4x32-10 published by its authors (Random123 library).
+    {
+        natural_32_bit const  key[2] = { 0U, 0U };
+        natural_32_bit const  counter[4] = { 0U, 0U, 0U, 0U };
+        natural_32_bit  output[4];
+        philox_4x32_10(key,counter,output);
+        TEST_SUCCESS(output[0] == 0x6627e8d5U && output[1] == 0xe169c58dU &&
+                     output[2] == 0xbc57ac4cU && output[3] == 0x9b00dbd8U);
+    }
+    {
+        natural_32_bit const  key[2] = { 0xffffffffU, 0xffffffffU };
+        natural_32_bit const  counter[4] = { 0xffffffffU, 0xffffffffU, 0xffffffffU, 0xffffffffU };
+        natural_32_bit  output[4];
+        philox_4x32_10(key,counter,output);
+        TEST_SUCCESS(output[0] == 0x408f276dU && output[1] == 0x41c83b0eU &&
+                     output[2] == 0xa20bc7c6U && output[3] == 0x6d5451fdU);
+    }
+    {
+        natural_32_bit const  key[2] = { 0xa4093822U, 0x299f31d0U };
+        natural_32_bit const  counter[4] = { 0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U };
+        natural_32_bit  output[4];
+        philox_4x32_10(key,counter,output);
+        TEST_SUCCESS(output[0] == 0xd16cfe09U && output[1] == 0x94fdccebU &&
+                     output[2] == 0x5001e420U && output[3] == 0x24126ea1U);
+    }
+
+    // Batched and single draws must produce the same stream, for any split of the stream into batches.
+    for (natural_32_bit  batch_size = 1U; batch_size != 11U; ++batch_size)
+    {
+        counter_based_random_generator  single(123ULL,7U,456ULL);
+        counter_based_random_generator  batched(123ULL,7U,456ULL);
+        std::vector<natural_32_bit>  expected(100U);
+        for (natural_32_bit&  value : expected)
+            value = single();
+        std::vector<natural_32_bit>  obtained(100U);
+        for (natural_32_bit  i = 0U; i < obtained.size(); i += batch_size)
+            batched.fill(obtained.data() + i,obtained.data() + std::min(i + batch_size,(natural_32_bit)obtained.size()));
+        TEST_SUCCESS(expected == obtained);
+        TEST_PROGRESS_UPDATE();
+    }
+
+    // Streams of the same seed differ and a split stream is the same as a constructed one.
+    {
+        counter_based_random_generator const  root(99ULL);
+        counter_based_random_generator  a = root.split(1U,2ULL);
+        counter_based_random_generator  b(99ULL,1U,2ULL);
+        counter_based_random_generator  c = root.split(1U,3ULL);
+        counter_based_random_generator  d = root.split(2U,2ULL);
+        bool  are_a_and_c_same = true;
+        bool  are_a_and_d_same = true;
+        for (natural_32_bit  i = 0U; i != 16U; ++i)
+        {
+            natural_32_bit const  value = a();
+            TEST_SUCCESS(value == b());
+            are_a_and_c_same = are_a_and_c_same && value == c();
+            are_a_and_d_same = are_a_and_d_same && value == d();
+        }
+        TEST_SUCCESS(!are_a_and_c_same && !are_a_and_d_same);
+    }
+
+    // Values in ranges.
+    {
+        counter_based_random_generator  generator(5ULL);
+        std::vector<natural_32_bit>  counts(10U,0U);
+        for (natural_32_bit  i = 0U; i != 100000U; ++i)
+        {
+            natural_32_bit const  value = get_random_natural_32_bit_in_range(10U,19U,generator);
+            TEST_SUCCESS(value >= 10U && value <= 19U);
+            ++counts.at(value - 10U);
+        }
+        for (natural_32_bit const  count : counts)
+            TEST_SUCCESS(count > 9000U && count < 11000U);
+
+        std::vector<float_32_bit>  floats(1001U);
+        fill_by_random_float_32_bit_in_range(floats.data(),floats.data() + floats.size(),-2.0f,3.0f,generator);
+        for (float_32_bit const  value : floats)
+            TEST_SUCCESS(value >= -2.0f && value <= 3.0f);
+
+        std::vector<natural_64_bit>  naturals(1001U);
+        fill_by_random_natural_64_bit_in_range(naturals.data(),naturals.data() + naturals.size(),
+                                               1ULL << 40U,(1ULL << 41U) - 1ULL,generator);
+        for (natural_64_bit const  value : naturals)
+            TEST_SUCCESS(value >= (1ULL << 40U) && value < (1ULL << 41U));
+    }
+}
+
 void run()
 {
     TMPROF_BLOCK();
 
     TEST_PROGRESS_SHOW();
 
+    test_counter_based_random_generator();
+
     natural_32_bit const  min_number = 0U;
     natural_32_bit const  max_number = 9U;
     natural_32_bit const  num_classes = 20U;
@@ -208,7 +299,9 @@ void run()
 
         compute_content_of_data_vectors(
                 min_number,max_number,
-                std::bind(&get_random_natural_32_bit_in_range,min_number,max_number,default_random_generator()),
+                std::bind(static_cast<natural_32_bit(*)(natural_32_bit,natural_32_bit,random_generator_for_natural_32_bit&)>(
+                                &get_random_natural_32_bit_in_range),
+                          min_number,max_number,default_random_generator()),
                 num_classes,
                 sequence_lenghts.at(i),
                 big_sequence,
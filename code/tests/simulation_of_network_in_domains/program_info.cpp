@@ -0,0 +1,17 @@
+#include "./program_info.hpp"
+
+std::string  get_program_name()
+{
+    return "simulation_of_network_in_domains";
+}
+
+std::string  get_program_version()
+{
+    return "0.01";
+}
+
+std::string  get_program_description()
+{
+    return "This program tests a simulation of a network split into domains running in threads\n"
+           "against a simulation of the same network in a single domain.";
+}
@@ -0,0 +1,452 @@
+#include "./program_info.hpp"
+#include <common/network_layers_with_payloads.hpp>
+#include <netexp/experiment_factory.hpp>
+#include <netexp/ship_controller_flat_space.hpp>
+#include <netlab/network.hpp>
+#include <netlab/network_layers_factory.hpp>
+#include <netlab/in_process_transport.hpp>
+#include <utility/basic_numeric_types.hpp>
+#include <utility/test.hpp>
+#include <utility/timeprof.hpp>
+#include <utility/log.hpp>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <cmath>
+
+
+/**
+ * Ships of experiments jitter around their docks, so they are never docked in the sense of the default rule
+ * (which also limits the speed), and they never sleep. The test switches the rule of this controller between
+ * updates, so it can put all ships asleep and then move only ships of some domains.
+ */
+struct  rule_of_docking
+{
+    enum struct  KIND : natural_8_bit
+    {
+        DEFAULT                     = 0,    //!< The rule of the experiment.
+        EVERYWHERE                  = 1,    //!< All ships are docked.
+        IN_FIRST_DOMAIN             = 2,    //!< Ships in dock sectors of the domain 0 are docked.
+    };
+
+    KIND  kind;
+    netlab::domain_of_network const*  domain;
+};
+
+
+struct  ship_controller_with_rule_of_docking : public netexp::ship_controller_flat_space
+{
+    ship_controller_with_rule_of_docking(
+            netexp::ship_controller_flat_space const&  controller,
+            std::shared_ptr<rule_of_docking const> const  rule
+            )
+        : netexp::ship_controller_flat_space(controller)
+        , m_rule(rule)
+    {}
+
+    bool  is_ship_docked(
+            vector3 const&  ship_position,
+            vector3 const&  ship_velocity,
+            netlab::layer_index_type const  area_layer_index,
+            netlab::network_props const&  props
+            ) const override
+    {
+        switch (m_rule->kind)
+        {
+        case rule_of_docking::KIND::EVERYWHERE:
+            return true;
+        case rule_of_docking::KIND::IN_FIRST_DOMAIN:
+            {
+                netlab::network_layer_props const&  area_layer_props = props.layer_props().at(area_layer_index);
+                netlab::sector_coordinate_type  x,y,c;
+                area_layer_props.dock_sector_coordinates(ship_position,x,y,c);
+                return m_rule->domain->domain_of_dock_sector(area_layer_index, area_layer_props.dock_sector_index(x,y,c)) == 0U;
+            }
+        default:
+            return netexp::ship_controller_flat_space::is_ship_docked(ship_position,ship_velocity,area_layer_index,props);
+        }
+    }
+
+private:
+    std::shared_ptr<rule_of_docking const>  m_rule;
+};
+
+
+static std::shared_ptr<netlab::network_props>  create_props_with_rule_of_docking(
+        std::string const&  experiment,
+        std::shared_ptr<rule_of_docking const> const  rule
+        )
+{
+    std::shared_ptr<netlab::network_props> const  props = netexp::experiment_factory::instance().create_network_props(experiment);
+    std::vector<netlab::network_layer_props>  layer_props;
+    for (netlab::network_layer_props const&  lp : props->layer_props())
+    {
+        netexp::ship_controller_flat_space const* const  controller =
+                dynamic_cast<netexp::ship_controller_flat_space const*>(lp.ship_controller_ptr().get());
+        if (controller == nullptr)
+            throw std::runtime_error("The experiment does not use the flat space ship controller.");
+        layer_props.push_back({
+                lp.num_spikers_along_x_axis(),
+                lp.num_spikers_along_y_axis(),
+                lp.num_spikers_along_c_axis(),
+                lp.num_docks_along_x_axis_per_spiker(),
+                lp.num_docks_along_y_axis_per_spiker(),
+                lp.num_docks_along_c_axis_per_spiker(),
+                lp.num_ships_per_spiker(),
+                lp.distance_of_docks_in_meters(),
+                lp.low_corner_of_docks(),
+                lp.sizes_of_ship_movement_areas_in_meters(),
+                lp.speed_limits_of_ship_in_meters_per_second(),
+                lp.are_spikers_excitatory(),
+                std::make_shared<ship_controller_with_rule_of_docking const>(*controller,rule)
+                });
+    }
+    return std::make_shared<netlab::network_props>(
+            layer_props,
+            props->update_time_step_in_seconds(),
+            props->spiking_potential_magnitude(),
+            props->mini_spiking_potential_magnitude(),
+            props->average_mini_spiking_period_in_seconds(),
+            props->max_connection_distance_in_meters(),
+            props->num_threads_to_use()
+            );
+}
+
+
+static std::unique_ptr<netlab::network>  create_and_construct_network(
+        std::string const&  experiment,
+        std::shared_ptr<netlab::network_props> const  props
+        )
+{
+    netexp::experiment_factory const&  factory = netexp::experiment_factory::instance();
+    std::unique_ptr<netlab::network>  net =
+            std::make_unique<netlab::network>(props, std::make_shared<factory_of_layers_with_payloads>());
+    net->enable_usage_of_queues_in_update_of_ships(true);
+    std::shared_ptr<netlab::initialiser_of_movement_area_centers> const  centers_initialiser =
+            factory.create_initialiser_of_movement_area_centers(experiment);
+    std::shared_ptr<netlab::initialiser_of_ships_in_movement_areas> const  ships_initialiser =
+            factory.create_initialiser_of_ships_in_movement_areas(experiment);
+    while (net->get_state() != netlab::NETWORK_STATE::READY_FOR_SIMULATION_STEP)
+        switch (net->get_state())
+        {
+        case netlab::NETWORK_STATE::READY_FOR_MOVEMENT_AREA_CENTERS_INITIALISATION:
+            net->initialise_movement_area_centers(*centers_initialiser);
+            break;
+        case netlab::NETWORK_STATE::READY_FOR_MOVEMENT_AREA_CENTERS_MIGRATION_STARTUP:
+            net->prepare_for_movement_area_centers_migration(*centers_initialiser);
+            break;
+        case netlab::NETWORK_STATE::READY_FOR_MOVEMENT_AREA_CENTERS_MIGRATION_STEP:
+            net->do_movement_area_centers_migration_step(*centers_initialiser);
+            break;
+        case netlab::NETWORK_STATE::READY_FOR_COMPUTATION_OF_SHIP_DENSITIES_IN_LAYERS:
+            net->compute_densities_of_ships_in_layers();
+            break;
+        case netlab::NETWORK_STATE::READY_FOR_LUNCHING_SHIPS_INTO_MOVEMENT_AREAS:
+            net->lunch_ships_into_movement_areas(*ships_initialiser);
+            break;
+        case netlab::NETWORK_STATE::READY_FOR_INITIALISATION_OF_MAP_FROM_DOCK_SECTORS_TO_SHIPS:
+            net->initialise_map_from_dock_sectors_to_ships();
+            break;
+        default:
+            throw std::runtime_error("Unexpected state of the constructed network.");
+        }
+    net->set_seed_of_movement_of_ships(11ULL);
+    net->set_seed_of_mini_spiking(13ULL);
+    return net;
+}
+
+
+/// Domains must call collective operations of the transport concurrently, so each one runs in its own thread.
+/// An exception thrown in any thread is rethrown in the calling one.
+static void  run_in_domains(
+        std::vector< std::unique_ptr<netlab::network> > const&  domains,
+        std::function<void(netlab::network&, natural_32_bit)> const&  operation
+        )
+{
+    std::vector<std::exception_ptr>  exceptions(domains.size());
+    std::vector<std::thread>  threads;
+    for (natural_32_bit  d = 0U; d != domains.size(); ++d)
+        threads.emplace_back([&domains, &operation, &exceptions, d]() {
+            try { operation(*domains.at(d), d); }
+            catch (...) { exceptions.at(d) = std::current_exception(); }
+        });
+    for (std::thread&  thread : threads)
+        thread.join();
+    for (std::exception_ptr const&  exception : exceptions)
+        if (exception != nullptr)
+            std::rethrow_exception(exception);
+}
+
+
+static std::vector<netlab::compressed_layer_and_object_indices>  spikers_to_spike_in_next_update(netlab::network const&  net)
+{
+    std::vector<netlab::compressed_layer_and_object_indices>  spikers;
+    net.get_spikers_to_spike_in_next_update().for_each(
+            [&spikers](netlab::compressed_layer_and_object_indices const  loc) { spikers.push_back(loc); }
+            );
+    return spikers;
+}
+
+
+static std::vector< std::vector<bool> >  awake_ships(netlab::network const&  net)
+{
+    std::vector< std::vector<bool> >  awake;
+    for (netlab::layer_index_type  layer_index = 0U; layer_index != net.properties()->layer_props().size(); ++layer_index)
+        awake.push_back(std::vector<bool>(net.get_layer_of_ships(layer_index).size(),false));
+    net.get_update_queue_of_ships().for_each(
+            [&awake](netlab::compressed_layer_and_object_indices const  loc) {
+                awake.at(loc.layer_index()).at(loc.object_index()) = true;
+            });
+    return awake;
+}
+
+
+/// It compares owned objects of all domains with the same objects of the single network. Each ship must be owned
+/// by exactly one domain, and it must be awake in its domain if and only if it is awake in the single network.
+static void  test_equal_to_single_network(
+        netlab::network const&  single,
+        std::vector< std::unique_ptr<netlab::network> > const&  domains
+        )
+{
+    std::vector< std::vector<bool> > const  awake_in_single = awake_ships(single);
+    std::vector< std::vector< std::vector<bool> > >  awake_in_domains;
+    for (std::unique_ptr<netlab::network> const&  domain : domains)
+        awake_in_domains.push_back(awake_ships(*domain));
+
+    bool  are_owners_unique = true;
+    bool  are_ships_equal = true;
+    bool  are_awake_ships_equal = true;
+    bool  are_spikers_equal = true;
+    bool  are_docks_equal = true;
+    for (netlab::layer_index_type  layer_index = 0U; layer_index != single.properties()->layer_props().size(); ++layer_index)
+    {
+        ships_with_weights const&  single_ships = dynamic_cast<ships_with_weights const&>(single.get_layer_of_ships(layer_index));
+        for (netlab::object_index_type  i = 0ULL; i != single_ships.size(); ++i)
+        {
+            natural_32_bit  num_owners = 0U;
+            for (natural_32_bit  d = 0U; d != domains.size(); ++d)
+            {
+                netlab::network const&  domain = *domains.at(d);
+                bool const  is_awake = awake_in_domains.at(d).at(layer_index).at(i);
+                if (!domain.get_domain()->owns_ship({ layer_index, i }))
+                {
+                    if (is_awake)
+                        are_awake_ships_equal = false;
+                    continue;
+                }
+                ++num_owners;
+                ships_with_weights const&  ships = dynamic_cast<ships_with_weights const&>(domain.get_layer_of_ships(layer_index));
+                if (ships.position(i) != single_ships.position(i) ||
+                    ships.velocity(i) != single_ships.velocity(i) ||
+                    ships.weight(i) != single_ships.weight(i))
+                    are_ships_equal = false;
+                if (is_awake != awake_in_single.at(layer_index).at(i))
+                    are_awake_ships_equal = false;
+            }
+            if (num_owners != 1U)
+                are_owners_unique = false;
+        }
+
+        netlab::layer_of_spikers const&  single_spikers = single.get_layer_of_spikers(layer_index);
+        for (netlab::object_index_type  i = 0ULL; i != single_spikers.size(); ++i)
+            for (std::unique_ptr<netlab::network> const&  domain : domains)
+                if (domain->get_domain()->owns_spiker(layer_index, i) &&
+                    domain->get_layer_of_spikers(layer_index).get_potential(i) != single_spikers.get_potential(i))
+                    are_spikers_equal = false;
+
+        docks_with_weights const&  single_docks = dynamic_cast<docks_with_weights const&>(single.get_layer_of_docks(layer_index));
+        for (netlab::object_index_type  i = 0ULL; i != single_docks.size(); ++i)
+            for (std::unique_ptr<netlab::network> const&  domain : domains)
+                if (domain->get_domain()->domain_of_dock_sector(layer_index, i) == domain->get_domain()->domain_index() &&
+                    dynamic_cast<docks_with_weights const&>(domain->get_layer_of_docks(layer_index)).weight(i) != single_docks.weight(i))
+                    are_docks_equal = false;
+    }
+    TEST_SUCCESS(are_owners_unique);
+    TEST_SUCCESS(are_ships_equal);
+    TEST_SUCCESS(are_awake_ships_equal);
+    TEST_SUCCESS(are_spikers_equal);
+    TEST_SUCCESS(are_docks_equal);
+
+    // Each domain holds the whole list of spikers, in the order of the single network.
+    std::vector<netlab::compressed_layer_and_object_indices> const  single_spikers_to_spike = spikers_to_spike_in_next_update(single);
+    for (std::unique_ptr<netlab::network> const&  domain : domains)
+        TEST_SUCCESS(spikers_to_spike_in_next_update(*domain) == single_spikers_to_spike);
+}
+
+
+/// Ships of the single network and their owners among domains, taken before an update.
+struct  state_of_ships
+{
+    state_of_ships(
+            netlab::network const&  single,
+            std::vector< std::unique_ptr<netlab::network> > const&  domains
+            )
+        : awake(awake_ships(single))
+        , owners()
+        , positions()
+    {
+        for (netlab::layer_index_type  layer_index = 0U; layer_index != awake.size(); ++layer_index)
+        {
+            netlab::layer_of_ships const&  ships = single.get_layer_of_ships(layer_index);
+            owners.push_back(std::vector<natural_32_bit>(ships.size(),0U));
+            positions.push_back(std::vector<vector3>(ships.size()));
+            for (netlab::object_index_type  i = 0ULL; i != ships.size(); ++i)
+            {
+                for (natural_32_bit  d = 0U; d != domains.size(); ++d)
+                    if (domains.at(d)->get_domain()->owns_ship({ layer_index, i }))
+                        owners.at(layer_index).at(i) = d;
+                positions.at(layer_index).at(i) = ships.position(i);
+            }
+        }
+    }
+
+    std::vector< std::vector<bool> >  awake;
+    std::vector< std::vector<natural_32_bit> >  owners;
+    std::vector< std::vector<vector3> >  positions;
+};
+
+
+/// It returns the number of ships, which were asleep before the last update and awake after it, and which could
+/// not be woken up by any ship of their own domain, i.e. they were woken up by a ship moving in another domain.
+/// A ship may wake up only ships closer than the range below (along each axis) to its old or its new position.
+static natural_64_bit  num_ships_woken_up_by_other_domains(netlab::network const&  single, state_of_ships const&  before)
+{
+    float_32_bit  range = 0.0f;
+    for (netlab::network_layer_props const&  layer_props : single.properties()->layer_props())
+        range = std::max(range,
+                         layer_props.ship_controller_ptr()->docks_enumerations_distance_for_accelerate_from_ship() +
+                         2.0f * layer_props.distance_of_docks_in_meters());
+    auto const  is_in_range = [range](vector3 const&  u, vector3 const&  v) -> bool {
+        return std::fabs(u(0) - v(0)) <= range && std::fabs(u(1) - v(1)) <= range && std::fabs(u(2) - v(2)) <= range;
+    };
+
+    std::vector< std::vector<bool> > const  awake_after = awake_ships(single);
+
+    // Moved ships, which stayed awake, are the only ones which wake up other ships.
+    std::vector<netlab::compressed_layer_and_object_indices>  waking_ships;
+    for (netlab::layer_index_type  layer_index = 0U; layer_index != awake_after.size(); ++layer_index)
+        for (netlab::object_index_type  i = 0ULL; i != awake_after.at(layer_index).size(); ++i)
+            if (before.awake.at(layer_index).at(i) && awake_after.at(layer_index).at(i))
+                waking_ships.push_back({ layer_index, i });
+
+    natural_64_bit  num_woken = 0ULL;
+    for (netlab::layer_index_type  layer_index = 0U; layer_index != awake_after.size(); ++layer_index)
+        for (netlab::object_index_type  i = 0ULL; i != awake_after.at(layer_index).size(); ++i)
+        {
+            if (before.awake.at(layer_index).at(i) || !awake_after.at(layer_index).at(i))
+                continue;
+            vector3 const&  position = before.positions.at(layer_index).at(i);
+            bool  is_woken_by_own_domain = false;
+            for (netlab::compressed_layer_and_object_indices const  loc : waking_ships)
+                if (before.owners.at(loc.layer_index()).at(loc.object_index()) == before.owners.at(layer_index).at(i) &&
+                    (is_in_range(position, before.positions.at(loc.layer_index()).at(loc.object_index())) ||
+                     is_in_range(position, single.get_layer_of_ships(loc.layer_index()).position(loc.object_index()))))
+                {
+                    is_woken_by_own_domain = true;
+                    break;
+                }
+            if (!is_woken_by_own_domain)
+                ++num_woken;
+        }
+    return num_woken;
+}
+
+
+static void  test_simulation_in_domains(std::string const&  experiment, natural_32_bit const  num_domains)
+{
+    TMPROF_BLOCK();
+
+    std::shared_ptr<rule_of_docking> const  rule = std::make_shared<rule_of_docking>();
+    rule->kind = rule_of_docking::KIND::DEFAULT;
+    rule->domain = nullptr;
+    std::shared_ptr<netlab::network_props> const  props = create_props_with_rule_of_docking(experiment,rule);
+
+    std::unique_ptr<netlab::network> const  single = create_and_construct_network(experiment,props);
+    std::vector< std::unique_ptr<netlab::network> >  domains;
+    for (natural_32_bit  d = 0U; d != num_domains; ++d)
+        domains.push_back(create_and_construct_network(experiment,props));
+
+    std::shared_ptr<netlab::in_process_transport::hub> const  hub = netlab::in_process_transport::create_hub(num_domains);
+    run_in_domains(domains, [&hub](netlab::network&  net, natural_32_bit const  domain_index) {
+        net.split_into_domains(std::make_shared<netlab::in_process_transport>(hub, domain_index));
+    });
+    test_equal_to_single_network(*single,domains);
+    TEST_PROGRESS_UPDATE();
+
+    natural_64_bit  num_ships_woken_by_other_domains = 0ULL;
+    auto const  do_simulation_step = [&props, &single, &domains, &num_ships_woken_by_other_domains]() -> void {
+        state_of_ships const  before(*single,domains);
+        single->do_simulation_step();
+        run_in_domains(domains, [](netlab::network&  net, natural_32_bit) { net.do_simulation_step(); });
+        test_equal_to_single_network(*single,domains);
+
+        // Each mini-spike is generated exactly once, by the owner of its ship.
+        natural_64_bit  num_mini_spikes_in_domains = 0ULL;
+        for (std::unique_ptr<netlab::network> const&  domain : domains)
+            num_mini_spikes_in_domains += domain->num_mini_spikes_in_last_update();
+        TEST_SUCCESS(single->num_mini_spikes_in_last_update() == props->num_mini_spikes_to_generate_per_simulation_step());
+        TEST_SUCCESS(num_mini_spikes_in_domains == single->num_mini_spikes_in_last_update());
+        num_ships_woken_by_other_domains += num_ships_woken_up_by_other_domains(*single,before);
+        TEST_PROGRESS_UPDATE();
+    };
+
+    // All ships move for a while (so some of them migrate between domains), and then they all fall asleep.
+    for (natural_32_bit  i = 0U; i != 20U; ++i)
+        do_simulation_step();
+    rule->kind = rule_of_docking::KIND::EVERYWHERE;
+    do_simulation_step();
+    TEST_SUCCESS(single->size_of_update_queue_of_ships() == 0ULL);
+
+    // Only ships of domains other than 0 are woken up, and they keep moving. So, sleeping ships of the domain 0
+    // can only be woken up by ships of other domains, and they fall asleep again right after they move.
+    rule->kind = rule_of_docking::KIND::IN_FIRST_DOMAIN;
+    rule->domain = domains.front()->get_domain();
+    for (netlab::layer_index_type  layer_index = 0U; layer_index != props->layer_props().size(); ++layer_index)
+        for (netlab::object_index_type  i = 0ULL; i != single->get_layer_of_ships(layer_index).size(); ++i)
+            if (!domains.front()->get_domain()->owns_ship({ layer_index, i }))
+            {
+                single->wake_up_ship({ layer_index, i });
+                for (std::unique_ptr<netlab::network> const&  net : domains)
+                    net->wake_up_ship({ layer_index, i });
+            }
+    test_equal_to_single_network(*single,domains);
+    for (natural_32_bit  i = 0U; i != 20U; ++i)
+        do_simulation_step();
+    TEST_SUCCESS(single->size_of_update_queue_of_ships() < props->num_ships());
+    TEST_SUCCESS(num_ships_woken_by_other_domains > 0ULL);
+
+    // Finally, all ships wake up and move again.
+    rule->kind = rule_of_docking::KIND::DEFAULT;
+    for (netlab::layer_index_type  layer_index = 0U; layer_index != props->layer_props().size(); ++layer_index)
+        for (netlab::object_index_type  i = 0ULL; i != single->get_layer_of_ships(layer_index).size(); ++i)
+        {
+            single->wake_up_ship({ layer_index, i });
+            for (std::unique_ptr<netlab::network> const&  net : domains)
+                net->wake_up_ship({ layer_index, i });
+        }
+    for (natural_32_bit  i = 0U; i != 10U; ++i)
+        do_simulation_step();
+    TEST_SUCCESS(single->size_of_update_queue_of_ships() == props->num_ships());
+}
+
+
+void run()
+{
+    TMPROF_BLOCK();
+
+    TEST_PROGRESS_SHOW();
+
+    test_simulation_in_domains("calibration",2U);
+    test_simulation_in_domains("calibration",3U);
+    test_simulation_in_domains("dbg_spiking_develop",2U);
+    test_simulation_in_domains("dbg_spiking_develop",4U);
+
+    TEST_PROGRESS_HIDE();
+
+    TEST_PRINT_STATISTICS();
+}
@@ -3,10 +3,13 @@
 #include <cellab/static_state_of_neural_tissue.hpp>
 #include <cellab/dynamic_state_of_neural_tissue.hpp>
 #include <cellab/transition_algorithms.hpp>
+#include <cellab/inlined_transition_algorithms.hpp>
+#include <cellab/double_buffered_transition_of_tissue.hpp>
 #include <cellab/utilities_for_transition_algorithms.hpp>
 #include <utility/basic_numeric_types.hpp>
 #include <utility/bits_reference.hpp>
 #include <utility/random.hpp>
+#include <utility/thread_pool.hpp>
 #include <utility/test.hpp>
 #include <utility/timeprof.hpp>
 #include <utility/log.hpp>
@@ -248,8 +251,44 @@ void callback_transition_function_of_cell(
     TEST_SUCCESS(elemement.count() == high_corner_elemement.count());
 }
 
+/**
+ * In the double-buffered transition a cell reads signalling computed in the previous step.
+ */
+void callback_transition_function_of_cell_reading_previous_signalling(
+    bits_reference& bits_of_cell_to_be_updated,
+    cellab::kind_of_cell,
+    natural_32_bit num_of_synapses_connected_to_the_cell,
+    std::function<std::tuple<bits_const_reference,cellab::kind_of_cell,cellab::kind_of_cell>(natural_32_bit)> const&,
+    cellab::shift_in_coordinates const& shift_to_low_corner,
+    cellab::shift_in_coordinates const& shift_to_high_corner,
+    std::function<std::pair<bits_const_reference,cellab::kind_of_cell>(cellab::shift_in_coordinates const&)> const&
+        get_signalling
+    )
+{
+    tissue_element elemement(bits_of_cell_to_be_updated);
+    ++elemement;
+    elemement >> bits_of_cell_to_be_updated;
+
+    TEST_SUCCESS(num_of_synapses_connected_to_the_cell == 0U);
+
+    tissue_element low_corner_elemement(get_signalling(shift_to_low_corner).first);
+    TEST_SUCCESS(elemement.count() == low_corner_elemement.count() + 1U);
+
+    tissue_element high_corner_elemement(get_signalling(shift_to_high_corner).first);
+    TEST_SUCCESS(elemement.count() == high_corner_elemement.count() + 1U);
+}
+
+template struct cellab::inlined_neural_tissue<
+        decltype(&callback_transition_of_synapses_to_muscles),
+        decltype(&callback_transition_of_synapses_of_tissue),
+        decltype(&callback_transition_function_of_signalling),
+        decltype(&callback_transition_function_of_cell)
+        >;
+
 static void test_algorithms(std::shared_ptr<cellab::dynamic_state_of_neural_tissue> dynamic_tissue,
                             natural_32_bit const  num_avalilable_threads,
+                            thread_pool* const  pool,
+                            bool const  use_inlined_algorithms,
                             tissue_element& cell_counter,
                             tissue_element& synapse_counter,
                             tissue_element& signalling_counter,
@@ -262,10 +301,23 @@ static void test_algorithms(std::shared_ptr<cellab::dynamic_state_of_neural_tiss
 
     for (natural_32_bit i = 0U; i < 5U; ++i)
     {
-        cellab::apply_transition_of_synapses_to_muscles(
-                    dynamic_tissue,
-                    &callback_transition_of_synapses_to_muscles,
-                    num_avalilable_threads);
+        if (pool == nullptr)
+            cellab::apply_transition_of_synapses_to_muscles(
+                        dynamic_tissue,
+                        &callback_transition_of_synapses_to_muscles,
+                        num_avalilable_threads);
+        else if (!use_inlined_algorithms)
+            cellab::apply_transition_of_synapses_to_muscles(
+                        dynamic_tissue,
+                        &callback_transition_of_synapses_to_muscles,
+                        num_avalilable_threads,
+                        *pool);
+        else
+            cellab::apply_inlined_transition_of_synapses_to_muscles(
+                        dynamic_tissue,
+                        &callback_transition_of_synapses_to_muscles,
+                        num_avalilable_threads,
+                        *pool);
         TEST_PROGRESS_UPDATE();
 
         test_tissue(dynamic_tissue,
@@ -278,10 +330,23 @@ static void test_algorithms(std::shared_ptr<cellab::dynamic_state_of_neural_tiss
         TEST_PROGRESS_UPDATE();
 //        ++synapse_to_muscle_counter;
 
-        cellab::apply_transition_of_synapses_of_tissue(
-                    dynamic_tissue,
-                    &callback_transition_of_synapses_of_tissue,
-                    num_avalilable_threads);
+        if (pool == nullptr)
+            cellab::apply_transition_of_synapses_of_tissue(
+                        dynamic_tissue,
+                        &callback_transition_of_synapses_of_tissue,
+                        num_avalilable_threads);
+        else if (!use_inlined_algorithms)
+            cellab::apply_transition_of_synapses_of_tissue(
+                        dynamic_tissue,
+                        &callback_transition_of_synapses_of_tissue,
+                        num_avalilable_threads,
+                        *pool);
+        else
+            cellab::apply_inlined_transition_of_synapses_of_tissue(
+                        dynamic_tissue,
+                        &callback_transition_of_synapses_of_tissue,
+                        num_avalilable_threads,
+                        *pool);
         TEST_PROGRESS_UPDATE();
 
         test_tissue(dynamic_tissue,
@@ -294,9 +359,15 @@ static void test_algorithms(std::shared_ptr<cellab::dynamic_state_of_neural_tiss
         TEST_PROGRESS_UPDATE();
 //        ++synapse_counter;
 
-        cellab::apply_transition_of_territorial_lists_of_synapses(
-                    dynamic_tissue,
-                    num_avalilable_threads);
+        if (pool == nullptr)
+            cellab::apply_transition_of_territorial_lists_of_synapses(
+                        dynamic_tissue,
+                        num_avalilable_threads);
+        else
+            cellab::apply_transition_of_territorial_lists_of_synapses(
+                        dynamic_tissue,
+                        num_avalilable_threads,
+                        *pool);
         TEST_PROGRESS_UPDATE();
 
         test_tissue(dynamic_tissue,
@@ -308,15 +379,34 @@ static void test_algorithms(std::shared_ptr<cellab::dynamic_state_of_neural_tiss
                     synapse_to_muscle_counter);
         TEST_PROGRESS_UPDATE();
 
-        cellab::apply_transition_of_synaptic_migration_in_tissue(
-                    dynamic_tissue,
-                    num_avalilable_threads);
+        if (pool == nullptr)
+            cellab::apply_transition_of_synaptic_migration_in_tissue(
+                        dynamic_tissue,
+                        num_avalilable_threads);
+        else
+            cellab::apply_transition_of_synaptic_migration_in_tissue(
+                        dynamic_tissue,
+                        num_avalilable_threads,
+                        *pool);
         TEST_PROGRESS_UPDATE();
 
-        cellab::apply_transition_of_signalling_in_tissue(
-                    dynamic_tissue,
-                    &callback_transition_function_of_signalling,
-                    num_avalilable_threads);
+        if (pool == nullptr)
+            cellab::apply_transition_of_signalling_in_tissue(
+                        dynamic_tissue,
+                        &callback_transition_function_of_signalling,
+                        num_avalilable_threads);
+        else if (!use_inlined_algorithms)
+            cellab::apply_transition_of_signalling_in_tissue(
+                        dynamic_tissue,
+                        &callback_transition_function_of_signalling,
+                        num_avalilable_threads,
+                        *pool);
+        else
+            cellab::apply_inlined_transition_of_signalling_in_tissue(
+                        dynamic_tissue,
+                        &callback_transition_function_of_signalling,
+                        num_avalilable_threads,
+                        *pool);
         TEST_PROGRESS_UPDATE();
 
         test_tissue(dynamic_tissue,
@@ -329,10 +419,23 @@ static void test_algorithms(std::shared_ptr<cellab::dynamic_state_of_neural_tiss
         TEST_PROGRESS_UPDATE();
 //        ++signalling_counter;
 
-        cellab::apply_transition_of_cells_of_tissue(
-                    dynamic_tissue,
-                    &callback_transition_function_of_cell,
-                    num_avalilable_threads);
+        if (pool == nullptr)
+            cellab::apply_transition_of_cells_of_tissue(
+                        dynamic_tissue,
+                        &callback_transition_function_of_cell,
+                        num_avalilable_threads);
+        else if (!use_inlined_algorithms)
+            cellab::apply_transition_of_cells_of_tissue(
+                        dynamic_tissue,
+                        &callback_transition_function_of_cell,
+                        num_avalilable_threads,
+                        *pool);
+        else
+            cellab::apply_inlined_transition_of_cells_of_tissue(
+                        dynamic_tissue,
+                        &callback_transition_function_of_cell,
+                        num_avalilable_threads,
+                        *pool);
         TEST_PROGRESS_UPDATE();
 
         test_tissue(dynamic_tissue,
@@ -353,12 +456,207 @@ static void test_algorithms(std::shared_ptr<cellab::dynamic_state_of_neural_tiss
     tissue_element signalling_counter;
     tissue_element sensory_cell_counter;
     tissue_element synapse_to_muscle_counter;
-    test_algorithms(dynamic_tissue,2U,cell_counter,synapse_counter,signalling_counter,sensory_cell_counter,synapse_to_muscle_counter);
-    test_algorithms(dynamic_tissue,4U,cell_counter,synapse_counter,signalling_counter,sensory_cell_counter,synapse_to_muscle_counter);
-    test_algorithms(dynamic_tissue,8U,cell_counter,synapse_counter,signalling_counter,sensory_cell_counter,synapse_to_muscle_counter);
-    test_algorithms(dynamic_tissue,16U,cell_counter,synapse_counter,signalling_counter,sensory_cell_counter,synapse_to_muscle_counter);
-    test_algorithms(dynamic_tissue,32U,cell_counter,synapse_counter,signalling_counter,sensory_cell_counter,synapse_to_muscle_counter);
-    test_algorithms(dynamic_tissue,64U,cell_counter,synapse_counter,signalling_counter,sensory_cell_counter,synapse_to_muscle_counter);
+    test_algorithms(dynamic_tissue,2U,nullptr,false,cell_counter,synapse_counter,signalling_counter,sensory_cell_counter,synapse_to_muscle_counter);
+    test_algorithms(dynamic_tissue,4U,nullptr,false,cell_counter,synapse_counter,signalling_counter,sensory_cell_counter,synapse_to_muscle_counter);
+    test_algorithms(dynamic_tissue,8U,nullptr,false,cell_counter,synapse_counter,signalling_counter,sensory_cell_counter,synapse_to_muscle_counter);
+    test_algorithms(dynamic_tissue,16U,nullptr,false,cell_counter,synapse_counter,signalling_counter,sensory_cell_counter,synapse_to_muscle_counter);
+    test_algorithms(dynamic_tissue,32U,nullptr,false,cell_counter,synapse_counter,signalling_counter,sensory_cell_counter,synapse_to_muscle_counter);
+    test_algorithms(dynamic_tissue,64U,nullptr,false,cell_counter,synapse_counter,signalling_counter,sensory_cell_counter,synapse_to_muscle_counter);
+
+    thread_pool  pool(63U);
+    for (natural_32_bit num_threads = 1U; num_threads <= 64U; num_threads *= 2U)
+        test_algorithms(dynamic_tissue,num_threads,&pool,false,cell_counter,synapse_counter,signalling_counter,sensory_cell_counter,synapse_to_muscle_counter);
+    for (natural_32_bit num_threads = 1U; num_threads <= 64U; num_threads *= 2U)
+        test_algorithms(dynamic_tissue,num_threads,&pool,true,cell_counter,synapse_counter,signalling_counter,sensory_cell_counter,synapse_to_muscle_counter);
+}
+
+
+static void initialise_tissue_for_migration(std::shared_ptr<cellab::dynamic_state_of_neural_tissue> dynamic_tissue,
+                                            random_generator_for_natural_32_bit&  generator)
+{
+    std::shared_ptr<cellab::static_state_of_neural_tissue const> static_tissue =
+            dynamic_tissue->get_static_state_of_neural_tissue();
+
+    std::vector<cellab::territorial_state_of_synapse> states_of_lists(cellab::num_delimiters() + 1U);
+    for (natural_32_bit i = 0U; i < states_of_lists.size(); ++i)
+    {
+        cellab::territorial_state_of_synapse const state = static_cast<cellab::territorial_state_of_synapse>(i);
+        states_of_lists.at(cellab::convert_territorial_state_of_synapse_to_territorial_list_index(state)) = state;
+    }
+
+    natural_32_bit  id = 0U;
+    for (natural_32_bit x = 0U; x < static_tissue->num_cells_along_x_axis(); ++x)
+        for (natural_32_bit y = 0U; y < static_tissue->num_cells_along_y_axis(); ++y)
+            for (natural_32_bit c = 0U; c < static_tissue->num_cells_along_columnar_axis(); ++c)
+            {
+                natural_32_bit const num_synapses =
+                        static_tissue->num_synapses_in_territory_of_cell_kind(
+                                static_tissue->compute_kind_of_cell_from_its_position_along_columnar_axis(c)
+                                );
+                std::vector<natural_32_bit> list_indices;
+                for (natural_32_bit s = 0U; s < num_synapses; ++s)
+                    list_indices.push_back(get_random_natural_32_bit_in_range(0U,cellab::num_delimiters(),generator));
+                std::sort(list_indices.begin(),list_indices.end());
+                for (natural_32_bit s = 0U; s < num_synapses; ++s)
+                {
+                    tissue_element(++id) >> dynamic_tissue->find_bits_of_synapse_in_tissue(x,y,c,s);
+                    value_to_bits((natural_32_bit)states_of_lists.at(list_indices.at(s)),
+                                  dynamic_tissue->find_bits_of_territorial_state_of_synapse_in_tissue(x,y,c,s));
+                }
+                for (natural_8_bit d = 0U; d < cellab::num_delimiters(); ++d)
+                    value_to_bits(
+                        (natural_32_bit)(std::upper_bound(list_indices.begin(),list_indices.end(),(natural_32_bit)d) -
+                                         list_indices.begin()),
+                        dynamic_tissue->find_bits_of_delimiter_between_territorial_lists(x,y,c,d)
+                        );
+            }
+}
+
+static std::vector<natural_32_bit>  collect_ids_of_synapses(std::shared_ptr<cellab::dynamic_state_of_neural_tissue> dynamic_tissue)
+{
+    std::shared_ptr<cellab::static_state_of_neural_tissue const> static_tissue =
+            dynamic_tissue->get_static_state_of_neural_tissue();
+    std::vector<natural_32_bit>  ids;
+    for (natural_32_bit x = 0U; x < static_tissue->num_cells_along_x_axis(); ++x)
+        for (natural_32_bit y = 0U; y < static_tissue->num_cells_along_y_axis(); ++y)
+            for (natural_32_bit c = 0U; c < static_tissue->num_cells_along_columnar_axis(); ++c)
+                for (natural_32_bit s = 0U;
+                     s < static_tissue->num_synapses_in_territory_of_cell_with_columnar_coord(c);
+                     ++s)
+                    ids.push_back(tissue_element(dynamic_tissue->find_bits_of_synapse_in_tissue(x,y,c,s)).count());
+    return ids;
+}
+
+static void test_deterministic_synaptic_migration(std::shared_ptr<cellab::static_state_of_neural_tissue const> static_tissue)
+{
+    thread_pool  pool(15U);
+    std::vector<natural_32_bit>  ids_of_single_threaded_run;
+    for (natural_32_bit num_threads = 1U; num_threads <= 16U; num_threads *= 2U)
+    {
+        std::array<std::shared_ptr<cellab::dynamic_state_of_neural_tissue>,2U>  tissues;
+        for (std::shared_ptr<cellab::dynamic_state_of_neural_tissue>&  tissue : tissues)
+        {
+            tissue = std::make_shared<cellab::dynamic_state_of_neural_tissue>(static_tissue);
+            random_generator_for_natural_32_bit  generator;
+            initialise_tissue_for_migration(tissue,generator);
+        }
+        std::vector<natural_32_bit> const  initial_ids = collect_ids_of_synapses(tissues.at(0));
+
+        for (natural_32_bit i = 0U; i < 3U; ++i)
+            for (std::shared_ptr<cellab::dynamic_state_of_neural_tissue>&  tissue : tissues)
+                cellab::apply_transition_of_synaptic_migration_in_tissue(tissue,num_threads,pool,12345U + i);
+        TEST_PROGRESS_UPDATE();
+
+        std::vector<natural_32_bit> const  ids_0 = collect_ids_of_synapses(tissues.at(0));
+        std::vector<natural_32_bit> const  ids_1 = collect_ids_of_synapses(tissues.at(1));
+        TEST_SUCCESS(ids_0 == ids_1);
+        TEST_SUCCESS(ids_0 != initial_ids);
+
+        std::vector<natural_32_bit>  sorted_ids = ids_0;
+        std::sort(sorted_ids.begin(),sorted_ids.end());
+        TEST_SUCCESS(sorted_ids == initial_ids);
+
+        if (num_threads == 1U)
+            ids_of_single_threaded_run = ids_0;
+        TEST_SUCCESS(ids_0 == ids_of_single_threaded_run);
+    }
+}
+
+
+static void test_synaptic_migration_in_tiles_smaller_than_column()
+{
+    // A tiny tissue with short territories, so that tiles of many threads are smaller than a column and
+    // neighbouring territories in slices share bytes.
+    natural_32_bit const  cells_x = 3U;
+    natural_32_bit const  cells_y = 7U;
+    std::vector<natural_32_bit> const  num_tissue_cells_of_cell_kind = { 1U, 2U, 3U };
+    std::vector<natural_32_bit> const  num_synapses_in_territory_of_cell_kind = { 3U, 5U, 7U };
+    std::vector<integer_8_bit> const  radii(num_tissue_cells_of_cell_kind.size(), 1);
+
+    std::shared_ptr<cellab::static_state_of_neural_tissue const> const  static_tissue =
+            std::make_shared<cellab::static_state_of_neural_tissue const>(
+                    (natural_16_bit)num_tissue_cells_of_cell_kind.size(),
+                    1U,
+                    1U,
+                    tissue_element::num_bits(),
+                    tissue_element::num_bits(),
+                    tissue_element::num_bits(),
+                    cells_x,
+                    cells_y,
+                    num_tissue_cells_of_cell_kind,
+                    num_synapses_in_territory_of_cell_kind,
+                    std::vector<natural_32_bit>{ 1U },
+                    std::vector<natural_32_bit>{ 1U },
+                    true,
+                    true,
+                    true,
+                    radii, radii, radii,
+                    radii, radii, radii,
+                    radii, radii, radii
+                    );
+    TEST_SUCCESS(cellab::compute_num_cells_in_tile_of_tissue(static_tissue,64U) <
+                 static_tissue->num_cells_along_columnar_axis());
+
+    std::vector<natural_32_bit>  expected_ids;
+    thread_pool  pool(63U);
+    for (natural_32_bit num_threads = 1U; num_threads <= 64U; num_threads *= 2U)
+        for (natural_32_bit repetition = 0U; repetition < 10U; ++repetition)
+        {
+            std::shared_ptr<cellab::dynamic_state_of_neural_tissue> const  tissue =
+                    std::make_shared<cellab::dynamic_state_of_neural_tissue>(static_tissue);
+            random_generator_for_natural_32_bit  generator;
+            initialise_tissue_for_migration(tissue,generator);
+            for (natural_32_bit i = 0U; i < 5U; ++i)
+                cellab::apply_transition_of_synaptic_migration_in_tissue(tissue,num_threads,pool,54321U + i);
+
+            std::vector<natural_32_bit> const  ids = collect_ids_of_synapses(tissue);
+            if (expected_ids.empty())
+                expected_ids = ids;
+            TEST_SUCCESS(ids == expected_ids);
+        }
+    TEST_PROGRESS_UPDATE();
+}
+
+static void test_double_buffered_transition(std::shared_ptr<cellab::static_state_of_neural_tissue const> static_tissue)
+{
+    cellab::territorial_state_of_synapse const territorial_state =
+            cellab::territorial_state_of_synapse::MIGRATION_ALONG_POSITIVE_X_AXIS;
+
+    thread_pool  pool(15U);
+    for (natural_32_bit num_threads = 1U; num_threads <= 16U; num_threads *= 2U)
+    {
+        // Tiles of packed units start at byte boundaries of all slices.
+        natural_32_bit const  num_cells_in_tile =
+                cellab::compute_num_cells_in_byte_aligned_tile_of_tissue(static_tissue,num_threads);
+        TEST_SUCCESS(num_cells_in_tile > 0U && num_cells_in_tile % (8U * static_tissue->num_cells_along_columnar_axis()) == 0U);
+
+        std::shared_ptr<cellab::dynamic_state_of_neural_tissue> const  dynamic_tissue =
+                std::make_shared<cellab::dynamic_state_of_neural_tissue>(
+                        static_tissue,
+                        cellab::PACKED_UNITS,
+                        cellab::DOUBLE_BUFFERED_CELLS_AND_SIGNALLING
+                        );
+        initialse_tissue(dynamic_tissue);
+
+        for (natural_32_bit i = 1U; i <= 3U; ++i)
+        {
+            cellab::apply_double_buffered_transition_of_tissue(
+                        dynamic_tissue,
+                        &callback_transition_of_synapses_to_muscles,
+                        &callback_transition_of_synapses_of_tissue,
+                        &callback_transition_function_of_signalling,
+                        &callback_transition_function_of_cell_reading_previous_signalling,
+                        num_threads,
+                        pool
+                        );
+            cellab::apply_transition_of_synaptic_migration_in_tissue(dynamic_tissue,num_threads,pool,12345U + i);
+            TEST_PROGRESS_UPDATE();
+
+            tissue_element const  counter(i);
+            test_tissue(dynamic_tissue,counter,counter,territorial_state,counter,tissue_element(),counter);
+            TEST_PROGRESS_UPDATE();
+        }
+    }
 }
 
 
@@ -512,6 +810,9 @@ void run()
 
                                     initialse_tissue(dynamic_tissue);
                                     test_algorithms(dynamic_tissue);
+                                    test_deterministic_synaptic_migration(static_tissue);
+                                    test_synaptic_migration_in_tiles_smaller_than_column();
+                                    test_double_buffered_transition(static_tissue);
                                 }
                             }
                 }
@@ -3,10 +3,13 @@
 #include <cellab/static_state_of_neural_tissue.hpp>
 #include <cellab/dynamic_state_of_neural_tissue.hpp>
 #include <cellab/utilities_for_transition_algorithms.hpp>
+#include <cellab/neighbourhood_clipping_table.hpp>
+#include <cellab/checkpoint_of_neural_tissue.hpp>
 #include <utility/basic_numeric_types.hpp>
 #include <utility/test.hpp>
 #include <utility/timeprof.hpp>
 #include <utility/log.hpp>
+#include <boost/filesystem.hpp>
 #include <vector>
 #include <array>
 #include <memory>
@@ -258,6 +261,84 @@ static void test_shift_in_coordinates(
                         }
 }
 
+static void test_neighbourhood_clipping_table(
+        std::shared_ptr<cellab::static_state_of_neural_tissue const> const static_tissue)
+{
+    cellab::neighbourhood_clipping_table const& table = static_tissue->get_neighbourhood_clipping_table();
+
+    struct local {
+        static std::vector<natural_32_bit>  coords_to_check(natural_32_bit const length_of_axis)
+        {
+            std::vector<natural_32_bit> coords;
+            for (natural_32_bit i = 0U; i < length_of_axis; ++i)
+                if (i < 4U || i + 4U >= length_of_axis || i == length_of_axis / 2U)
+                    coords.push_back(i);
+            return coords;
+        }
+        static void  get_radii(std::shared_ptr<cellab::static_state_of_neural_tissue const> const static_tissue,
+                               cellab::kind_of_neighbourhood const neighbourhood_kind,
+                               cellab::kind_of_cell const kind,
+                               integer_8_bit& rx, integer_8_bit& ry, integer_8_bit& rc)
+        {
+            switch (neighbourhood_kind)
+            {
+            case cellab::SIGNALLING_NEIGHBOURHOOD_OF_CELL:
+                rx = static_tissue->get_x_radius_of_signalling_neighbourhood_of_cell(kind);
+                ry = static_tissue->get_y_radius_of_signalling_neighbourhood_of_cell(kind);
+                rc = static_tissue->get_columnar_radius_of_signalling_neighbourhood_of_cell(kind);
+                break;
+            case cellab::SIGNALLING_NEIGHBOURHOOD_OF_SYNAPSE:
+                rx = static_tissue->get_x_radius_of_signalling_neighbourhood_of_synapse(kind);
+                ry = static_tissue->get_y_radius_of_signalling_neighbourhood_of_synapse(kind);
+                rc = static_tissue->get_columnar_radius_of_signalling_neighbourhood_of_synapse(kind);
+                break;
+            default:
+                rx = static_tissue->get_x_radius_of_cellular_neighbourhood_of_signalling(kind);
+                ry = static_tissue->get_y_radius_of_cellular_neighbourhood_of_signalling(kind);
+                rc = static_tissue->get_columnar_radius_of_cellular_neighbourhood_of_signalling(kind);
+                break;
+            }
+        }
+    };
+
+    std::vector<natural_32_bit> const X = local::coords_to_check(static_tissue->num_cells_along_x_axis());
+    std::vector<natural_32_bit> const Y = local::coords_to_check(static_tissue->num_cells_along_y_axis());
+
+    for (natural_32_bit n = 0U; n < 3U; ++n)
+    {
+        cellab::kind_of_neighbourhood const neighbourhood_kind = static_cast<cellab::kind_of_neighbourhood>(n);
+        for (natural_32_bit c = 0U; c < static_tissue->num_cells_along_columnar_axis(); ++c)
+        {
+            cellab::kind_of_cell const kind = static_tissue->compute_kind_of_cell_and_relative_columnar_index_from_coordinate_along_columnar_axis(c).first;
+            TEST_SUCCESS(table.get_kind_of_tissue_cell(c) == kind);
+
+            integer_8_bit rx, ry, rc;
+            local::get_radii(static_tissue,neighbourhood_kind,kind,rx,ry,rc);
+
+            for (natural_32_bit x : X)
+                for (natural_32_bit y : Y)
+                {
+                    cellab::shift_in_coordinates const low = table.get_shift_to_low_corner(neighbourhood_kind,x,y,c);
+                    cellab::shift_in_coordinates const high = table.get_shift_to_high_corner(neighbourhood_kind,x,y,c);
+
+                    TEST_SUCCESS(low.get_shift_along_x_axis() ==
+                                 cellab::clip_shift((integer_8_bit)-rx,x,static_tissue->num_cells_along_x_axis(),static_tissue->is_x_axis_torus_axis()));
+                    TEST_SUCCESS(low.get_shift_along_y_axis() ==
+                                 cellab::clip_shift((integer_8_bit)-ry,y,static_tissue->num_cells_along_y_axis(),static_tissue->is_y_axis_torus_axis()));
+                    TEST_SUCCESS(low.get_shift_along_columnar_axis() ==
+                                 cellab::clip_shift((integer_8_bit)-rc,c,static_tissue->num_cells_along_columnar_axis(),static_tissue->is_columnar_axis_torus_axis()));
+
+                    TEST_SUCCESS(high.get_shift_along_x_axis() ==
+                                 cellab::clip_shift(rx,x,static_tissue->num_cells_along_x_axis(),static_tissue->is_x_axis_torus_axis()));
+                    TEST_SUCCESS(high.get_shift_along_y_axis() ==
+                                 cellab::clip_shift(ry,y,static_tissue->num_cells_along_y_axis(),static_tissue->is_y_axis_torus_axis()));
+                    TEST_SUCCESS(high.get_shift_along_columnar_axis() ==
+                                 cellab::clip_shift(rc,c,static_tissue->num_cells_along_columnar_axis(),static_tissue->is_columnar_axis_torus_axis()));
+                }
+        }
+    }
+}
+
 static void test_find_bits_of_cell(
         std::shared_ptr<cellab::dynamic_state_of_neural_tissue> const dynamic_tissue)
 {
@@ -565,6 +646,7 @@ static void test_static_state(std::shared_ptr<cellab::static_state_of_neural_tis
     test_compute_kind_of_synapse_to_muscle_from_its_index(static_tissue);
     test_compute_kind_of_synapse_to_muscle_and_relative_index_from_its_index(static_tissue);
     test_compute_index_of_first_synapse_to_muscle_of_kind(static_tissue);
+    test_neighbourhood_clipping_table(static_tissue);
 }
 
 static void test_dynamic_state(std::shared_ptr<cellab::dynamic_state_of_neural_tissue> const dynamic_tissue)
@@ -580,6 +662,159 @@ static void test_dynamic_state(std::shared_ptr<cellab::dynamic_state_of_neural_t
     test_find_bits_of_synapse_to_muscle(dynamic_tissue);
 }
 
+struct  test_synapse_type { natural_8_bit  bytes[3]; };
+
+static void test_byte_aligned_storage_of_units()
+{
+    std::shared_ptr<cellab::static_state_of_neural_tissue const> const  static_tissue(
+                new cellab::static_state_of_neural_tissue(
+                    2U, 1U, 1U,
+                    8U * sizeof(natural_32_bit),
+                    8U * sizeof(test_synapse_type),
+                    8U * sizeof(natural_64_bit),
+                    7U, 5U,
+                    { 3U, 2U }, { 4U, 5U }, { 3U }, { 2U },
+                    true, false, true,
+                    { 1, 1 }, { 1, 1 }, { 1, 1 },
+                    { 1, 1 }, { 1, 1 }, { 1, 1 },
+                    { 1, 1 }, { 1, 1 }, { 1, 1 }
+                    ));
+    std::shared_ptr<cellab::dynamic_state_of_neural_tissue> const  dynamic_tissue(
+                new cellab::dynamic_state_of_neural_tissue(static_tissue,cellab::BYTE_ALIGNED_UNITS)
+                );
+    TEST_SUCCESS(dynamic_tissue->get_storage_of_units() == cellab::BYTE_ALIGNED_UNITS);
+
+    natural_32_bit  counter = 0U;
+    for (natural_32_bit x = 0U; x < static_tissue->num_cells_along_x_axis(); ++x)
+        for (natural_32_bit y = 0U; y < static_tissue->num_cells_along_y_axis(); ++y)
+            for (natural_32_bit c = 0U; c < static_tissue->num_cells_along_columnar_axis(); ++c)
+            {
+                dynamic_tissue->find_cell_in_tissue<natural_32_bit>(x,y,c) = ++counter;
+                dynamic_tissue->find_signalling<natural_64_bit>(x,y,c) = 1000000000000ULL + counter;
+                for (natural_32_bit i = 0U;
+                     i < static_tissue->num_synapses_in_territory_of_cell_with_columnar_coord(c);
+                     ++i)
+                {
+                    test_synapse_type&  synapse = dynamic_tissue->find_synapse_in_tissue<test_synapse_type>(x,y,c,i);
+                    synapse.bytes[0] = (natural_8_bit)counter;
+                    synapse.bytes[1] = (natural_8_bit)i;
+                    synapse.bytes[2] = (natural_8_bit)(counter >> 8U);
+                }
+            }
+    for (natural_32_bit i = 0U; i < static_tissue->num_sensory_cells(); ++i)
+        dynamic_tissue->find_sensory_cell<natural_32_bit>(i) = 100U + i;
+
+    counter = 0U;
+    for (natural_32_bit x = 0U; x < static_tissue->num_cells_along_x_axis(); ++x)
+        for (natural_32_bit y = 0U; y < static_tissue->num_cells_along_y_axis(); ++y)
+            for (natural_32_bit c = 0U; c < static_tissue->num_cells_along_columnar_axis(); ++c)
+            {
+                ++counter;
+                TEST_SUCCESS(dynamic_tissue->find_bits_of_cell_in_tissue(x,y,c).shift_in_the_first_byte() == 0U);
+                TEST_SUCCESS(dynamic_tissue->find_cell_in_tissue<natural_32_bit>(x,y,c) == counter);
+                TEST_SUCCESS(dynamic_tissue->find_signalling<natural_64_bit>(x,y,c) == 1000000000000ULL + counter);
+                for (natural_32_bit i = 0U;
+                     i < static_tissue->num_synapses_in_territory_of_cell_with_columnar_coord(c);
+                     ++i)
+                {
+                    test_synapse_type const&  synapse =
+                            dynamic_tissue->find_synapse_in_tissue<test_synapse_type>(x,y,c,i);
+                    TEST_SUCCESS(synapse.bytes[0] == (natural_8_bit)counter);
+                    TEST_SUCCESS(synapse.bytes[1] == (natural_8_bit)i);
+                    TEST_SUCCESS(synapse.bytes[2] == (natural_8_bit)(counter >> 8U));
+                }
+            }
+    for (natural_32_bit i = 0U; i < static_tissue->num_sensory_cells(); ++i)
+        TEST_SUCCESS(dynamic_tissue->find_sensory_cell<natural_32_bit>(i) == 100U + i);
+
+    test_dynamic_state(dynamic_tissue);
+}
+
+static bool  are_bits_of_dynamic_states_equal(
+        cellab::dynamic_state_of_neural_tissue const&  left,
+        cellab::dynamic_state_of_neural_tissue const&  right)
+{
+    std::vector<array_of_bit_units const*> const  left_arrays = left.get_arrays_of_units_in_order_of_allocation();
+    std::vector<array_of_bit_units const*> const  right_arrays = right.get_arrays_of_units_in_order_of_allocation();
+    if (left_arrays.size() != right_arrays.size())
+        return false;
+    for (natural_32_bit i = 0U; i < left_arrays.size(); ++i)
+        if (left_arrays.at(i)->num_bytes() != right_arrays.at(i)->num_bytes() ||
+            std::memcmp(left_arrays.at(i)->data(), right_arrays.at(i)->data(), left_arrays.at(i)->num_bytes()) != 0)
+            return false;
+    return true;
+}
+
+static void test_checkpoint_of_neural_tissue(
+        cellab::storage_of_units_of_neural_tissue const  storage_of_units,
+        cellab::buffering_of_cells_and_signalling const  buffering)
+{
+    std::shared_ptr<cellab::static_state_of_neural_tissue const> const  static_tissue(
+                new cellab::static_state_of_neural_tissue(
+                    2U, 2U, 1U,
+                    8U * sizeof(natural_32_bit), 24U, 8U * sizeof(natural_64_bit),
+                    7U, 5U,
+                    { 3U, 2U }, { 4U, 5U }, { 3U, 1U }, { 2U },
+                    true, false, true,
+                    { 1, 2 }, { 1, 1 }, { 1, 1 },
+                    { 2, 1 }, { 1, 1 }, { 1, 1 },
+                    { 1, 1 }, { 2, 2 }, { 1, 1 }
+                    ));
+    std::shared_ptr<cellab::dynamic_state_of_neural_tissue> const  dynamic_tissue(
+                new cellab::dynamic_state_of_neural_tissue(static_tissue,storage_of_units,buffering)
+                );
+
+    natural_32_bit  counter = 0U;
+    for (natural_32_bit x = 0U; x < static_tissue->num_cells_along_x_axis(); ++x)
+        for (natural_32_bit y = 0U; y < static_tissue->num_cells_along_y_axis(); ++y)
+            for (natural_32_bit c = 0U; c < static_tissue->num_cells_along_columnar_axis(); ++c)
+            {
+                value_to_bits(++counter,dynamic_tissue->find_bits_of_cell_in_tissue(x,y,c));
+                value_to_bits(counter,dynamic_tissue->find_bits_of_signalling(x,y,c),0U,32U);
+                for (natural_32_bit i = 0U;
+                     i < static_tissue->num_synapses_in_territory_of_cell_with_columnar_coord(c);
+                     ++i)
+                    value_to_bits(counter + i,dynamic_tissue->find_bits_of_synapse_in_tissue(x,y,c,i));
+            }
+    for (natural_32_bit i = 0U; i < static_tissue->num_sensory_cells(); ++i)
+        value_to_bits(100U + i,dynamic_tissue->find_bits_of_sensory_cell(i));
+
+    boost::filesystem::path const  path =
+            boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("E2-tissue-%%%%-%%%%.checkpoint");
+    cellab::save_checkpoint_of_neural_tissue(*dynamic_tissue,path);
+    {
+        std::shared_ptr<cellab::dynamic_state_of_neural_tissue> const  loaded_tissue =
+                cellab::load_checkpoint_of_neural_tissue(path);
+        TEST_SUCCESS(loaded_tissue->get_storage_of_units() == storage_of_units);
+        TEST_SUCCESS(loaded_tissue->get_buffering_of_cells_and_signalling() == buffering);
+        TEST_SUCCESS(loaded_tissue->get_static_state_of_neural_tissue()->num_sensory_cells() ==
+                     static_tissue->num_sensory_cells());
+        TEST_SUCCESS(loaded_tissue->get_static_state_of_neural_tissue()->get_y_radius_of_cellular_neighbourhood_of_signalling(1U) ==
+                     static_tissue->get_y_radius_of_cellular_neighbourhood_of_signalling(1U));
+        TEST_SUCCESS(are_bits_of_dynamic_states_equal(*dynamic_tissue,*loaded_tissue));
+        test_dynamic_state(loaded_tissue);
+
+        // A privately mapped state can be modified without affecting the checkpoint file.
+        value_to_bits(~bits_to_value<natural_32_bit>(loaded_tissue->find_bits_of_cell_in_tissue(1U,2U,3U)),
+                      loaded_tissue->find_bits_of_cell_in_tissue(1U,2U,3U));
+        TEST_SUCCESS(!are_bits_of_dynamic_states_equal(*dynamic_tissue,*loaded_tissue));
+    }
+    {
+        std::shared_ptr<cellab::dynamic_state_of_neural_tissue> const  loaded_tissue =
+                cellab::load_checkpoint_of_neural_tissue(path,cellab::SHARED_MAPPING_OF_CHECKPOINT);
+        TEST_SUCCESS(are_bits_of_dynamic_states_equal(*dynamic_tissue,*loaded_tissue));
+
+        // A state mapped as shared writes its modifications directly to the checkpoint file.
+        value_to_bits(~bits_to_value<natural_32_bit>(loaded_tissue->find_bits_of_cell_in_tissue(1U,2U,3U)),
+                      loaded_tissue->find_bits_of_cell_in_tissue(1U,2U,3U));
+        value_to_bits(~bits_to_value<natural_32_bit>(dynamic_tissue->find_bits_of_cell_in_tissue(1U,2U,3U)),
+                      dynamic_tissue->find_bits_of_cell_in_tissue(1U,2U,3U));
+    }
+    TEST_SUCCESS(are_bits_of_dynamic_states_equal(*dynamic_tissue,*cellab::load_checkpoint_of_neural_tissue(path)));
+
+    boost::filesystem::remove(path);
+}
+
 void run()
 {
     TMPROF_BLOCK();
@@ -729,6 +964,11 @@ void run()
         }
     }
 
+    test_byte_aligned_storage_of_units();
+
+    test_checkpoint_of_neural_tissue(cellab::PACKED_UNITS,cellab::SINGLE_BUFFERED_CELLS_AND_SIGNALLING);
+    test_checkpoint_of_neural_tissue(cellab::BYTE_ALIGNED_UNITS,cellab::DOUBLE_BUFFERED_CELLS_AND_SIGNALLING);
+
     TEST_PROGRESS_HIDE();
 
     TEST_PRINT_STATISTICS();
@@ -0,0 +1,22 @@
+#include <netbench/program_info.hpp>
+
+std::string  get_program_name()
+{
+    return "netbench";
+}
+
+std::string  get_program_version()
+{
+    return "0.01";
+}
+
+std::string  get_program_description()
+{
+    return "Netbench is an E2 tool which builds a network of an experiment registered in the\n"
+           "experiment factory and runs a given number of simulation steps without any GUI. It\n"
+           "writes wall times of all phases of the construction of the network, throughput of\n"
+           "the movement of ships, mini-spiking, and spiking, and the peak resident memory of\n"
+           "the process as a JSON document. It is meant for scaling studies and for tracking\n"
+           "performance regressions between commits.\n"
+           ;
+}
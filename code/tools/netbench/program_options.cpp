@@ -0,0 +1,85 @@
+#include <netbench/program_options.hpp>
+#include <netbench/program_info.hpp>
+#include <utility/assumptions.hpp>
+#include <stdexcept>
+#include <iostream>
+
+program_options::program_options(int argc, char* argv[])
+    : vm()
+    , desc(get_program_description() + "\nUsage")
+{
+    namespace bpo = boost::program_options;
+
+    desc.add_options()
+        ("help,h","Produces this help message.")
+        ("version,v", "Prints the version string.")
+        ("list,l", "Prints names of all experiments registered in the experiment factory.")
+        ("experiment,e",
+            bpo::value<std::string>()->default_value("performance"),
+            "A name of the experiment (registered in the experiment factory) to build and to simulate.")
+        ("steps,n",
+            bpo::value<natural_64_bit>()->default_value(100ULL),
+            "A number of simulation steps to run after the network is constructed.")
+        ("threads,t",
+            bpo::value<natural_32_bit>()->default_value(0U),
+            "A number of threads the network uses. The value 0 keeps the number defined by the experiment.")
+        ("disable-queue", "Moves all ships in each step, i.e. the update queue of ships is not used.")
+        ("disable-spiking", "Simulation steps do not propagate spikes.")
+        ("disable-mini-spiking", "Simulation steps do not generate mini-spikes.")
+        ("disable-movement", "Simulation steps do not move ships.")
+        ("output,o",
+            bpo::value<std::string>()->default_value(""),
+            "A path to a file where to write the metrics in the JSON format. The metrics are written to the "
+            "standard output, if the path is empty.")
+        ("domains",
+            bpo::value<natural_32_bit>()->default_value(1U),
+            "A number of processes simulating the network together. Each of them must be started with the same "
+            "options, except the option --domain. Each process simulates one domain of the network. Domains "
+            "divide only the work; each process holds the whole network in its memory.")
+        ("domain",
+            bpo::value<natural_32_bit>()->default_value(0U),
+            "An index of the domain simulated by this process, in the range 0,...,domains-1.")
+        ("transport",
+            bpo::value<std::string>()->default_value("shared_memory"),
+            "A transport of messages between domains: 'shared_memory' or 'loopback_socket'.")
+        ("transport-name",
+            bpo::value<std::string>()->default_value("e2_netbench"),
+            "A name of the shared memory segment of the transport 'shared_memory'. It should be unique per run.")
+        ("port",
+            bpo::value<natural_32_bit>()->default_value(47000U),
+            "The port of the domain 0 of the transport 'loopback_socket'. The domain d listens on the port + d.")
+        // Specify more options here, if needed.
+        ;
+
+    bpo::positional_options_description pos_desc;
+
+    bpo::store(bpo::command_line_parser(argc,argv).allow_unregistered().
+               options(desc).positional(pos_desc).run(),vm);
+    bpo::notify(vm);
+}
+
+std::ostream& program_options::operator<<(std::ostream& ostr) const
+{
+    return ostr << desc;
+}
+
+static program_options_ptr  global_program_options;
+
+void initialise_program_options(int argc, char* argv[])
+{
+    ASSUMPTION(!global_program_options.operator bool());
+    global_program_options = program_options_ptr(new program_options(argc,argv));
+}
+
+program_options_ptr get_program_options()
+{
+    ASSUMPTION(global_program_options.operator bool());
+    return global_program_options;
+}
+
+std::ostream& operator<<(std::ostream& ostr, program_options_ptr options)
+{
+    ASSUMPTION(options.operator bool());
+    options->operator<<(ostr);
+    return ostr;
+}
@@ -0,0 +1,50 @@
+#ifndef E2_TOOL_NETBENCH_PROGRAM_OPTIONS_HPP_INCLUDED
+#   define E2_TOOL_NETBENCH_PROGRAM_OPTIONS_HPP_INCLUDED
+
+#   include <utility/basic_numeric_types.hpp>
+#   include <boost/program_options.hpp>
+#   include <boost/noncopyable.hpp>
+#   include <ostream>
+#   include <memory>
+#   include <string>
+
+class program_options : private boost::noncopyable
+{
+public:
+    program_options(int argc, char* argv[]);
+
+    bool helpMode() const { return vm.count("help") > 0; }
+    bool versionMode() const { return vm.count("version") > 0; }
+    bool listMode() const { return vm.count("list") > 0; }
+
+    std::string  experiment() const { return vm["experiment"].as<std::string>(); }
+    natural_64_bit  numSteps() const { return vm["steps"].as<natural_64_bit>(); }
+    natural_32_bit  numThreads() const { return vm["threads"].as<natural_32_bit>(); }
+    bool  useUpdateQueue() const { return vm.count("disable-queue") == 0; }
+    bool  useSpiking() const { return vm.count("disable-spiking") == 0; }
+    bool  useMiniSpiking() const { return vm.count("disable-mini-spiking") == 0; }
+    bool  useMovementOfShips() const { return vm.count("disable-movement") == 0; }
+    std::string  output() const { return vm["output"].as<std::string>(); }
+    natural_32_bit  numDomains() const { return vm["domains"].as<natural_32_bit>(); }
+    natural_32_bit  domainIndex() const { return vm["domain"].as<natural_32_bit>(); }
+    std::string  transport() const { return vm["transport"].as<std::string>(); }
+    std::string  transportName() const { return vm["transport-name"].as<std::string>(); }
+    natural_32_bit  port() const { return vm["port"].as<natural_32_bit>(); }
+
+    // Add more option access/query functions here, if needed.
+
+    std::ostream& operator<<(std::ostream& ostr) const;
+
+private:
+    boost::program_options::variables_map vm;
+    boost::program_options::options_description desc;
+};
+
+typedef std::shared_ptr<program_options const> program_options_ptr;
+
+void initialise_program_options(int argc, char* argv[]);
+program_options_ptr get_program_options();
+
+std::ostream& operator<<(std::ostream& ostr, program_options_ptr options);
+
+#endif
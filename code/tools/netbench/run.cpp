@@ -0,0 +1,351 @@
+#include <netbench/program_info.hpp>
+#include <netbench/program_options.hpp>
+#include <netexp/experiment_factory.hpp>
+#include <netlab/network.hpp>
+#include <netlab/shared_memory_transport.hpp>
+#include <netlab/loopback_socket_transport.hpp>
+#include <angeo/tensor_math.hpp>
+#include <utility/timeprof.hpp>
+#include <utility/log.hpp>
+#include <utility/msgstream.hpp>
+#include <utility/config.hpp>
+#include <utility/basic_numeric_types.hpp>
+#include <utility/assumptions.hpp>
+#include <utility/invariants.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <memory>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#if PLATFORM() == PLATFORM_WINDOWS()
+#   include <windows.h>
+#   include <psapi.h>
+#   pragma comment(lib, "psapi.lib")
+#else
+#   include <sys/resource.h>
+#endif
+
+namespace {
+
+
+float_64_bit  seconds_since(std::chrono::steady_clock::time_point const  start_time)
+{
+    return std::chrono::duration<float_64_bit>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+
+/// It returns the peak resident set size of the process in bytes.
+natural_64_bit  peak_resident_memory_in_bytes()
+{
+#if PLATFORM() == PLATFORM_WINDOWS()
+    PROCESS_MEMORY_COUNTERS  counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == 0)
+        return 0ULL;
+    return counters.PeakWorkingSetSize;
+#else
+    rusage  usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0ULL;
+    return (natural_64_bit)usage.ru_maxrss * 1024ULL;    // On Linux the value is in kilobytes.
+#endif
+}
+
+
+/**
+ * The network does not measure its phases itself. Durations of phases of simulation steps are thus taken from
+ * the time profile of the blocks (see 'TMPROF_BLOCK') in methods of the network updating individual phases.
+ * A method may contain also nested blocks, so the block with the lowest line is the one of the whole method.
+ * A negative value is returned, if the block was not measured (e.g. when time profiling is disabled).
+ */
+float_64_bit  profiled_duration_of_function_in_seconds(std::string const&  function_name)
+{
+    std::vector<time_profile_data_of_block>  profile;
+    copy_time_profile_data_of_all_measured_blocks_into_vector(profile, false);
+    time_profile_data_of_block const*  result = nullptr;
+    for (time_profile_data_of_block const&  block : profile)
+        if (block.function_name() == function_name && (result == nullptr || block.line() < result->line()))
+            result = &block;
+    return result == nullptr ? -1.0 : result->summary_duration_of_all_executions_in_seconds();
+}
+
+
+struct  phase_of_construction
+{
+    std::string  name;
+    natural_64_bit  num_calls;
+    float_64_bit  seconds;
+};
+
+
+struct  phase_of_simulation
+{
+    std::string  name;
+    std::string  name_of_work_units;
+    float_64_bit  seconds;
+    natural_64_bit  num_work_units;
+};
+
+
+void  write_number(std::ostream&  ostr, float_64_bit const  value)
+{
+    if (value < 0.0)
+        ostr << "null";
+    else
+        ostr << value;
+}
+
+
+void  write_rate(std::ostream&  ostr, float_64_bit const  count, float_64_bit const  seconds)
+{
+    write_number(ostr, seconds > 0.0 ? count / seconds : -1.0);
+}
+
+
+}
+
+
+void run(int argc, char* argv[])
+{
+    TMPROF_BLOCK();
+
+    netexp::experiment_factory&  factory = netexp::experiment_factory::instance();
+
+    if (get_program_options()->listMode())
+    {
+        std::vector<std::string>  names;
+        factory.get_names_of_registered_experiments(names);
+        for (std::string const&  name : names)
+            std::cout << name << "\n";
+        return;
+    }
+
+    std::string const  experiment = get_program_options()->experiment();
+    {
+        std::vector<std::string>  names;
+        factory.get_names_of_registered_experiments(names);
+        if (std::find(names.cbegin(), names.cend(), experiment) == names.cend())
+            throw std::runtime_error(msgstream() << "Unknown experiment '" << experiment
+                                                 << "'. Use the option --list to see all experiments.");
+    }
+
+    natural_32_bit const  num_domains = get_program_options()->numDomains();
+    natural_32_bit const  domain_index = get_program_options()->domainIndex();
+    std::string const  transport = get_program_options()->transport();
+    if (num_domains == 0U || domain_index >= num_domains)
+        throw std::runtime_error(msgstream() << "The domain index " << domain_index << " is not less than the number of domains "
+                                             << num_domains << ".");
+    if (transport != "shared_memory" && transport != "loopback_socket")
+        throw std::runtime_error(msgstream() << "Unknown transport '" << transport << "'.");
+    if (transport == "loopback_socket" && get_program_options()->port() + num_domains > 65536U)
+        throw std::runtime_error(msgstream() << "Ports of domains exceed the range of ports.");
+
+    std::shared_ptr<netlab::network_props>  props = factory.create_network_props(experiment);
+    if (get_program_options()->numThreads() != 0U)
+        props = std::make_shared<netlab::network_props>(
+                    props->layer_props(),
+                    props->update_time_step_in_seconds(),
+                    props->spiking_potential_magnitude(),
+                    props->mini_spiking_potential_magnitude(),
+                    props->average_mini_spiking_period_in_seconds(),
+                    props->max_connection_distance_in_meters(),
+                    get_program_options()->numThreads()
+                    );
+
+    // Construction of the network
+
+    std::vector<phase_of_construction>  construction_phases;
+    std::chrono::steady_clock::time_point const  construction_start_time = std::chrono::steady_clock::now();
+
+    std::unique_ptr<netlab::network>  network;
+    {
+        std::chrono::steady_clock::time_point const  start_time = std::chrono::steady_clock::now();
+        network = std::make_unique<netlab::network>(props, factory.create_network_layers_factory(experiment));
+        construction_phases.push_back({ "construction_of_layers_of_network", 1ULL, seconds_since(start_time) });
+    }
+    std::shared_ptr<netlab::initialiser_of_movement_area_centers> const  area_centers_initialiser =
+            factory.create_initialiser_of_movement_area_centers(experiment);
+    std::shared_ptr<netlab::initialiser_of_ships_in_movement_areas> const  ships_initialiser =
+            factory.create_initialiser_of_ships_in_movement_areas(experiment);
+    while (network->get_state() != netlab::NETWORK_STATE::READY_FOR_SIMULATION_STEP)
+    {
+        std::string  name_of_phase;
+        std::chrono::steady_clock::time_point const  start_time = std::chrono::steady_clock::now();
+        switch (network->get_state())
+        {
+        case netlab::NETWORK_STATE::READY_FOR_MOVEMENT_AREA_CENTERS_INITIALISATION:
+            name_of_phase = "initialise_movement_area_centers";
+            network->initialise_movement_area_centers(*area_centers_initialiser);
+            break;
+        case netlab::NETWORK_STATE::READY_FOR_MOVEMENT_AREA_CENTERS_MIGRATION_STARTUP:
+            name_of_phase = "prepare_for_movement_area_centers_migration";
+            network->prepare_for_movement_area_centers_migration(*area_centers_initialiser);
+            break;
+        case netlab::NETWORK_STATE::READY_FOR_MOVEMENT_AREA_CENTERS_MIGRATION_STEP:
+            name_of_phase = "do_movement_area_centers_migration_step";
+            network->do_movement_area_centers_migration_step(*area_centers_initialiser);
+            break;
+        case netlab::NETWORK_STATE::READY_FOR_COMPUTATION_OF_SHIP_DENSITIES_IN_LAYERS:
+            name_of_phase = "compute_densities_of_ships_in_layers";
+            network->compute_densities_of_ships_in_layers();
+            break;
+        case netlab::NETWORK_STATE::READY_FOR_LUNCHING_SHIPS_INTO_MOVEMENT_AREAS:
+            name_of_phase = "lunch_ships_into_movement_areas";
+            network->lunch_ships_into_movement_areas(*ships_initialiser);
+            break;
+        case netlab::NETWORK_STATE::READY_FOR_INITIALISATION_OF_MAP_FROM_DOCK_SECTORS_TO_SHIPS:
+            name_of_phase = "initialise_map_from_dock_sectors_to_ships";
+            network->initialise_map_from_dock_sectors_to_ships();
+            break;
+        default:
+            UNREACHABLE();
+        }
+        float_64_bit const  seconds = seconds_since(start_time);
+        if (construction_phases.back().name == name_of_phase)
+        {
+            ++construction_phases.back().num_calls;
+            construction_phases.back().seconds += seconds;
+        }
+        else
+            construction_phases.push_back({ name_of_phase, 1ULL, seconds });
+    }
+
+    if (num_domains > 1U)
+    {
+        std::chrono::steady_clock::time_point const  start_time = std::chrono::steady_clock::now();
+        std::shared_ptr<netlab::transport_between_domains>  transport_between_domains;
+        if (transport == "shared_memory")
+            transport_between_domains = std::make_shared<netlab::shared_memory_transport>(
+                    get_program_options()->transportName(), num_domains, domain_index);
+        else
+            transport_between_domains = std::make_shared<netlab::loopback_socket_transport>(
+                    (natural_16_bit)get_program_options()->port(), num_domains, domain_index);
+        network->split_into_domains(transport_between_domains);
+        construction_phases.push_back({ "split_into_domains", 1ULL, seconds_since(start_time) });
+    }
+
+    float_64_bit const  construction_seconds = seconds_since(construction_start_time);
+
+    // Simulation steps
+
+    natural_64_bit  num_ships_with_controllers = 0ULL;
+    for (netlab::network_layer_props const&  layer_props : props->layer_props())
+        if (layer_props.ship_controller_ptr() != nullptr)
+            num_ships_with_controllers += layer_props.num_ships();
+
+    network->enable_usage_of_queues_in_update_of_ships(get_program_options()->useUpdateQueue());
+
+    std::vector<phase_of_simulation>  simulation_phases{
+        { "movement_of_ships", "ships", 0.0, 0ULL },
+        { "mini_spiking", "mini_spikes", 0.0, 0ULL },
+        { "spiking", "spikes", 0.0, 0ULL },
+    };
+    std::vector<std::string> const  profiled_functions{ "update_movement_of_ships", "update_mini_spiking", "update_spiking" };
+    std::vector<bool> const  are_phases_used{
+        get_program_options()->useMovementOfShips(),
+        get_program_options()->useMiniSpiking(),
+        get_program_options()->useSpiking()
+    };
+    for (natural_32_bit  i = 0U; i != simulation_phases.size(); ++i)
+        simulation_phases.at(i).seconds = profiled_duration_of_function_in_seconds(profiled_functions.at(i));
+
+    natural_64_bit const  num_steps = get_program_options()->numSteps();
+    std::chrono::steady_clock::time_point const  simulation_start_time = std::chrono::steady_clock::now();
+    for (natural_64_bit  step = 0ULL; step != num_steps; ++step)
+    {
+        if (are_phases_used.at(0))
+            simulation_phases.at(0).num_work_units += network->is_update_queue_of_ships_used() ?
+                                                            network->size_of_update_queue_of_ships() :
+                                                      network->is_split_into_domains() ?
+                                                            network->get_domain()->num_owned_ships_with_controllers() :
+                                                            num_ships_with_controllers;
+        if (are_phases_used.at(2))
+            simulation_phases.at(2).num_work_units += network->num_spikers_to_spike_in_next_update();
+
+        network->do_simulation_step(are_phases_used.at(2), are_phases_used.at(1), are_phases_used.at(0));
+
+        simulation_phases.at(1).num_work_units += network->num_mini_spikes_in_last_update();
+    }
+    float_64_bit const  simulation_seconds = seconds_since(simulation_start_time);
+
+    for (natural_32_bit  i = 0U; i != simulation_phases.size(); ++i)
+    {
+        float_64_bit const  seconds_before = simulation_phases.at(i).seconds;
+        float_64_bit const  seconds_after = profiled_duration_of_function_in_seconds(profiled_functions.at(i));
+        simulation_phases.at(i).seconds = seconds_after < 0.0 ? -1.0 : seconds_after - std::max(seconds_before, 0.0);
+    }
+
+    // Writing of metrics
+
+    boost::filesystem::ofstream  file;
+    if (!get_program_options()->output().empty())
+    {
+        file.open(get_program_options()->output());
+        if (!file.good())
+            throw std::runtime_error(msgstream() << "Cannot open the output file '" << get_program_options()->output() << "'.");
+    }
+    std::ostream&  ostr = get_program_options()->output().empty() ? std::cout : file;
+
+    ostr << std::setprecision(9)
+         << "{\n"
+         << "    \"program\": \"" << get_program_name() << "\",\n"
+         << "    \"version\": \"" << get_program_version() << "\",\n"
+         << "    \"experiment\": \"" << experiment << "\",\n"
+         << "    \"num_threads\": " << props->num_threads_to_use() << ",\n"
+         << "    \"num_domains\": " << num_domains << ",\n"
+         << "    \"domain_index\": " << domain_index << ",\n"
+         << "    \"transport\": " << (num_domains > 1U ? "\"" + transport + "\"" : std::string("null")) << ",\n"
+         << "    \"num_steps\": " << num_steps << ",\n"
+         << "    \"use_update_queue_of_ships\": " << (get_program_options()->useUpdateQueue() ? "true" : "false") << ",\n"
+         << "    \"network\": {\n"
+         << "        \"num_layers\": " << props->layer_props().size() << ",\n"
+         << "        \"num_spikers\": " << props->num_spikers() << ",\n"
+         << "        \"num_docks\": " << props->num_docks() << ",\n"
+         << "        \"num_ships\": " << props->num_ships() << "\n"
+         << "    },\n"
+         << "    \"construction\": {\n"
+         << "        \"seconds\": " << construction_seconds << ",\n"
+         << "        \"phases\": [\n"
+         ;
+    for (natural_32_bit  i = 0U; i != construction_phases.size(); ++i)
+        ostr << "            { \"name\": \"" << construction_phases.at(i).name << "\""
+             << ", \"num_calls\": " << construction_phases.at(i).num_calls
+             << ", \"seconds\": " << construction_phases.at(i).seconds
+             << " }" << (i + 1U == construction_phases.size() ? "\n" : ",\n");
+    ostr << "        ]\n"
+         << "    },\n"
+         << "    \"simulation\": {\n"
+         << "        \"seconds\": " << simulation_seconds << ",\n"
+         << "        \"steps_per_second\": "
+         ;
+    write_rate(ostr, (float_64_bit)num_steps, simulation_seconds);
+    ostr << ",\n"
+         << "        \"phases\": [\n"
+         ;
+    for (natural_32_bit  i = 0U; i != simulation_phases.size(); ++i)
+    {
+        phase_of_simulation const&  phase = simulation_phases.at(i);
+        bool const  is_used = are_phases_used.at(i);
+        ostr << "            { \"name\": \"" << phase.name << "\""
+             << ", \"enabled\": " << (is_used ? "true" : "false")
+             << ", \"seconds\": ";
+        write_number(ostr, phase.seconds);
+        ostr << ", \"steps_per_second\": ";
+        write_rate(ostr, is_used ? (float_64_bit)num_steps : -1.0, phase.seconds);
+        ostr << ", \"" << phase.name_of_work_units << "\": " << phase.num_work_units
+             << ", \"" << phase.name_of_work_units << "_per_second\": ";
+        write_rate(ostr, is_used ? (float_64_bit)phase.num_work_units : -1.0, phase.seconds);
+        ostr << " }" << (i + 1U == simulation_phases.size() ? "\n" : ",\n");
+    }
+    ostr << "        ]\n"
+         << "    },\n"
+         << "    \"peak_resident_memory_in_bytes\": " << peak_resident_memory_in_bytes() << "\n"
+         << "}\n"
+         ;
+
+    if (ostr.bad())
+        throw std::runtime_error(msgstream() << "Cannot write the metrics to the output.");
+}
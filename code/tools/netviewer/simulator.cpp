@@ -1445,9 +1445,8 @@ std::string  simulator::get_network_info_text() const
     natural_64_bit  total_memory_docks = 0ULL;
     natural_64_bit  total_memory_ships = 0ULL;
     natural_64_bit  total_memory_movement_area_centers = 0ULL;
-    natural_64_bit  total_memory_index_of_ships_in_sectors = 0ULL;
-    natural_64_bit  total_max_memory_of_update_queues_of_ships =
-            network()->max_size_of_update_queue_of_ships() * sizeof(netlab::network::element_type_in_update_queue_of_ships);
+    natural_64_bit  total_memory_index_of_ships_in_sectors = network()->get_ships_in_dock_sectors().num_bytes();
+    natural_64_bit  total_max_memory_of_update_queues_of_ships = network()->get_update_queue_of_ships().num_bytes();
     for (netlab::layer_index_type layer_index = 0U; layer_index != props.layer_props().size(); ++layer_index)
     {
         netlab::network_layer_props const&  layer_props = props.layer_props().at(layer_index);
@@ -1465,8 +1464,6 @@ std::string  simulator::get_network_info_text() const
                 network()->get_layer_of_ships(layer_index).num_extra_bytes_per_ship()
                 );
         total_memory_movement_area_centers += layer_props.num_spikers() * sizeof(vector3);
-        total_memory_index_of_ships_in_sectors += layer_props.num_docks() *
-                                                  3ULL * sizeof(netlab::compressed_layer_and_object_indices);
 
     }
     natural_64_bit  total_memory =
@@ -1903,17 +1900,13 @@ std::string  simulator::get_network_performance_text() const
 
     if (network()->is_update_queue_of_ships_used())
     {
-        ostr << "Update queue of ships: ";
-        if (network()->is_update_queue_of_ships_overloaded())
-            ostr << "OVERLOADED! (=> all ships are simulated)";
-        else
-            ostr << network()->size_of_update_queue_of_ships() << " / "
-                    << network()->max_size_of_update_queue_of_ships() << " (~"
-                    << percentage_string(network()->size_of_update_queue_of_ships(),
-                                        network()->max_size_of_update_queue_of_ships())
-                    << "%)"
-                    ;
-        ostr << "\n";
+        ostr << "Update queue of ships (awake ships): "
+             << network()->size_of_update_queue_of_ships() << " / "
+             << network()->max_size_of_update_queue_of_ships() << " (~"
+             << percentage_string(network()->size_of_update_queue_of_ships(),
+                                  network()->max_size_of_update_queue_of_ships())
+             << "%)\n"
+             ;
     }
     else
         ostr << "Update queue of ships is NOT used.\n"
@@ -4,19 +4,50 @@
 #   include <utility/basic_numeric_types.hpp>
 #   include <utility/bits_reference.hpp>
 #   include <boost/noncopyable.hpp>
-#   include <boost/scoped_array.hpp>
+#   include <functional>
+#   include <memory>
+
+
+/**
+ * A source of memory for bits of units of an array. It receives a number of bytes the array needs
+ * and it returns a pointer to (at least) that many bytes. The array shares ownership of the memory
+ * through the returned pointer, so the memory can be a part of a bigger block (e.g. a region of
+ * a memory-mapped file), which is released only when all arrays in it are destroyed.
+ */
+using  memory_provider_for_array_of_bit_units = std::function<std::shared_ptr<natural_8_bit>(natural_64_bit)>;
 
 
 struct array_of_bit_units : private boost::noncopyable
 {
-    array_of_bit_units(natural_16_bit const num_bits_per_unit, natural_64_bit const num_units);
+    /**
+     * If 'align_units_to_bytes' is true, then each unit starts at a byte boundary (i.e. each unit
+     * occupies the lowest number of whole bytes which can store 'num_bits_per_unit' bits). So,
+     * returned bits references always have zero shift in the first byte, and if 'num_bits_per_unit'
+     * is 8*sizeof(T) for some plain type T, then units can directly be accessed as instances of T.
+     *
+     * If 'memory_provider' is empty, then the memory for units is allocated on the heap. Otherwise,
+     * the memory is obtained from the provider. The memory is NOT initialised in either case.
+     */
+    array_of_bit_units(natural_16_bit const num_bits_per_unit, natural_64_bit const num_units,
+                       bool const align_units_to_bytes = false,
+                       memory_provider_for_array_of_bit_units const& memory_provider =
+                            memory_provider_for_array_of_bit_units());
     bits_reference find_bits_of_unit(natural_64_bit const index_of_unit);
     natural_16_bit num_bits_per_unit() const;
     natural_64_bit num_units() const;
+    bool are_units_aligned_to_bytes() const;
+
+    /**
+     * These two methods give a raw access to the whole memory of the array. They are
+     * useful for copying the array verbatim (e.g. into a file).
+     */
+    natural_64_bit num_bytes() const;
+    natural_8_bit const* data() const;
 private:
     natural_64_bit m_num_bits_per_unit;
+    natural_64_bit m_num_bits_between_units;    //!< Equals 'm_num_bits_per_unit', unless units are aligned to bytes.
     natural_64_bit m_num_units;
-    boost::scoped_array<natural_8_bit> m_bits_of_all_units;
+    std::shared_ptr<natural_8_bit> m_bits_of_all_units;
 };
 
 
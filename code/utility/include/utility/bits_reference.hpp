@@ -4,6 +4,8 @@
 #   include <utility/basic_numeric_types.hpp>
 #   include <utility/bit_count.hpp>
 #   include <utility/assumptions.hpp>
+#   include <type_traits>
+#   include <cstdint>
 
 
 struct bits_reference;
@@ -98,6 +100,7 @@ bool  get_bit(bits_reference const& bits_ref, natural_16_bit const bit_index);
 bool  get_bit(bits_const_reference const& bits_ref, natural_16_bit const bit_index);
 void  set_bit(bits_reference& bits_ref, natural_16_bit const bit_index, bool const value);
 void  swap_referenced_bits( bits_reference& left_bits, bits_reference& right_bits);
+void  copy_referenced_bits(bits_const_reference const& source_bits, bits_reference& target_bits);
 
 void  bits_to_value(
     bits_reference const& source_bits,
@@ -149,5 +152,30 @@ void value_to_bits(
     bits_reference const& target_bits
     );
 
+/**
+ * If referenced bits start at a byte boundary, their count is 8*sizeof(T), and their first byte is
+ * properly aligned for T, then the referenced memory can be accessed directly as an instance of
+ * a plain type T (i.e. without any packing/unpacking of the value from/to the bits).
+ */
+template<typename T>
+T&  reinterpret_bits_as(bits_reference const& bits_ref)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only plain types can be stored in referenced bits.");
+    ASSUMPTION(bits_ref.shift_in_the_first_byte() == 0U);
+    ASSUMPTION(bits_ref.num_bits() == 8U * sizeof(T));
+    ASSUMPTION(reinterpret_cast<std::uintptr_t>(bits_ref.first_byte_ptr()) % alignof(T) == 0U);
+    return *reinterpret_cast<T*>(const_cast<natural_8_bit*>(bits_ref.first_byte_ptr()));
+}
+
+template<typename T>
+T const&  reinterpret_bits_as(bits_const_reference const& bits_ref)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only plain types can be stored in referenced bits.");
+    ASSUMPTION(bits_ref.shift_in_the_first_byte() == 0U);
+    ASSUMPTION(bits_ref.num_bits() == 8U * sizeof(T));
+    ASSUMPTION(reinterpret_cast<std::uintptr_t>(bits_ref.first_byte_ptr()) % alignof(T) == 0U);
+    return *reinterpret_cast<T const*>(bits_ref.first_byte_ptr());
+}
+
 
 #endif
@@ -50,6 +50,110 @@ void  reset(random_generator_for_natural_64_bit&  generator,
             natural_64_bit const  seed = random_generator_for_natural_64_bit::default_seed);
 
 
+/**
+ * A counter-based generator (Philox4x32-10 of Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+ * Each output block of four numbers is a pure function of a key and a counter. The key is the seed, while
+ * the counter consists of an index of the block and an identifier of a stream. So, streams for any pair
+ * (step, substream) can be created independently in any order, in any thread, and they never overlap. The
+ * substream is typically an index of a cell (or of any other object processed by a parallel algorithm), or
+ * an index of a thread. When streams are keyed by objects (not threads), results of a parallel algorithm
+ * do not depend on the number of threads used.
+ *
+ * The generator satisfies the UniformRandomBitGenerator requirements, so it can be passed to distributions
+ * of the standard library. Nevertheless, functions below dedicated to this generator map outputs to ranges
+ * by a fixed arithmetic, so their results are identical on all platforms.
+ */
+struct  counter_based_random_generator
+{
+    using  result_type = natural_32_bit;
+
+    explicit counter_based_random_generator(
+            natural_64_bit const  seed = 0ULL,
+            natural_32_bit const  step = 0U,
+            natural_64_bit const  substream = 0ULL
+            );
+
+    static constexpr result_type  min() { return 0U; }
+    static constexpr result_type  max() { return 0xffffffffU; }
+
+    result_type  operator()()
+    {
+        if (m_index_in_block == 4U)
+            generate_next_block();
+        return m_block[m_index_in_block++];
+    }
+
+    /// Returns a generator of a different stream with the same seed.
+    counter_based_random_generator  split(natural_32_bit const  step, natural_64_bit const  substream) const
+    { return counter_based_random_generator(seed(), step, substream); }
+
+    natural_64_bit  seed() const { return ((natural_64_bit)m_key[1] << 32U) | (natural_64_bit)m_key[0]; }
+
+    /// Writes the next [end - begin] numbers of the stream to the passed range. The result is
+    /// the same as calling the operator () repeatedly, but whole blocks are written directly.
+    void  fill(natural_32_bit*  begin, natural_32_bit* const  end);
+
+    /// Writes numbers uniformly distributed in [0,1) (they have 24 random bits each) to the passed range.
+    void  fill(float_32_bit*  begin, float_32_bit* const  end);
+
+private:
+    void  generate_next_block();
+
+    natural_32_bit  m_key[2];
+    natural_32_bit  m_counter[4];   //!< The index of the next block followed by the step and the substream.
+    natural_32_bit  m_block[4];
+    natural_32_bit  m_index_in_block;
+};
+
+/**
+ * Philox4x32-10 bijection of the passed counter under the passed key. Exposed for (known-answer) testing.
+ */
+void  philox_4x32_10(natural_32_bit const  key[2], natural_32_bit const  counter[4], natural_32_bit  output[4]);
+
+natural_32_bit  get_random_natural_32_bit_in_range(
+    natural_32_bit const min_value,
+    natural_32_bit const max_value,
+    counter_based_random_generator&   generator
+    );
+
+float_32_bit  get_random_float_32_bit_in_range(
+    float_32_bit const min_value,
+    float_32_bit const max_value,
+    counter_based_random_generator&   generator
+    );
+
+natural_64_bit  get_random_natural_64_bit_in_range(
+    natural_64_bit const  min_value,
+    natural_64_bit const  max_value,
+    counter_based_random_generator&  generator
+    );
+
+/// Batched versions of the functions above. They fill the passed range by the next numbers of the generator.
+void  fill_by_random_natural_32_bit_in_range(
+    natural_32_bit*  begin,
+    natural_32_bit* const  end,
+    natural_32_bit const min_value,
+    natural_32_bit const max_value,
+    counter_based_random_generator&   generator
+    );
+
+void  fill_by_random_float_32_bit_in_range(
+    float_32_bit*  begin,
+    float_32_bit* const  end,
+    float_32_bit const min_value,
+    float_32_bit const max_value,
+    counter_based_random_generator&   generator
+    );
+
+void  fill_by_random_natural_64_bit_in_range(
+    natural_64_bit*  begin,
+    natural_64_bit* const  end,
+    natural_64_bit const  min_value,
+    natural_64_bit const  max_value,
+    counter_based_random_generator&  generator
+    );
+
+
 using  bar_random_distribution = std::vector<float_32_bit>;
 
 inline natural_32_bit  get_num_bars(bar_random_distribution const&  bar_distribution)
@@ -70,6 +174,11 @@ natural_32_bit  get_random_bar_index(
     random_generator_for_natural_32_bit&   generator
     );
 
+natural_32_bit  get_random_bar_index(
+    bar_random_distribution const&  bar_distribution,
+    counter_based_random_generator&   generator
+    );
+
 
 /// It is completely specified by a function which does whole the computation.
 /// It can be any non-decreasing function mapping interval [0,1] to interval [0,1].
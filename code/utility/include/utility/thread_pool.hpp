@@ -0,0 +1,63 @@
+#ifndef UTILITY_THREAD_POOL_HPP_INCLUDED
+#   define UTILITY_THREAD_POOL_HPP_INCLUDED
+
+#   include <utility/basic_numeric_types.hpp>
+#   include <boost/noncopyable.hpp>
+#   include <functional>
+#   include <exception>
+#   include <vector>
+#   include <thread>
+#   include <mutex>
+#   include <condition_variable>
+
+
+/**
+ * It is a fixed set of worker threads which are created once (in the constructor) and then
+ * they are reused for any number of parallel computations. Between computations the workers
+ * are parked on a condition variable, so they do not consume any CPU time. A computation is
+ * started by the method 'run_and_wait'. The calling thread always participates in the
+ * computation (it executes the task of the index 0), so a pool with N workers can run a
+ * computation on up to N+1 threads. The method returns only after all threads finished
+ * their tasks (i.e. all threads meet at a barrier), and so the workers are immediately
+ * available for the next computation.
+ *
+ * The pool is NOT re-entrant: 'run_and_wait' must not be called concurrently from several
+ * threads, nor from inside of a task running in the pool.
+ */
+struct thread_pool : private boost::noncopyable
+{
+    using  task_type = std::function<void(natural_32_bit)>;
+                    //!< A task receives an index of the thread it runs in. The index is always
+                    //!< in the range 0,...,num_threads-1, where 'num_threads' is the value passed
+                    //!< to 'run_and_wait'.
+
+    explicit thread_pool(natural_32_bit const num_workers);
+    ~thread_pool();
+
+    natural_32_bit  num_workers() const { return (natural_32_bit)m_workers.size(); }
+
+    /**
+     * It calls 'task' exactly 'num_threads' times in parallel, each time with a different thread
+     * index. The index 0 is always processed by the calling thread. It is required that
+     * 1 <= num_threads <= num_workers() + 1. If any task throws an exception, then the method
+     * rethrows the first caught exception once all tasks are finished.
+     */
+    void  run_and_wait(natural_32_bit const  num_threads, task_type const&  task);
+
+private:
+    void  worker(natural_32_bit const  worker_index);
+
+    std::vector<std::thread>  m_workers;
+    std::mutex  m_mutex;
+    std::condition_variable  m_start_condition;
+    std::condition_variable  m_finish_condition;
+    task_type const*  m_task;
+    natural_32_bit  m_num_active_workers;
+    natural_32_bit  m_num_unfinished_workers;
+    natural_64_bit  m_generation;
+    bool  m_terminate;
+    std::exception_ptr  m_exception;
+};
+
+
+#endif
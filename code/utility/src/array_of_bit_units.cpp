@@ -13,25 +13,35 @@ natural_64_bit compute_num_bits_of_all_array_units_with_checked_operations(natur
 }
 
 
-array_of_bit_units::array_of_bit_units(natural_16_bit const num_bits_per_unit,natural_64_bit const num_units)
+array_of_bit_units::array_of_bit_units(natural_16_bit const num_bits_per_unit,natural_64_bit const num_units,
+                                       bool const align_units_to_bytes,
+                                       memory_provider_for_array_of_bit_units const& memory_provider)
     : m_num_bits_per_unit(num_bits_per_unit)
+    , m_num_bits_between_units(align_units_to_bytes ? 8ULL * num_bytes_to_store_bits(num_bits_per_unit) :
+                                                      m_num_bits_per_unit)
     , m_num_units(num_units)
-    , m_bits_of_all_units(
-        new natural_8_bit[
-            num_bytes_to_store_bits(
-                compute_num_bits_of_all_array_units_with_checked_operations((natural_16_bit)m_num_bits_per_unit,m_num_units))
-            ]
-        )
+    , m_bits_of_all_units()
 {
     ASSUMPTION(m_num_bits_per_unit > 0U);
     ASSUMPTION(m_num_units > 0U);
+
+    natural_64_bit const  num_bytes_of_all_units =
+            num_bytes_to_store_bits(
+                compute_num_bits_of_all_array_units_with_checked_operations((natural_16_bit)m_num_bits_between_units,
+                                                                            m_num_units));
+    if (memory_provider)
+        m_bits_of_all_units = memory_provider(num_bytes_of_all_units);
+    else
+        m_bits_of_all_units = std::shared_ptr<natural_8_bit>(new natural_8_bit[num_bytes_of_all_units],
+                                                             std::default_delete<natural_8_bit[]>());
+    ASSUMPTION(m_bits_of_all_units.get() != nullptr);
 }
 
 bits_reference array_of_bit_units::find_bits_of_unit(natural_64_bit const index_of_unit)
 {
     ASSUMPTION(index_of_unit < m_num_units);
-    natural_64_bit const first_bit_index = index_of_unit * m_num_bits_per_unit;
-    return bits_reference(&m_bits_of_all_units[first_bit_index >> 3U],
+    natural_64_bit const first_bit_index = index_of_unit * m_num_bits_between_units;
+    return bits_reference(m_bits_of_all_units.get() + (first_bit_index >> 3U),
                           first_bit_index & 7U,
                           (natural_16_bit)m_num_bits_per_unit);
 }
@@ -45,3 +55,18 @@ natural_64_bit  array_of_bit_units::num_units() const
 {
     return m_num_units;
 }
+
+bool  array_of_bit_units::are_units_aligned_to_bytes() const
+{
+    return m_num_bits_between_units % 8ULL == 0ULL;
+}
+
+natural_64_bit  array_of_bit_units::num_bytes() const
+{
+    return num_bytes_to_store_bits(m_num_bits_between_units * m_num_units);
+}
+
+natural_8_bit const*  array_of_bit_units::data() const
+{
+    return m_bits_of_all_units.get();
+}
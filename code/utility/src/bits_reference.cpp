@@ -1,6 +1,5 @@
 #include <utility/bits_reference.hpp>
 #include <utility/assumptions.hpp>
-#include <utility/endian.hpp>
 #include <utility/checked_number_operations.hpp>
 #include <algorithm>
 
@@ -22,6 +21,54 @@ static void write_bit(natural_8_bit* first_byte_ptr, natural_16_bit bit_index, b
         first_byte_ptr[byte_index] &= ~bit_mask;
 }
 
+/**
+ * Bits of a byte are referenced from the most significant one (i.e. the bit of the index 0 is the
+ * bit 0x80). However, when bits are transfered to/from a value, then the bit of the index 0 is the
+ * least significant bit of the value. The function below converts the order of bits in a byte
+ * between these two conventions. It allows us to assemble up to 8 consecutive bytes into a single
+ * 64-bit number, where the bit of the index i in the referenced memory is the i-th least significant
+ * bit of the number. So, a read/write of up to 57 bits is then only a shift and a mask.
+ */
+static natural_8_bit reverse_bits_in_byte(natural_8_bit byte)
+{
+    byte = (natural_8_bit)(((byte & 0xF0U) >> 4U) | ((byte & 0x0FU) << 4U));
+    byte = (natural_8_bit)(((byte & 0xCCU) >> 2U) | ((byte & 0x33U) << 2U));
+    byte = (natural_8_bit)(((byte & 0xAAU) >> 1U) | ((byte & 0x55U) << 1U));
+    return byte;
+}
+
+static natural_64_bit read_bits(natural_8_bit const* first_byte_ptr, natural_32_bit bit_index, natural_8_bit const num_bits)
+{
+    ASSUMPTION(num_bits <= 57U);
+    if (num_bits == 0U)
+        return 0ULL;
+    natural_8_bit const* const bytes = first_byte_ptr + (bit_index >> 3U);
+    natural_8_bit const shift = (natural_8_bit)(bit_index & 7U);
+    natural_8_bit const num_bytes = (natural_8_bit)((shift + num_bits + 7U) >> 3U);
+    natural_64_bit word = 0ULL;
+    for (natural_8_bit i = 0U; i < num_bytes; ++i)
+        word |= (natural_64_bit)reverse_bits_in_byte(bytes[i]) << (8U * i);
+    return (word >> shift) & (((natural_64_bit)1ULL << num_bits) - 1ULL);
+}
+
+static void write_bits(natural_8_bit* first_byte_ptr, natural_32_bit bit_index, natural_8_bit const num_bits,
+                       natural_64_bit const value)
+{
+    ASSUMPTION(num_bits <= 57U);
+    if (num_bits == 0U)
+        return;
+    natural_8_bit* const bytes = first_byte_ptr + (bit_index >> 3U);
+    natural_8_bit const shift = (natural_8_bit)(bit_index & 7U);
+    natural_8_bit const num_bytes = (natural_8_bit)((shift + num_bits + 7U) >> 3U);
+    natural_64_bit const mask = ((((natural_64_bit)1ULL << num_bits) - 1ULL) << shift);
+    natural_64_bit word = 0ULL;
+    for (natural_8_bit i = 0U; i < num_bytes; ++i)
+        word |= (natural_64_bit)reverse_bits_in_byte(bytes[i]) << (8U * i);
+    word = (word & ~mask) | ((value << shift) & mask);
+    for (natural_8_bit i = 0U; i < num_bytes; ++i)
+        bytes[i] = reverse_bits_in_byte((natural_8_bit)(word >> (8U * i)));
+}
+
 
 namespace private_internal_implementation_details {
 
@@ -90,12 +137,80 @@ static void  swap_referenced_bits( bits_reference_impl& left_bits, bits_referenc
 {
     ASSUMPTION(left_bits.num_bits() == right_bits.num_bits());
 
-    for (natural_16_bit i = 0U; i < left_bits.num_bits(); ++i)
+    natural_32_bit const num_bits = left_bits.num_bits();
+    natural_8_bit* const left_ptr = left_bits.first_byte_ptr();
+    natural_8_bit* const right_ptr = right_bits.first_byte_ptr();
+    natural_8_bit const shift = left_bits.shift_in_the_first_byte();
+
+    if (shift == right_bits.shift_in_the_first_byte())
     {
-        bool const left_ith_bit = get_bit(left_bits,i);
-        bool const right_ith_bit = get_bit(right_bits,i);
-        set_bit(left_bits,i,right_ith_bit);
-        set_bit(right_bits,i,left_ith_bit);
+        // Both references have the same alignment, so all whole bytes in the middle
+        // are swapped directly and only the partial bytes at the ends are masked.
+        natural_32_bit const num_head_bits = std::min(num_bits, (8U - shift) % 8U);
+        natural_32_bit const num_body_bytes = (num_bits - num_head_bits) >> 3U;
+        natural_32_bit const num_tail_bits = (num_bits - num_head_bits) & 7U;
+
+        natural_64_bit const left_head = read_bits(left_ptr,shift,(natural_8_bit)num_head_bits);
+        write_bits(left_ptr,shift,(natural_8_bit)num_head_bits,read_bits(right_ptr,shift,(natural_8_bit)num_head_bits));
+        write_bits(right_ptr,shift,(natural_8_bit)num_head_bits,left_head);
+
+        natural_32_bit const body_byte_index = (shift + num_head_bits) >> 3U;
+        std::swap_ranges(left_ptr + body_byte_index,
+                         left_ptr + body_byte_index + num_body_bytes,
+                         right_ptr + body_byte_index);
+
+        natural_32_bit const tail_bit_index = (body_byte_index + num_body_bytes) << 3U;
+        natural_64_bit const left_tail = read_bits(left_ptr,tail_bit_index,(natural_8_bit)num_tail_bits);
+        write_bits(left_ptr,tail_bit_index,(natural_8_bit)num_tail_bits,
+                   read_bits(right_ptr,tail_bit_index,(natural_8_bit)num_tail_bits));
+        write_bits(right_ptr,tail_bit_index,(natural_8_bit)num_tail_bits,left_tail);
+        return;
+    }
+
+    natural_32_bit const right_shift = right_bits.shift_in_the_first_byte();
+    for (natural_32_bit i = 0U; i < num_bits; i += 56U)
+    {
+        natural_8_bit const num_bits_in_chunk = (natural_8_bit)std::min(56U, num_bits - i);
+        natural_64_bit const left_chunk = read_bits(left_ptr,shift + i,num_bits_in_chunk);
+        write_bits(left_ptr,shift + i,num_bits_in_chunk,read_bits(right_ptr,right_shift + i,num_bits_in_chunk));
+        write_bits(right_ptr,right_shift + i,num_bits_in_chunk,left_chunk);
+    }
+}
+
+static void  copy_referenced_bits(bits_reference_impl const& source_bits, bits_reference_impl& target_bits)
+{
+    ASSUMPTION(source_bits.num_bits() == target_bits.num_bits());
+
+    natural_32_bit const num_bits = source_bits.num_bits();
+    natural_8_bit const* const source_ptr = source_bits.first_byte_ptr();
+    natural_8_bit* const target_ptr = target_bits.first_byte_ptr();
+    natural_8_bit const shift = source_bits.shift_in_the_first_byte();
+
+    if (shift == target_bits.shift_in_the_first_byte())
+    {
+        // The same alignment: whole bytes in the middle are copied directly.
+        natural_32_bit const num_head_bits = std::min(num_bits, (8U - shift) % 8U);
+        natural_32_bit const num_body_bytes = (num_bits - num_head_bits) >> 3U;
+        natural_32_bit const num_tail_bits = (num_bits - num_head_bits) & 7U;
+
+        write_bits(target_ptr,shift,(natural_8_bit)num_head_bits,read_bits(source_ptr,shift,(natural_8_bit)num_head_bits));
+
+        natural_32_bit const body_byte_index = (shift + num_head_bits) >> 3U;
+        std::copy(source_ptr + body_byte_index,
+                  source_ptr + body_byte_index + num_body_bytes,
+                  target_ptr + body_byte_index);
+
+        natural_32_bit const tail_bit_index = (body_byte_index + num_body_bytes) << 3U;
+        write_bits(target_ptr,tail_bit_index,(natural_8_bit)num_tail_bits,
+                   read_bits(source_ptr,tail_bit_index,(natural_8_bit)num_tail_bits));
+        return;
+    }
+
+    natural_32_bit const target_shift = target_bits.shift_in_the_first_byte();
+    for (natural_32_bit i = 0U; i < num_bits; i += 56U)
+    {
+        natural_8_bit const num_bits_in_chunk = (natural_8_bit)std::min(56U, num_bits - i);
+        write_bits(target_ptr,target_shift + i,num_bits_in_chunk,read_bits(source_ptr,shift + i,num_bits_in_chunk));
     }
 }
 
@@ -109,33 +224,11 @@ static void bits_to_value(
     ASSUMPTION( natural_16_bit(index_of_start_bit) +  how_many_bits <= source_bits.num_bits() );
     ASSUMPTION( how_many_bits <= sizeof(variable_where_the_value_will_be_stored) * 8U );
 
-    variable_where_the_value_will_be_stored = 0U;
-
-    natural_8_bit* const target_memory = reinterpret_cast<natural_8_bit*>(
-        &variable_where_the_value_will_be_stored
-        );
-
-    bits_reference_impl target_bits(
-        target_memory,
-        0,
-        sizeof(variable_where_the_value_will_be_stored) * 8U
+    variable_where_the_value_will_be_stored = (natural_32_bit)read_bits(
+        source_bits.first_byte_ptr(),
+        (natural_32_bit)source_bits.shift_in_the_first_byte() + index_of_start_bit,
+        how_many_bits
         );
-
-    for (natural_16_bit i = 0; i < how_many_bits; ++i)
-        set_bit(
-            target_bits,
-            target_bits.num_bits() - 1U - i,
-            get_bit(
-                source_bits,
-                index_of_start_bit + i
-                )
-            );
-
-    if (is_this_little_endian_machine())
-        std::reverse(
-            target_memory,
-            target_memory + sizeof(variable_where_the_value_will_be_stored)
-            );
 }
 
 static void value_to_bits(
@@ -148,31 +241,12 @@ static void value_to_bits(
     ASSUMPTION(how_many_bits_to_transfer <= sizeof(variable_where_the_value_is_stored) * 8U);
     ASSUMPTION(natural_16_bit(index_of_the_first_target_bit) + how_many_bits_to_transfer <= target_bits.num_bits());
 
-    natural_8_bit* const source_memory = reinterpret_cast<natural_8_bit*>(
-        &variable_where_the_value_is_stored
-        );
-
-    if (is_this_little_endian_machine())
-        std::reverse(
-            source_memory,
-            source_memory + sizeof(variable_where_the_value_is_stored)
-            );
-
-    bits_reference_impl const source_bits(
-        source_memory,
-        0,
-        sizeof(variable_where_the_value_is_stored) * 8U
+    write_bits(
+        target_bits.first_byte_ptr(),
+        (natural_32_bit)target_bits.shift_in_the_first_byte() + index_of_the_first_target_bit,
+        how_many_bits_to_transfer,
+        variable_where_the_value_is_stored
         );
-
-    for (natural_16_bit i = 0; i < how_many_bits_to_transfer; ++i)
-        set_bit(
-            target_bits,
-            index_of_the_first_target_bit + i,
-            get_bit(
-                source_bits,
-                source_bits.num_bits() - 1U - i
-                )
-            );
 }
 
 }
@@ -237,6 +311,11 @@ void  swap_referenced_bits( bits_reference& left_bits, bits_reference& right_bit
     details::swap_referenced_bits(details::get_impl(left_bits),details::get_impl(right_bits));
 }
 
+void  copy_referenced_bits(bits_const_reference const& source_bits, bits_reference& target_bits)
+{
+    details::copy_referenced_bits(details::get_impl(source_bits),details::get_impl(target_bits));
+}
+
 void bits_to_value(
     bits_reference const& source_bits,
     natural_8_bit index_of_the_first_bit,
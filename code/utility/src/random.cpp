@@ -4,6 +4,7 @@
 #include <limits>
 #include <algorithm>
 #include <iterator>
+#include <cstring>
 
 
 random_generator_for_natural_32_bit&  default_random_generator()
@@ -60,6 +61,179 @@ void  reset(random_generator_for_natural_64_bit&  generator, natural_64_bit cons
 }
 
 
+void  philox_4x32_10(natural_32_bit const  key[2], natural_32_bit const  counter[4], natural_32_bit  output[4])
+{
+    natural_32_bit  k0 = key[0];
+    natural_32_bit  k1 = key[1];
+    natural_32_bit  x0 = counter[0];
+    natural_32_bit  x1 = counter[1];
+    natural_32_bit  x2 = counter[2];
+    natural_32_bit  x3 = counter[3];
+    for (natural_32_bit  round = 0U; round != 10U; ++round)
+    {
+        natural_64_bit const  product0 = (natural_64_bit)0xD2511F53U * (natural_64_bit)x0;
+        natural_64_bit const  product1 = (natural_64_bit)0xCD9E8D57U * (natural_64_bit)x2;
+        natural_32_bit const  y0 = (natural_32_bit)(product1 >> 32U) ^ x1 ^ k0;
+        natural_32_bit const  y1 = (natural_32_bit)product1;
+        natural_32_bit const  y2 = (natural_32_bit)(product0 >> 32U) ^ x3 ^ k1;
+        natural_32_bit const  y3 = (natural_32_bit)product0;
+        x0 = y0; x1 = y1; x2 = y2; x3 = y3;
+        k0 += 0x9E3779B9U;
+        k1 += 0xBB67AE85U;
+    }
+    output[0] = x0;
+    output[1] = x1;
+    output[2] = x2;
+    output[3] = x3;
+}
+
+
+counter_based_random_generator::counter_based_random_generator(
+        natural_64_bit const  seed,
+        natural_32_bit const  step,
+        natural_64_bit const  substream
+        )
+    : m_key{ (natural_32_bit)seed, (natural_32_bit)(seed >> 32U) }
+    , m_counter{ 0U, step, (natural_32_bit)substream, (natural_32_bit)(substream >> 32U) }
+    , m_block{ 0U, 0U, 0U, 0U }
+    , m_index_in_block(4U)
+{}
+
+
+void  counter_based_random_generator::generate_next_block()
+{
+    philox_4x32_10(m_key,m_counter,m_block);
+    ++m_counter[0];
+    INVARIANT(m_counter[0] != 0U); // The stream is exhausted (2^34 numbers were generated).
+    m_index_in_block = 0U;
+}
+
+
+void  counter_based_random_generator::fill(natural_32_bit*  begin, natural_32_bit* const  end)
+{
+    for ( ; begin != end && m_index_in_block != 4U; ++begin)
+        *begin = m_block[m_index_in_block++];
+    for ( ; end - begin >= 4; begin += 4)
+    {
+        philox_4x32_10(m_key,m_counter,begin);
+        ++m_counter[0];
+        INVARIANT(m_counter[0] != 0U);
+    }
+    for ( ; begin != end; ++begin)
+        *begin = (*this)();
+}
+
+
+void  counter_based_random_generator::fill(float_32_bit*  begin, float_32_bit* const  end)
+{
+    static_assert(sizeof(float_32_bit) == sizeof(natural_32_bit),"We reuse the output memory for the raw numbers.");
+    fill(reinterpret_cast<natural_32_bit*>(begin),reinterpret_cast<natural_32_bit*>(end));
+    for ( ; begin != end; ++begin)
+    {
+        natural_32_bit  raw;
+        std::memcpy(&raw,begin,sizeof(raw));
+        *begin = (float_32_bit)(raw >> 8U) * (1.0f / 16777216.0f);
+    }
+}
+
+
+natural_32_bit  get_random_natural_32_bit_in_range(
+    natural_32_bit const min_value,
+    natural_32_bit const max_value,
+    counter_based_random_generator&   generator
+    )
+{
+    ASSUMPTION(min_value <= max_value);
+    natural_32_bit const  range = max_value - min_value;
+    if (range == 0xffffffffU)
+        return generator();
+    // Lemire's multiply-and-shift with rejection of the biased low part (no division in the common case).
+    natural_64_bit const  num_values = (natural_64_bit)range + 1ULL;
+    natural_64_bit  product = (natural_64_bit)generator() * num_values;
+    if ((natural_32_bit)product < num_values)
+    {
+        natural_32_bit const  threshold = (natural_32_bit)((0x100000000ULL - num_values) % num_values);
+        while ((natural_32_bit)product < threshold)
+            product = (natural_64_bit)generator() * num_values;
+    }
+    return min_value + (natural_32_bit)(product >> 32U);
+}
+
+
+float_32_bit  get_random_float_32_bit_in_range(
+    float_32_bit const min_value,
+    float_32_bit const max_value,
+    counter_based_random_generator&   generator
+    )
+{
+    ASSUMPTION(min_value <= max_value);
+    float_64_bit const  coef = (float_64_bit)(generator() >> 8U) / 16777216.0;
+    return static_cast<float_32_bit>(min_value + coef * (max_value - min_value));
+}
+
+
+natural_64_bit  get_random_natural_64_bit_in_range(
+    natural_64_bit const  min_value,
+    natural_64_bit const  max_value,
+    counter_based_random_generator&  generator
+    )
+{
+    ASSUMPTION(min_value <= max_value);
+    natural_64_bit const  range = max_value - min_value;
+    if (range <= (natural_64_bit)0xffffffffU)
+        return min_value + get_random_natural_32_bit_in_range(0U,(natural_32_bit)range,generator);
+    natural_64_bit  value = ((natural_64_bit)generator() << 32U) | (natural_64_bit)generator();
+    if (range == std::numeric_limits<natural_64_bit>::max())
+        return value;
+    natural_64_bit const  num_values = range + 1ULL;
+    natural_64_bit const  threshold = (natural_64_bit)(0ULL - num_values) % num_values;
+    while (value < threshold)
+        value = ((natural_64_bit)generator() << 32U) | (natural_64_bit)generator();
+    return min_value + value % num_values;
+}
+
+
+void  fill_by_random_natural_32_bit_in_range(
+    natural_32_bit*  begin,
+    natural_32_bit* const  end,
+    natural_32_bit const min_value,
+    natural_32_bit const max_value,
+    counter_based_random_generator&   generator
+    )
+{
+    for ( ; begin != end; ++begin)
+        *begin = get_random_natural_32_bit_in_range(min_value,max_value,generator);
+}
+
+
+void  fill_by_random_float_32_bit_in_range(
+    float_32_bit*  begin,
+    float_32_bit* const  end,
+    float_32_bit const min_value,
+    float_32_bit const max_value,
+    counter_based_random_generator&   generator
+    )
+{
+    ASSUMPTION(min_value <= max_value);
+    generator.fill(begin,end);
+    for ( ; begin != end; ++begin)
+        *begin = static_cast<float_32_bit>(min_value + (float_64_bit)*begin * (max_value - min_value));
+}
+
+
+void  fill_by_random_natural_64_bit_in_range(
+    natural_64_bit*  begin,
+    natural_64_bit* const  end,
+    natural_64_bit const  min_value,
+    natural_64_bit const  max_value,
+    counter_based_random_generator&  generator
+    )
+{
+    for ( ; begin != end; ++begin)
+        *begin = get_random_natural_64_bit_in_range(min_value,max_value,generator);
+}
+
+
 bar_random_distribution  make_bar_random_distribution_from_count_bars(
         std::vector<natural_64_bit> const&  count_bars
         )
@@ -119,16 +293,16 @@ bar_random_distribution  make_bar_random_distribution_from_probability_bars(
     return distribution;
 }
 
-natural_32_bit  get_random_bar_index(
+static natural_32_bit  get_bar_index(
     bar_random_distribution const&  bar_distribution,
-    random_generator_for_natural_32_bit&   generator
+    float_32_bit const  random_value_in_unit_interval
     )
 {
     bar_random_distribution::const_iterator const  it =
             std::upper_bound(
                     bar_distribution.cbegin(),
                     bar_distribution.cend(),
-                    get_random_float_32_bit_in_range(0.0f,1.0f,generator)
+                    random_value_in_unit_interval
                     );
     return static_cast<natural_32_bit>(
                 (it == bar_distribution.cend()) ? bar_distribution.size() - 1UL :
@@ -136,6 +310,22 @@ natural_32_bit  get_random_bar_index(
                 );
 }
 
+natural_32_bit  get_random_bar_index(
+    bar_random_distribution const&  bar_distribution,
+    random_generator_for_natural_32_bit&   generator
+    )
+{
+    return get_bar_index(bar_distribution, get_random_float_32_bit_in_range(0.0f,1.0f,generator));
+}
+
+natural_32_bit  get_random_bar_index(
+    bar_random_distribution const&  bar_distribution,
+    counter_based_random_generator&   generator
+    )
+{
+    return get_bar_index(bar_distribution, get_random_float_32_bit_in_range(0.0f,1.0f,generator));
+}
+
 float_32_bit  get_random_float_32_bit_in_range(
         float_32_bit const min_value,
         float_32_bit const max_value,
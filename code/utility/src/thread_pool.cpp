@@ -0,0 +1,112 @@
+#include <utility/thread_pool.hpp>
+#include <utility/assumptions.hpp>
+#include <utility/invariants.hpp>
+
+
+thread_pool::thread_pool(natural_32_bit const num_workers)
+    : m_workers()
+    , m_mutex()
+    , m_start_condition()
+    , m_finish_condition()
+    , m_task(nullptr)
+    , m_num_active_workers(0U)
+    , m_num_unfinished_workers(0U)
+    , m_generation(0ULL)
+    , m_terminate(false)
+    , m_exception()
+{
+    m_workers.reserve(num_workers);
+    for (natural_32_bit i = 0U; i < num_workers; ++i)
+        m_workers.push_back(std::thread(&thread_pool::worker, this, i));
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> const  lock(m_mutex);
+        m_terminate = true;
+    }
+    m_start_condition.notify_all();
+    for (std::thread&  thread : m_workers)
+        thread.join();
+}
+
+void  thread_pool::run_and_wait(natural_32_bit const  num_threads, task_type const&  task)
+{
+    ASSUMPTION(num_threads > 0U && num_threads <= num_workers() + 1U);
+
+    {
+        std::lock_guard<std::mutex> const  lock(m_mutex);
+        INVARIANT(m_num_unfinished_workers == 0U);
+        m_task = &task;
+        m_num_active_workers = num_threads - 1U;
+        m_num_unfinished_workers = num_threads - 1U;
+        m_exception = nullptr;
+        ++m_generation;
+    }
+    if (num_threads > 1U)
+        m_start_condition.notify_all();
+
+    std::exception_ptr  exception_of_this_thread;
+    try
+    {
+        task(0U);
+    }
+    catch (...)
+    {
+        exception_of_this_thread = std::current_exception();
+    }
+
+    std::exception_ptr  exception_of_workers;
+    {
+        std::unique_lock<std::mutex>  lock(m_mutex);
+        m_finish_condition.wait(lock, [this] { return m_num_unfinished_workers == 0U; });
+        m_task = nullptr;
+        exception_of_workers = m_exception;
+        m_exception = nullptr;
+    }
+
+    if (exception_of_this_thread)
+        std::rethrow_exception(exception_of_this_thread);
+    if (exception_of_workers)
+        std::rethrow_exception(exception_of_workers);
+}
+
+void  thread_pool::worker(natural_32_bit const  worker_index)
+{
+    natural_64_bit  last_generation = 0ULL;
+    while (true)
+    {
+        task_type const*  task;
+        {
+            std::unique_lock<std::mutex>  lock(m_mutex);
+            m_start_condition.wait(lock, [this, last_generation, worker_index] {
+                return m_terminate || (m_generation != last_generation && worker_index < m_num_active_workers);
+                });
+            if (m_terminate)
+                return;
+            last_generation = m_generation;
+            task = m_task;
+        }
+
+        std::exception_ptr  exception;
+        try
+        {
+            (*task)(worker_index + 1U);
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> const  lock(m_mutex);
+            if (exception && !m_exception)
+                m_exception = exception;
+            INVARIANT(m_num_unfinished_workers > 0U);
+            --m_num_unfinished_workers;
+            if (m_num_unfinished_workers == 0U)
+                m_finish_condition.notify_all();
+        }
+    }
+}